@@ -0,0 +1,32 @@
+#pragma once
+
+#include <opencv2/core.hpp>
+
+/*
+* Landmark distances of one tracker result, in (sub)pixels.
+* Landmark indices are the 49 IntraFace points.
+*/
+struct FaceFeatures
+{
+	float NoseHeight;      // 10 - 16
+	float LeftEyeV1;       // 20 - 24
+	float LeftEyeV2;       // 21 - 23
+	float LeftEyeH;        // 19 - 22
+	float RightEyeV1;      // 26 - 30
+	float RightEyeV2;      // 27 - 29
+	float RightEyeH;       // 25 - 28
+	float MouthHeight;     // 44 - 47
+	float MouthWidth;      // 31 - 37
+	float LeftBrowHeight;  // 10 - 4
+	float RightBrowHeight; // 10 - 5
+
+	// eye aspect ratio, (v1 + v2) / (2 * h)
+	float LeftEAR;
+	float RightEAR;
+};
+
+/*
+* Compute every FaceFeatures distance in one SIMD pass
+* landmarks: 2x49 CV_32F, row 0 = x, row 1 = y
+*/
+void ExtractFaceFeatures(const cv::Mat& landmarks, FaceFeatures& outFeatures);
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+
+/*
+* Face parameters from one tracker result.
+* Published by Ioface as a whole, so a sample never mixes two tracker results.
+*/
+struct FaceSample
+{
+	uint64_t Sequence = 0;  // increased by one for every published sample, 0 = nothing published yet
+	double Timestamp = 0.0; // capture time of the frame, in seconds of std::chrono::steady_clock
+
+	bool IsDetected = false;
+	float Score = 0.0f;
+
+	float DistScale = 1.f;
+	float AngleX = 0.0f;
+	float AngleY = 0.0f;
+	float AngleZ = 0.0f;
+	float LeftEAR = 0.0f;
+	float RightEAR = 0.0f;
+	float EAR = 0.0f; // average of left & right EAR
+	float MouthOpenY = 0.0f;
+	float MouthForm = 1.0f;
+	float EyeBrowLY = 0.0f;
+	float EyeBrowRY = 0.0f;
+};
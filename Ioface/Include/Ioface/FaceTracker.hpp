@@ -0,0 +1,47 @@
+#pragma once
+
+#include <opencv2/core.hpp>
+
+/*
+* Landmark tracker backend used by Ioface.
+*
+* Landmarks are 2xn float matrix (row 0: x, row 1: y), n = 49.
+* Rotation is 3x3 float head rotation matrix.
+*/
+class FaceTracker
+{
+public:
+	virtual ~FaceTracker() = default;
+
+	virtual const char* GetName() const = 0;
+	virtual bool IsInitialized() const = 0;
+
+	// false when the backend produces results without camera frames (e.g. replay)
+	virtual bool NeedsFrames() const { return true; }
+
+	// false when Detect() doesn't need a face rectangle from the face detector
+	virtual bool NeedsFaceRect() const { return true; }
+
+	// true when no more results will come (e.g. a replay that reached its end)
+	virtual bool IsFinished() const { return false; }
+
+	/*
+	* Find landmarks of the face inside faceRect
+	* return true when landmarks & score are valid
+	*/
+	virtual bool Detect(const cv::Mat& image, const cv::Rect& faceRect, cv::Mat& landmarks, float& score) = 0;
+
+	/*
+	* Follow previous landmarks into the new image
+	* return true when landmarks & score are valid
+	*/
+	virtual bool Track(const cv::Mat& image, const cv::Mat& prevLandmarks, cv::Mat& landmarks, float& score) = 0;
+
+	virtual bool EstimateHeadPose(const cv::Mat& landmarks, cv::Mat& rotation) = 0;
+
+	/*
+	* Capture time of the last result in seconds of std::chrono::steady_clock,
+	* return 0 to use the capture time of the camera frame
+	*/
+	virtual double GetResultTimestamp() const { return 0.0; }
+};
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <opencv2/core.hpp>
+#include <opencv2/videoio.hpp>
+#include "Ioface/TripleBuffer.hpp"
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <string>
+#include <cstdint>
+
+/*
+* Read frames from a cv::VideoCapture on its own thread.
+*
+* Frames are written into a lock-free triple buffer of preallocated cv::Mat,
+* the consumer always swap out the newest frame and never wait for the sensor.
+* Frames that the consumer didn't take in time are overwritten (dropped).
+*/
+class FrameGrabber
+{
+public:
+	FrameGrabber();
+	~FrameGrabber();
+
+	FrameGrabber(const FrameGrabber&) = delete;
+	FrameGrabber& operator=(const FrameGrabber&) = delete;
+
+	/*
+	* Open camera / video file / image sequence (e.g. "frames/img_%04d.png")
+	* and start the grabber thread.
+	* return false when the source can't be opened or the first frame can't be read
+	*/
+	bool OpenCamera(int deviceId);
+	bool OpenFile(const std::string& filePath, bool loop = true);
+
+	// stop the grabber thread and release the source
+	void Close();
+
+	bool IsOpened() const { return m_Running.load(std::memory_order_acquire); }
+
+	/*
+	* Take the newest frame, outFrame will point to a buffer owned by the grabber,
+	* it stays valid until the next successful AcquireLatest().
+	* return false when there's no frame newer than the previous one
+	*/
+	bool AcquireLatest(cv::Mat& outFrame);
+
+	/*
+	* Block until a new frame is published or timeout
+	* return true when a new frame is ready
+	*/
+	bool WaitForFrame(int timeoutMs);
+
+	// sequence number of the last acquired frame (starts from 1)
+	uint64_t GetFrameSequence() const { return m_FrontSequence; }
+
+	// capture time of the last acquired frame, in seconds of std::chrono::steady_clock
+	double GetFrameTimestamp() const { return m_Frames.ReadBuffer().Timestamp; }
+
+	uint64_t GetGrabbedCount() const { return m_GrabbedCount.load(std::memory_order_relaxed); }
+	uint64_t GetDroppedCount() const { return m_DroppedCount; }
+
+private:
+	bool Start();
+	void GrabLoop();
+	bool ReadNextFrame(cv::Mat& frame);
+	void Publish();
+	void StopRunning();
+
+private:
+	struct GrabbedFrame
+	{
+		cv::Mat Image;
+		uint64_t Sequence = 0;
+		double Timestamp = 0.0;
+	};
+
+	cv::VideoCapture m_Cap;
+
+	// file source
+	bool m_IsFile;
+	bool m_Loop;
+	std::string m_FilePath;
+	double m_FramePeriod; // seconds, 0 for live camera
+
+	TripleBuffer<GrabbedFrame> m_Frames;
+
+	uint64_t m_FrontSequence;
+	uint64_t m_DroppedCount;
+	std::atomic<uint64_t> m_GrabbedCount;
+
+	std::thread m_Thread;
+	std::atomic<bool> m_Running;
+
+	// only used to park the consumer when there's nothing new,
+	// Publish() and StopRunning() change the waited state under it
+	std::mutex m_MtxWait;
+	std::condition_variable m_CvFrameReady;
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Ioface/FaceTracker.hpp"
+#include <memory>
+
+namespace INTRAFACE {
+	class XXDescriptor;
+	class FaceAlignment;
+}
+
+/*
+* IntraFace (Windows only binary) landmark tracker
+*/
+class IntraFaceTracker : public FaceTracker
+{
+public:
+	IntraFaceTracker(const char* detectionModel, const char* trackingModel);
+	~IntraFaceTracker();
+
+	const char* GetName() const override { return "IntraFace"; }
+	bool IsInitialized() const override;
+
+	bool Detect(const cv::Mat& image, const cv::Rect& faceRect, cv::Mat& landmarks, float& score) override;
+	bool Track(const cv::Mat& image, const cv::Mat& prevLandmarks, cv::Mat& landmarks, float& score) override;
+	bool EstimateHeadPose(const cv::Mat& landmarks, cv::Mat& rotation) override;
+
+private:
+	std::unique_ptr<INTRAFACE::XXDescriptor> m_XXD;
+	std::unique_ptr<INTRAFACE::FaceAlignment> m_FaceAlignment;
+};
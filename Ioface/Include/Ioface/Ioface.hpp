@@ -7,11 +7,14 @@
 #include <opencv2/objdetect.hpp>
 #include <opencv2/calib3d.hpp>
 #include <opencv2/features2d.hpp>
-#include "intraface/FaceAlignment.h"
-#include "intraface/XXDescriptor.h"
+#include "Ioface/FrameGrabber.hpp"
+#include "Ioface/FaceTracker.hpp"
+#include "Ioface/LandmarkRecorder.hpp"
+#include "Ioface/FaceSample.hpp"
+#include "Ioface/TripleBuffer.hpp"
 #include <memory>
 #include <optional>
-#include <tuple>
+#include <mutex>
 
 class Ioface
 {
@@ -27,7 +30,26 @@ public:
 	* return false when failed
 	*/
 	bool OpenCamera(int deviceId = 0);
-	bool IsCameraOpened() const { return m_Cap.isOpened(); }
+
+	/*
+	* Open video file or image sequence (e.g. "frames/img_%04d.png") as the frame source,
+	* file paths given to Ioface are UTF-8
+	* return true when success
+	* return false when failed
+	*/
+	bool OpenVideoFile(const std::string& filePath, bool loop = true);
+
+	/*
+	* Replay a landmark recording (.iolm) instead of tracking camera frames
+	* realtime: false = replay as fast as possible
+	* loop: false = stop at the end of the recording
+	* return true when success
+	* return false when failed
+	*/
+	bool OpenReplay(const std::string& filePath, bool realtime = true, bool loop = true);
+
+	// camera, video file, or replay is opened
+	bool IsCameraOpened() const { return m_Grabber.IsOpened() || m_ReplayTracker != nullptr; }
 
 	void CloseCamera();
 
@@ -36,23 +58,53 @@ public:
 
 	void UpdateAll();
 
+	/*
+	* Copy the newest published face sample
+	* must be called from a single consumer thread (e.g. the render thread)
+	* return true when it's a new sample since the previous call
+	*/
+	bool GetLatestSample(FaceSample& outSample);
+
 	void ShowFrame(bool showFace = false);
 	void CloseAllFrame();
 
 	void PrintIofaceStatus();
 
+	/*
+	* Record tracker results of every frame into a landmark recording (.iolm)
+	*/
+	bool StartRecording(const std::string& filePath);
+	void StopRecording();
+	bool IsRecording();
+
+	struct DetectionStats
+	{
+		int Attempts = 0;         // attempts since the face was lost
+		float LastTimeMs = 0.0f;  // duration of the last attempt
+		bool LastWasFullFrame = false;
+	};
+	const DetectionStats& GetDetectionStats() const { return m_DetectionStats; }
+
+	/*
+	* Euler angles in degrees (pitch, yaw, roll) of a 3x3 CV_32F rotation matrix,
+	* same angles as cv::decomposeProjectionMatrix but without allocating
+	*/
+	static cv::Vec3d RotationToEuler(const cv::Mat& rotation);
+
 private:
-	void UpdateFrame();
+	bool UpdateFrame();
 	void UpdateParameters();
 	void DoUpdateParameters();
+	void PublishSample(float score);
 	
 	void DrawPose(float lineL);
 	void DrawLandmarks(cv::Mat& frame, const cv::Scalar& pointColor = cv::Scalar(0, 255, 0));
 
 	std::optional<cv::Rect> DetectFirstFace(const cv::Mat& image);
-	void EstimateHeadPose(const INTRAFACE::HeadPose& headPose);
+	std::optional<cv::Rect> DetectFaceInRegion(const cv::Mat& image, const cv::Rect& region, int minFaceSize);
+	static cv::Rect GetLandmarksBoundingBox(const cv::Mat& landmarks);
+	void EstimateHeadPose(const cv::Mat& rotation);
 	void EstimateFeatureDistance(const cv::Mat& landmarks);
-	std::tuple<float, float> GetEyeAspectRatio(const cv::Mat& landmarks);
 
 public:
 	// log function
@@ -61,35 +113,38 @@ public:
 	// tracking delay in milliseconds
 	int TrackingDelay;
 
-	// parameter properties
-	float DistScale = 1.f;
-	float AngleX = 0.0f;
-	float AngleY = 0.0f;
-	float AngleZ = 0.0f;
-	float LeftEAR = 0.0f;
-	float RightEAR = 0.0f;
-	float EAR = 0.0f; // average of left & right EAR
-	float MouthOpenY = 0.0f;
-	float MouthForm = 1.0f;
-	float EyeBrowLY = 0.0f;
-	float EyeBrowRY = 0.0f;
-
 private:
-	bool m_Initialized;
-
-	cv::VideoCapture m_Cap;
-	cv::Mat m_Frame;
+	FrameGrabber m_Grabber;
+	cv::Mat m_Frame; // newest frame, shared with the grabber's buffer
 	
 	cv::CascadeClassifier m_FaceCascade;
+
+	// face re-detection
+	static constexpr int kFullFrameSearchInterval = 10; // frames
+	static constexpr int kFullFrameMinFaceSize = 150;   // the bigger the lighter, but can't see smoll face
+	static constexpr int kMinScaledFaceSize = 40;       // stop downscaling below this face size
+	cv::Rect m_LastFaceRect; // landmarks bounding box of the last detected face
+	DetectionStats m_DetectionStats;
 	
-	std::unique_ptr<INTRAFACE::XXDescriptor> m_XXD;
-	std::unique_ptr<INTRAFACE::FaceAlignment> m_FaceAlignment;
-	INTRAFACE::HeadPose m_HeadPose;
+	// landmark tracker backends
+	std::unique_ptr<FaceTracker> m_LiveTracker;   // tracks camera frames
+	std::unique_ptr<FaceTracker> m_ReplayTracker; // only while a recording is replayed
+	FaceTracker* m_Tracker;                       // active backend
 
 	cv::Mat m_Landmarks; // 49 facial landmarks
+	cv::Mat m_HeadRotation; // 3x3
+
+	LandmarkRecorder m_Recorder;
+	std::mutex m_MtxRecorder;
+
+	// parameters of the current tracker result, only touched by the capture thread
+	FaceSample m_Sample;
+	TripleBuffer<FaceSample> m_PublishedSamples;
+	uint64_t m_ConsumedSequence;
 
 	// flags
 	bool m_IsDetected;
 	bool m_DoDisplayErrors;
 	bool m_WaitingFaceHasPrinted;
+	bool m_TrackerEndHasPrinted;
 };
\ No newline at end of file
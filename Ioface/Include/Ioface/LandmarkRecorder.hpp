@@ -0,0 +1,46 @@
+#pragma once
+
+#include <opencv2/core.hpp>
+#include <fstream>
+#include <string>
+#include <cstdint>
+
+/*
+* Landmark recording (.iolm), tracker results of every frame in a compact binary file.
+*
+* header : char[4] "IOLM", uint32 version, uint32 point count (n)
+* record : double timestamp (seconds since the first record), float score,
+*          float landmarks[2 * n] (n x then n y), float rotation[9] (row major)
+*/
+namespace LandmarkRecording {
+	constexpr char kMagic[4] = { 'I', 'O', 'L', 'M' };
+	constexpr uint32_t kVersion = 1;
+	constexpr uint32_t kPointCount = 49;
+
+	// floats per record after the timestamp
+	constexpr uint32_t FloatsPerRecord(uint32_t pointCount) { return 1 + pointCount * 2 + 9; }
+}
+
+class LandmarkRecorder
+{
+public:
+	LandmarkRecorder() = default;
+	~LandmarkRecorder() { Close(); }
+
+	bool Open(const std::string& filePath);
+	void Close();
+	bool IsOpen() const { return m_File.is_open(); }
+
+	/*
+	* Append one tracker result
+	* empty landmarks / rotation are written as zeros
+	*/
+	void Write(double timestamp, float score, const cv::Mat& landmarks, const cv::Mat& rotation);
+
+	uint64_t GetRecordCount() const { return m_RecordCount; }
+
+private:
+	std::ofstream m_File;
+	double m_FirstTimestamp = 0.0;
+	uint64_t m_RecordCount = 0;
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Ioface/FaceTracker.hpp"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/*
+* Play a landmark recording (.iolm) back as tracker results.
+* Doesn't need a camera, a face detector or IntraFace.
+*/
+class ReplayTracker : public FaceTracker
+{
+public:
+	/*
+	* realtime: true  = results come at their recorded speed
+	*           false = as fast as they are requested (benchmark)
+	*/
+	ReplayTracker(const std::string& filePath, bool realtime = true, bool loop = true);
+
+	const char* GetName() const override { return "Replay"; }
+	bool IsInitialized() const override { return m_RecordCount > 0; }
+
+	bool NeedsFrames() const override { return false; }
+	bool NeedsFaceRect() const override { return false; }
+
+	bool Detect(const cv::Mat& image, const cv::Rect& faceRect, cv::Mat& landmarks, float& score) override;
+	bool Track(const cv::Mat& image, const cv::Mat& prevLandmarks, cv::Mat& landmarks, float& score) override;
+	bool EstimateHeadPose(const cv::Mat& landmarks, cv::Mat& rotation) override;
+
+	double GetResultTimestamp() const override { return m_ResultTimestamp; }
+
+	bool IsFinished() const override { return !m_Loop && m_NextRecord >= m_RecordCount; }
+
+	size_t GetRecordCount() const { return m_RecordCount; }
+
+private:
+	bool Load(const std::string& filePath);
+	bool NextRecord(cv::Mat& landmarks, float& score);
+	const float* GetRecord(size_t index) const;
+
+private:
+	bool m_Realtime;
+	bool m_Loop;
+
+	uint32_t m_PointCount;
+	size_t m_RecordCount;
+	std::vector<double> m_Timestamps;
+	std::vector<float> m_Records; // FloatsPerRecord() floats per record
+
+	size_t m_NextRecord;
+	size_t m_CurrentRecord;
+
+	double m_StartTime;  // steady clock time of the first record
+	double m_LoopOffset; // recording length * played loops
+	double m_ResultTimestamp;
+};
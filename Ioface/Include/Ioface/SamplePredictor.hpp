@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Ioface/FaceSample.hpp"
+#include <array>
+
+/*
+* Keep the last few timestamped face samples and evaluate the face at render time,
+* so a slow tracker can drive a faster render loop without steps.
+*/
+class SamplePredictor
+{
+public:
+	enum class Mode
+	{
+		Latest = 0,  // newest sample as is
+		Interpolate, // interpolate between samples, InterpolationDelay seconds in the past
+		Extrapolate, // constant velocity from the two newest samples
+		Count
+	};
+
+	enum class Group
+	{
+		HeadAngles = 0, // AngleX, AngleY, AngleZ and DistScale
+		Eyes,           // LeftEAR, RightEAR, EAR
+		Mouth,          // MouthOpenY, MouthForm
+		Brows,          // EyeBrowLY, EyeBrowRY
+		Count
+	};
+
+public:
+	SamplePredictor();
+
+	/*
+	* Add a new tracker sample, samples must be pushed in capture order.
+	* An undetected sample clears the history.
+	*/
+	void Push(const FaceSample& sample);
+	void Clear();
+
+	/*
+	* Evaluate the face at renderTime (seconds of std::chrono::steady_clock)
+	* return false when there's no sample yet
+	*/
+	bool Evaluate(double renderTime, FaceSample& outSample) const;
+
+	void SetMode(Group group, Mode mode) { m_Modes[static_cast<int>(group)] = mode; }
+	Mode GetMode(Group group) const { return m_Modes[static_cast<int>(group)]; }
+	Mode* GetPtrMode(Group group) { return &m_Modes[static_cast<int>(group)]; }
+
+	static double Now();
+
+	static const char* ModeName(Mode mode);
+	static const char* GroupName(Group group);
+
+public:
+	// delay used by Mode::Interpolate, should cover one tracker frame plus the tracker latency and jitter,
+	// shorter and the newest sample is often reached, the parameters then hold until the next one.
+	// 60 ms fits a 30 FPS camera (33 ms) with ~15 ms of tracking and a few ms of capture jitter
+	float InterpolationDelay = 0.06f;
+
+	// Mode::Extrapolate never predicts further than this from the newest sample
+	float MaxExtrapolation = 0.1f;
+
+private:
+	// i = 0 is the newest sample
+	const FaceSample& GetHistory(int i) const;
+
+	void EvaluateGroup(Group group, double renderTime, FaceSample& outSample) const;
+
+private:
+	static constexpr int kHistorySize = 8;
+
+	std::array<FaceSample, kHistorySize> m_History;
+	int m_HistoryHead;  // index of the newest sample
+	int m_HistoryCount;
+
+	std::array<Mode, static_cast<int>(Group::Count)> m_Modes;
+};
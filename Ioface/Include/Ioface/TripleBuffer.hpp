@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/*
+* Lock-free single producer / single consumer triple buffer.
+*
+* The producer fills WriteBuffer() then Publish(), the consumer calls Update()
+* and reads ReadBuffer(). The consumer always sees a whole, newest published value,
+* values published in between are overwritten.
+*/
+template<typename T>
+class TripleBuffer
+{
+public:
+	TripleBuffer() : m_BackIndex(0), m_FrontIndex(1), m_Middle(2) {}
+
+	TripleBuffer(const TripleBuffer&) = delete;
+	TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+	// producer side
+	T& WriteBuffer() { return m_Buffers[m_BackIndex]; }
+
+	void Publish()
+	{
+		// swap back <-> middle, and mark middle as fresh
+		uint8_t oldMiddle = m_Middle.exchange(static_cast<uint8_t>(m_BackIndex) | kFreshBit, std::memory_order_acq_rel);
+		m_BackIndex = oldMiddle & kIndexMask;
+	}
+
+	// consumer side
+	bool HasNew() const { return (m_Middle.load(std::memory_order_acquire) & kFreshBit) != 0; }
+
+	/*
+	* Swap the newest published value into ReadBuffer()
+	* return false when nothing was published since the last Update()
+	*/
+	bool Update()
+	{
+		if (!HasNew())
+			return false;
+
+		// swap front <-> middle, and mark middle as consumed
+		uint8_t oldMiddle = m_Middle.exchange(static_cast<uint8_t>(m_FrontIndex), std::memory_order_acq_rel);
+		m_FrontIndex = oldMiddle & kIndexMask;
+		return true;
+	}
+
+	const T& ReadBuffer() const { return m_Buffers[m_FrontIndex]; }
+
+	/*
+	* Direct access to every buffer (e.g. for preallocation),
+	* only safe while neither side is running
+	*/
+	T& At(int index) { return m_Buffers[index]; }
+	static constexpr int Size() { return kBufferCount; }
+
+	void Reset()
+	{
+		m_BackIndex = 0;
+		m_FrontIndex = 1;
+		m_Middle.store(2, std::memory_order_release);
+	}
+
+private:
+	static constexpr int kBufferCount = 3;
+
+	// bits 0-1: index of the middle buffer, bit 2: middle buffer holds a new value
+	static constexpr uint8_t kIndexMask = 0x3;
+	static constexpr uint8_t kFreshBit = 0x4;
+
+	T m_Buffers[kBufferCount];
+
+	int m_BackIndex;  // owned by the producer
+	int m_FrontIndex; // owned by the consumer
+	std::atomic<uint8_t> m_Middle;
+};
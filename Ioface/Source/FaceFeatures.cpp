@@ -0,0 +1,57 @@
+#include "Ioface/FaceFeatures.hpp"
+#include <opencv2/core/hal/intrin.hpp>
+#include <cmath>
+
+namespace {
+	// landmark pairs, in the order of the FaceFeatures distances,
+	// padded to a multiple of the vector width with a zero length pair
+	constexpr int kPairCount = 12;
+
+	const int kPairFrom[kPairCount] = { 10, 20, 21, 19, 26, 27, 25, 44, 31, 10, 10, 0 };
+	const int kPairTo[kPairCount]   = { 16, 24, 23, 22, 30, 29, 28, 47, 37,  4,  5, 0 };
+}
+
+void ExtractFaceFeatures(const cv::Mat& landmarks, FaceFeatures& outFeatures)
+{
+	CV_Assert(landmarks.type() == CV_32FC1 && landmarks.rows == 2 && landmarks.cols >= 49);
+
+	const float* xs = landmarks.ptr<float>(0);
+	const float* ys = landmarks.ptr<float>(1);
+
+	// gather the pair deltas, SoA
+	CV_DECL_ALIGNED(16) float dx[kPairCount];
+	CV_DECL_ALIGNED(16) float dy[kPairCount];
+	for (int i = 0; i < kPairCount; i++)
+	{
+		dx[i] = xs[kPairTo[i]] - xs[kPairFrom[i]];
+		dy[i] = ys[kPairTo[i]] - ys[kPairFrom[i]];
+	}
+
+	CV_DECL_ALIGNED(16) float distances[kPairCount];
+#if CV_SIMD128
+	for (int i = 0; i < kPairCount; i += 4)
+	{
+		cv::v_float32x4 vx = cv::v_load_aligned(dx + i);
+		cv::v_float32x4 vy = cv::v_load_aligned(dy + i);
+		cv::v_store_aligned(distances + i, cv::v_sqrt(vx * vx + vy * vy));
+	}
+#else
+	for (int i = 0; i < kPairCount; i++)
+		distances[i] = std::sqrt(dx[i] * dx[i] + dy[i] * dy[i]);
+#endif
+
+	outFeatures.NoseHeight = distances[0];
+	outFeatures.LeftEyeV1 = distances[1];
+	outFeatures.LeftEyeV2 = distances[2];
+	outFeatures.LeftEyeH = distances[3];
+	outFeatures.RightEyeV1 = distances[4];
+	outFeatures.RightEyeV2 = distances[5];
+	outFeatures.RightEyeH = distances[6];
+	outFeatures.MouthHeight = distances[7];
+	outFeatures.MouthWidth = distances[8];
+	outFeatures.LeftBrowHeight = distances[9];
+	outFeatures.RightBrowHeight = distances[10];
+
+	outFeatures.LeftEAR = (outFeatures.LeftEyeV1 + outFeatures.LeftEyeV2) / (2.0f * outFeatures.LeftEyeH);
+	outFeatures.RightEAR = (outFeatures.RightEyeV1 + outFeatures.RightEyeV2) / (2.0f * outFeatures.RightEyeH);
+}
@@ -0,0 +1,198 @@
+#include "Ioface/FrameGrabber.hpp"
+#include <chrono>
+
+static double SteadyClockSeconds()
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+FrameGrabber::FrameGrabber()
+	: m_IsFile(false), m_Loop(false), m_FramePeriod(0.0),
+	m_FrontSequence(0), m_DroppedCount(0), m_GrabbedCount(0),
+	m_Running(false)
+{
+}
+
+FrameGrabber::~FrameGrabber()
+{
+	Close();
+}
+
+bool FrameGrabber::OpenCamera(int deviceId)
+{
+	Close();
+
+	m_IsFile = false;
+	m_Loop = false;
+	m_FilePath.clear();
+	m_FramePeriod = 0.0;
+
+	m_Cap.open(deviceId);
+	return Start();
+}
+
+bool FrameGrabber::OpenFile(const std::string& filePath, bool loop)
+{
+	Close();
+
+	m_IsFile = true;
+	m_Loop = loop;
+	m_FilePath = filePath;
+
+	m_Cap.open(filePath);
+
+	// play the file at its recorded speed, image sequences usually report 0 fps
+	double fps = m_Cap.get(cv::CAP_PROP_FPS);
+	m_FramePeriod = (fps > 0.0 && fps < 1000.0) ? 1.0 / fps : 1.0 / 30.0;
+
+	return Start();
+}
+
+bool FrameGrabber::Start()
+{
+	if (!m_Cap.isOpened())
+		return false;
+
+	cv::Mat testFrame;
+	if (!m_Cap.read(testFrame) || testFrame.empty())
+	{
+		m_Cap.release();
+		return false;
+	}
+
+	// preallocate every slot, so VideoCapture::read() can reuse the buffers
+	m_Frames.Reset();
+	for (int i = 0; i < m_Frames.Size(); i++)
+	{
+		testFrame.copyTo(m_Frames.At(i).Image);
+		m_Frames.At(i).Sequence = 0;
+		m_Frames.At(i).Timestamp = 0.0;
+	}
+
+	m_FrontSequence = 0;
+	m_DroppedCount = 0;
+	m_GrabbedCount.store(0, std::memory_order_relaxed);
+
+	// the test frame is a valid frame too
+	m_Frames.WriteBuffer().Sequence = 1;
+	m_Frames.WriteBuffer().Timestamp = SteadyClockSeconds();
+	m_GrabbedCount.store(1, std::memory_order_relaxed);
+	Publish();
+
+	m_Running.store(true, std::memory_order_release);
+	m_Thread = std::thread(&FrameGrabber::GrabLoop, this);
+
+	return true;
+}
+
+void FrameGrabber::Close()
+{
+	StopRunning();
+	if (m_Thread.joinable())
+		m_Thread.join();
+
+	if (m_Cap.isOpened())
+		m_Cap.release();
+
+	for (int i = 0; i < m_Frames.Size(); i++)
+		m_Frames.At(i).Image.release();
+}
+
+void FrameGrabber::GrabLoop()
+{
+	using clock = std::chrono::steady_clock;
+	auto nextFrameTime = clock::now();
+
+	while (m_Running.load(std::memory_order_acquire))
+	{
+		if (m_IsFile)
+		{
+			// pacing for file source, a camera is paced by its sensor
+			nextFrameTime += std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(m_FramePeriod));
+			auto now = clock::now();
+			if (nextFrameTime > now)
+				std::this_thread::sleep_until(nextFrameTime);
+			else
+				nextFrameTime = now;
+		}
+
+		GrabbedFrame& backFrame = m_Frames.WriteBuffer();
+		if (!ReadNextFrame(backFrame.Image))
+		{
+			if (m_IsFile && !m_Loop)
+			{
+				// end of file
+				StopRunning();
+				break;
+			}
+
+			// camera hiccup, don't spin on a disconnected device
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+			continue;
+		}
+
+		backFrame.Timestamp = SteadyClockSeconds();
+		backFrame.Sequence = m_GrabbedCount.fetch_add(1, std::memory_order_relaxed) + 1;
+		Publish();
+	}
+}
+
+bool FrameGrabber::ReadNextFrame(cv::Mat& frame)
+{
+	if (m_Cap.read(frame) && !frame.empty())
+		return true;
+
+	if (m_IsFile && m_Loop)
+	{
+		// rewind, reopening works for both video files and image sequences
+		m_Cap.open(m_FilePath);
+		return m_Cap.read(frame) && !frame.empty();
+	}
+
+	return false;
+}
+
+void FrameGrabber::Publish()
+{
+	// publish under the wait mutex, a consumer between its HasNew() check
+	// and the wait would otherwise miss the notification and sleep until the timeout
+	{
+		std::lock_guard<std::mutex> lock(m_MtxWait);
+		m_Frames.Publish();
+	}
+	m_CvFrameReady.notify_one();
+}
+
+void FrameGrabber::StopRunning()
+{
+	// same as Publish(), the consumer checks IsOpened() under the wait mutex
+	{
+		std::lock_guard<std::mutex> lock(m_MtxWait);
+		m_Running.store(false, std::memory_order_release);
+	}
+	m_CvFrameReady.notify_all();
+}
+
+bool FrameGrabber::AcquireLatest(cv::Mat& outFrame)
+{
+	if (!m_Frames.Update())
+		return false;
+
+	const GrabbedFrame& frontFrame = m_Frames.ReadBuffer();
+
+	uint64_t sequence = frontFrame.Sequence;
+	if (m_FrontSequence > 0 && sequence > m_FrontSequence + 1)
+		m_DroppedCount += sequence - m_FrontSequence - 1;
+	m_FrontSequence = sequence;
+
+	outFrame = frontFrame.Image;
+	return true;
+}
+
+bool FrameGrabber::WaitForFrame(int timeoutMs)
+{
+	std::unique_lock<std::mutex> lock(m_MtxWait);
+	return m_CvFrameReady.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this]() {
+		return m_Frames.HasNew() || !IsOpened();
+	}) && IsOpened();
+}
@@ -0,0 +1,40 @@
+#include "Ioface/IntraFaceTracker.hpp"
+#include "intraface/FaceAlignment.h"
+#include "intraface/XXDescriptor.h"
+
+IntraFaceTracker::IntraFaceTracker(const char* detectionModel, const char* trackingModel)
+{
+	m_XXD = std::make_unique<INTRAFACE::XXDescriptor>(4);
+	m_FaceAlignment = std::make_unique<INTRAFACE::FaceAlignment>(
+		detectionModel,
+		trackingModel,
+		m_XXD.get()
+	);
+}
+
+IntraFaceTracker::~IntraFaceTracker() = default;
+
+bool IntraFaceTracker::IsInitialized() const
+{
+	return m_FaceAlignment && m_FaceAlignment->Initialized();
+}
+
+bool IntraFaceTracker::Detect(const cv::Mat& image, const cv::Rect& faceRect, cv::Mat& landmarks, float& score)
+{
+	return m_FaceAlignment->Detect(image, faceRect, landmarks, score) == INTRAFACE::IF_OK;
+}
+
+bool IntraFaceTracker::Track(const cv::Mat& image, const cv::Mat& prevLandmarks, cv::Mat& landmarks, float& score)
+{
+	return m_FaceAlignment->Track(image, prevLandmarks, landmarks, score) == INTRAFACE::IF_OK;
+}
+
+bool IntraFaceTracker::EstimateHeadPose(const cv::Mat& landmarks, cv::Mat& rotation)
+{
+	INTRAFACE::HeadPose headPose;
+	if (m_FaceAlignment->EstimateHeadPose(landmarks, headPose) != INTRAFACE::IF_OK)
+		return false;
+
+	rotation = headPose.rot;
+	return true;
+}
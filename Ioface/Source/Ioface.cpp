@@ -1,15 +1,20 @@
 #include "Ioface/Ioface.hpp"
+#include "Ioface/ReplayTracker.hpp"
+#include "Ioface/FaceFeatures.hpp"
+#if IOFACE_INTRAFACE
+#include "Ioface/IntraFaceTracker.hpp"
+#endif
 #include <vector>
 #include <cmath>
 #include <thread>
 #include <chrono>
 #include <iostream>
 
-#define L2Norm(p1, p2) std::sqrt(std::pow(p2.x - p1.x, 2) + std::pow(p2.y - p1.y, 2))
 #define INGFO std::cout << "[IOFACE][DEBUG] "
 
 Ioface::Ioface()
-	: m_Initialized(false), m_IsDetected(false), m_DoDisplayErrors(true), m_WaitingFaceHasPrinted(false), TrackingDelay(0)
+	: TrackingDelay(0), m_Tracker(nullptr), m_ConsumedSequence(0),
+	m_IsDetected(false), m_DoDisplayErrors(true), m_WaitingFaceHasPrinted(false), m_TrackerEndHasPrinted(false)
 {
 }
 
@@ -20,63 +25,97 @@ Ioface::~Ioface()
 
 void Ioface::Init()
 {
+#if IOFACE_INTRAFACE
 	const char* fa_detection_model = "./Assets/models/DetectionModel-v1.5.bin";
 	const char* fa_tracking_model = "./Assets/models/TrackingModel-v1.10.bin";
 
-	m_XXD = std::make_unique<INTRAFACE::XXDescriptor>(4);
-	m_FaceAlignment = std::make_unique<INTRAFACE::FaceAlignment>(
-		fa_detection_model,
-		fa_tracking_model,
-		m_XXD.get()
-	);
-
-	bool error = false;
+	m_LiveTracker = std::make_unique<IntraFaceTracker>(fa_detection_model, fa_tracking_model);
+#endif
+	m_Tracker = m_LiveTracker.get();
 
-	if (m_FaceAlignment->Initialized())
+	if (m_LiveTracker && m_LiveTracker->IsInitialized())
+	{
+		LoggingFunction("[Ioface][I] %s initialized\n", m_LiveTracker->GetName());
+	}
+	else if (m_LiveTracker)
 	{
-		LoggingFunction("[Ioface][I] IntraFace initialized\n");
+		LoggingFunction("[Ioface][E] Can't initialize %s!\n", m_LiveTracker->GetName());
 	}
 	else
 	{
-		LoggingFunction("[Ioface][E] Can't initialize IntraFace!\n");
-		error = true;
+		LoggingFunction("[Ioface][E] Built without a live face tracker, only replay is available!\n");
 	}
 
 	m_FaceCascade = cv::CascadeClassifier("./Assets/models/haarcascade_frontalface_alt2.xml");
 	if (m_FaceCascade.empty())
 	{
-		error = true;
 		LoggingFunction("[Ioface][E] Can't load face detection model!\n");
 	}
 	else
 	{
 		LoggingFunction("[Ioface][I] Face detection model loaded\n");
 	}
-
-	m_Initialized = !error;
 }
 
 bool Ioface::OpenCamera(int deviceId)
 {
 	m_DoDisplayErrors = true;
 	m_WaitingFaceHasPrinted = false;
+	m_TrackerEndHasPrinted = false;
 
-	m_Cap.open(deviceId);
-
-	cv::Mat testFrame;
-	bool testSuccess = m_Cap.read(testFrame);
+	m_ReplayTracker.reset();
+	m_Tracker = m_LiveTracker.get();
 
-	if (!testSuccess || testFrame.empty())
+	if (!m_Grabber.OpenCamera(deviceId))
 	{
 		LoggingFunction("[Ioface][E] Can't read new frame from camera!\n");
+		return false;
+	}
 
-		m_Cap.release();
+	return true;
+}
+
+bool Ioface::OpenVideoFile(const std::string& filePath, bool loop)
+{
+	m_DoDisplayErrors = true;
+	m_WaitingFaceHasPrinted = false;
+	m_TrackerEndHasPrinted = false;
+
+	m_ReplayTracker.reset();
+	m_Tracker = m_LiveTracker.get();
+
+	if (!m_Grabber.OpenFile(filePath, loop))
+	{
+		LoggingFunction("[Ioface][E] Can't read new frame from %s!\n", filePath.c_str());
 		return false;
 	}
-	else
+
+	return true;
+}
+
+bool Ioface::OpenReplay(const std::string& filePath, bool realtime, bool loop)
+{
+	m_DoDisplayErrors = true;
+	m_WaitingFaceHasPrinted = false;
+	m_TrackerEndHasPrinted = false;
+
+	auto replayTracker = std::make_unique<ReplayTracker>(filePath, realtime, loop);
+	if (!replayTracker->IsInitialized())
 	{
-		return m_Cap.isOpened();
+		LoggingFunction("[Ioface][E] Can't read landmark recording %s!\n", filePath.c_str());
+		return false;
 	}
+
+	LoggingFunction("[Ioface][I] Replaying %d records from %s\n",
+		static_cast<int>(replayTracker->GetRecordCount()), filePath.c_str());
+
+	// replay doesn't need camera frames
+	m_Grabber.Close();
+
+	m_ReplayTracker = std::move(replayTracker);
+	m_Tracker = m_ReplayTracker.get();
+
+	return true;
 }
 
 void Ioface::CloseCamera()
@@ -84,43 +123,116 @@ void Ioface::CloseCamera()
 	m_DoDisplayErrors = true;
 
 	CloseAllFrame();
-	if (m_Cap.isOpened())
-		m_Cap.release();
+	m_Grabber.Close();
+
+	m_ReplayTracker.reset();
+	m_Tracker = m_LiveTracker.get();
+
+	StopRecording();
 
 	if (!m_Frame.empty())
 		m_Frame.release();
 }
 
+bool Ioface::StartRecording(const std::string& filePath)
+{
+	std::lock_guard<std::mutex> lock(m_MtxRecorder);
+	if (!m_Recorder.Open(filePath))
+	{
+		LoggingFunction("[Ioface][E] Can't create landmark recording %s!\n", filePath.c_str());
+		return false;
+	}
+
+	LoggingFunction("[Ioface][I] Recording landmarks into %s\n", filePath.c_str());
+	return true;
+}
+
+void Ioface::StopRecording()
+{
+	std::lock_guard<std::mutex> lock(m_MtxRecorder);
+	if (m_Recorder.IsOpen())
+	{
+		m_Recorder.Close();
+		LoggingFunction("[Ioface][I] Landmark recording stopped, %d records\n", static_cast<int>(m_Recorder.GetRecordCount()));
+	}
+}
+
+bool Ioface::IsRecording()
+{
+	std::lock_guard<std::mutex> lock(m_MtxRecorder);
+	return m_Recorder.IsOpen();
+}
+
 void Ioface::PrintIofaceStatus()
 {
-	LoggingFunction("Status:\n\tCamera opened: %d\n", m_Cap.isOpened());
+	LoggingFunction("Status:\n\tCamera opened: %d\n", m_Grabber.IsOpened());
 	LoggingFunction("\tFrame not empty: %d\n", !m_Frame.empty());
-	LoggingFunction("\tIntraface initialized: %d\n", m_FaceAlignment->Initialized());
+	LoggingFunction("\tFace tracker (%s) initialized: %d\n",
+		m_Tracker ? m_Tracker->GetName() : "none", m_Tracker && m_Tracker->IsInitialized());
 	LoggingFunction("\tFace detection model loaded: %d\n", !m_FaceCascade.empty());
 }
 
 void Ioface::UpdateAll()
 {
-	UpdateFrame();
-	UpdateParameters();
+	if (m_Tracker && m_Tracker->IsFinished())
+	{
+		if (!m_TrackerEndHasPrinted)
+		{
+			LoggingFunction("[Ioface][I] %s has no more results\n", m_Tracker->GetName());
+			m_TrackerEndHasPrinted = true;
+		}
+
+		// nothing will come anymore, don't spin the capture loop
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		return;
+	}
+
+	if (m_Tracker && !m_Tracker->NeedsFrames())
+	{
+		// replay, results don't come from camera frames
+		UpdateParameters();
+		return;
+	}
+
+	if (UpdateFrame())
+		UpdateParameters();
 }
 
-void Ioface::UpdateFrame()
+bool Ioface::UpdateFrame()
 {
-	if (m_Cap.isOpened())
+	if (m_Grabber.IsOpened())
 	{
-		m_Cap.read(m_Frame);
+		// always track the newest frame, older frames are skipped by the grabber
+		if (m_Grabber.AcquireLatest(m_Frame))
+			return true;
+
+		// nothing new yet, wait for the grabber instead of tracking the same frame again
+		if (m_Grabber.WaitForFrame(100))
+			return m_Grabber.AcquireLatest(m_Frame);
+
+		return false;
 	}
 	else
 	{
+		// never opened, stopped, or a video file at its end: report once
 		if (m_DoDisplayErrors)
+		{
+			m_DoDisplayErrors = false;
 			LoggingFunction("[Ioface][E] Can't take new frame from camera because it's not opened\n");
+			PrintIofaceStatus();
+		}
+
+		// and don't spin the capture loop until a camera or file is opened again
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		return false;
 	}
 }
 
 void Ioface::UpdateParameters()
 {
-	bool errStatus = (!m_Cap.isOpened() || !m_Initialized || m_Frame.empty());
+	bool errStatus = (!m_Tracker || !m_Tracker->IsInitialized() ||
+		(m_Tracker->NeedsFrames() && (!m_Grabber.IsOpened() || m_Frame.empty())) ||
+		(m_Tracker->NeedsFaceRect() && m_FaceCascade.empty()));
 	if (errStatus)
 	{
 		if (m_DoDisplayErrors)
@@ -139,7 +251,7 @@ void Ioface::UpdateParameters()
 	{
 		// trying to track new accurate landmarks based on previous landmarks
 		cv::Mat trackedLandmarks;
-		if (m_FaceAlignment->Track(m_Frame, m_Landmarks, trackedLandmarks, score) == INTRAFACE::IF_OK)
+		if (m_Tracker->Track(m_Frame, m_Landmarks, trackedLandmarks, score))
 		{
 			m_Landmarks = trackedLandmarks;
 
@@ -157,16 +269,20 @@ void Ioface::UpdateParameters()
 			m_WaitingFaceHasPrinted = true;
 		}
 
-		auto faceRect = DetectFirstFace(m_Frame);
-		if (!faceRect.has_value()) // check is there's a face in the frame
+		cv::Rect faceRect;
+		if (m_Tracker->NeedsFaceRect())
 		{
-			// sleep a little bit, because detecting face again and again, is heavy.
-			std::this_thread::sleep_for(std::chrono::milliseconds(100));
-			return;
+			auto detectedFaceRect = DetectFirstFace(m_Frame);
+			if (!detectedFaceRect.has_value()) // check is there's a face in the frame
+			{
+				// try again on the next frame, the search is cheap enough to not sleep
+				return;
+			}
+			faceRect = detectedFaceRect.value();
 		}
 
 		// detect face landmarks
-		if (m_FaceAlignment->Detect(m_Frame, faceRect.value(), m_Landmarks, score) == INTRAFACE::IF_OK)
+		if (m_Tracker->Detect(m_Frame, faceRect, m_Landmarks, score))
 		{
 			// got accurate Landmarks, do follow them in the next frame
 			doTrackLandmarks = true;
@@ -174,8 +290,10 @@ void Ioface::UpdateParameters()
 			if (score > 0.5)
 			{
 				// log
-				LoggingFunction("[Ioface][I] Found face!\n\n");
+				LoggingFunction("[Ioface][I] Found face! (%d attempts, last detection %.1fms)\n\n",
+					m_DetectionStats.Attempts, m_DetectionStats.LastTimeMs);
 				m_WaitingFaceHasPrinted = false;
+				m_DetectionStats.Attempts = 0;
 			}
 		}
 	}
@@ -183,6 +301,7 @@ void Ioface::UpdateParameters()
 	if (score > 0.5)
 	{
 		m_IsDetected = true;
+		m_LastFaceRect = GetLandmarksBoundingBox(m_Landmarks);
 		DoUpdateParameters();
 	}
 	else
@@ -191,13 +310,45 @@ void Ioface::UpdateParameters()
 		m_IsDetected = false;
 		doTrackLandmarks = false;
 	}
+
+	PublishSample(score);
+}
+
+void Ioface::PublishSample(float score)
+{
+	// replay has its own timestamps
+	double trackerTimestamp = m_Tracker->GetResultTimestamp();
+
+	m_Sample.Sequence++;
+	m_Sample.Timestamp = trackerTimestamp > 0.0 ? trackerTimestamp : m_Grabber.GetFrameTimestamp();
+	m_Sample.IsDetected = m_IsDetected;
+	m_Sample.Score = score;
+
+	{
+		std::lock_guard<std::mutex> lock(m_MtxRecorder);
+		if (m_Recorder.IsOpen())
+			m_Recorder.Write(m_Sample.Timestamp, score, m_Landmarks, m_HeadRotation);
+	}
+
+	m_PublishedSamples.WriteBuffer() = m_Sample;
+	m_PublishedSamples.Publish();
+}
+
+bool Ioface::GetLatestSample(FaceSample& outSample)
+{
+	m_PublishedSamples.Update();
+	outSample = m_PublishedSamples.ReadBuffer();
+
+	bool isNewSample = outSample.Sequence != m_ConsumedSequence;
+	m_ConsumedSequence = outSample.Sequence;
+	return isNewSample;
 }
 
 void Ioface::DoUpdateParameters()
 {
 	// head pose estimation
-	m_FaceAlignment->EstimateHeadPose(m_Landmarks, m_HeadPose);
-	EstimateHeadPose(m_HeadPose);
+	if (m_Tracker->EstimateHeadPose(m_Landmarks, m_HeadRotation))
+		EstimateHeadPose(m_HeadRotation);
 
 	EstimateFeatureDistance(m_Landmarks);
 
@@ -249,14 +400,47 @@ void Ioface::DoUpdateParameters()
 	}*/
 }
 
-void Ioface::EstimateHeadPose(const INTRAFACE::HeadPose& headPose)
+cv::Vec3d Ioface::RotationToEuler(const cv::Mat& rotation)
+{
+	CV_Assert(rotation.type() == CV_32FC1 && rotation.rows == 3 && rotation.cols == 3);
+
+	const float* r1 = rotation.ptr<float>(1);
+	const float* r2 = rotation.ptr<float>(2);
+
+	/*
+	* Same Givens rotations as cv::RQDecomp3x3 (x, then y, then z),
+	* written out for a rotation matrix: R = Rz * Ry * Rx.
+	* The 180 degree ambiguity fix of RQDecomp3x3 never triggers for a proper rotation.
+	*/
+	const double kRadToDeg = 180.0 / CV_PI;
+
+	// x: zero r21
+	double nx = std::sqrt((double)r2[1] * r2[1] + (double)r2[2] * r2[2]);
+	double sx = nx > 0.0 ? r2[1] / nx : 0.0;
+	double cx = nx > 0.0 ? r2[2] / nx : 1.0;
+
+	// row 1 after x
+	double m11 = r1[1] * cx - r1[2] * sx;
+	double m12 = r1[1] * sx + r1[2] * cx;
+
+	// y: zero r20, r22 became nx
+	double ny = std::sqrt((double)r2[0] * r2[0] + nx * nx);
+	double sy = ny > 0.0 ? -r2[0] / ny : 0.0;
+	double cy = ny > 0.0 ? nx / ny : 1.0;
+
+	// z: zero r10
+	double m10 = r1[0] * cy + m12 * sy;
+
+	return cv::Vec3d(
+		std::atan2(sx, cx) * kRadToDeg,
+		std::atan2(sy, cy) * kRadToDeg,
+		std::atan2(m10, m11) * kRadToDeg
+	);
+}
+
+void Ioface::EstimateHeadPose(const cv::Mat& rotation)
 {
-	cv::Vec3d eav;
-	cv::Mat tmp, tmp1, tmp2, tmp3, tmp4, tmp5;
-	double _pm[12] = { headPose.rot.at<float>(0, 0), headPose.rot.at<float>(0, 1),headPose.rot.at<float>(0, 2), 0,
-						headPose.rot.at<float>(1, 0), headPose.rot.at<float>(1, 1),headPose.rot.at<float>(1, 2), 0,
-						headPose.rot.at<float>(2, 0),headPose.rot.at<float>(2, 1),headPose.rot.at<float>(2, 2), 0 };
-	cv::decomposeProjectionMatrix(cv::Mat(3, 4, CV_64FC1, _pm), tmp, tmp1, tmp2, tmp3, tmp4, tmp5, eav);
+	cv::Vec3d eav = RotationToEuler(rotation);
 
 	/*
 		eav[0] : Pitch
@@ -264,87 +448,50 @@ void Ioface::EstimateHeadPose(const INTRAFACE::HeadPose& headPose)
 		eav[2] : Roll
 	*/
 
-	this->AngleY = -eav[0];
-	this->AngleX = eav[1];
-	this->AngleZ = -eav[2];
+	m_Sample.AngleY = -eav[0];
+	m_Sample.AngleX = eav[1];
+	m_Sample.AngleZ = -eav[2];
 }
 
 void Ioface::EstimateFeatureDistance(const cv::Mat& landmarks)
 {
+	FaceFeatures features;
+	ExtractFaceFeatures(landmarks, features);
+
 	// scale landmark size based on nose height
-	cv::Point pTopNose = cv::Point(landmarks.at<float>(0, 10), landmarks.at<float>(1, 10));
-	cv::Point pBottomNose = cv::Point(landmarks.at<float>(0, 16), landmarks.at<float>(1, 16));
-	float noseHeight = L2Norm(pTopNose, pBottomNose);
-	this->DistScale = noseHeight / 80.f;
-	if (DistScale > 1.0f)
+	float distScale = features.NoseHeight / 80.f;
+	if (distScale > 1.0f)
 	{
-		DistScale = 1.f - (DistScale - 1.f);
+		distScale = 1.f - (distScale - 1.f);
 	}
-	else if (DistScale < 1.0f)
+	else if (distScale < 1.0f)
 	{
-		DistScale = 1.f + (1.0f - DistScale);
-		if (DistScale > 1.5f)
-			DistScale = 1.5f;
+		distScale = 1.f + (1.0f - distScale);
+		if (distScale > 1.5f)
+			distScale = 1.5f;
 	}
+	m_Sample.DistScale = distScale;
 
-	// calculate eye aspect ratio
-	auto [_leftEAR, _rightEAR] = GetEyeAspectRatio(landmarks);
-	this->LeftEAR = _leftEAR;
-	this->RightEAR = _rightEAR;
-	this->EAR = (LeftEAR + RightEAR) / 2.0f;
+	// eye aspect ratio
+	// Reference: https://www.pyimagesearch.com/2017/04/24/eye-blink-detection-opencv-python-dlib/
+	m_Sample.LeftEAR = features.LeftEAR;
+	m_Sample.RightEAR = features.RightEAR;
+	m_Sample.EAR = (features.LeftEAR + features.RightEAR) / 2.0f;
 
 	// mouth open y (distance between point 44 & 47 (top & bottom mouth))
-	cv::Point pCenterMouthTop = cv::Point(landmarks.at<float>(0, 44), landmarks.at<float>(1, 44));
-	cv::Point pCenterMouthBottom = cv::Point(landmarks.at<float>(0, 47), landmarks.at<float>(1, 47));
-	this->MouthOpenY = L2Norm(pCenterMouthTop, pCenterMouthBottom);
+	m_Sample.MouthOpenY = features.MouthHeight;
 
 	// mouth form (distance between point 31 & 37 (left & right mouth))
-	cv::Point pMouthLeft = cv::Point(landmarks.at<float>(0, 31), landmarks.at<float>(1, 31));
-	cv::Point pMouthRight = cv::Point(landmarks.at<float>(0, 37), landmarks.at<float>(1, 37));
-	this->MouthForm = L2Norm(pMouthLeft, pMouthRight);
+	m_Sample.MouthForm = features.MouthWidth;
 
 	// eye brow (distance between brow & top nose)
-	cv::Point pBrowLeft = cv::Point(landmarks.at<float>(0, 4), landmarks.at<float>(1, 4));
-	cv::Point pBrowRight = cv::Point(landmarks.at<float>(0, 5), landmarks.at<float>(1, 5));
-	this->EyeBrowLY = L2Norm(pTopNose, pBrowLeft);
-	this->EyeBrowRY = L2Norm(pTopNose, pBrowRight);
-}
-
-std::tuple<float, float> Ioface::GetEyeAspectRatio(const cv::Mat& landmarks)
-{
-	/* Reference: https://www.pyimagesearch.com/2017/04/24/eye-blink-detection-opencv-python-dlib/
-	*/
-
-	// left eye
-	cv::Point l_eye_top_v1 = cv::Point(landmarks.at<float>(0, 20), landmarks.at<float>(1, 20)); // vertical 1
-	cv::Point l_eye_bottom_v1 = cv::Point(landmarks.at<float>(0, 24), landmarks.at<float>(1, 24));
-	cv::Point l_eye_top_v2 = cv::Point(landmarks.at<float>(0, 21), landmarks.at<float>(1, 21)); // vertical 2
-	cv::Point l_eye_bottom_v2 = cv::Point(landmarks.at<float>(0, 23), landmarks.at<float>(1, 23));
-	cv::Point l_eye_hl = cv::Point(landmarks.at<float>(0, 19), landmarks.at<float>(1, 19)); // horizontal left
-	cv::Point l_eye_hr = cv::Point(landmarks.at<float>(0, 22), landmarks.at<float>(1, 22)); // horizontal right
-	float l_eye_v1_range = L2Norm(l_eye_top_v1, l_eye_bottom_v1);
-	float l_eye_v2_range = L2Norm(l_eye_top_v2, l_eye_bottom_v2);
-	float l_eye_h_range = L2Norm(l_eye_hl, l_eye_hr);
-	float _leftEAR = (l_eye_v1_range + l_eye_v2_range) / (2.0f * l_eye_h_range);
-
-	// right eye
-	cv::Point r_eye_top_v1 = cv::Point(landmarks.at<float>(0, 26), landmarks.at<float>(1, 26));
-	cv::Point r_eye_bottom_v1 = cv::Point(landmarks.at<float>(0, 30), landmarks.at<float>(1, 30));
-	cv::Point r_eye_top_v2 = cv::Point(landmarks.at<float>(0, 27), landmarks.at<float>(1, 27));
-	cv::Point r_eye_bottom_v2 = cv::Point(landmarks.at<float>(0, 29), landmarks.at<float>(1, 29));
-	cv::Point r_eye_hl = cv::Point(landmarks.at<float>(0, 25), landmarks.at<float>(1, 25));
-	cv::Point r_eye_hr = cv::Point(landmarks.at<float>(0, 28), landmarks.at<float>(1, 28));
-	float r_eye_v1_range = L2Norm(r_eye_top_v1, r_eye_bottom_v1);
-	float r_eye_v2_range = L2Norm(r_eye_top_v2, r_eye_bottom_v2);
-	float r_eye_h_range = L2Norm(r_eye_hl, r_eye_hr);
-	float _rightEAR = (r_eye_v1_range + r_eye_v2_range) / (2.0f * r_eye_h_range);
-
-	return { _leftEAR, _rightEAR };
+	m_Sample.EyeBrowLY = features.LeftBrowHeight;
+	m_Sample.EyeBrowRY = features.RightBrowHeight;
 }
 
 void Ioface::ShowFrame(bool showFace)
 {
-	if (!m_Cap.isOpened() || m_Frame.empty()) return;
+	if (!m_Grabber.IsOpened() || m_Frame.empty()) return;
 	
 	cv::Mat showedFrame;
 
@@ -373,18 +520,101 @@ void Ioface::CloseAllFrame()
 
 std::optional<cv::Rect> Ioface::DetectFirstFace(const cv::Mat& image)
 {
+	auto start = std::chrono::steady_clock::now();
+
+	m_DetectionStats.Attempts++;
+
+	const cv::Rect frameRect(0, 0, image.cols, image.rows);
+	std::optional<cv::Rect> faceRect;
+
+	bool searchedFullFrame = false;
+	if (m_LastFaceRect.area() > 0)
+	{
+		// search around the last known face first, a lost face usually didn't go far
+		cv::Rect roi = m_LastFaceRect;
+		roi.x -= roi.width;
+		roi.y -= roi.height;
+		roi.width *= 3;
+		roi.height *= 3;
+		roi &= frameRect;
+
+		// cascade box is a bit bigger than the landmarks box
+		int minFaceSize = static_cast<int>(m_LastFaceRect.width * 0.6f);
+		faceRect = DetectFaceInRegion(image, roi, minFaceSize);
+	}
+
+	// full frame search is heavy, do it only every few frames once we know where the face was
+	if (!faceRect.has_value() &&
+		(m_LastFaceRect.area() == 0 || m_DetectionStats.Attempts % kFullFrameSearchInterval == 0))
+	{
+		faceRect = DetectFaceInRegion(image, frameRect, kFullFrameMinFaceSize);
+		searchedFullFrame = true;
+	}
+
+	auto end = std::chrono::steady_clock::now();
+	m_DetectionStats.LastTimeMs = std::chrono::duration<float, std::milli>(end - start).count();
+	m_DetectionStats.LastWasFullFrame = searchedFullFrame;
+
+#if IOFACE_DEBUG
+	INGFO << "face detection #" << m_DetectionStats.Attempts
+		<< (searchedFullFrame ? " (full frame) " : " (roi) ")
+		<< m_DetectionStats.LastTimeMs << "ms" << (faceRect.has_value() ? ", found" : "") << "\n";
+#endif
+
+	return faceRect;
+}
+
+std::optional<cv::Rect> Ioface::DetectFaceInRegion(const cv::Mat& image, const cv::Rect& region, int minFaceSize)
+{
+	if (region.width < kMinScaledFaceSize || region.height < kMinScaledFaceSize)
+		return std::nullopt;
+
+	cv::Mat gray;
+	if (image.channels() == 3)
+		cv::cvtColor(image(region), gray, cv::COLOR_BGR2GRAY);
+	else
+		gray = image(region);
+
+	// downscale with a pyramid as long as the smallest face stays detectable
+	int scale = 1;
+	if (minFaceSize < kMinScaledFaceSize)
+		minFaceSize = kMinScaledFaceSize;
+	while (minFaceSize / (scale * 2) >= kMinScaledFaceSize)
+	{
+		cv::Mat downscaled;
+		cv::pyrDown(gray, downscaled);
+		gray = downscaled;
+		scale *= 2;
+	}
+
 	std::vector<cv::Rect> facesRect;
-	m_FaceCascade.detectMultiScale(image, facesRect,
+	m_FaceCascade.detectMultiScale(gray, facesRect,
 		1.2,
 		2,
 		0,
-		cv::Size(150, 150) // the bigger the lighter, but can't see smoll face
+		cv::Size(minFaceSize / scale, minFaceSize / scale)
 	);
 
-	if (facesRect.size() > 0)
-		return facesRect[0];
-	else
+	if (facesRect.empty())
 		return std::nullopt;
+
+	const cv::Rect& face = facesRect[0];
+	return cv::Rect(
+		region.x + face.x * scale,
+		region.y + face.y * scale,
+		face.width * scale,
+		face.height * scale
+	);
+}
+
+cv::Rect Ioface::GetLandmarksBoundingBox(const cv::Mat& landmarks)
+{
+	double minX, maxX, minY, maxY;
+	cv::minMaxLoc(landmarks.row(0), &minX, &maxX);
+	cv::minMaxLoc(landmarks.row(1), &minY, &maxY);
+
+	return cv::Rect(cv::Point(static_cast<int>(minX), static_cast<int>(minY)),
+		cv::Point(static_cast<int>(maxX), static_cast<int>(maxY)));
 }
 
 void Ioface::DrawLandmarks(cv::Mat& frame, const cv::Scalar& pointColor)
@@ -405,7 +635,7 @@ void Ioface::DrawLandmarks(cv::Mat& frame, const cv::Scalar& pointColor)
 void Ioface::DrawPose(float lineL)
 {
 	if (!m_IsDetected && m_Landmarks.empty() && m_Frame.empty()) return;
-	if (m_HeadPose.rot.empty()) return;
+	if (m_HeadRotation.empty()) return;
 
 	int loc[2] = { 70, 70 };
 	int thickness = 2;
@@ -415,7 +645,7 @@ void Ioface::DrawPose(float lineL)
 		0, lineL, 0, 0,
 		0, 0, -lineL, 0,
 		0, 0, 0, -lineL);
-	P = m_HeadPose.rot.rowRange(0, 2) * P;
+	P = m_HeadRotation.rowRange(0, 2) * P;
 	P.row(0) += loc[0];
 	P.row(1) += loc[1];
 	cv::Point p0(P.at<float>(0, 0), P.at<float>(1, 0));
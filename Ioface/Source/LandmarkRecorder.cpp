@@ -0,0 +1,65 @@
+#include "Ioface/LandmarkRecorder.hpp"
+#include <vector>
+#include <algorithm>
+#include <filesystem>
+
+bool LandmarkRecorder::Open(const std::string& filePath)
+{
+	Close();
+
+	m_File.open(std::filesystem::u8path(filePath), std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!m_File.is_open())
+		return false;
+
+	m_File.write(LandmarkRecording::kMagic, sizeof(LandmarkRecording::kMagic));
+	m_File.write(reinterpret_cast<const char*>(&LandmarkRecording::kVersion), sizeof(uint32_t));
+	m_File.write(reinterpret_cast<const char*>(&LandmarkRecording::kPointCount), sizeof(uint32_t));
+
+	m_FirstTimestamp = 0.0;
+	m_RecordCount = 0;
+
+	return m_File.good();
+}
+
+void LandmarkRecorder::Close()
+{
+	if (m_File.is_open())
+		m_File.close();
+}
+
+void LandmarkRecorder::Write(double timestamp, float score, const cv::Mat& landmarks, const cv::Mat& rotation)
+{
+	if (!m_File.is_open()) return;
+
+	constexpr uint32_t pointCount = LandmarkRecording::kPointCount;
+	float record[LandmarkRecording::FloatsPerRecord(pointCount)] = {};
+
+	record[0] = score;
+
+	if (landmarks.rows == 2 && landmarks.cols == pointCount && landmarks.type() == CV_32FC1)
+	{
+		for (int row = 0; row < 2; row++)
+		{
+			const float* src = landmarks.ptr<float>(row);
+			std::copy(src, src + pointCount, record + 1 + row * pointCount);
+		}
+	}
+
+	if (rotation.rows == 3 && rotation.cols == 3 && rotation.type() == CV_32FC1)
+	{
+		for (int row = 0; row < 3; row++)
+		{
+			const float* src = rotation.ptr<float>(row);
+			std::copy(src, src + 3, record + 1 + pointCount * 2 + row * 3);
+		}
+	}
+
+	if (m_RecordCount == 0)
+		m_FirstTimestamp = timestamp;
+
+	double relativeTimestamp = timestamp - m_FirstTimestamp;
+	m_File.write(reinterpret_cast<const char*>(&relativeTimestamp), sizeof(double));
+	m_File.write(reinterpret_cast<const char*>(record), sizeof(record));
+
+	m_RecordCount++;
+}
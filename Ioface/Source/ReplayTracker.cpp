@@ -0,0 +1,126 @@
+#include "Ioface/ReplayTracker.hpp"
+#include "Ioface/LandmarkRecorder.hpp"
+#include <fstream>
+#include <filesystem>
+#include <thread>
+#include <chrono>
+#include <cstring>
+
+static double SteadyClockSeconds()
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+ReplayTracker::ReplayTracker(const std::string& filePath, bool realtime, bool loop)
+	: m_Realtime(realtime), m_Loop(loop),
+	m_PointCount(0), m_RecordCount(0),
+	m_NextRecord(0), m_CurrentRecord(0),
+	m_StartTime(0.0), m_LoopOffset(0.0), m_ResultTimestamp(0.0)
+{
+	if (!Load(filePath))
+	{
+		m_RecordCount = 0;
+		m_Timestamps.clear();
+		m_Records.clear();
+	}
+}
+
+bool ReplayTracker::Load(const std::string& filePath)
+{
+	std::ifstream file(std::filesystem::u8path(filePath), std::ios::in | std::ios::binary);
+	if (!file.is_open())
+		return false;
+
+	char magic[4];
+	uint32_t version = 0;
+	file.read(magic, sizeof(magic));
+	file.read(reinterpret_cast<char*>(&version), sizeof(uint32_t));
+	file.read(reinterpret_cast<char*>(&m_PointCount), sizeof(uint32_t));
+
+	if (!file.good() ||
+		std::memcmp(magic, LandmarkRecording::kMagic, sizeof(magic)) != 0 ||
+		version != LandmarkRecording::kVersion ||
+		m_PointCount == 0)
+	{
+		return false;
+	}
+
+	const uint32_t floatsPerRecord = LandmarkRecording::FloatsPerRecord(m_PointCount);
+	std::vector<float> record(floatsPerRecord);
+
+	while (true)
+	{
+		double timestamp;
+		file.read(reinterpret_cast<char*>(&timestamp), sizeof(double));
+		file.read(reinterpret_cast<char*>(record.data()), floatsPerRecord * sizeof(float));
+		if (!file.good())
+			break; // end of file, or a truncated last record
+
+		m_Timestamps.push_back(timestamp);
+		m_Records.insert(m_Records.end(), record.begin(), record.end());
+	}
+
+	m_RecordCount = m_Timestamps.size();
+	return m_RecordCount > 0;
+}
+
+const float* ReplayTracker::GetRecord(size_t index) const
+{
+	return m_Records.data() + index * LandmarkRecording::FloatsPerRecord(m_PointCount);
+}
+
+bool ReplayTracker::NextRecord(cv::Mat& landmarks, float& score)
+{
+	if (m_RecordCount == 0)
+		return false;
+
+	if (m_NextRecord >= m_RecordCount)
+	{
+		if (!m_Loop)
+			return false;
+
+		// start over, keep the timestamps going forward
+		m_LoopOffset += m_Timestamps.back() + (m_RecordCount > 1 ? m_Timestamps[1] - m_Timestamps[0] : 0.0);
+		m_NextRecord = 0;
+	}
+
+	if (m_NextRecord == 0 && m_LoopOffset == 0.0)
+		m_StartTime = SteadyClockSeconds();
+
+	m_CurrentRecord = m_NextRecord++;
+	m_ResultTimestamp = m_StartTime + m_LoopOffset + m_Timestamps[m_CurrentRecord];
+
+	if (m_Realtime)
+	{
+		auto resultTime = std::chrono::steady_clock::time_point(
+			std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(m_ResultTimestamp)));
+		std::this_thread::sleep_until(resultTime);
+	}
+
+	const float* record = GetRecord(m_CurrentRecord);
+	score = record[0];
+	cv::Mat(2, static_cast<int>(m_PointCount), CV_32FC1, const_cast<float*>(record + 1)).copyTo(landmarks);
+
+	return true;
+}
+
+bool ReplayTracker::Detect(const cv::Mat& /*image*/, const cv::Rect& /*faceRect*/, cv::Mat& landmarks, float& score)
+{
+	return NextRecord(landmarks, score);
+}
+
+bool ReplayTracker::Track(const cv::Mat& /*image*/, const cv::Mat& /*prevLandmarks*/, cv::Mat& landmarks, float& score)
+{
+	return NextRecord(landmarks, score);
+}
+
+bool ReplayTracker::EstimateHeadPose(const cv::Mat& /*landmarks*/, cv::Mat& rotation)
+{
+	if (m_RecordCount == 0)
+		return false;
+
+	const float* record = GetRecord(m_CurrentRecord);
+	cv::Mat(3, 3, CV_32FC1, const_cast<float*>(record + 1 + m_PointCount * 2)).copyTo(rotation);
+
+	return true;
+}
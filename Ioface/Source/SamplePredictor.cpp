@@ -0,0 +1,151 @@
+#include "Ioface/SamplePredictor.hpp"
+#include <chrono>
+#include <algorithm>
+
+namespace {
+	struct GroupFields
+	{
+		int count;
+		float FaceSample::* fields[4];
+	};
+
+	// face parameters grouped by SamplePredictor::Group
+	const GroupFields kGroupFields[] = {
+		{ 4, { &FaceSample::AngleX, &FaceSample::AngleY, &FaceSample::AngleZ, &FaceSample::DistScale } },
+		{ 3, { &FaceSample::LeftEAR, &FaceSample::RightEAR, &FaceSample::EAR } },
+		{ 2, { &FaceSample::MouthOpenY, &FaceSample::MouthForm } },
+		{ 2, { &FaceSample::EyeBrowLY, &FaceSample::EyeBrowRY } },
+	};
+}
+
+SamplePredictor::SamplePredictor()
+	: m_HistoryHead(0), m_HistoryCount(0)
+{
+	m_Modes.fill(Mode::Interpolate);
+}
+
+void SamplePredictor::Push(const FaceSample& sample)
+{
+	if (!sample.IsDetected)
+	{
+		// don't predict across a lost face
+		Clear();
+		return;
+	}
+
+	if (m_HistoryCount > 0)
+	{
+		const FaceSample& newest = GetHistory(0);
+		if (sample.Sequence == newest.Sequence || sample.Timestamp <= newest.Timestamp)
+			return;
+	}
+
+	m_HistoryHead = (m_HistoryHead + 1) % kHistorySize;
+	m_History[m_HistoryHead] = sample;
+	m_HistoryCount = std::min(m_HistoryCount + 1, kHistorySize);
+}
+
+void SamplePredictor::Clear()
+{
+	m_HistoryCount = 0;
+}
+
+const FaceSample& SamplePredictor::GetHistory(int i) const
+{
+	return m_History[(m_HistoryHead - i + kHistorySize) % kHistorySize];
+}
+
+bool SamplePredictor::Evaluate(double renderTime, FaceSample& outSample) const
+{
+	if (m_HistoryCount == 0)
+		return false;
+
+	outSample = GetHistory(0);
+
+	for (int group = 0; group < static_cast<int>(Group::Count); group++)
+		EvaluateGroup(static_cast<Group>(group), renderTime, outSample);
+
+	return true;
+}
+
+void SamplePredictor::EvaluateGroup(Group group, double renderTime, FaceSample& outSample) const
+{
+	const GroupFields& groupFields = kGroupFields[static_cast<int>(group)];
+
+	switch (m_Modes[static_cast<int>(group)])
+	{
+	case Mode::Interpolate:
+	{
+		double time = renderTime - InterpolationDelay;
+
+		// find the two samples around time, the history is ordered newest first
+		int i = 0;
+		while (i + 1 < m_HistoryCount && GetHistory(i).Timestamp > time)
+			i++;
+
+		const FaceSample& older = GetHistory(i);
+		const FaceSample& newer = GetHistory(i > 0 ? i - 1 : 0);
+
+		double span = newer.Timestamp - older.Timestamp;
+		float t = 0.0f;
+		if (span > 0.0)
+			t = static_cast<float>(std::clamp((time - older.Timestamp) / span, 0.0, 1.0));
+
+		for (int f = 0; f < groupFields.count; f++)
+		{
+			auto field = groupFields.fields[f];
+			outSample.*field = older.*field + (newer.*field - older.*field) * t;
+		}
+		break;
+	}
+	case Mode::Extrapolate:
+	{
+		if (m_HistoryCount < 2)
+			break; // keep the newest sample
+
+		const FaceSample& newest = GetHistory(0);
+		const FaceSample& previous = GetHistory(1);
+
+		double span = newest.Timestamp - previous.Timestamp;
+		double ahead = std::clamp(renderTime - newest.Timestamp, 0.0, static_cast<double>(MaxExtrapolation));
+		float k = static_cast<float>(ahead / span);
+
+		for (int f = 0; f < groupFields.count; f++)
+		{
+			auto field = groupFields.fields[f];
+			outSample.*field = newest.*field + (newest.*field - previous.*field) * k;
+		}
+		break;
+	}
+	default:
+		break; // Mode::Latest, already copied
+	}
+}
+
+double SamplePredictor::Now()
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+const char* SamplePredictor::ModeName(Mode mode)
+{
+	switch (mode)
+	{
+	case Mode::Latest: return "Latest";
+	case Mode::Interpolate: return "Interpolate";
+	case Mode::Extrapolate: return "Extrapolate";
+	default: return "";
+	}
+}
+
+const char* SamplePredictor::GroupName(Group group)
+{
+	switch (group)
+	{
+	case Group::HeadAngles: return "Head angles";
+	case Group::Eyes: return "Eyes";
+	case Group::Mouth: return "Mouth";
+	case Group::Brows: return "Brows";
+	default: return "";
+	}
+}
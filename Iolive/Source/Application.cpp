@@ -60,8 +60,18 @@ namespace Iolive {
 
 	void Application::OnUpdate()
 	{
-		if (m_Ioface.IsDetected())
-			DoOptimizeParameters();
+		// take a whole tracker result, never read Ioface parameters one by one
+		FaceSample faceSample;
+		if (m_Ioface.GetLatestSample(faceSample))
+			m_FacePredictor.Push(faceSample);
+
+		if (faceSample.IsDetected)
+		{
+			// tracker runs slower than the render loop, evaluate the face at render time
+			FaceSample predictedSample;
+			if (m_FacePredictor.Evaluate(SamplePredictor::Now(), predictedSample))
+				DoOptimizeParameters(predictedSample);
+		}
 
 		if (m_UserModel.IsModelInitialized())
 		{
@@ -131,8 +141,38 @@ namespace Iolive {
 	bool Application::OpenCamera()
 	{
 		int selectedCamId = MainGui::Get().SelectedCameraId;
-		ExampleAppLog::AddLogf("[Iolive][I] Opening camera with id: %d\n", selectedCamId);
-		if (m_Ioface.OpenCamera(selectedCamId))
+
+		bool opened = false;
+		if (selectedCamId < 0)
+		{
+			// video file / image sequence instead of a camera
+			// Ioface takes UTF-8 paths, non-ASCII paths must not depend on the C locale
+			const std::wstring& wFilePath = MainGui::Get().VideoFilePath;
+			std::string filePath;
+			bool isReplay = wFilePath.size() > 5 && wFilePath.compare(wFilePath.size() - 5, 5, L".iolm") == 0;
+			if (!WindowsAPI::WideToUtf8(wFilePath, filePath))
+			{
+				ExampleAppLog::AddLog("[Iolive][E] Can't convert the video file path to UTF-8!\n");
+			}
+			else if (isReplay)
+			{
+				// recorded landmarks, replayed without a tracker
+				ExampleAppLog::AddLogf("[Iolive][I] Opening landmark recording: %s\n", filePath.c_str());
+				opened = m_Ioface.OpenReplay(filePath);
+			}
+			else
+			{
+				ExampleAppLog::AddLogf("[Iolive][I] Opening video file: %s\n", filePath.c_str());
+				opened = m_Ioface.OpenVideoFile(filePath);
+			}
+		}
+		else
+		{
+			ExampleAppLog::AddLogf("[Iolive][I] Opening camera with id: %d\n", selectedCamId);
+			opened = m_Ioface.OpenCamera(selectedCamId);
+		}
+
+		if (opened)
 		{
 			ExampleAppLog::AddLog("[Iolive][I] Successfully opened the camera\n");
 
@@ -144,7 +184,7 @@ namespace Iolive {
 			if (m_UserModel.IsModelInitialized())
 			{
 				// bind model parameters with Ioface
-				BindDefaultParametersWithFace();
+				BindParametersWithFace();
 			}
 			return true;
 		}
@@ -169,13 +209,14 @@ namespace Iolive {
 		if (m_UserModel.IsModelInitialized())
 		{
 			// bind model parameters with the gui
-			BindDefaultParametersWithGui();
+			BindParametersWithGui();
 		}
 	}
 
 	void Application::SetModel(Model2D* model)
 	{
 		m_UserModel.SetModel(model);
+		model->SetPhysicsRate(MainGui::Get().GetPhysicsRate());
 
 		auto& parameterGui = MainGui::Get().ParameterGUI;
 		parameterGui.SetModel(model);
@@ -186,15 +227,9 @@ namespace Iolive {
 			model->SetParameterBindingAt(paramIndex, parameterGui.GetPtrValueByIndex(paramIndex));
 		}
 
-		if (m_Ioface.IsCameraOpened())
-		{
-			// there's a new model and camera opened
-			// but model parameter wasn't binded with face capture. Bind it now
-			BindDefaultParametersWithFace();
-		}
-
 		// Load iolive's settings file
 		std::wstring ioliveSettingsPath = model->GetModelDir() + kSettingsFileName;
+		bool settingsLoaded = false;
 		bool jsonReaded = m_JsonManager.ReadJson(ioliveSettingsPath.c_str());
 		if (jsonReaded)
 		{
@@ -207,12 +242,30 @@ namespace Iolive {
 				if (jsonVersion == kCurrentJsonVersion)
 				{
 					LoadHotkeys();
-					return;
+					settingsLoaded = true;
 				}
 			}
 		}
 
-		CreateNewHotkeys(ioliveSettingsPath.c_str());
+		if (!settingsLoaded)
+			CreateNewHotkeys(ioliveSettingsPath.c_str());
+
+		// hotkey motions are the likely ones, load them in the background now
+		if (model->GetMotionLoading().Lazy && model->GetMotionLoading().PrefetchHotkeys)
+		{
+			auto& guiHotkeys = MainGui::Get().GuiHotkeys;
+			for (int i = 0; i < guiHotkeys.Size(); i++)
+				model->PrefetchMotion(guiHotkeys.GetItemAtIndex(i));
+		}
+
+		LoadFaceMapping(ioliveSettingsPath.c_str());
+
+		if (m_Ioface.IsCameraOpened())
+		{
+			// there's a new model and camera opened
+			// but model parameter wasn't binded with face capture. Bind it now
+			BindParametersWithFace();
+		}
 	}
 
 	void Application::CreateNewHotkeys(const wchar_t* outFilePath)
@@ -456,76 +509,10 @@ namespace Iolive {
 		}
 	}
 
-	void Application::DoOptimizeParameters()
+	void Application::DoOptimizeParameters(const FaceSample& face)
 	{
 		/* Update Parameters from Ioface */
 
-		float deltaTime = static_cast<float>(m_Window->GetDeltaTime());
-		#define SMOOTH_SLOW(start, end) MathUtils::Lerp(start, end, deltaTime * 4.f)
-		#define SMOOTH_MEDIUM(start, end) MathUtils::Lerp(start, end, deltaTime * 8.f)
-		#define SMOOTH_FAST(start, end) MathUtils::Lerp(start, end, deltaTime * 16.f)
-
-		// ParamAngle
-		OptimizedParameter.ParamAngleX = SMOOTH_SLOW(OptimizedParameter.ParamAngleX, m_Ioface.AngleX);
-		OptimizedParameter.ParamAngleY = SMOOTH_SLOW(OptimizedParameter.ParamAngleY, m_Ioface.AngleY * 1.3f);
-		OptimizedParameter.ParamAngleZ = SMOOTH_SLOW(OptimizedParameter.ParamAngleZ, m_Ioface.AngleZ);
-
-		// BodyAngle
-		OptimizedParameter.ParamBodyAngleX = OptimizedParameter.ParamAngleX * 0.2f;
-		OptimizedParameter.ParamBodyAngleY = OptimizedParameter.ParamAngleY * 0.25f;
-		OptimizedParameter.ParamBodyAngleZ = OptimizedParameter.ParamAngleZ * 0.2f;
-
-		// MouthOpenY
-		float normalizedMouthOpenY = MathUtils::Normalize(m_Ioface.DistScale * m_Ioface.MouthOpenY, 3.0f, 15.0f);
-		OptimizedParameter.ParamMouthOpenY = SMOOTH_FAST(OptimizedParameter.ParamMouthOpenY, normalizedMouthOpenY);
-
-		// MouthForm
-		float normalizedMouthForm = MathUtils::Normalize(m_Ioface.DistScale * m_Ioface.MouthForm, 72.0f, 85.0f);
-		OptimizedParameter.ParamMouthForm = SMOOTH_MEDIUM(OptimizedParameter.ParamMouthForm, normalizedMouthForm);
-
-		if (MainGui::Get().Checkbox_EqualizeEyes.IsChecked())
-		{
-			// Equalize EyeOpenY Left & Right value
-			float normalizedEAR = MathUtils::Normalize(m_Ioface.DistScale * m_Ioface.EAR, m_Ioface.DistScale * 0.11f, m_Ioface.DistScale * 0.26f);
-			OptimizedParameter.ParamEyeLOpen = SMOOTH_MEDIUM(OptimizedParameter.ParamEyeLOpen, normalizedEAR);
-			OptimizedParameter.ParamEyeROpen = OptimizedParameter.ParamEyeLOpen; // same
-		}
-		else
-		{
-			// EyeOpenLY
-			float normalizedLeftEAR = MathUtils::Normalize(m_Ioface.DistScale * m_Ioface.LeftEAR, m_Ioface.DistScale * 0.11f, m_Ioface.DistScale * 0.26f);
-			OptimizedParameter.ParamEyeLOpen = SMOOTH_MEDIUM(OptimizedParameter.ParamEyeLOpen, normalizedLeftEAR);
-			// EyeOpenRY
-			float normalizedRightEAR = MathUtils::Normalize(m_Ioface.DistScale * m_Ioface.RightEAR, m_Ioface.DistScale * 0.11f, m_Ioface.DistScale * 0.26f);
-			OptimizedParameter.ParamEyeROpen = SMOOTH_MEDIUM(OptimizedParameter.ParamEyeROpen, normalizedRightEAR);
-		}
-
-		/*// Eye smile based on MouthForm
-		OptimizedParameter.ParamEyeForm = MathUtils::Normalize(OptimizedParameter.ParamMouthForm, -0.3, 0.9f);
-		OptimizedParameter.ParamEyeLSmile = OptimizedParameter.ParamEyeForm; // both left | right are equal ^^
-		OptimizedParameter.ParamEyeRSmile = OptimizedParameter.ParamEyeForm;*/
-
-		// Eye smile based on AngleY
-		float normalizedEyeForm = MathUtils::Normalize(OptimizedParameter.ParamAngleY, -20.0f, 10.0f);
-		OptimizedParameter.ParamEyeForm = SMOOTH_MEDIUM(OptimizedParameter.ParamEyeForm, normalizedEyeForm);
-		OptimizedParameter.ParamEyeLSmile = OptimizedParameter.ParamEyeForm; // both left | right are equal ^^
-		OptimizedParameter.ParamEyeRSmile = OptimizedParameter.ParamEyeForm;
-
-		// EyeBrowY, left & right value will be equal
-		float optBrowLY = MathUtils::Normalize(m_Ioface.DistScale * m_Ioface.EyeBrowLY, 42.0f, 54.0f);
-		float optBrowRY = MathUtils::Normalize(m_Ioface.DistScale * m_Ioface.EyeBrowRY, 42.0f, 54.0f);
-		float avgBrow = (optBrowLY + optBrowRY) / 2.f;
-		OptimizedParameter.ParamBrowLY = SMOOTH_SLOW(OptimizedParameter.ParamBrowLY, avgBrow);
-		OptimizedParameter.ParamBrowRY = OptimizedParameter.ParamBrowLY; // same
-
-		// EyeBrowForm follow EyeBrowY, but <= 0.0f
-		OptimizedParameter.ParamBrowLForm = OptimizedParameter.ParamBrowLY < 0.0f ? OptimizedParameter.ParamBrowLY : 0.0f;
-		OptimizedParameter.ParamBrowRForm = OptimizedParameter.ParamBrowLForm;
-
-		// EyeBrowAngle follow EyeBrowForm
-		OptimizedParameter.ParamBrowLAngle = OptimizedParameter.ParamBrowLForm;
-		OptimizedParameter.ParamBrowRAngle = OptimizedParameter.ParamBrowLForm;
-
 		// EyeBall X & Y
 		float eyeBallX = 0.0f;
 		float eyeBallY = 0.0f;
@@ -542,112 +529,52 @@ namespace Iolive {
 				eyeBallY = MathUtils::Normalize(mouseY, screenHeight / 2, screenHeight) / 1.337f;
 			}
 		}
-		OptimizedParameter.ParamEyeBallX = eyeBallX;
-		OptimizedParameter.ParamEyeBallY = -eyeBallY;
+
+		// every face -> parameter mapping, see FaceMapping
+		m_FaceMapping.Evaluate(face, eyeBallX, eyeBallY,
+			MainGui::Get().Checkbox_EqualizeEyes.IsChecked(),
+			static_cast<float>(m_Window->GetDeltaTime())
+		);
+	}
+
+	void Application::LoadFaceMapping(const wchar_t* settingsFilePath)
+	{
+		auto& document = m_JsonManager.document;
+
+		if (!document.HasMember("faceMapping") || !m_FaceMapping.LoadFromJson(document["faceMapping"]))
+		{
+			// write the built-in mapping into the settings file, so it can be edited
+			m_FaceMapping.LoadDefault();
+
+			auto& docAllocator = document.GetAllocator();
+			rapidjson::Value mappingArray;
+			m_FaceMapping.WriteToJson(mappingArray, docAllocator);
+
+			document.RemoveMember("faceMapping");
+			document.AddMember("faceMapping", mappingArray, docAllocator);
+			m_JsonManager.SaveJson(settingsFilePath);
+		}
+
+		m_FaceMapping.Compile(m_UserModel.GetModel2D());
 	}
 
-	void Application::BindDefaultParametersWithFace()
+	void Application::BindParametersWithFace()
 	{
 		ExampleAppLog::AddLog("[Iolive][I] Binding model parameters with Ioface\n\n");
-		Model2D* model = m_UserModel.GetModel2D();
-		const auto& paramIndex = model->GetParameterIndex();
-
-		// check is parameter exist?, then bind it
-		if (paramIndex.ParamAngleX > -1)
-			model->SetParameterBindingAt(paramIndex.ParamAngleX, &(OptimizedParameter.ParamAngleX));
-		if (paramIndex.ParamAngleY > -1)
-			model->SetParameterBindingAt(paramIndex.ParamAngleY, &(OptimizedParameter.ParamAngleY));
-		if (paramIndex.ParamAngleZ > -1)
-			model->SetParameterBindingAt(paramIndex.ParamAngleZ, &(OptimizedParameter.ParamAngleZ));
-		if (paramIndex.ParamBodyAngleX > -1)
-			model->SetParameterBindingAt(paramIndex.ParamBodyAngleX, &(OptimizedParameter.ParamBodyAngleX));
-		if (paramIndex.ParamBodyAngleY > -1)
-			model->SetParameterBindingAt(paramIndex.ParamBodyAngleY, &(OptimizedParameter.ParamBodyAngleY));
-		if (paramIndex.ParamBodyAngleZ > -1)
-			model->SetParameterBindingAt(paramIndex.ParamBodyAngleZ, &(OptimizedParameter.ParamBodyAngleZ));
-		if (paramIndex.ParamEyeLOpen > -1)
-			model->SetParameterBindingAt(paramIndex.ParamEyeLOpen, &(OptimizedParameter.ParamEyeLOpen));
-		if (paramIndex.ParamEyeROpen > -1)
-			model->SetParameterBindingAt(paramIndex.ParamEyeROpen, &(OptimizedParameter.ParamEyeROpen));
-		if (paramIndex.ParamEyeLSmile > -1)
-			model->SetParameterBindingAt(paramIndex.ParamEyeLSmile, &(OptimizedParameter.ParamEyeLSmile));
-		if (paramIndex.ParamEyeRSmile > -1)
-			model->SetParameterBindingAt(paramIndex.ParamEyeRSmile, &(OptimizedParameter.ParamEyeRSmile));
-		if (paramIndex.ParamEyeForm > -1)
-			model->SetParameterBindingAt(paramIndex.ParamEyeForm, &(OptimizedParameter.ParamEyeForm));
-		if (paramIndex.ParamEyeBallX > -1)
-			model->SetParameterBindingAt(paramIndex.ParamEyeBallX, &(OptimizedParameter.ParamEyeBallX));
-		if (paramIndex.ParamEyeBallY > -1)
-			model->SetParameterBindingAt(paramIndex.ParamEyeBallY, &(OptimizedParameter.ParamEyeBallY));
-		if (paramIndex.ParamMouthOpenY > -1)
-			model->SetParameterBindingAt(paramIndex.ParamMouthOpenY, &(OptimizedParameter.ParamMouthOpenY));
-		if (paramIndex.ParamMouthForm > -1)
-			model->SetParameterBindingAt(paramIndex.ParamMouthForm, &(OptimizedParameter.ParamMouthForm));
-		if (paramIndex.ParamBrowLY > -1)
-			model->SetParameterBindingAt(paramIndex.ParamBrowLY, &(OptimizedParameter.ParamBrowLY));
-		if (paramIndex.ParamBrowRY > -1)
-			model->SetParameterBindingAt(paramIndex.ParamBrowRY, &(OptimizedParameter.ParamBrowRY));
-		if (paramIndex.ParamBrowLForm > -1)
-			model->SetParameterBindingAt(paramIndex.ParamBrowLForm, &(OptimizedParameter.ParamBrowLForm));
-		if (paramIndex.ParamBrowRForm > -1)
-			model->SetParameterBindingAt(paramIndex.ParamBrowRForm, &(OptimizedParameter.ParamBrowRForm));
-		if (paramIndex.ParamBrowLAngle > -1)
-			model->SetParameterBindingAt(paramIndex.ParamBrowLAngle, &(OptimizedParameter.ParamBrowLAngle));
-		if (paramIndex.ParamBrowRAngle > -1)
-			model->SetParameterBindingAt(paramIndex.ParamBrowRAngle, &(OptimizedParameter.ParamBrowRAngle));
+
+		m_FaceMapping.BindWithModel(m_UserModel.GetModel2D());
 	}
 
-	void Application::BindDefaultParametersWithGui()
+	void Application::BindParametersWithGui()
 	{
 		ExampleAppLog::AddLog("[Iolive][I] Binding model parameters with the GUI\n\n");
 
 		Model2D* model = m_UserModel.GetModel2D();
-		const auto& paramIndex = model->GetParameterIndex();
-
 		ParameterScene& paramGui = MainGui::Get().ParameterGUI;
 
-		// check is parameter exist?, then bind it
-		if (paramIndex.ParamAngleX > -1)
-			model->SetParameterBindingAt(paramIndex.ParamAngleX, paramGui.GetPtrValueByIndex(paramIndex.ParamAngleX));
-		if (paramIndex.ParamAngleY > -1)
-			model->SetParameterBindingAt(paramIndex.ParamAngleY, paramGui.GetPtrValueByIndex(paramIndex.ParamAngleY));
-		if (paramIndex.ParamAngleZ > -1)
-			model->SetParameterBindingAt(paramIndex.ParamAngleZ, paramGui.GetPtrValueByIndex(paramIndex.ParamAngleZ));
-		if (paramIndex.ParamBodyAngleX > -1)
-			model->SetParameterBindingAt(paramIndex.ParamBodyAngleX, paramGui.GetPtrValueByIndex(paramIndex.ParamBodyAngleX));
-		if (paramIndex.ParamBodyAngleY > -1)
-			model->SetParameterBindingAt(paramIndex.ParamBodyAngleY, paramGui.GetPtrValueByIndex(paramIndex.ParamBodyAngleY));
-		if (paramIndex.ParamBodyAngleZ > -1)
-			model->SetParameterBindingAt(paramIndex.ParamBodyAngleZ, paramGui.GetPtrValueByIndex(paramIndex.ParamBodyAngleZ));
-		if (paramIndex.ParamEyeLOpen > -1)
-			model->SetParameterBindingAt(paramIndex.ParamEyeLOpen, paramGui.GetPtrValueByIndex(paramIndex.ParamEyeLOpen));
-		if (paramIndex.ParamEyeROpen > -1)
-			model->SetParameterBindingAt(paramIndex.ParamEyeROpen, paramGui.GetPtrValueByIndex(paramIndex.ParamEyeROpen));
-		if (paramIndex.ParamEyeLSmile > -1)
-			model->SetParameterBindingAt(paramIndex.ParamEyeLSmile, paramGui.GetPtrValueByIndex(paramIndex.ParamEyeLSmile));
-		if (paramIndex.ParamEyeRSmile > -1)
-			model->SetParameterBindingAt(paramIndex.ParamEyeRSmile, paramGui.GetPtrValueByIndex(paramIndex.ParamEyeRSmile));
-		if (paramIndex.ParamEyeForm > -1)
-			model->SetParameterBindingAt(paramIndex.ParamEyeForm, paramGui.GetPtrValueByIndex(paramIndex.ParamEyeForm));
-		if (paramIndex.ParamEyeBallX > -1)
-			model->SetParameterBindingAt(paramIndex.ParamEyeBallX, paramGui.GetPtrValueByIndex(paramIndex.ParamEyeBallX));
-		if (paramIndex.ParamEyeBallY > -1)
-			model->SetParameterBindingAt(paramIndex.ParamEyeBallY, paramGui.GetPtrValueByIndex(paramIndex.ParamEyeBallY));
-		if (paramIndex.ParamMouthOpenY > -1)
-			model->SetParameterBindingAt(paramIndex.ParamMouthOpenY, paramGui.GetPtrValueByIndex(paramIndex.ParamMouthOpenY));
-		if (paramIndex.ParamMouthForm > -1)
-			model->SetParameterBindingAt(paramIndex.ParamMouthForm, paramGui.GetPtrValueByIndex(paramIndex.ParamMouthForm));
-		if (paramIndex.ParamBrowLY > -1)
-			model->SetParameterBindingAt(paramIndex.ParamBrowLY, paramGui.GetPtrValueByIndex(paramIndex.ParamBrowLY));
-		if (paramIndex.ParamBrowRY > -1)
-			model->SetParameterBindingAt(paramIndex.ParamBrowRY, paramGui.GetPtrValueByIndex(paramIndex.ParamBrowRY));
-		if (paramIndex.ParamBrowLForm > -1)
-			model->SetParameterBindingAt(paramIndex.ParamBrowLForm, paramGui.GetPtrValueByIndex(paramIndex.ParamBrowLForm));
-		if (paramIndex.ParamBrowRForm > -1)
-			model->SetParameterBindingAt(paramIndex.ParamBrowRForm, paramGui.GetPtrValueByIndex(paramIndex.ParamBrowRForm));
-		if (paramIndex.ParamBrowLAngle > -1)
-			model->SetParameterBindingAt(paramIndex.ParamBrowLAngle, paramGui.GetPtrValueByIndex(paramIndex.ParamBrowLAngle));
-		if (paramIndex.ParamBrowRAngle > -1)
-			model->SetParameterBindingAt(paramIndex.ParamBrowRAngle, paramGui.GetPtrValueByIndex(paramIndex.ParamBrowRAngle));
+		// give every parameter driven by the face back to the gui
+		m_FaceMapping.ForEachTargetIndex([&](int paramIndex) {
+			model->SetParameterBindingAt(paramIndex, paramGui.GetPtrValueByIndex(paramIndex));
+		});
 	}
 } // namespace Iolive
\ No newline at end of file
@@ -11,7 +11,9 @@
 #include "MainGui.hpp"
 #include "Window.hpp"
 #include "Ioface/Ioface.hpp"
+#include "Ioface/SamplePredictor.hpp"
 #include "Live2D/Model2D.hpp"
+#include "FaceMapping.hpp"
 #include "Utility/JsonManager.hpp"
 #include <thread>
 #include <mutex>
@@ -98,9 +100,10 @@ namespace Iolive {
 		void LoadHotkeys();
 		void OnHotkeysSaved(int index, ModelMotion* motion);
 
-		void DoOptimizeParameters();
-		void BindDefaultParametersWithFace();
-		void BindDefaultParametersWithGui();
+		void DoOptimizeParameters(const FaceSample& face);
+		void LoadFaceMapping(const wchar_t* settingsFilePath);
+		void BindParametersWithFace();
+		void BindParametersWithGui();
 
 		/*
 		* Window callback as static method
@@ -115,6 +118,9 @@ namespace Iolive {
 
 		// Ioface
 		Ioface m_Ioface;
+
+		// evaluate tracked face at render time
+		SamplePredictor m_FacePredictor;
 		
 		// UserModel for handling Model2D
 		UserModel m_UserModel;
@@ -124,8 +130,8 @@ namespace Iolive {
 		
 		JsonManager m_JsonManager;
 
-		// Optimized parameter for Live2D model
-		DefaultParameter::ParametersValue OptimizedParameter = {};
+		// face -> model parameters, loaded from the settings file
+		FaceMapping m_FaceMapping;
 
 		// a flags
 		bool flags_StopCapture;
@@ -0,0 +1,460 @@
+#include "FaceMapping.hpp"
+#include "MainGui.hpp"
+#include "Utility/MathUtils.hpp"
+#include <cstring>
+#include <cfloat>
+#include <cassert>
+#include <algorithm>
+
+namespace Iolive {
+	namespace {
+		constexpr int kSourceCount = static_cast<int>(FaceMapping::Source::Count);
+
+		/*
+		* Iolive's built-in face tracking, written as a mapping table
+		* (see FaceMapping::Mapping for the meaning of each column)
+		*/
+		struct DefaultRow
+		{
+			const char* input;
+			const char* target;
+			float inMin, inMax, outMin, outMax;
+			float smoothing;
+			bool scaleByDistance;
+			bool hasClampMax;
+			float clampMax;
+		};
+
+		constexpr float kSlow = 4.0f;
+		constexpr float kMedium = 8.0f;
+		constexpr float kFast = 16.0f;
+
+		const DefaultRow kDefaultTable[] = {
+			// head
+			{ "AngleX", "ParamAngleX", 0.0f, 1.0f, 0.0f, 1.0f, kSlow, false, false, 0.0f },
+			{ "AngleY", "ParamAngleY", 0.0f, 1.0f, 0.0f, 1.3f, kSlow, false, false, 0.0f },
+			{ "AngleZ", "ParamAngleZ", 0.0f, 1.0f, 0.0f, 1.0f, kSlow, false, false, 0.0f },
+
+			// body follows the head
+			{ "ParamAngleX", "ParamBodyAngleX", 0.0f, 1.0f, 0.0f, 0.2f, 0.0f, false, false, 0.0f },
+			{ "ParamAngleY", "ParamBodyAngleY", 0.0f, 1.0f, 0.0f, 0.25f, 0.0f, false, false, 0.0f },
+			{ "ParamAngleZ", "ParamBodyAngleZ", 0.0f, 1.0f, 0.0f, 0.2f, 0.0f, false, false, 0.0f },
+
+			// mouth
+			{ "MouthOpenY", "ParamMouthOpenY", 3.0f, 15.0f, 0.0f, 1.0f, kFast, true, false, 0.0f },
+			{ "MouthForm", "ParamMouthForm", 72.0f, 85.0f, 0.0f, 1.0f, kMedium, true, false, 0.0f },
+
+			// eyes
+			{ "LeftEAR", "ParamEyeLOpen", 0.11f, 0.26f, 0.0f, 1.0f, kMedium, false, false, 0.0f },
+			{ "RightEAR", "ParamEyeROpen", 0.11f, 0.26f, 0.0f, 1.0f, kMedium, false, false, 0.0f },
+
+			// eye smile based on AngleY
+			{ "ParamAngleY", "ParamEyeForm", -20.0f, 10.0f, 0.0f, 1.0f, kMedium, false, false, 0.0f },
+			{ "ParamEyeForm", "ParamEyeLSmile", 0.0f, 1.0f, 0.0f, 1.0f, 0.0f, false, false, 0.0f },
+			{ "ParamEyeForm", "ParamEyeRSmile", 0.0f, 1.0f, 0.0f, 1.0f, 0.0f, false, false, 0.0f },
+
+			// brows, left & right are equal, form & angle follow Y but <= 0.0f
+			{ "EyeBrowY", "ParamBrowLY", 42.0f, 54.0f, 0.0f, 1.0f, kSlow, true, false, 0.0f },
+			{ "ParamBrowLY", "ParamBrowRY", 0.0f, 1.0f, 0.0f, 1.0f, 0.0f, false, false, 0.0f },
+			{ "ParamBrowLY", "ParamBrowLForm", 0.0f, 1.0f, 0.0f, 1.0f, 0.0f, false, true, 0.0f },
+			{ "ParamBrowLY", "ParamBrowRForm", 0.0f, 1.0f, 0.0f, 1.0f, 0.0f, false, true, 0.0f },
+			{ "ParamBrowLY", "ParamBrowLAngle", 0.0f, 1.0f, 0.0f, 1.0f, 0.0f, false, true, 0.0f },
+			{ "ParamBrowLY", "ParamBrowRAngle", 0.0f, 1.0f, 0.0f, 1.0f, 0.0f, false, true, 0.0f },
+
+			// eye ball
+			{ "CursorX", "ParamEyeBallX", 0.0f, 1.0f, 0.0f, 1.0f, 0.0f, false, false, 0.0f },
+			{ "CursorY", "ParamEyeBallY", 0.0f, 1.0f, 0.0f, -1.0f, 0.0f, false, false, 0.0f },
+		};
+
+		/*
+		* Ids of the built-in table are the Cubism 3 names,
+		* older models use other names (e.g. PARAM_ANGLE_X) which Model2D already indexed
+		*/
+		struct DefaultAlias
+		{
+			const char* id;
+			int DefaultParameter::ParametersIndex::* index;
+		};
+
+		const DefaultAlias kDefaultAliases[] = {
+			{ "ParamAngleX", &DefaultParameter::ParametersIndex::ParamAngleX },
+			{ "ParamAngleY", &DefaultParameter::ParametersIndex::ParamAngleY },
+			{ "ParamAngleZ", &DefaultParameter::ParametersIndex::ParamAngleZ },
+			{ "ParamBodyAngleX", &DefaultParameter::ParametersIndex::ParamBodyAngleX },
+			{ "ParamBodyAngleY", &DefaultParameter::ParametersIndex::ParamBodyAngleY },
+			{ "ParamBodyAngleZ", &DefaultParameter::ParametersIndex::ParamBodyAngleZ },
+			{ "ParamEyeLOpen", &DefaultParameter::ParametersIndex::ParamEyeLOpen },
+			{ "ParamEyeROpen", &DefaultParameter::ParametersIndex::ParamEyeROpen },
+			{ "ParamEyeLSmile", &DefaultParameter::ParametersIndex::ParamEyeLSmile },
+			{ "ParamEyeRSmile", &DefaultParameter::ParametersIndex::ParamEyeRSmile },
+			{ "ParamEyeForm", &DefaultParameter::ParametersIndex::ParamEyeForm },
+			{ "ParamEyeBallX", &DefaultParameter::ParametersIndex::ParamEyeBallX },
+			{ "ParamEyeBallY", &DefaultParameter::ParametersIndex::ParamEyeBallY },
+			{ "ParamMouthOpenY", &DefaultParameter::ParametersIndex::ParamMouthOpenY },
+			{ "ParamMouthForm", &DefaultParameter::ParametersIndex::ParamMouthForm },
+			{ "ParamBrowLY", &DefaultParameter::ParametersIndex::ParamBrowLY },
+			{ "ParamBrowRY", &DefaultParameter::ParametersIndex::ParamBrowRY },
+			{ "ParamBrowLForm", &DefaultParameter::ParametersIndex::ParamBrowLForm },
+			{ "ParamBrowRForm", &DefaultParameter::ParametersIndex::ParamBrowRForm },
+			{ "ParamBrowLAngle", &DefaultParameter::ParametersIndex::ParamBrowLAngle },
+			{ "ParamBrowRAngle", &DefaultParameter::ParametersIndex::ParamBrowRAngle },
+			{ "ParamBreath", &DefaultParameter::ParametersIndex::ParamBreath },
+		};
+
+		float GetFloat(const rapidjson::Value& obj, const char* name, float defaultValue)
+		{
+			auto it = obj.FindMember(name);
+			if (it != obj.MemberEnd() && it->value.IsNumber())
+				return it->value.GetFloat();
+			return defaultValue;
+		}
+	}
+
+	FaceMapping::FaceMapping()
+		: m_CompiledModel(nullptr), m_BoundModel(nullptr)
+	{
+		LoadDefault();
+	}
+
+	bool FaceMapping::LoadFromJson(const rapidjson::Value& mappingArray)
+	{
+		if (!mappingArray.IsArray())
+			return false;
+
+		std::vector<Mapping> mappings;
+		mappings.reserve(mappingArray.Size());
+
+		for (const auto& obj : mappingArray.GetArray())
+		{
+			if (!obj.IsObject() || !obj.HasMember("input") || !obj.HasMember("target") ||
+				!obj["input"].IsString() || !obj["target"].IsString())
+			{
+				ExampleAppLog::AddLog("[Iolive][W] Face mapping without input or target, skipped\n");
+				continue;
+			}
+
+			Mapping mapping;
+			mapping.Input = obj["input"].GetString();
+			mapping.Target = obj["target"].GetString();
+			mapping.InMin = GetFloat(obj, "inMin", mapping.InMin);
+			mapping.InMax = GetFloat(obj, "inMax", mapping.InMax);
+			mapping.OutMin = GetFloat(obj, "outMin", mapping.OutMin);
+			mapping.OutMax = GetFloat(obj, "outMax", mapping.OutMax);
+			mapping.Smoothing = GetFloat(obj, "smoothing", mapping.Smoothing);
+
+			if (obj.HasMember("curve") && obj["curve"].IsString())
+			{
+				const char* curveName = obj["curve"].GetString();
+				int c = 0;
+				while (c < static_cast<int>(Curve::Count) && strcmp(curveName, CurveName(static_cast<Curve>(c))) != 0)
+					c++;
+
+				if (c < static_cast<int>(Curve::Count))
+					mapping.Shape = static_cast<Curve>(c);
+				else
+					ExampleAppLog::AddLogf("[Iolive][W] Face mapping curve \"%s\" of \"%s\" is unknown, using linear\n", curveName, mapping.Target.c_str());
+			}
+
+			if (obj.HasMember("scaleByDistance") && obj["scaleByDistance"].IsBool())
+				mapping.ScaleByDistance = obj["scaleByDistance"].GetBool();
+
+			if (obj.HasMember("clampMin") && obj["clampMin"].IsNumber())
+			{
+				mapping.HasClampMin = true;
+				mapping.ClampMin = obj["clampMin"].GetFloat();
+			}
+			if (obj.HasMember("clampMax") && obj["clampMax"].IsNumber())
+			{
+				mapping.HasClampMax = true;
+				mapping.ClampMax = obj["clampMax"].GetFloat();
+			}
+
+			mappings.push_back(std::move(mapping));
+		}
+
+		m_Mappings = std::move(mappings);
+		return true;
+	}
+
+	void FaceMapping::WriteToJson(rapidjson::Value& outArray, rapidjson::Document::AllocatorType& allocator) const
+	{
+		outArray.SetArray();
+		for (const Mapping& mapping : m_Mappings)
+		{
+			rapidjson::Value obj(rapidjson::kObjectType);
+			obj.AddMember("input", rapidjson::Value(mapping.Input.c_str(), allocator), allocator);
+			obj.AddMember("target", rapidjson::Value(mapping.Target.c_str(), allocator), allocator);
+			obj.AddMember("inMin", mapping.InMin, allocator);
+			obj.AddMember("inMax", mapping.InMax, allocator);
+			obj.AddMember("outMin", mapping.OutMin, allocator);
+			obj.AddMember("outMax", mapping.OutMax, allocator);
+			obj.AddMember("curve", rapidjson::StringRef(CurveName(mapping.Shape)), allocator);
+			obj.AddMember("smoothing", mapping.Smoothing, allocator);
+			obj.AddMember("scaleByDistance", mapping.ScaleByDistance, allocator);
+			if (mapping.HasClampMin)
+				obj.AddMember("clampMin", mapping.ClampMin, allocator);
+			if (mapping.HasClampMax)
+				obj.AddMember("clampMax", mapping.ClampMax, allocator);
+
+			outArray.PushBack(obj, allocator);
+		}
+	}
+
+	void FaceMapping::LoadDefault()
+	{
+		m_Mappings.clear();
+		for (const DefaultRow& row : kDefaultTable)
+		{
+			Mapping mapping;
+			mapping.Input = row.input;
+			mapping.Target = row.target;
+			mapping.InMin = row.inMin;
+			mapping.InMax = row.inMax;
+			mapping.OutMin = row.outMin;
+			mapping.OutMax = row.outMax;
+			mapping.Smoothing = row.smoothing;
+			mapping.ScaleByDistance = row.scaleByDistance;
+			mapping.HasClampMax = row.hasClampMax;
+			mapping.ClampMax = row.clampMax;
+			m_Mappings.push_back(mapping);
+		}
+	}
+
+	void FaceMapping::Compile(Model2D* model)
+	{
+		// the registers are reallocated below, a model still reading them must be bound again
+		const bool rebind = model != nullptr && model == m_BoundModel && IsBoundTo(model);
+		if (rebind)
+		{
+			for (const TargetSlot& target : m_Targets)
+				if (target.ParameterIndex > -1)
+					model->SetParameterBindingAt(target.ParameterIndex, nullptr);
+		}
+		m_BoundModel = nullptr;
+
+		m_Ops.clear();
+		m_Targets.clear();
+		m_CompiledModel = model;
+
+		auto findTarget = [this](const std::string& id) -> int {
+			for (size_t i = 0; i < m_Targets.size(); i++)
+				if (m_Targets[i].Id == id)
+					return static_cast<int>(i);
+			return -1;
+		};
+
+		for (const Mapping& mapping : m_Mappings)
+		{
+			// input: a face source, or the target of an earlier mapping
+			int src = -1;
+			for (int s = 0; s < kSourceCount; s++)
+			{
+				if (mapping.Input == SourceName(static_cast<Source>(s)))
+				{
+					src = s;
+					break;
+				}
+			}
+			if (src < 0)
+			{
+				int targetSlot = findTarget(mapping.Input);
+				if (targetSlot < 0)
+				{
+					ExampleAppLog::AddLogf("[Iolive][W] Face mapping input \"%s\" isn't a face source or an earlier target, skipped\n", mapping.Input.c_str());
+					continue;
+				}
+				src = kSourceCount + targetSlot;
+			}
+
+			int targetSlot = findTarget(mapping.Target);
+			if (targetSlot < 0)
+			{
+				targetSlot = static_cast<int>(m_Targets.size());
+				m_Targets.push_back({ mapping.Target, model ? FindParameterIndex(model, mapping.Target) : -1 });
+			}
+
+			float inRange = mapping.InMax - mapping.InMin;
+
+			Op op;
+			op.Src = src;
+			op.Dst = kSourceCount + targetSlot;
+			op.InMin = mapping.InMin;
+			op.InvInRange = inRange != 0.0f ? 1.0f / inRange : 0.0f;
+			op.OutMin = mapping.OutMin;
+			op.OutRange = mapping.OutMax - mapping.OutMin;
+			op.ClampMin = mapping.HasClampMin ? mapping.ClampMin : -FLT_MAX;
+			op.ClampMax = mapping.HasClampMax ? mapping.ClampMax : FLT_MAX;
+			op.Smoothing = mapping.Smoothing;
+			op.Shape = mapping.Shape;
+			op.ScaleByDistance = mapping.ScaleByDistance;
+			m_Ops.push_back(op);
+		}
+
+		// start smoothing from the model's default values
+		m_Registers.assign(kSourceCount + m_Targets.size(), 0.0f);
+		for (size_t i = 0; i < m_Targets.size(); i++)
+		{
+			if (m_Targets[i].ParameterIndex > -1)
+				m_Registers[kSourceCount + i] = model->GetModel()->GetParameterDefaultValue(m_Targets[i].ParameterIndex);
+		}
+
+		int unresolved = static_cast<int>(std::count_if(m_Targets.begin(), m_Targets.end(),
+			[](const TargetSlot& target) { return target.ParameterIndex < 0; }));
+
+		ExampleAppLog::AddLogf("[Iolive][I] Face mapping compiled: %d ops, %d targets (%d not found on the model)\n",
+			static_cast<int>(m_Ops.size()), static_cast<int>(m_Targets.size()), unresolved);
+
+		if (rebind)
+			BindWithModel(model);
+	}
+
+	void FaceMapping::Evaluate(const FaceSample& face, float cursorX, float cursorY, bool equalizeEyes, float deltaTime)
+	{
+		if (m_Registers.size() < kSourceCount)
+			return; // not compiled
+
+		float* reg = m_Registers.data();
+		reg[static_cast<int>(Source::AngleX)] = face.AngleX;
+		reg[static_cast<int>(Source::AngleY)] = face.AngleY;
+		reg[static_cast<int>(Source::AngleZ)] = face.AngleZ;
+		reg[static_cast<int>(Source::DistScale)] = face.DistScale;
+		reg[static_cast<int>(Source::LeftEAR)] = equalizeEyes ? face.EAR : face.LeftEAR;
+		reg[static_cast<int>(Source::RightEAR)] = equalizeEyes ? face.EAR : face.RightEAR;
+		reg[static_cast<int>(Source::EAR)] = face.EAR;
+		reg[static_cast<int>(Source::MouthOpenY)] = face.MouthOpenY;
+		reg[static_cast<int>(Source::MouthForm)] = face.MouthForm;
+		reg[static_cast<int>(Source::EyeBrowLY)] = face.EyeBrowLY;
+		reg[static_cast<int>(Source::EyeBrowRY)] = face.EyeBrowRY;
+		reg[static_cast<int>(Source::EyeBrowY)] = (face.EyeBrowLY + face.EyeBrowRY) / 2.f;
+		reg[static_cast<int>(Source::CursorX)] = cursorX;
+		reg[static_cast<int>(Source::CursorY)] = cursorY;
+
+		const float distScale = face.DistScale;
+
+		// most ops share a few smoothing speeds, don't exp() for each of them
+		float lastSpeed = 0.0f;
+		float lastFactor = 1.0f;
+
+		for (const Op& op : m_Ops)
+		{
+			float value = reg[op.Src];
+			if (op.ScaleByDistance)
+				value *= distScale;
+
+			float t = (value - op.InMin) * op.InvInRange;
+			switch (op.Shape)
+			{
+			case Curve::SmoothStep:
+				t = std::clamp(t, 0.0f, 1.0f);
+				t = t * t * (3.0f - 2.0f * t);
+				break;
+			case Curve::EaseIn:
+				t = std::clamp(t, 0.0f, 1.0f);
+				t = t * t;
+				break;
+			case Curve::EaseOut:
+				t = std::clamp(t, 0.0f, 1.0f);
+				t = 1.0f - (1.0f - t) * (1.0f - t);
+				break;
+			default:
+				break; // Curve::Linear
+			}
+
+			float out = std::clamp(op.OutMin + t * op.OutRange, op.ClampMin, op.ClampMax);
+
+			if (op.Smoothing > 0.0f)
+			{
+				if (op.Smoothing != lastSpeed)
+				{
+					lastSpeed = op.Smoothing;
+					lastFactor = MathUtils::SmoothFactor(op.Smoothing, deltaTime);
+				}
+				out = MathUtils::Lerp(reg[op.Dst], out, lastFactor);
+			}
+
+			reg[op.Dst] = out;
+		}
+	}
+
+	void FaceMapping::BindWithModel(Model2D* model)
+	{
+		// parameter indices are the ones of the compiled model
+		assert(model == m_CompiledModel && "FaceMapping::Compile() must be called for this model first");
+		if (model != m_CompiledModel)
+			return;
+
+		for (size_t i = 0; i < m_Targets.size(); i++)
+		{
+			if (m_Targets[i].ParameterIndex > -1)
+				model->SetParameterBindingAt(m_Targets[i].ParameterIndex, &m_Registers[kSourceCount + i]);
+		}
+		m_BoundModel = model;
+	}
+
+	bool FaceMapping::IsBoundTo(Model2D* model) const
+	{
+		const ParameterBinding& binding = model->GetBindedParameter();
+		for (size_t i = 0; i < m_Targets.size(); i++)
+		{
+			int paramIndex = m_Targets[i].ParameterIndex;
+			if (paramIndex > -1 && binding.GetSource(paramIndex) == &m_Registers[kSourceCount + i])
+				return true;
+		}
+		return false;
+	}
+
+	int FaceMapping::FindParameterIndex(Model2D* model, const std::string& id)
+	{
+		const char** paramIds = model->GetModel()->GetParameterIds();
+		csmInt32 paramCount = model->GetModel()->GetParameterCount();
+
+		for (csmInt32 paramIndex = 0; paramIndex < paramCount; paramIndex++)
+		{
+			if (id == paramIds[paramIndex])
+				return paramIndex;
+		}
+
+		// older parameter names
+		for (const DefaultAlias& alias : kDefaultAliases)
+		{
+			if (id == alias.id)
+				return model->GetParameterIndex().*(alias.index);
+		}
+
+		return -1;
+	}
+
+	const char* FaceMapping::SourceName(Source source)
+	{
+		switch (source)
+		{
+		case Source::AngleX: return "AngleX";
+		case Source::AngleY: return "AngleY";
+		case Source::AngleZ: return "AngleZ";
+		case Source::DistScale: return "DistScale";
+		case Source::LeftEAR: return "LeftEAR";
+		case Source::RightEAR: return "RightEAR";
+		case Source::EAR: return "EAR";
+		case Source::MouthOpenY: return "MouthOpenY";
+		case Source::MouthForm: return "MouthForm";
+		case Source::EyeBrowLY: return "EyeBrowLY";
+		case Source::EyeBrowRY: return "EyeBrowRY";
+		case Source::EyeBrowY: return "EyeBrowY";
+		case Source::CursorX: return "CursorX";
+		case Source::CursorY: return "CursorY";
+		default: return "";
+		}
+	}
+
+	const char* FaceMapping::CurveName(Curve curve)
+	{
+		switch (curve)
+		{
+		case Curve::Linear: return "linear";
+		case Curve::SmoothStep: return "smoothstep";
+		case Curve::EaseIn: return "easeIn";
+		case Curve::EaseOut: return "easeOut";
+		default: return "";
+		}
+	}
+} // namespace Iolive
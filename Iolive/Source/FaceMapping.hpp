@@ -0,0 +1,151 @@
+#pragma once
+
+#include "Ioface/FaceSample.hpp"
+#include "Live2D/Model2D.hpp"
+#include <rapidjson/document.h>
+#include <string>
+#include <vector>
+
+namespace Iolive {
+	/*
+	* Data driven mapping from face features to model parameters.
+	*
+	* The mapping table is read from the "faceMapping" array of the Iolive settings file,
+	* then compiled into a flat array of ops over one register file:
+	*   [ face sources ... | mapping targets ... ]
+	* A mapping can read the face sources or the target of an earlier mapping.
+	*/
+	class FaceMapping
+	{
+	public:
+		enum class Source
+		{
+			AngleX = 0,
+			AngleY,
+			AngleZ,
+			DistScale,
+			LeftEAR,
+			RightEAR,
+			EAR,
+			MouthOpenY,
+			MouthForm,
+			EyeBrowLY,
+			EyeBrowRY,
+			EyeBrowY,  // average of left & right
+			CursorX,   // eye ball follow cursor, 0 when disabled
+			CursorY,
+			Count
+		};
+
+		enum class Curve
+		{
+			Linear = 0,
+			SmoothStep, // clamped to the output range
+			EaseIn,     // t^2, clamped
+			EaseOut,    // 1 - (1 - t)^2, clamped
+			Count
+		};
+
+		/*
+		* One row of the mapping table (as written in json)
+		*   t = (input * (DistScale when ScaleByDistance) - InMin) / (InMax - InMin)
+		*   target = smooth(clamp(OutMin + shape(t) * (OutMax - OutMin)))
+		*/
+		struct Mapping
+		{
+			std::string Input;  // Source name, or the target of an earlier mapping
+			std::string Target; // model parameter id
+			float InMin = 0.0f;
+			float InMax = 1.0f;
+			float OutMin = 0.0f;
+			float OutMax = 1.0f;
+			Curve Shape = Curve::Linear;
+			float Smoothing = 0.0f; // smoothing speed (1/s), 0 = no smoothing
+			bool ScaleByDistance = false;
+			bool HasClampMin = false;
+			bool HasClampMax = false;
+			float ClampMin = 0.0f;
+			float ClampMax = 0.0f;
+		};
+
+	public:
+		FaceMapping();
+
+		/*
+		* Read the mapping table from a json array
+		* return false when it isn't an array (the table is left unchanged)
+		*/
+		bool LoadFromJson(const rapidjson::Value& mappingArray);
+		void WriteToJson(rapidjson::Value& outArray, rapidjson::Document::AllocatorType& allocator) const;
+
+		// Iolive's built-in face tracking
+		void LoadDefault();
+
+		/*
+		* Resolve targets to the model parameter indices and build the ops,
+		* must be called after loading a table or changing the model.
+		* The registers move, a model bound to them by BindWithModel() is bound again.
+		*/
+		void Compile(Model2D* model);
+
+		/*
+		* Run every op once
+		* equalizeEyes: both eyes use the average EAR
+		*/
+		void Evaluate(const FaceSample& face, float cursorX, float cursorY, bool equalizeEyes, float deltaTime);
+
+		// bind every resolved target with the model, the mapping must be compiled for it
+		void BindWithModel(Model2D* model);
+
+		template<typename Func>
+		void ForEachTargetIndex(Func func) const
+		{
+			for (const TargetSlot& target : m_Targets)
+				if (target.ParameterIndex > -1)
+					func(target.ParameterIndex);
+		}
+
+		size_t GetMappingCount() const { return m_Mappings.size(); }
+		size_t GetOpCount() const { return m_Ops.size(); }
+
+		static const char* SourceName(Source source);
+		static const char* CurveName(Curve curve);
+
+	private:
+		struct Op
+		{
+			int Src; // register indices
+			int Dst;
+			float InMin;
+			float InvInRange; // 1 / (InMax - InMin)
+			float OutMin;
+			float OutRange;
+			float ClampMin;
+			float ClampMax;
+			float Smoothing;
+			Curve Shape;
+			bool ScaleByDistance;
+		};
+
+		struct TargetSlot
+		{
+			std::string Id;
+			int ParameterIndex; // -1 = not found on the model
+		};
+
+		static int FindParameterIndex(Model2D* model, const std::string& id);
+
+		// true when the model still reads at least one target from m_Registers
+		bool IsBoundTo(Model2D* model) const;
+
+	private:
+		std::vector<Mapping> m_Mappings;
+
+		std::vector<Op> m_Ops;
+		std::vector<TargetSlot> m_Targets;
+		std::vector<float> m_Registers;
+
+		Model2D* m_CompiledModel; // model of the resolved parameter indices
+		Model2D* m_BoundModel;    // last model given to BindWithModel()
+	};
+} // namespace Iolive
@@ -0,0 +1,124 @@
+#include "MotionCache.hpp"
+
+MotionCache::~MotionCache()
+{
+	Stop();
+}
+
+void MotionCache::Start(LoadFunction load, size_t budgetBytes)
+{
+	Stop();
+
+	m_Load = std::move(load);
+	m_Stats = Stats();
+	m_Stats.BudgetBytes = budgetBytes;
+	m_Stopping = false;
+
+	m_Thread = std::thread(&MotionCache::LoadLoop, this);
+}
+
+void MotionCache::Stop()
+{
+	if (!m_Thread.joinable())
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Stopping = true;
+		m_Queue.clear();
+	}
+	m_Condition.notify_one();
+	m_Thread.join();
+
+	// nobody will collect these
+	for (Loaded& loaded : m_Done)
+		Csm::ACubismMotion::Delete(loaded.Motion);
+	m_Done.clear();
+
+	m_Lru.clear();
+	m_Resident.clear();
+	m_Pending.clear();
+}
+
+bool MotionCache::Acquire(int key)
+{
+	auto resident = m_Resident.find(key);
+	if (resident != m_Resident.end())
+	{
+		// move to the most recently used end
+		m_Lru.splice(m_Lru.begin(), m_Lru, resident->second.LruPosition);
+		m_Stats.Hits++;
+		return true;
+	}
+
+	m_Stats.Misses++;
+	Queue(key);
+	return false;
+}
+
+void MotionCache::Prefetch(int key)
+{
+	if (m_Resident.find(key) == m_Resident.end())
+		Queue(key);
+}
+
+void MotionCache::Queue(int key)
+{
+	if (!m_Thread.joinable() || !m_Pending.insert(key).second)
+		return; // not started or already queued
+
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Queue.push_back(key);
+	}
+	m_Condition.notify_one();
+}
+
+void MotionCache::Collect(std::vector<Loaded>& outLoaded)
+{
+	size_t first = outLoaded.size();
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		if (m_Done.empty())
+			return;
+
+		outLoaded.insert(outLoaded.end(), m_Done.begin(), m_Done.end());
+		m_Done.clear();
+	}
+
+	for (size_t i = first; i < outLoaded.size(); i++)
+	{
+		const Loaded& loaded = outLoaded[i];
+		m_Pending.erase(loaded.Key);
+
+		if (!loaded.Motion)
+			continue;
+
+		m_Lru.push_front(loaded.Key);
+		m_Resident[loaded.Key] = { m_Lru.begin(), loaded.Bytes };
+		m_Stats.ResidentBytes += loaded.Bytes;
+		m_Stats.Resident++;
+	}
+}
+
+void MotionCache::LoadLoop()
+{
+	std::unique_lock<std::mutex> lock(m_Mutex);
+	while (true)
+	{
+		m_Condition.wait(lock, [this]() { return m_Stopping || !m_Queue.empty(); });
+		if (m_Stopping)
+			break;
+
+		int key = m_Queue.front();
+		m_Queue.pop_front();
+
+		// parse without holding the lock
+		lock.unlock();
+		size_t bytes = 0;
+		Csm::ACubismMotion* motion = m_Load(key, bytes);
+		lock.lock();
+
+		m_Done.push_back({ key, motion, bytes });
+	}
+}
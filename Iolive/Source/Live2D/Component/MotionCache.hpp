@@ -0,0 +1,125 @@
+#pragma once
+
+#include <Motion/ACubismMotion.hpp>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+/*
+* On-demand motion loader with a memory-budgeted LRU.
+*
+* Motions are identified by a key (the index in Model2D's motion list). A miss queues the
+* load on a background thread; Collect() hands the loaded motions back on the main thread,
+* Trim() evicts the least recently used idle motions while over the budget.
+* The cache only tracks keys & sizes, the caller owns the motions.
+*/
+class MotionCache
+{
+public:
+	struct Stats
+	{
+		int Hits = 0;
+		int Misses = 0;
+		int Evictions = 0;
+		int Resident = 0;
+		size_t ResidentBytes = 0;
+		size_t BudgetBytes = 0;
+	};
+
+	struct Loaded
+	{
+		int Key;
+		Csm::ACubismMotion* Motion; // nullptr when the load failed
+		size_t Bytes;
+	};
+
+	// called on the loader thread, outBytes: memory estimate of the returned motion
+	using LoadFunction = std::function<Csm::ACubismMotion*(int key, size_t& outBytes)>;
+
+public:
+	MotionCache() = default;
+	~MotionCache();
+
+	MotionCache(const MotionCache&) = delete;
+	MotionCache& operator=(const MotionCache&) = delete;
+
+	void Start(LoadFunction load, size_t budgetBytes);
+
+	// join the loader, queued loads are dropped and uncollected motions deleted
+	void Stop();
+	bool IsRunning() const { return m_Thread.joinable(); }
+
+	/*
+	* Main thread only from here
+	*/
+
+	// true (hit) when the motion is resident, otherwise (miss) its load is queued
+	bool Acquire(int key);
+
+	// queue the load without touching the counters
+	void Prefetch(int key);
+
+	// take every finished load, successful ones become resident
+	void Collect(std::vector<Loaded>& outLoaded);
+
+	/*
+	* Evict from the least recently used end until the resident size fits the budget
+	* canEvict(key): the motion isn't in use, onEvict(key): release it
+	*/
+	template<typename CanEvict, typename OnEvict>
+	void Trim(CanEvict canEvict, OnEvict onEvict)
+	{
+		auto it = m_Lru.end();
+		while (m_Stats.ResidentBytes > m_Stats.BudgetBytes && it != m_Lru.begin())
+		{
+			--it;
+			int key = *it;
+			if (!canEvict(key))
+				continue;
+
+			onEvict(key);
+
+			m_Stats.ResidentBytes -= m_Resident[key].Bytes;
+			m_Resident.erase(key);
+			it = m_Lru.erase(it);
+
+			m_Stats.Resident--;
+			m_Stats.Evictions++;
+		}
+	}
+
+	const Stats& GetStats() const { return m_Stats; }
+
+private:
+	void Queue(int key);
+	void LoadLoop();
+
+private:
+	struct ResidentEntry
+	{
+		std::list<int>::iterator LruPosition;
+		size_t Bytes;
+	};
+
+	LoadFunction m_Load;
+
+	// main thread
+	std::list<int> m_Lru; // most recently used first
+	std::unordered_map<int, ResidentEntry> m_Resident;
+	std::unordered_set<int> m_Pending; // queued or loading
+	Stats m_Stats;
+
+	// shared with the loader thread
+	std::thread m_Thread;
+	std::mutex m_Mutex;
+	std::condition_variable m_Condition;
+	std::deque<int> m_Queue;
+	std::vector<Loaded> m_Done;
+	bool m_Stopping = false;
+};
@@ -0,0 +1,97 @@
+#include "ParameterBinding.hpp"
+#include <algorithm>
+
+ParameterBinding::ParameterBinding()
+	: m_SourceCount(0), m_Dirty(false)
+{}
+
+void ParameterBinding::Setup(int parameterCount, const float* minValues, const float* maxValues)
+{
+	m_Sources.assign(parameterCount, nullptr);
+	m_SourceCount = 0;
+	m_MinValues.assign(minValues, minValues + parameterCount);
+	m_MaxValues.assign(maxValues, maxValues + parameterCount);
+	m_Dirty = true;
+}
+
+void ParameterBinding::Clear()
+{
+	m_Sources.clear();
+	m_SourceCount = 0;
+	m_MinValues.clear();
+	m_MaxValues.clear();
+	m_Dirty = true;
+}
+
+void ParameterBinding::Bind(int index, float* source)
+{
+	if (index < 0 || index >= GetParameterCount())
+		return;
+
+	if (m_Sources[index] != source)
+	{
+		m_SourceCount += (source != nullptr) - (m_Sources[index] != nullptr);
+		m_Sources[index] = source;
+		m_Dirty = true;
+	}
+}
+
+float* ParameterBinding::GetSource(int index) const
+{
+	if (index < 0 || index >= GetParameterCount())
+		return nullptr;
+
+	return m_Sources[index];
+}
+
+void ParameterBinding::RebuildBound()
+{
+	m_BoundIndices.clear();
+	m_BoundSources.clear();
+	m_BoundMin.clear();
+	m_BoundMax.clear();
+
+	for (int i = 0; i < GetParameterCount(); i++)
+	{
+		if (m_Sources[i])
+		{
+			m_BoundIndices.push_back(i);
+			m_BoundSources.push_back(m_Sources[i]);
+			m_BoundMin.push_back(m_MinValues[i]);
+			m_BoundMax.push_back(m_MaxValues[i]);
+		}
+	}
+
+	m_Staging.resize(m_BoundIndices.size());
+	m_Dirty = false;
+}
+
+void ParameterBinding::Apply(float* values)
+{
+	if (m_Dirty)
+		RebuildBound();
+
+	const int count = static_cast<int>(m_BoundIndices.size());
+	const bool allBound = IsAllBound(); // bound indices are 0..n-1, write straight into the values
+	float* const* sources = m_BoundSources.data();
+	const float* minValues = m_BoundMin.data();
+	const float* maxValues = m_BoundMax.data();
+
+	// the common case, the GUI binds every parameter
+	float* out = allBound ? values : m_Staging.data();
+
+	// gather
+	for (int i = 0; i < count; i++)
+		out[i] = *sources[i];
+
+	// clamp, plain min/max over contiguous arrays so it vectorizes
+	for (int i = 0; i < count; i++)
+		out[i] = std::min(std::max(out[i], minValues[i]), maxValues[i]);
+
+	if (!allBound)
+	{
+		const int* indices = m_BoundIndices.data();
+		for (int i = 0; i < count; i++)
+			values[indices[i]] = out[i];
+	}
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <vector>
+
+/*
+* Dense parameter binding table: model parameter index -> float* source.
+* Bound entries are kept compact (index, source, min, max), so writing them
+* into the model is one gather + one clamp loop instead of a map walk
+* with a SetParameterValue call each.
+*/
+class ParameterBinding
+{
+public:
+	ParameterBinding();
+
+	/*
+	* Reset the table for a model, every parameter becomes unbound
+	* minValues & maxValues: parameterCount values each
+	*/
+	void Setup(int parameterCount, const float* minValues, const float* maxValues);
+	void Clear();
+
+	// source == nullptr unbinds the parameter
+	void Bind(int index, float* source);
+	float* GetSource(int index) const;
+
+	int GetParameterCount() const { return static_cast<int>(m_Sources.size()); }
+	int GetBoundCount() const { return m_SourceCount; }
+
+	// every parameter is rewritten by Apply()
+	bool IsAllBound() const { return m_SourceCount > 0 && m_SourceCount == GetParameterCount(); }
+
+	/*
+	* Write every bound source into values[parameterIndex], clamped to the parameter range
+	*/
+	void Apply(float* values);
+
+private:
+	void RebuildBound();
+
+private:
+	std::vector<float*> m_Sources; // per parameter, nullptr = unbound
+	int m_SourceCount;             // non null m_Sources
+	std::vector<float> m_MinValues;
+	std::vector<float> m_MaxValues;
+
+	// compacted bound entries, in parameter order
+	std::vector<int> m_BoundIndices;
+	std::vector<float*> m_BoundSources;
+	std::vector<float> m_BoundMin;
+	std::vector<float> m_BoundMax;
+	std::vector<float> m_Staging;
+	bool m_Dirty;
+};
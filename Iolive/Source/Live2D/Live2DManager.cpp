@@ -24,7 +24,7 @@ void Live2DManager::ReleaseCubism()
 	CubismFramework::Dispose();
 }
 
-Model2D* Live2DManager::CreateModel(const wchar_t* modelJson)
+Model2D* Live2DManager::CreateModel(const wchar_t* modelJson, const MotionLoading& motionLoading)
 {
 	// load .model3.json
 	auto [buffer, fileSize] = Utility::CreateBufferFromFile(modelJson);
@@ -47,7 +47,7 @@ Model2D* Live2DManager::CreateModel(const wchar_t* modelJson)
 
 	// create new model!
 	LoggingFunction("[Live2DManager][I] Creating new model ...\n");
-	Model2D* newModel = new Model2D(modelSetting, modelDir, modelFilename);
+	Model2D* newModel = new Model2D(modelSetting, modelDir, modelFilename, motionLoading);
 	if (newModel->IsInitialized())
 	{
 		LoggingFunction("[Live2DManager][I] New Model initialized\n\n");
@@ -14,7 +14,7 @@ public:
 	static bool InitCubism();
 	static void ReleaseCubism();
 
-	static Model2D* CreateModel(const wchar_t* modelJson);
+	static Model2D* CreateModel(const wchar_t* modelJson, const MotionLoading& motionLoading = MotionLoading());
 
 private:
 	static bool CheckModelSetting(ICubismModelSetting* modelSetting);
@@ -1,15 +1,75 @@
 #include "Model2D.hpp"
 #include <future>
+#include <chrono>
+#include <filesystem>
+#include <thread>
+#include <atomic>
+#include <algorithm>
 #include <string.h>
+#include <stdio.h>
 
-Model2D::Model2D(ICubismModelSetting* modelSetting, const std::wstring& modelDir, const std::wstring& modelFilename)
+namespace {
+	const wchar_t* kMotionCacheExtension = L".iomb";
+
+	/*
+	* One motion or expression file to preload,
+	* filled by the loader threads and read back in order afterwards
+	*/
+	struct PreloadSlot
+	{
+		ModelMotion::MotionType Type;
+		int Id; // motion id or expression index, doesn't depend on the load order
+		const char* Name;
+		std::wstring Path;
+		float FadeInTime = -1.0f;
+		float FadeOutTime = -1.0f;
+
+		ACubismMotion* Motion = nullptr;
+		bool FromCache = false;
+		double LoadMs = 0.0;
+	};
+
+	/*
+	* Run func(index) for every index in [0, count) on at most threadCount threads, 0 = hardware_concurrency
+	* (the calling one included), returns once every call finished
+	*/
+	template<typename Func>
+	unsigned int ParallelFor(size_t count, unsigned int threadCount, Func func)
+	{
+		if (threadCount == 0)
+			threadCount = std::thread::hardware_concurrency();
+		threadCount = std::max(1u, threadCount);
+		threadCount = static_cast<unsigned int>(std::min<size_t>(threadCount, count));
+
+		std::atomic<size_t> next = 0;
+		auto work = [&]() {
+			for (size_t i = next++; i < count; i = next++)
+				func(i);
+		};
+
+		std::vector<std::thread> workers;
+		for (unsigned int i = 1; i < threadCount; i++)
+			workers.emplace_back(work);
+
+		work();
+
+		for (std::thread& worker : workers)
+			worker.join();
+
+		return threadCount;
+	}
+}
+
+Model2D::Model2D(ICubismModelSetting* modelSetting, const std::wstring& modelDir, const std::wstring& modelFilename,
+	const MotionLoading& motionLoading)
 	: m_ModelSetting(nullptr),
 	m_ProjectionMatrix(CubismMatrix44()),
 	m_ModelDir(modelDir),
 	m_ModelFileName(modelFilename),
 	m_ModelScale(1.0f),
 	m_ModelTranslateX(0.0f),
-	m_ModelTranslateY(0.0f)
+	m_ModelTranslateY(0.0f),
+	m_MotionLoading(motionLoading)
 {
 	_initialized = false;
 
@@ -23,6 +83,9 @@ Model2D::~Model2D()
 {
 	CubismFramework::CoreLogFunction("[Model2D][I] Delete model!\n\n");
 
+	// no more background loads into m_Motions
+	m_MotionCache.Stop();
+
 	// release expression
 	for (auto& expression : m_Expressions)
 		ACubismMotion::Delete(expression.motion);
@@ -44,37 +107,83 @@ void Model2D::OnUpdate(float deltaTime)
 {
 	if (!_initialized || _model == NULL) return;
 
+	using Clock = std::chrono::steady_clock;
+	Clock::time_point stageStart = Clock::now();
+	auto stageElapsedMs = [&stageStart]() -> float {
+		Clock::time_point now = Clock::now();
+		float elapsedMs = std::chrono::duration<float, std::milli>(now - stageStart).count();
+		stageStart = now;
+		return elapsedMs;
+	};
+
+	m_UpdateStats.SnapshotCopies = 0;
+
+	if (m_MotionLoading.Lazy)
+		UpdateMotionCache();
+
+	/*
+	* The snapshot keeps the parameters after binding & motion, so the additive stages below
+	* (expression, breath, physics, pose) don't pile up on unbinded parameters frame after frame.
+	* When every parameter is binded they're all rewritten each frame, no snapshot needed.
+	*/
+	const bool needsSnapshot = !m_ParameterBinding.IsAllBound();
+
+	if (needsSnapshot)
+	{
+		_model->LoadParameters();
+		m_UpdateStats.SnapshotCopies++;
+	}
 	UpdateBindedParameters();
-	_model->LoadParameters();
+	m_UpdateStats.BindingMs = stageElapsedMs();
 
 	_motionManager->UpdateMotion(_model, deltaTime);
-	_model->SaveParameters();
-	_model->LoadParameters();
+	if (needsSnapshot)
+	{
+		_model->SaveParameters();
+		m_UpdateStats.SnapshotCopies++;
+	}
+	m_UpdateStats.MotionMs = stageElapsedMs();
 
 	_expressionManager->UpdateMotion(_model, deltaTime);
+	m_UpdateStats.ExpressionMs = stageElapsedMs();
 
 	if (_breath)
 	{
 		_breath->UpdateParameters(_model, deltaTime);
 	}
+	m_UpdateStats.BreathMs = stageElapsedMs();
 
 	if (_physics)
 	{
 		_physics->Evaluate(_model, deltaTime);
+		m_UpdateStats.PhysicsSteps = _physics->GetLastStepCount();
 	}
+	m_UpdateStats.PhysicsMs = stageElapsedMs();
 
 	if (_pose)
 	{
 		_pose->UpdateParameters(_model, deltaTime);
 	}
+	m_UpdateStats.PoseMs = stageElapsedMs();
 
 	_model->Update();
+	m_UpdateStats.ModelUpdateMs = stageElapsedMs();
 }
 
 void Model2D::OnDraw(int width, int height)
 {
 	if (!_initialized || _model == NULL) return;
-	if (width < 1 || height < 1) return;
+	if (width < 1 || height < 1)
+	{
+		m_DrawSkipped = true;
+		return;
+	}
+
+	if (m_DrawSkipped)
+	{
+		GetRenderer<Rendering::CubismRenderer_OpenGLES2>()->InvalidateDrawableCaches();
+		m_DrawSkipped = false;
+	}
 
 	CubismMatrix44* projectionMatrix = GetProjectionMatrix();
 
@@ -95,7 +204,21 @@ void Model2D::StartMotion(ModelMotion* modelMotion)
 {
 	if (modelMotion->motionType == ModelMotion::MotionType::Motion)
 	{
-		DoStartMotion(modelMotion->motion);
+		if (m_MotionLoading.Lazy)
+		{
+			int motionIndex = static_cast<int>(modelMotion - m_Motions.data());
+			if (!m_MotionCache.Acquire(motionIndex))
+			{
+				// started by UpdateMotionCache() once loaded
+				m_PendingMotionStarts.insert(motionIndex);
+				return;
+			}
+			m_MotionHandles[motionIndex] = DoStartMotion(modelMotion->motion);
+		}
+		else
+		{
+			DoStartMotion(modelMotion->motion);
+		}
 	}
 	else if (modelMotion->motionType == ModelMotion::MotionType::Expression)
 	{
@@ -121,6 +244,7 @@ void Model2D::ResetAllMotions()
 
 	// Stop motions
 	_motionManager->StopAllMotions();
+	m_PendingMotionStarts.clear();
 }
 
 void Model2D::DoStartExpression(ACubismMotion* motion)
@@ -147,9 +271,79 @@ void Model2D::DoStartExpression(ACubismMotion* motion)
 	m_MapActiveExpression[motion] = newQueueEntryHandler;
 }
 
-void Model2D::DoStartMotion(ACubismMotion* motion)
+CubismMotionQueueEntryHandle Model2D::DoStartMotion(ACubismMotion* motion)
 {
-	CubismMotionQueueEntryHandle newQueueEntryHandler = _motionManager->StartMotion(motion, false, /*unused*/0.0f, true);
+	return _motionManager->StartMotion(motion, false, /*unused*/0.0f, true);
+}
+
+void Model2D::PrefetchMotion(ModelMotion* modelMotion)
+{
+	if (!m_MotionLoading.Lazy || modelMotion->motionType != ModelMotion::MotionType::Motion)
+		return;
+
+	m_MotionCache.Prefetch(static_cast<int>(modelMotion - m_Motions.data()));
+}
+
+void Model2D::UpdateMotionCache()
+{
+	std::vector<MotionCache::Loaded> loaded;
+	m_MotionCache.Collect(loaded);
+
+	for (MotionCache::Loaded& result : loaded)
+	{
+		ModelMotion& modelMotion = m_Motions[result.Key];
+		bool startNow = m_PendingMotionStarts.erase(result.Key) > 0;
+
+		if (!result.Motion)
+		{
+			CubismFramework::CoreLogFunction("[Model2D][E] Error while loading a motion\n");
+			continue;
+		}
+
+		AdoptMotion(modelMotion, static_cast<CubismMotion*>(result.Motion));
+
+		if (startNow)
+			m_MotionHandles[result.Key] = DoStartMotion(modelMotion.motion);
+	}
+
+	m_MotionCache.Trim(
+		[this](int motionIndex) { return !IsMotionPlaying(motionIndex); },
+		[this](int motionIndex) {
+			ACubismMotion::Delete(m_Motions[motionIndex].motion);
+			m_Motions[motionIndex].motion = nullptr;
+			m_MotionHandles.erase(motionIndex);
+		}
+	);
+}
+
+void Model2D::SetPhysicsRate(float stepsPerSecond)
+{
+	m_PhysicsRate = stepsPerSecond;
+
+	if (_physics)
+		_physics->SetFixedTimeStep(stepsPerSecond > 0.0f ? 1.0f / stepsPerSecond : 0.0f);
+}
+
+bool Model2D::IsMotionPlaying(int motionIndex) const
+{
+	auto handle = m_MotionHandles.find(motionIndex);
+	if (handle == m_MotionHandles.end())
+		return false;
+
+	// finished entries are removed from the queue
+	return _motionManager->GetCubismMotionQueueEntry(handle->second) != NULL;
+}
+
+void Model2D::AdoptMotion(ModelMotion& modelMotion, CubismMotion* motion)
+{
+	if (modelMotion.fadeInTime >= 0.0f)
+		motion->SetFadeInTime(modelMotion.fadeInTime);
+	if (modelMotion.fadeOutTime >= 0.0f)
+		motion->SetFadeOutTime(modelMotion.fadeOutTime);
+
+	motion->SetEffectIds(m_EyeBlinkIds, m_LipSyncIds);
+
+	modelMotion.motion = motion;
 }
 
 bool Model2D::SetupModelSetting(ICubismModelSetting* modelSetting)
@@ -159,6 +353,76 @@ bool Model2D::SetupModelSetting(ICubismModelSetting* modelSetting)
 	// set modeSetting as class member
 	m_ModelSetting = modelSetting;
 
+	// collect the motion and expression files first, the model setting isn't read from the loader threads
+	std::vector<PreloadSlot> preloadSlots;
+	{
+		int motionId = 0;
+		for (csmInt32 i = 0; i < m_ModelSetting->GetMotionGroupCount(); i++)
+		{
+			const char* groupName = m_ModelSetting->GetMotionGroupName(i);
+
+			const csmInt32 count = m_ModelSetting->GetMotionCount(groupName);
+			for (csmInt32 i = 0; i < count; i++)
+			{
+				PreloadSlot slot;
+				slot.Type = ModelMotion::MotionType::Motion;
+				slot.Id = motionId++;
+				slot.Name = m_ModelSetting->GetMotionFileName(groupName, i);
+				slot.FadeInTime = m_ModelSetting->GetMotionFadeInTimeValue(groupName, i);
+				slot.FadeOutTime = m_ModelSetting->GetMotionFadeOutTimeValue(groupName, i);
+
+				wchar_t* motionPath = Utility::NewWideChar(slot.Name);
+				slot.Path = m_ModelDir + motionPath;
+				delete[] motionPath;
+
+				preloadSlots.push_back(std::move(slot));
+			}
+		}
+
+		for (csmInt32 i = 0; i < m_ModelSetting->GetExpressionCount(); i++)
+		{
+			PreloadSlot slot;
+			slot.Type = ModelMotion::MotionType::Expression;
+			slot.Id = i;
+			slot.Name = m_ModelSetting->GetExpressionName(i);
+
+			wchar_t* expressionPath = Utility::NewWideChar(m_ModelSetting->GetExpressionFileName(i));
+			slot.Path = m_ModelDir + expressionPath;
+			delete[] expressionPath;
+
+			preloadSlots.push_back(std::move(slot));
+		}
+	}
+
+	// read & parse every motion and expression while the moc and textures are loading
+	auto preloadStart = std::chrono::steady_clock::now();
+	std::future<unsigned int> preload = std::async(std::launch::async, [this, &preloadSlots]() -> unsigned int {
+		return ParallelFor(preloadSlots.size(), m_MotionLoading.PreloadThreads, [this, &preloadSlots](size_t index) {
+			PreloadSlot& slot = preloadSlots[index];
+			auto start = std::chrono::steady_clock::now();
+
+			if (slot.Type == ModelMotion::MotionType::Motion)
+			{
+				if (m_MotionLoading.Lazy)
+					return; // loaded on first use
+
+				size_t dataSize = 0;
+				slot.Motion = LoadMotionWithCache(slot.Path, slot.FromCache, dataSize);
+			}
+			else
+			{
+				auto [buffer, fileSize] = Utility::CreateBufferFromFile(slot.Path.c_str());
+				if (buffer)
+				{
+					slot.Motion = LoadExpression(buffer, fileSize, /*reinterpret_cast<char*>(expressionName)*/0);
+					delete[] buffer;
+				}
+			}
+
+			slot.LoadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		});
+	});
+
 	std::future<bool> loadMoc = std::async(std::launch::async, [this]() -> bool {
 		// load .moc3
 		wchar_t* moc3Filename = Utility::NewWideChar(m_ModelSetting->GetModelFileName());
@@ -188,34 +452,6 @@ bool Model2D::SetupModelSetting(ICubismModelSetting* modelSetting)
 		}
 	});
 
-	std::future<void> loadExpressions = std::async(std::launch::async, [this]() -> void {
-		// Load expressions
-		const csmInt32 count = m_ModelSetting->GetExpressionCount();
-		if (count > 0)
-		{
-			m_Expressions.reserve(count);
-			for (csmInt32 i = 0; i < count; i++)
-			{
-				wchar_t* expressionPath = Utility::NewWideChar(m_ModelSetting->GetExpressionFileName(i));
-				auto [buffer, fileSize] = Utility::CreateBufferFromFile((m_ModelDir + expressionPath).data());
-				delete[] expressionPath;
-
-				if (buffer)
-				{
-					ACubismMotion* motion = LoadExpression(buffer, fileSize, /*reinterpret_cast<char*>(expressionName)*/0);
-					delete[] buffer;
-
-					m_Expressions.push_back({
-						i,
-						m_ModelSetting->GetExpressionName(i),
-						motion,
-						ModelMotion::MotionType::Expression
-					});
-				}
-			}
-		}
-	});
-
 	// UserData
 	if (strcmp(m_ModelSetting->GetUserDataFile(), "") != 0)
 	{
@@ -266,11 +502,20 @@ bool Model2D::SetupModelSetting(ICubismModelSetting* modelSetting)
 		}
 	}
 
+	// nothing owns the preloaded motions until they're collected below
+	auto releasePreloaded = [&preload, &preloadSlots]() {
+		preload.wait();
+		for (PreloadSlot& slot : preloadSlots)
+			if (slot.Motion)
+				ACubismMotion::Delete(slot.Motion);
+	};
+
 	// wait until .moc3 loaded
 	if (loadMoc.get() != true || !_moc)
 	{
 		// error while loading .moc3
 		CubismFramework::CoreLogFunction("[Model2D][E] Error while loading .moc3 file\n");
+		releasePreloaded();
 		return false;
 	}
 	else
@@ -281,6 +526,7 @@ bool Model2D::SetupModelSetting(ICubismModelSetting* modelSetting)
 	if (textureErrFlags)
 	{
 		CubismFramework::CoreLogFunction("[Model2D][E] Error while loading texture file\n");
+		releasePreloaded();
 		return false;
 	}
 
@@ -294,63 +540,150 @@ bool Model2D::SetupModelSetting(ICubismModelSetting* modelSetting)
 		GetRenderer<Rendering::CubismRenderer_OpenGLES2>()->BindTexture(modelTexCount, textureId);
 	}
 	GetRenderer<Rendering::CubismRenderer_OpenGLES2>()->IsPremultipliedAlpha(false);
+	// meshes stay on the GPU, only moved vertices are streamed
+	GetRenderer<Rendering::CubismRenderer_OpenGLES2>()->UseVertexBuffers(true);
+	GetRenderer<Rendering::CubismRenderer_OpenGLES2>()->UseDrawBatching(true);
+	// falls back to the GLES2 shaders without OpenGL 3.3
+	GetRenderer<Rendering::CubismRenderer_OpenGLES2>()->UseUniformBuffers(true);
+	// clipping masks are only drawn again when their drawables change
+	GetRenderer<Rendering::CubismRenderer_OpenGLES2>()->UseMaskCaching(true);
+	// Application::OnRender sets the viewport and clears every frame and ImGui sets up its own state,
+	// nothing relies on the state from before the model was drawn
+	GetRenderer<Rendering::CubismRenderer_OpenGLES2>()->UseStateRestore(false);
 
 	csmMap<csmString, csmFloat32> modelLayout;
 	m_ModelSetting->GetLayoutMap(modelLayout);
 	_modelMatrix->SetupFromLayout(modelLayout);
 	_model->SaveParameters();
 
+	// every parameter starts unbound, clamp range cached once
+	m_ParameterBinding.Setup(_model->GetParameterCount(),
+		Live2D::Cubism::Core::csmGetParameterMinimumValues(_model->GetModel()),
+		Live2D::Cubism::Core::csmGetParameterMaximumValues(_model->GetModel())
+	);
+
 	SetupIndexOfDefaultParameters();
 	SetupModelUtils();
 
-	// Preload model motions
-	int motionId = 0;
-	for (csmInt32 i = 0; i < m_ModelSetting->GetMotionGroupCount(); i++)
+	// Collect the preloaded motions in file order, so ids don't depend on which thread finished first
+	unsigned int preloadThreads = preload.get();
+	int cachedCount = 0;
+	for (PreloadSlot& slot : preloadSlots)
 	{
-		const char* groupName = m_ModelSetting->GetMotionGroupName(i);
-
-		const csmInt32 count = m_ModelSetting->GetMotionCount(groupName);
-		for (csmInt32 i = 0; i < count; i++)
+		if (slot.Type == ModelMotion::MotionType::Motion && m_MotionLoading.Lazy)
 		{
-			wchar_t* motionPath = Utility::NewWideChar(m_ModelSetting->GetMotionFileName(groupName, i));
-			auto [buffer, fileSize] = Utility::CreateBufferFromFile((m_ModelDir + motionPath).data());
-			delete[] motionPath;
-
-			if (buffer)
-			{
-				CubismMotion* motion = static_cast<CubismMotion*>(LoadMotion(buffer, fileSize, 0));
-				delete[] buffer;
+			// every motion gets an entry, so the index is the id
+			m_Motions.push_back({ slot.Id, slot.Name, nullptr, ModelMotion::MotionType::Motion });
+			m_Motions.back().path = slot.Path;
+			m_Motions.back().fadeInTime = slot.FadeInTime;
+			m_Motions.back().fadeOutTime = slot.FadeOutTime;
+			continue;
+		}
 
-				float fadeInTime = m_ModelSetting->GetMotionFadeInTimeValue(groupName, i);
-				float fadeOutTime = m_ModelSetting->GetMotionFadeOutTimeValue(groupName, i);
+		char message[256];
+		snprintf(message, sizeof(message), "[Model2D][I] %s %s in %.2f ms%s\n",
+			slot.Name, slot.Motion ? "loaded" : "failed", slot.LoadMs, slot.FromCache ? " (cache)" : "");
+		CubismFramework::CoreLogFunction(message);
 
-				if (fadeInTime >= 0.0f)
-					motion->SetFadeInTime(fadeInTime);
-				if (fadeOutTime >= 0.0f)
-					motion->SetFadeOutTime(fadeOutTime);
+		if (!slot.Motion)
+			continue;
 
-				motion->SetEffectIds(m_EyeBlinkIds, m_LipSyncIds);
+		if (slot.Type == ModelMotion::MotionType::Motion)
+		{
+			cachedCount += slot.FromCache;
 
-				m_Motions.push_back({
-					motionId,
-					m_ModelSetting->GetMotionFileName(groupName, i),
-					motion,
-					ModelMotion::MotionType::Motion
-				});
-			}
-			motionId++;
+			m_Motions.push_back({ slot.Id, slot.Name, nullptr, ModelMotion::MotionType::Motion });
+			m_Motions.back().path = slot.Path;
+			m_Motions.back().fadeInTime = slot.FadeInTime;
+			m_Motions.back().fadeOutTime = slot.FadeOutTime;
+			AdoptMotion(m_Motions.back(), static_cast<CubismMotion*>(slot.Motion));
+		}
+		else
+		{
+			m_Expressions.push_back({ slot.Id, slot.Name, slot.Motion, ModelMotion::MotionType::Expression });
 		}
 	}
 	_motionManager->StopAllMotions();
 
+	{
+		double preloadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - preloadStart).count();
+		char message[160];
+		snprintf(message, sizeof(message), "[Model2D][I] %d motions (%s, %d from cache) and %d expressions loaded in %.2f ms on %u threads\n",
+			static_cast<int>(m_Motions.size()), m_MotionLoading.Lazy ? "lazy" : "preloaded", cachedCount,
+			static_cast<int>(m_Expressions.size()), preloadMs, preloadThreads);
+		CubismFramework::CoreLogFunction(message);
+	}
+
+	if (m_MotionLoading.Lazy)
+	{
+		m_MotionCache.Start([this](int motionIndex, size_t& outBytes) -> ACubismMotion* {
+			// path never changes after setup, safe to read from the loader thread
+			bool fromCache = false;
+			return LoadMotionWithCache(m_Motions[motionIndex].path, fromCache, outBytes);
+		}, m_MotionLoading.BudgetBytes);
+	}
+
 	loadPhysics.wait();
-	loadExpressions.wait();
 
 	_updating = false;
 
 	return true;
 }
 
+CubismMotion* Model2D::LoadMotionWithCache(const std::wstring& motionPath, bool& fromCache, size_t& dataSize)
+{
+	namespace fs = std::filesystem;
+
+	const std::wstring cachePath = motionPath + kMotionCacheExtension;
+	fromCache = false;
+	dataSize = 0;
+
+	// use the sidecar only when it's newer than the json
+	std::error_code error;
+	fs::file_time_type jsonTime = fs::last_write_time(motionPath, error);
+	bool hasJson = !error;
+	fs::file_time_type cacheTime = fs::last_write_time(cachePath, error);
+	bool hasCache = !error;
+
+	if (hasCache && (!hasJson || cacheTime >= jsonTime))
+	{
+		Utility::MappedFile cache;
+		if (cache.Open(cachePath.c_str()) && CubismMotion::IsBinary(cache.GetData(), static_cast<csmSizeInt>(cache.GetSize())))
+		{
+			CubismMotion* motion = static_cast<CubismMotion*>(LoadMotion(cache.GetData(), static_cast<csmSizeInt>(cache.GetSize()), 0));
+			if (motion)
+			{
+				fromCache = true;
+				dataSize = cache.GetSize();
+				return motion;
+			}
+		}
+		// outdated version or broken, fall back to the json and rewrite it
+	}
+
+	if (!hasJson)
+		return nullptr;
+
+	auto [buffer, fileSize] = Utility::CreateBufferFromFile(motionPath.c_str());
+	if (!buffer)
+		return nullptr;
+
+	CubismMotion* motion = static_cast<CubismMotion*>(LoadMotion(buffer, fileSize, 0));
+	delete[] buffer;
+
+	if (motion)
+	{
+		// written before the model setting overrides the fade times
+		csmVector<csmByte> binary;
+		motion->WriteBinary(binary);
+		dataSize = binary.GetSize();
+		if (!Utility::WriteBufferToFile(cachePath.c_str(), binary.GetPtr(), binary.GetSize()))
+			CubismFramework::CoreLogFunction("[Model2D][W] Can't write the motion cache\n");
+	}
+
+	return motion;
+}
+
 void Model2D::SetupIndexOfDefaultParameters()
 {
 	const char** paramIds = GetModel()->GetParameterIds();
@@ -493,16 +826,8 @@ void Model2D::SetupModelUtils()
 
 void Model2D::UpdateBindedParameters()
 {
-	// update binded parameter
-	for (auto [index, ptrValue] : m_ParameterBinding)
-	{
-		if (ptrValue)
-		{
-			GetModel()->SetParameterValue(index, *ptrValue);
-		}
-	}
-
-	GetModel()->SaveParameters();
+	// write every binded source straight into the model's parameter values
+	m_ParameterBinding.Apply(Live2D::Cubism::Core::csmGetParameterValues(GetModel()->GetModel()));
 }
 
 /*
@@ -542,16 +867,20 @@ std::vector<std::array<float, 2>> Model2D::GetParameterMinMax()
 	return paramMinMax;
 }
 
-ParameterBinding& Model2D::GetBindedParameter() { return m_ParameterBinding; }
+const ParameterBinding& Model2D::GetBindedParameter() const { return m_ParameterBinding; }
+const Model2D::UpdateStats& Model2D::GetUpdateStats() const { return m_UpdateStats; }
 DefaultParameter::ParametersIndex& Model2D::GetParameterIndex() { return m_IndexOfDefaultParameter; }
 
 std::vector<ModelMotion>& Model2D::GetExpressions() { return m_Expressions; }
 std::vector<ModelMotion>& Model2D::GetMotions() { return m_Motions; }
+const MotionLoading& Model2D::GetMotionLoading() const { return m_MotionLoading; }
+float Model2D::GetPhysicsRate() const { return m_PhysicsRate; }
+const MotionCache::Stats& Model2D::GetMotionCacheStats() const { return m_MotionCache.GetStats(); }
+const Rendering::CubismRenderer_OpenGLES2::CubismDrawStatistics& Model2D::GetDrawStatistics() { return GetRenderer<Rendering::CubismRenderer_OpenGLES2>()->GetDrawStatistics(); }
 
 int Model2D::GetParameterCount() const { return GetModel()->GetParameterCount(); }
 
-void Model2D::SetParameterBinding(const ParameterBinding& parameterBinding) { m_ParameterBinding = parameterBinding; }
-void Model2D::SetParameterBindingAt(int index, float* ptrValue) { m_ParameterBinding[index] = ptrValue; };
+void Model2D::SetParameterBindingAt(int index, float* ptrValue) { m_ParameterBinding.Bind(index, ptrValue); };
 
 void Model2D::SetModelScale(float scaleValue) { m_ModelScale = scaleValue; }
 void Model2D::AddModelScale(float scaleValue) { m_ModelScale += scaleValue; }
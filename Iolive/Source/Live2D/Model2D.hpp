@@ -15,10 +15,14 @@
 #include <Type/csmVector.hpp>
 #include "Utility.hpp"
 #include "Component/TextureManager.hpp"
+#include "Component/ParameterBinding.hpp"
+#include "Component/MotionCache.hpp"
 #include <string>
 #include <vector>
 #include <array>
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 
 using namespace Csm;
 
@@ -50,34 +54,6 @@ namespace DefaultParameter {
 		int ParamBrowRAngle = -1;
 		int ParamBreath = -1;
 	};
-
-	/*
-	* Default parameter value
-	*/
-	struct ParametersValue {
-		float ParamAngleX = 0.0f;
-		float ParamAngleY = 0.0f;
-		float ParamAngleZ = 0.0f;
-		float ParamBodyAngleX = 0.0f;
-		float ParamBodyAngleY = 0.0f;
-		float ParamBodyAngleZ = 0.0f;
-		float ParamEyeLOpen = 1.0f;
-		float ParamEyeROpen = 1.0f;
-		float ParamEyeLSmile = 0.0f;
-		float ParamEyeRSmile = 0.0f;
-		float ParamEyeForm = 0.0f;
-		float ParamEyeBallX = 0.0f;
-		float ParamEyeBallY = 0.0f;
-		float ParamMouthOpenY = 0.0f;
-		float ParamMouthForm = 1.0f;
-		float ParamBrowLY = 0.0f;
-		float ParamBrowRY = 0.0f;
-		float ParamBrowLForm = 0.0f;
-		float ParamBrowRForm = 0.0f;
-		float ParamBrowLAngle = 0.0f;
-		float ParamBrowRAngle = 0.0f;
-		float ParamBreath = 0.0f;
-	};
 }
 
 struct ModelMotion
@@ -91,34 +67,97 @@ public:
 	{}
 
 	const char* name;
-	ACubismMotion* motion;
+	ACubismMotion* motion; // nullptr while a lazy motion isn't loaded
 	MotionType motionType;
 	int id;
+
+	// motions only, used to (re)load lazy motions
+	std::wstring path;
+	float fadeInTime = -1.0f;
+	float fadeOutTime = -1.0f;
 };
 
-typedef std::map<int, float*> ParameterBinding;
+/*
+* How motions (not expressions, those are small) are loaded
+* Lazy: only the file paths are read at setup, a motion is parsed on a background thread
+* the first time it's started, and idle motions are evicted past BudgetBytes
+*/
+struct MotionLoading
+{
+	bool Lazy = false;
+	bool PrefetchHotkeys = true; // see Model2D::PrefetchMotion()
+	size_t BudgetBytes = 32 * 1024 * 1024;
+	unsigned int PreloadThreads = 0; // motion & expression loader threads at setup, 0 = hardware_concurrency
+};
 
 class Model2D : public CubismUserModel
 {
 public:
-	Model2D(ICubismModelSetting* modelSetting, const std::wstring& modelDir, const std::wstring& modelFilename);
+	Model2D(ICubismModelSetting* modelSetting, const std::wstring& modelDir, const std::wstring& modelFilename,
+		const MotionLoading& motionLoading = MotionLoading());
 	~Model2D();
 
 	void OnUpdate(float deltaTime);
 	void OnDraw(int width, int height);
 
+	/*
+	* Duration of each OnUpdate stage in the last frame, in milliseconds
+	*/
+	struct UpdateStats
+	{
+		float BindingMs = 0.0f;
+		float MotionMs = 0.0f;
+		float ExpressionMs = 0.0f;
+		float BreathMs = 0.0f;
+		float PhysicsMs = 0.0f;
+		float PoseMs = 0.0f;
+		float ModelUpdateMs = 0.0f;
+		int SnapshotCopies = 0; // Load/SaveParameters calls
+		int PhysicsSteps = 0;
+	};
+	const UpdateStats& GetUpdateStats() const;
+
+	// lazy motions start once they're loaded
 	void StartMotion(ModelMotion* motion);
 	void ResetAllMotions();
 
+	// queue a lazy motion (e.g. bound to a hotkey) before it's started, no-op otherwise
+	void PrefetchMotion(ModelMotion* motion);
+
+	const MotionLoading& GetMotionLoading() const;
+
+	/*
+	* Physics steps per second, 0 = one step per frame with the frame delta time
+	* a fixed rate keeps physics the same at any frame rate
+	*/
+	void SetPhysicsRate(float stepsPerSecond);
+	float GetPhysicsRate() const;
+	const MotionCache::Stats& GetMotionCacheStats() const;
+
+	// draw calls & uploaded vertex data of the last OnDraw
+	const Rendering::CubismRenderer_OpenGLES2::CubismDrawStatistics& GetDrawStatistics();
+
 private:
 	bool SetupModelSetting(ICubismModelSetting* modelSetting);
 	void SetupIndexOfDefaultParameters();
 	void SetupModelUtils();
 
+	/*
+	* Load a motion3.json through its precompiled sidecar (<motion>.iomb),
+	* the sidecar is (re)written when it's missing or older than the json
+	*/
+	CubismMotion* LoadMotionWithCache(const std::wstring& motionPath, bool& fromCache, size_t& dataSize);
+
+	// adopt the motions loaded in the background, start the pending ones and trim the cache
+	void UpdateMotionCache();
+	// apply the model setting fade times & effect ids, then store the motion
+	void AdoptMotion(ModelMotion& modelMotion, CubismMotion* motion);
+	bool IsMotionPlaying(int motionIndex) const;
+
 	void UpdateBindedParameters();
 
 	void DoStartExpression(ACubismMotion* motion);
-	void DoStartMotion(ACubismMotion* motion);
+	CubismMotionQueueEntryHandle DoStartMotion(ACubismMotion* motion);
 
 public:
 	// <ParameterName, value>
@@ -127,7 +166,7 @@ public:
 	// [Index] => <Min, Max>
 	std::vector<std::array<float, 2>> GetParameterMinMax();
 
-	ParameterBinding& GetBindedParameter();
+	const ParameterBinding& GetBindedParameter() const;
 	DefaultParameter::ParametersIndex& GetParameterIndex();
 
 	std::vector<ModelMotion>& GetExpressions();
@@ -135,7 +174,6 @@ public:
 
 	int GetParameterCount() const;
 
-	void SetParameterBinding(const ParameterBinding& parameterBinding);
 	void SetParameterBindingAt(int index, float* ptrValue);
 
 	void SetModelScale(float scaleValue);
@@ -163,6 +201,7 @@ private:
 	TextureManager m_TextureManager;
 
 	ParameterBinding m_ParameterBinding;
+	UpdateStats m_UpdateStats;
 	DefaultParameter::ParametersIndex m_IndexOfDefaultParameter;
 
 	csmVector<CubismIdHandle> m_EyeBlinkIds;
@@ -172,7 +211,15 @@ private:
 	std::vector<ModelMotion> m_Motions;
 
 	std::map<ACubismMotion*, CubismMotionQueueEntryHandle> m_MapActiveExpression;
+
+	MotionLoading m_MotionLoading;
+	MotionCache m_MotionCache;
+	std::unordered_set<int> m_PendingMotionStarts; // motion indices started before being loaded
+	std::unordered_map<int, CubismMotionQueueEntryHandle> m_MotionHandles; // last start of each lazy motion
 	
+	float m_PhysicsRate = 0.0f;
+	bool m_DrawSkipped = false; // updated while minimized, the renderer caches are stale
+
 	CubismMatrix44 m_ProjectionMatrix;
 	float m_ModelScale;
 	float m_ModelTranslateX;
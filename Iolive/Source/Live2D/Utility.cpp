@@ -1,4 +1,5 @@
 #include "Utility.hpp"
+#include <windows.h>
 #include <sys/stat.h>
 #include <fstream>
 // #include <sstream>
@@ -33,6 +34,77 @@ namespace Utility {
 		return { buf, fileSize };
 	}
 
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	bool MappedFile::Open(const wchar_t* filePath)
+	{
+		Close();
+
+		HANDLE file = CreateFileW(filePath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+		m_File = file;
+
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0)
+		{
+			// empty files can't be mapped
+			Close();
+			return false;
+		}
+
+		m_Mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!m_Mapping)
+		{
+			Close();
+			return false;
+		}
+
+		m_Data = static_cast<const unsigned char*>(MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0));
+		if (!m_Data)
+		{
+			Close();
+			return false;
+		}
+
+		m_Size = static_cast<size_t>(fileSize.QuadPart);
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (m_Data)
+			UnmapViewOfFile(m_Data);
+		if (m_Mapping)
+			CloseHandle(m_Mapping);
+		if (m_File)
+			CloseHandle(m_File);
+
+		m_File = nullptr;
+		m_Mapping = nullptr;
+		m_Data = nullptr;
+		m_Size = 0;
+	}
+
+	bool WriteBufferToFile(const wchar_t* filePath, const unsigned char* buffer, size_t size)
+	{
+		HANDLE file = CreateFileW(filePath, GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+
+		DWORD written = 0;
+		bool success = WriteFile(file, buffer, static_cast<DWORD>(size), &written, nullptr) && written == size;
+		CloseHandle(file);
+
+		if (!success)
+			DeleteFileW(filePath);
+
+		return success;
+	}
+
 	wchar_t* NewWideChar(const char* value)
 	{
 		const size_t charSize = strlen(value) + 1;
@@ -1,11 +1,41 @@
 #pragma once
 
 #include <tuple>
+#include <cstddef>
 
 namespace Utility {
 
 	std::tuple<unsigned char*, int> CreateBufferFromFile(const wchar_t* filePath);
 
+	/*
+	* Read-only view of a whole file mapped into memory,
+	* the data stays valid until Close() or destruction
+	*/
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		bool Open(const wchar_t* filePath);
+		void Close();
+
+		const unsigned char* GetData() const { return m_Data; }
+		size_t GetSize() const { return m_Size; }
+
+	private:
+		void* m_File = nullptr;    // HANDLE
+		void* m_Mapping = nullptr; // HANDLE
+		const unsigned char* m_Data = nullptr;
+		size_t m_Size = 0;
+	};
+
+	// write (or overwrite) the whole file, a partially written file is removed
+	bool WriteBufferToFile(const wchar_t* filePath, const unsigned char* buffer, size_t size);
+
 	// create new heap allocated wide char
 	// don't forget to delete[] it
 	wchar_t* NewWideChar(const char* value);
@@ -2,6 +2,7 @@
 #include "Utility/WindowsAPI.hpp"
 #include "Live2D/Live2DManager.hpp"
 #include <string>
+#include <ctime>
 
 namespace Iolive {
 	void MainGui::InitializeImGui(GLFWwindow* window)
@@ -166,7 +167,11 @@ namespace Iolive {
 							// clear hotkeys
 							MainGui::Get().GuiHotkeys.ClearAll();
 
-							Model2D* newModel = Live2DManager::CreateModel(filePath.data());
+							MotionLoading motionLoading;
+							motionLoading.Lazy = Checkbox_LazyMotions.IsChecked();
+							motionLoading.PrefetchHotkeys = Checkbox_PrefetchHotkeyMotions.IsChecked();
+
+							Model2D* newModel = Live2DManager::CreateModel(filePath.data(), motionLoading);
 							if (newModel)
 							{
 								// success create model
@@ -176,6 +181,13 @@ namespace Iolive {
 					}
 					ImGui::PopStyleVar(); // End button style var
 
+					// used by the next opened model
+					Checkbox_LazyMotions.Draw();
+					if (ImGui::IsItemHovered())
+						ImGui::SetTooltip("Load motions on first use, applies to the next opened model");
+					if (Checkbox_LazyMotions.IsChecked())
+						Checkbox_PrefetchHotkeyMotions.Draw();
+
 					if (app->m_UserModel.IsModelInitialized())
 					{
 						Checkbox_ShowModelHotkeys.Draw();
@@ -212,7 +224,8 @@ namespace Iolive {
 						ImGui::PushItemFlag(ImGuiItemFlags_Disabled, true);
 						ImGui::PushStyleVar(ImGuiStyleVar_Alpha, ImGui::GetStyle().Alpha * 0.55f);
 					}
-					if (ImGui::BeginCombo("##CameraDevices", CameraDevicesMap[SelectedCameraId].deviceName.c_str()))
+					const char* selectedSourceName = SelectedCameraId < 0 ? "Video File" : CameraDevicesMap[SelectedCameraId].deviceName.c_str();
+					if (ImGui::BeginCombo("##CameraDevices", selectedSourceName))
 					{
 						CameraDevicesMap = DeviceEnumerator.getVideoDevicesMap(); // update device map
 						for (int i = 0; i < CameraDevicesMap.size(); i++)
@@ -226,6 +239,21 @@ namespace Iolive {
 									ImGui::SetItemDefaultFocus();
 							}
 						}
+
+						// video file / image sequence as a camera replacement
+						if (ImGui::Selectable("Video File ...", SelectedCameraId < 0))
+						{
+							std::wstring filePath = WindowsAPI::WOpenFileDialog(
+								L"Video / Image File (*.*)\000*.*\000Landmark Recording (*.iolm)\000*.iolm\000",
+								glfwGetWin32Window(app->m_Window->GetGlfwWindow())
+							);
+
+							if (filePath.size() > 0) // file selected
+							{
+								VideoFilePath = filePath;
+								SelectedCameraId = -1;
+							}
+						}
 						ImGui::EndCombo();
 					}
 					if (Checkbox_FaceCapture.IsChecked())
@@ -250,6 +278,7 @@ namespace Iolive {
 							// next time, don't automatically showing the frame!
 							Checkbox_ShowFrame.SetChecked(false);
 							Checkbox_ShowFace.SetChecked(false);
+							Checkbox_RecordLandmarks.SetChecked(false); // recording stops with the camera
 						}
 					}
 
@@ -278,11 +307,55 @@ namespace Iolive {
 							Checkbox_ShowFace.Draw();
 						}
 
+						ImGui::Spacing(); ImGui::SameLine();
+						if (Checkbox_RecordLandmarks.Draw()) // Checkbox record landmarks
+						{
+							if (Checkbox_RecordLandmarks.IsChecked())
+							{
+								char fileName[64];
+								std::time_t now = std::time(nullptr);
+								std::strftime(fileName, sizeof(fileName), "Landmarks_%Y%m%d_%H%M%S.iolm", std::localtime(&now));
+								if (!app->m_Ioface.StartRecording(fileName))
+									Checkbox_RecordLandmarks.SetChecked(false);
+							}
+							else
+							{
+								app->m_Ioface.StopRecording();
+							}
+						}
+
 						ImGui::Spacing(); ImGui::SameLine();
 						Checkbox_EqualizeEyes.Draw(); // Checkbox equalize eye parameter
 
 						ImGui::Spacing(); ImGui::SameLine();
 						Checkbox_EyeballFollowCursor.Draw(); // Checkbox eye ball follow cursor
+
+						if (ImGui::CollapsingHeader("Prediction"))
+						{
+							// how each parameter group is evaluated between tracker results
+							ImGui::PushItemWidth(ImGui::GetWindowSize().x / 2.25);
+							for (int group = 0; group < static_cast<int>(SamplePredictor::Group::Count); group++)
+							{
+								auto predictorGroup = static_cast<SamplePredictor::Group>(group);
+								SamplePredictor::Mode* mode = app->m_FacePredictor.GetPtrMode(predictorGroup);
+
+								if (ImGui::BeginCombo(SamplePredictor::GroupName(predictorGroup), SamplePredictor::ModeName(*mode)))
+								{
+									for (int i = 0; i < static_cast<int>(SamplePredictor::Mode::Count); i++)
+									{
+										auto itemMode = static_cast<SamplePredictor::Mode>(i);
+										if (ImGui::Selectable(SamplePredictor::ModeName(itemMode), *mode == itemMode))
+											*mode = itemMode;
+									}
+									ImGui::EndCombo();
+								}
+							}
+
+							float delayMs = app->m_FacePredictor.InterpolationDelay * 1000.0f;
+							if (ImGui::SliderFloat("Interpolation delay", &delayMs, 0.0f, 100.0f, "%.0fms"))
+								app->m_FacePredictor.InterpolationDelay = delayMs / 1000.0f;
+							ImGui::PopItemWidth();
+						}
 					}
 
 					ImGui::EndTabItem();
@@ -305,9 +378,47 @@ namespace Iolive {
 					}
 
 					ImGui::SliderFloat("Max FPS (not accurate)", &(app->m_Window->MaxFPS), 20.0f, 90.0f, "%.0f");
+
+					// physics at its own rate, so it looks the same at any FPS
+					bool physicsRateChanged = Checkbox_FixedPhysicsRate.Draw();
+					if (Checkbox_FixedPhysicsRate.IsChecked())
+						physicsRateChanged |= ImGui::SliderInt("Physics Rate", &SliderInt_PhysicsRate, 30, 120, "%d Hz");
+					if (physicsRateChanged && app->m_UserModel.IsModelInitialized())
+						app->m_UserModel.GetModel2D()->SetPhysicsRate(GetPhysicsRate());
 					ImGui::PopItemWidth();
 
 					ImGui::Text("Estimated FPS: %.0f", io.Framerate);
+					if (ImGui::IsItemHovered() && app->m_UserModel.IsModelInitialized())
+					{
+						// model update cost per stage
+						Model2D* model = app->m_UserModel.GetModel2D();
+						const Model2D::UpdateStats& stats = model->GetUpdateStats();
+						ImGui::BeginTooltip();
+						ImGui::Text(
+							"Binding: %.3fms\nMotion: %.3fms\nExpression: %.3fms\nBreath: %.3fms\nPhysics: %.3fms (%d steps)\nPose: %.3fms\nModel update: %.3fms\nSnapshot copies: %d",
+							stats.BindingMs, stats.MotionMs, stats.ExpressionMs, stats.BreathMs,
+							stats.PhysicsMs, stats.PhysicsSteps, stats.PoseMs, stats.ModelUpdateMs, stats.SnapshotCopies
+						);
+
+						const auto& drawStats = model->GetDrawStatistics();
+						ImGui::Text(
+							"Draw calls: %u\nUploaded: %.1f KB\nState changes: %u (%u skipped)\nMask redraws: %u (%u vertices scanned)",
+							drawStats.DrawCalls, drawStats.UploadedBytes / 1024.0,
+							drawStats.StateChanges, drawStats.SkippedStateChanges,
+							drawStats.MaskRedraws, drawStats.MaskVerticesScanned
+						);
+
+						if (model->GetMotionLoading().Lazy)
+						{
+							const MotionCache::Stats& cacheStats = model->GetMotionCacheStats();
+							ImGui::Text(
+								"Motion cache: %d hits, %d misses, %d evictions\nResident motions: %d (%.1f / %.1f MB)",
+								cacheStats.Hits, cacheStats.Misses, cacheStats.Evictions, cacheStats.Resident,
+								cacheStats.ResidentBytes / (1024.0 * 1024.0), cacheStats.BudgetBytes / (1024.0 * 1024.0)
+							);
+						}
+						ImGui::EndTooltip();
+					}
 
 					ImGui::Text("Log:");
 					ImGui::PushStyleColor(ImGuiCol_ChildBg, ImVec4(0.1f, 0.1f, 0.1f, 1.0f));
@@ -467,12 +578,16 @@ namespace Iolive {
 
 		ImGui::PushItemWidth(150);
 
-		std::map<int, float*> modelBindedParameter = m_Model2D->GetBindedParameter();
+		const ParameterBinding& modelBindedParameter = m_Model2D->GetBindedParameter();
 
-		size_t paramIndex = 0;
+		int paramIndex = 0;
 		for (auto& [name, value] : m_Parameters)
 		{
-			bool isBindedWithGUI = &value == modelBindedParameter[paramIndex];
+			float* bindedValue = modelBindedParameter.GetSource(paramIndex);
+			if (bindedValue == nullptr)
+				bindedValue = &value; // not binded at all, show the gui value
+
+			bool isBindedWithGUI = &value == bindedValue;
 			if (!isBindedWithGUI)
 			{
 				// this parameter is not binded with the GUI. Disable this parameter
@@ -480,7 +595,7 @@ namespace Iolive {
 				ImGui::PushStyleVar(ImGuiStyleVar_Alpha, ImGui::GetStyle().Alpha * 0.55f);
 			}
 
-			ImGui::SliderFloat(name, modelBindedParameter[paramIndex],
+			ImGui::SliderFloat(name, bindedValue,
 				m_ParamMinMax[paramIndex][0], m_ParamMinMax[paramIndex][1], "%.2f"
 			);
 
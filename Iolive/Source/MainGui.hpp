@@ -132,20 +132,29 @@ namespace Iolive {
 		*/
 
 		Checkbox Checkbox_ShowModelHotkeys = Checkbox("Show Model Hotkeys", false);
+		Checkbox Checkbox_LazyMotions = Checkbox("Lazy Motion Loading", false);
+		Checkbox Checkbox_PrefetchHotkeyMotions = Checkbox("Prefetch Hotkey Motions", true);
 		Checkbox Checkbox_EqualizeEyes = Checkbox("Equalize Eye Parameters", true);
 		Checkbox Checkbox_EyeballFollowCursor = Checkbox("Eye Ball Follow Cursor", true);
 
 		Checkbox Checkbox_FaceCapture = Checkbox("Enable Face Capture", false);
 		Checkbox Checkbox_ShowFrame = Checkbox("Show Frame", false);
 		Checkbox Checkbox_ShowFace = Checkbox("Show Face", false);
+		Checkbox Checkbox_RecordLandmarks = Checkbox("Record Landmarks", false);
 
 		Checkbox Checkbox_WindowVisible = Checkbox("Window Visible", true);
+		Checkbox Checkbox_FixedPhysicsRate = Checkbox("Fixed Physics Rate", true);
+		int SliderInt_PhysicsRate = 60;
+
+		// steps per second for Model2D::SetPhysicsRate()
+		float GetPhysicsRate() const { return Checkbox_FixedPhysicsRate.IsChecked() ? static_cast<float>(SliderInt_PhysicsRate) : 0.0f; }
 
 		ParameterScene ParameterGUI;
 
 		DeviceEnumerator DeviceEnumerator; // DeviceEnumerator instance
 		std::map<int, Device> CameraDevicesMap; // Camera Devices map
 		int SelectedCameraId = 0; // default camera is 0
+		std::wstring VideoFilePath; // used when SelectedCameraId is -1
 
 		float ColorEdit_ClearColor[3] = { 0.22f, 1.0f, 0.07f }; // default neon green.
 
@@ -12,6 +12,15 @@ namespace MathUtils {
 		return (value - min) / (max - min);
 	};
 
+	/*
+	* Lerp percent for exponential smoothing with given speed (1/s),
+	* unlike (deltaTime * speed) it gives the same result at any frame rate
+	*/
+	inline float SmoothFactor(float speed, float deltaTime)
+	{
+		return 1.0f - std::exp(-speed * deltaTime);
+	}
+
 	inline float Abs(float value)
 	{
 		return std::abs(value);
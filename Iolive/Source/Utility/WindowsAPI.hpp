@@ -65,6 +65,24 @@ namespace WindowsAPI {
 		return filePathWStr;
 	}
 
+	/*
+	* Convert an UTF-16 path to UTF-8
+	* \return false when the string isn't valid UTF-16
+	*/
+	static bool WideToUtf8(const std::wstring& wstr, std::string& outStr)
+	{
+		outStr.clear();
+		if (wstr.empty())
+			return true;
+
+		int length = WideCharToMultiByte(CP_UTF8, WC_ERR_INVALID_CHARS, wstr.c_str(), static_cast<int>(wstr.size()), NULL, 0, NULL, NULL);
+		if (length <= 0)
+			return false;
+
+		outStr.resize(length);
+		return WideCharToMultiByte(CP_UTF8, WC_ERR_INVALID_CHARS, wstr.c_str(), static_cast<int>(wstr.size()), outStr.data(), length, NULL, NULL) == length;
+	}
+
 	static void OpenUrlInBrowser(const char* url)
 	{
 		ShellExecute(0, 0, url, 0, 0, SW_SHOW);
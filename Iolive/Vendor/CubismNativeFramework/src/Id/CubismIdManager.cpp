@@ -10,6 +10,29 @@
 
 namespace Live2D { namespace Cubism { namespace Framework {
 
+namespace {
+
+/// Initial size of the ID hash table.
+const csmUint32 InitialTableSize = 256;
+
+/// Gets the first slot of a hash code.
+///
+/// @param  hashcode  Hash code of the ID name.
+/// @param  mask  Table size - 1.
+/// @return Slot index.
+csmUint32 GetTableSlot(csmInt32 hashcode, csmUint32 mask)
+{
+    // csmString hash codes are weak in the low bits for short names, mix them first
+    csmUint32 hash = static_cast<csmUint32>(hashcode);
+    hash ^= hash >> 16;
+    hash *= 0x45d9f3bu;
+    hash ^= hash >> 16;
+
+    return hash & mask;
+}
+
+}
+
 CubismIdManager::CubismIdManager()
 { }
 
@@ -39,7 +62,7 @@ void CubismIdManager::RegisterIds(const csmVector<csmString>& ids)
 
 const CubismId* CubismIdManager::GetId(const csmString& id)
 {
-    return RegisterId(id.GetRawString());
+    return RegisterId(id);
 }
 
 const CubismId* CubismIdManager::GetId(const csmChar* id)
@@ -49,40 +72,106 @@ const CubismId* CubismIdManager::GetId(const csmChar* id)
 
 csmBool CubismIdManager::IsExist(const csmString& id) const
 {
-    return IsExist(id.GetRawString());
+    std::lock_guard<std::mutex> lock(_mutex);
+    return (FindId(id.GetRawString(), id.GetLength(), id.GetHashcode()) != NULL);
 }
 csmBool CubismIdManager::IsExist(const csmChar* id) const
 {
-    return (FindId(id) != NULL);
+    const csmInt32 length = static_cast<csmInt32>(strlen(id));
+    const csmInt32 hashcode = csmString::CalcHashcode(id, length);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    return (FindId(id, length, hashcode) != NULL);
 }
 
 const CubismId* CubismIdManager::RegisterId(const csmChar* id)
 {
+    const csmInt32 length = static_cast<csmInt32>(strlen(id));
+
+    return RegisterId(id, length, csmString::CalcHashcode(id, length));
+}
+
+const CubismId* CubismIdManager::RegisterId(const csmString& id)
+{
+    return RegisterId(id.GetRawString(), id.GetLength(), id.GetHashcode());
+}
+
+const CubismId* CubismIdManager::RegisterId(const csmChar* id, csmInt32 length, csmInt32 hashcode)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
     CubismId* result = NULL;
 
-    if ((result = FindId(id)) != NULL)
+    if ((result = FindId(id, length, hashcode)) != NULL)
     {
         return result;
     }
 
     result = CSM_NEW CubismId(id);
     _ids.PushBack(result);
+    InsertId(result);
 
     return result;
 }
 
-const CubismId* CubismIdManager::RegisterId(const csmString& id)
+void CubismIdManager::InsertId(CubismId* id)
 {
-    return RegisterId(id.GetRawString());
+    // keep the table at most half full so the probe sequences stay short
+    if (_ids.GetSize() * 2 > _table.GetSize())
+    {
+        csmUint32 size = (_table.GetSize() > 0) ? _table.GetSize() * 2 : InitialTableSize;
+
+        while (_ids.GetSize() * 2 > size)
+        {
+            size *= 2;
+        }
+
+        _table.Clear();
+        _table.Resize(static_cast<csmInt32>(size), NULL);
+
+        // _ids already holds the new ID
+        for (csmUint32 i = 0; i < _ids.GetSize(); ++i)
+        {
+            csmUint32 slot = GetTableSlot(_ids[i]->GetString().GetHashcode(), size - 1);
+
+            while (_table[slot] != NULL)
+            {
+                slot = (slot + 1) & (size - 1);
+            }
+
+            _table[slot] = _ids[i];
+        }
+
+        return;
+    }
+
+    const csmUint32 mask = _table.GetSize() - 1;
+    csmUint32 slot = GetTableSlot(id->GetString().GetHashcode(), mask);
+
+    while (_table[slot] != NULL)
+    {
+        slot = (slot + 1) & mask;
+    }
+
+    _table[slot] = id;
 }
 
-CubismId* CubismIdManager::FindId(const csmChar* id) const
+CubismId* CubismIdManager::FindId(const csmChar* id, csmInt32 length, csmInt32 hashcode) const
 {
-    for (csmUint32 i = 0; i < _ids.GetSize(); ++i)
+    if (_table.GetSize() == 0)
     {
-        if (_ids[i]->GetString() == id)
+        return NULL;
+    }
+
+    const csmUint32 mask = _table.GetSize() - 1;
+
+    for (csmUint32 slot = GetTableSlot(hashcode, mask); _table[slot] != NULL; slot = (slot + 1) & mask)
+    {
+        const csmString& name = _table[slot]->GetString();
+
+        if (name.GetHashcode() == hashcode && name.GetLength() == length && strcmp(name.GetRawString(), id) == 0)
         {
-            return _ids[i];
+            return _table[slot];
         }
     }
 
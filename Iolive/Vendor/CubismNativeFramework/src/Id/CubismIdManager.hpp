@@ -10,6 +10,7 @@
 #include "Type/CubismBasicType.hpp"
 #include "Type/csmString.hpp"
 #include "Type/csmVector.hpp"
+#include <mutex>
 
 namespace Live2D { namespace Cubism { namespace Framework {
 
@@ -127,12 +128,31 @@ private:
      *
      * ID名からIDを検索する。
      *
-     * @param[in]   id  ID名
+     * @param[in]   id          ID名
+     * @param[in]   length      ID名の長さ
+     * @param[in]   hashcode    csmString::CalcHashcode() of the name
      * @return  登録されているID。なければNULL。
+     * @note    _mutex must be held
+     */
+    CubismId* FindId(const csmChar* id, csmInt32 length, csmInt32 hashcode) const;
+
+    /**
+     * @brief ID名を登録
+     *
+     * Same as RegisterId() with the hash code already known.
+     */
+    const CubismId* RegisterId(const csmChar* id, csmInt32 length, csmInt32 hashcode);
+
+    /**
+     * @brief Add an ID to the hash table, growing it when half full
+     *
+     * @note    _mutex must be held
      */
-    CubismId* FindId(const csmChar* id) const;
+    void InsertId(CubismId* id);
 
     csmVector<CubismId*> _ids;      ///< 登録されているIDのリスト
+    csmVector<CubismId*> _table;    ///< open addressing table of _ids by hash code, size is a power of two
+    mutable std::mutex   _mutex;    ///< guards _ids & _table, motions and the moc are loaded from several threads
 };
 
 }}}
@@ -22,6 +22,7 @@ CubismModel::CubismModel(Core::csmModel* model)
     , _parameterValues(NULL)
     , _parameterMaximumValues(NULL)
     , _parameterMinimumValues(NULL)
+    , _parameterCount(0)
     , _partOpacities(NULL)
 { }
 
@@ -181,7 +182,8 @@ csmInt32 CubismModel::GetParameterIndex(CubismIdHandle parameterId)
 
 csmFloat32 CubismModel::GetParameterValue(csmInt32 parameterIndex)
 {
-    if (_notExistParameterValues.IsExist(parameterIndex))
+    // not-exist parameters are always indexed past the model parameters, skip the map lookup for the rest
+    if (parameterIndex >= _parameterCount && _notExistParameterValues.IsExist(parameterIndex))
     {
         return _notExistParameterValues[parameterIndex];
     }
@@ -194,7 +196,7 @@ csmFloat32 CubismModel::GetParameterValue(csmInt32 parameterIndex)
 
 void CubismModel::SetParameterValue(csmInt32 parameterIndex, csmFloat32 value, csmFloat32 weight)
 {
-    if (_notExistParameterValues.IsExist(parameterIndex))
+    if (parameterIndex >= _parameterCount && _notExistParameterValues.IsExist(parameterIndex))
     {
         _notExistParameterValues[parameterIndex] = (weight == 1)
                                                          ? value
@@ -206,13 +208,13 @@ void CubismModel::SetParameterValue(csmInt32 parameterIndex, csmFloat32 value, c
     //インデックスの範囲内検知
     CSM_ASSERT(0 <= parameterIndex && parameterIndex < GetParameterCount());
 
-    if (Core::csmGetParameterMaximumValues(_model)[parameterIndex] < value)
+    if (_parameterMaximumValues[parameterIndex] < value)
     {
-        value = Core::csmGetParameterMaximumValues(_model)[parameterIndex];
+        value = _parameterMaximumValues[parameterIndex];
     }
-    if (Core::csmGetParameterMinimumValues(_model)[parameterIndex] > value)
+    if (_parameterMinimumValues[parameterIndex] > value)
     {
-        value = Core::csmGetParameterMinimumValues(_model)[parameterIndex];
+        value = _parameterMinimumValues[parameterIndex];
     }
 
     _parameterValues[parameterIndex] = (weight == 1)
@@ -363,6 +365,7 @@ void CubismModel::Initialize()
         const csmChar** parameterIds = Core::csmGetParameterIds(_model);
         const csmInt32  parameterCount = Core::csmGetParameterCount(_model);
 
+        _parameterCount = parameterCount;
         _parameterIds.PrepareCapacity(parameterCount);
         for (csmInt32 i = 0; i < parameterCount; ++i)
         {
@@ -540,27 +543,24 @@ void CubismModel::LoadParameters()
         parameterCount = savedParameterCount;
     }
 
-    for (csmInt32 i = 0; i < parameterCount; ++i)
+    if (parameterCount > 0)
     {
-        _parameterValues[i] = _savedParameters[i];
+        memcpy(_parameterValues, _savedParameters.GetPtr(), sizeof(csmFloat32) * parameterCount);
     }
 }
 
 void CubismModel::SaveParameters()
 {
     const csmInt32 parameterCount = Core::csmGetParameterCount(_model);
-    const csmInt32 savedParameterCount = static_cast<csmInt32>(_savedParameters.GetSize());
 
-    for (csmInt32 i = 0; i < parameterCount; ++i)
+    if (static_cast<csmInt32>(_savedParameters.GetSize()) != parameterCount)
     {
-        if (i < savedParameterCount)
-        {
-            _savedParameters[i] = _parameterValues[i];
-        }
-        else
-        {
-            _savedParameters.PushBack(_parameterValues[i], false);
-        }
+        _savedParameters.UpdateSize(parameterCount, 0.0f, false);
+    }
+
+    if (parameterCount > 0)
+    {
+        memcpy(_savedParameters.GetPtr(), _parameterValues, sizeof(csmFloat32) * parameterCount);
     }
 }
 
@@ -579,6 +579,7 @@ private:
     csmFloat32*         _parameterValues;                       ///< パラメータの値のリスト
     const csmFloat32*   _parameterMaximumValues;                ///< パラメータの最大値のリスト
     const csmFloat32*   _parameterMinimumValues;                ///< パラメータの最小値のリスト
+    csmInt32            _parameterCount;                        ///< parameter count, indices past it are not-exist parameters
 
     csmFloat32*         _partOpacities;                         ///< パーツの不透明度のリスト
 
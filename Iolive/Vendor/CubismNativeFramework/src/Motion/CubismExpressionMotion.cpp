@@ -25,6 +25,7 @@ const csmFloat32 DefaultFadeTime = 1.0f;
 }
 
 CubismExpressionMotion::CubismExpressionMotion()
+    : _boundModel(NULL)
 { }
 
 CubismExpressionMotion::~CubismExpressionMotion()
@@ -88,22 +89,35 @@ CubismExpressionMotion* CubismExpressionMotion::Create(const csmByte* buffer, cs
 
 void CubismExpressionMotion::DoUpdateParameters(CubismModel* model, csmFloat32 userTimeSeconds, csmFloat32 weight, CubismMotionQueueEntry* motionQueueEntry)
 {
+    // resolve the parameter ids once per model
+    if (_boundModel != model)
+    {
+        _parameterIndices.Clear();
+        _parameterIndices.PrepareCapacity(_parameters.GetSize());
+        for (csmUint32 i = 0; i < _parameters.GetSize(); ++i)
+        {
+            _parameterIndices.PushBack(model->GetParameterIndex(_parameters[i].ParameterId));
+        }
+        _boundModel = model;
+    }
+
     for (csmUint32 i = 0; i < _parameters.GetSize(); ++i)
     {
         ExpressionParameter& parameter = _parameters[i];
+        const csmInt32 parameterIndex = _parameterIndices[i];
 
         switch (parameter.BlendType)
         {
         case ExpressionBlendType_Add: {
-            model->AddParameterValue(parameter.ParameterId, parameter.Value, weight);            // 相対変化 加算
+            model->AddParameterValue(parameterIndex, parameter.Value, weight);            // 相対変化 加算
             break;
         }
         case ExpressionBlendType_Multiply: {
-            model->MultiplyParameterValue(parameter.ParameterId, parameter.Value, weight);       // 相対変化 乗算
+            model->MultiplyParameterValue(parameterIndex, parameter.Value, weight);       // 相対変化 乗算
             break;
         }
         case ExpressionBlendType_Overwrite: {
-            model->SetParameterValue(parameter.ParameterId, parameter.Value, weight);            // 絶対変化 上書き
+            model->SetParameterValue(parameterIndex, parameter.Value, weight);            // 絶対変化 上書き
             break;
         }
         default:
@@ -73,6 +73,9 @@ private:
     virtual ~CubismExpressionMotion();
 
     csmVector<ExpressionParameter> _parameters;         ///< 表情のパラメータ情報リスト
+
+    CubismModel*            _boundModel;                ///< model _parameterIndices is resolved for, NULL = not bound
+    csmVector<csmInt32>     _parameterIndices;          ///< model parameter index per expression parameter
 };
 
 }}}
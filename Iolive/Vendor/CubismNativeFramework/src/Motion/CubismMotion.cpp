@@ -9,6 +9,7 @@
 #include <float.h>
 #include "CubismFramework.hpp"
 #include "CubismMotionInternal.hpp"
+#include "CubismMotionBinary.hpp"
 #include "CubismMotionJson.hpp"
 #include "CubismMotionQueueManager.hpp"
 #include "CubismMotionQueueEntry.hpp"
@@ -77,41 +78,142 @@ csmFloat32 InverseSteppedEvaluate(const CubismMotionPoint* points, const csmFloa
     return points[1].Value;
 }
 
-csmFloat32 EvaluateCurve(const CubismMotionData* motionData, const csmInt32 index, csmFloat32 time)
+// indexed by CubismMotionSegmentType
+const csmMotionSegmentEvaluationFunction SegmentEvaluators[] =
 {
-    // Find segment to evaluate.
-    const CubismMotionCurve& curve = motionData->Curves[index];
+    LinearEvaluate,
+    BezierEvaluate,
+    SteppedEvaluate,
+    InverseSteppedEvaluate,
+};
+
+csmUint32 AppendString(csmVector<csmByte>& strings, const csmString& value)
+{
+    const csmUint32 offset = strings.GetSize();
+    const csmChar* raw = value.GetRawString();
+
+    for (csmInt32 i = 0; i < value.GetLength(); ++i)
+    {
+        strings.PushBack(static_cast<csmByte>(raw[i]));
+    }
+    strings.PushBack(0);
+
+    return offset;
+}
+
+csmFloat32 EvaluateSegment(const CubismMotionData* motionData, const CubismMotionSegment& segment, const csmFloat32 time)
+{
+    const CubismMotionPoint* points = &motionData->Points[segment.BasePointIndex];
+
+    // dispatch on the type so the evaluators can be inlined
+    switch (segment.SegmentType)
+    {
+    case CubismMotionSegmentType_Linear:
+        return LinearEvaluate(points, time);
+    case CubismMotionSegmentType_Bezier:
+        return BezierEvaluate(points, time);
+    case CubismMotionSegmentType_Stepped:
+        return SteppedEvaluate(points, time);
+    case CubismMotionSegmentType_InverseStepped:
+        return InverseSteppedEvaluate(points, time);
+    default:
+        return segment.Evaluate(points, time);
+    }
+}
+
+csmInt32 GetSegmentLastPointIndex(const CubismMotionData* motionData, const csmInt32 segmentIndex)
+{
+    const CubismMotionSegment& segment = motionData->Segments[segmentIndex];
+
+    return segment.BasePointIndex + (segment.SegmentType == CubismMotionSegmentType_Bezier ? 3 : 1);
+}
+
+csmFloat32 GetSegmentEndTime(const CubismMotionData* motionData, const csmInt32 segmentIndex)
+{
+    return motionData->Points[GetSegmentLastPointIndex(motionData, segmentIndex)].Time;
+}
+
+/**
+ * @brief Find the first segment of a curve that ends after time
+ *
+ * Playback time only moves forward between loops, so the segment is almost always
+ * the cached one or the next one. Anything else (loop, seek) falls back to a binary search.
+ *
+ * @param[in]       motionData  motion data
+ * @param[in]       curve       curve to search
+ * @param[in]       time        time [s]
+ * @param[in,out]   cursor      segment found last time, relative to the curve
+ * @return  segment index relative to the curve, curve.SegmentCount when time is past the last segment
+ */
+csmInt32 FindSegment(const CubismMotionData* motionData, const CubismMotionCurve& curve, const csmFloat32 time, csmInt32& cursor)
+{
+    const csmInt32 base = curve.BaseSegmentIndex;
+    const csmInt32 count = curve.SegmentCount;
 
-    csmInt32 target = -1;
-    const csmInt32 totalSegmentCount = curve.BaseSegmentIndex + curve.SegmentCount;
-    csmInt32 pointPosition = 0;
-    for (csmInt32 i = curve.BaseSegmentIndex; i < totalSegmentCount; ++i)
+    csmInt32 i = (cursor < 0 || cursor >= count) ? 0 : cursor;
+    csmInt32 low, high;
+
+    if (GetSegmentEndTime(motionData, base + i) > time)
     {
-        // Get first point of next segment.
-        pointPosition = motionData->Segments[i].BasePointIndex
-            + (motionData->Segments[i].SegmentType == CubismMotionSegmentType_Bezier
-                ? 3
-                : 1);
+        if (i == 0 || GetSegmentEndTime(motionData, base + i - 1) <= time)
+        {
+            cursor = i;
+            return i;
+        }
 
+        // went backward
+        low = 0;
+        high = i;
+    }
+    else
+    {
+        // went forward, try the next segment first
+        low = i + 1;
+        high = count;
 
-        // Break if time lies within current segment.
-        if (motionData->Points[pointPosition].Time > time)
+        if (low < count && GetSegmentEndTime(motionData, base + low) > time)
         {
-            target = i;
-            break;
+            cursor = low;
+            return low;
         }
     }
 
+    while (low < high)
+    {
+        const csmInt32 middle = low + (high - low) / 2;
+
+        if (GetSegmentEndTime(motionData, base + middle) > time)
+        {
+            high = middle;
+        }
+        else
+        {
+            low = middle + 1;
+        }
+    }
 
-    if (target == -1)
+    cursor = (low < count) ? low : count - 1;
+    return low;
+}
+
+csmFloat32 EvaluateCurve(const CubismMotionData* motionData, const csmInt32 index, csmFloat32 time, csmInt32& cursor)
+{
+    // Find segment to evaluate.
+    const CubismMotionCurve& curve = motionData->Curves[index];
+
+    if (curve.SegmentCount <= 0)
     {
-        return motionData->Points[pointPosition].Value;
+        return motionData->Points[0].Value;
     }
 
+    const csmInt32 target = FindSegment(motionData, curve, time, cursor);
 
-    const CubismMotionSegment& segment = motionData->Segments[target];
+    if (target == curve.SegmentCount)
+    {
+        return motionData->Points[GetSegmentLastPointIndex(motionData, curve.BaseSegmentIndex + target - 1)].Value;
+    }
 
-    return segment.Evaluate(&motionData->Points[segment.BasePointIndex], time);
+    return EvaluateSegment(motionData, motionData->Segments[curve.BaseSegmentIndex + target], time);
 }
 
 }
@@ -125,6 +227,9 @@ CubismMotion::CubismMotion()
     , _motionData(NULL)
     , _modelCurveIdEyeBlink(NULL)
     , _modelCurveIdLipSync(NULL)
+    , _boundModel(NULL)
+    , _eyeBlinkCurveIndex(-1)
+    , _lipSyncCurveIndex(-1)
 { }
 
 CubismMotion::~CubismMotion()
@@ -136,7 +241,19 @@ CubismMotion* CubismMotion::Create(const csmByte* buffer, csmSizeInt size, Finis
 {
     CubismMotion* ret = CSM_NEW CubismMotion();
 
-    ret->Parse(buffer, size);
+    if (IsBinary(buffer, size))
+    {
+        if (!ret->ParseBinary(buffer, size))
+        {
+            CubismLogError("Invalid binary motion.");
+            ACubismMotion::Delete(ret);
+            return NULL;
+        }
+    }
+    else
+    {
+        ret->Parse(buffer, size);
+    }
     ret->_sourceFrameRate = ret->_motionData->Fps;
     ret->_loopDurationSeconds = ret->_motionData->Duration;
     ret->_onFinishedMotion = onFinishedMotionHandler;
@@ -152,7 +269,10 @@ csmFloat32 CubismMotion::GetDuration()
     return _isLoop ? -1.0f : _loopDurationSeconds;
 }
 
-void CubismMotion::DoUpdateParameters(CubismModel* model, csmFloat32 userTimeSeconds, csmFloat32 fadeWeight, CubismMotionQueueEntry* motionQueueEntry)
+//まばたき、リップシンクのうちモーションの適用を検出するためのビット（maxFlagCount個まで
+static const csmUint32 MaxTargetSize = 64;
+
+void CubismMotion::BindModel(CubismModel* model)
 {
     if (_modelCurveIdEyeBlink == NULL)
     {
@@ -164,6 +284,99 @@ void CubismMotion::DoUpdateParameters(CubismModel* model, csmFloat32 userTimeSec
         _modelCurveIdLipSync = CubismFramework::GetIdManager()->GetId(EffectNameLipSync);
     }
 
+    //瞬き、リップシンクのターゲット数が上限を超えている場合
+    if (_eyeBlinkParameterIds.GetSize() > MaxTargetSize)
+    {
+        CubismLogDebug("too many eye blink targets : %d", _eyeBlinkParameterIds.GetSize());
+    }
+    if (_lipSyncParameterIds.GetSize() > MaxTargetSize)
+    {
+        CubismLogDebug("too many lip sync targets : %d", _lipSyncParameterIds.GetSize());
+    }
+
+    const csmUint32 eyeBlinkCount = (_eyeBlinkParameterIds.GetSize() < MaxTargetSize) ? _eyeBlinkParameterIds.GetSize() : MaxTargetSize;
+    const csmUint32 lipSyncCount = (_lipSyncParameterIds.GetSize() < MaxTargetSize) ? _lipSyncParameterIds.GetSize() : MaxTargetSize;
+
+    _eyeBlinkParameterIndices.Clear();
+    _eyeBlinkParameterIndices.PrepareCapacity(eyeBlinkCount);
+    for (csmUint32 i = 0; i < eyeBlinkCount; ++i)
+    {
+        _eyeBlinkParameterIndices.PushBack(model->GetParameterIndex(_eyeBlinkParameterIds[i]));
+    }
+
+    _lipSyncParameterIndices.Clear();
+    _lipSyncParameterIndices.PrepareCapacity(lipSyncCount);
+    for (csmUint32 i = 0; i < lipSyncCount; ++i)
+    {
+        _lipSyncParameterIndices.PushBack(model->GetParameterIndex(_lipSyncParameterIds[i]));
+    }
+
+    const csmInt32 curveCount = _motionData->CurveCount;
+    _curveParameterIndices.UpdateSize(curveCount, -1, false);
+    _curveEyeBlinkMasks.UpdateSize(curveCount, 0ULL, false);
+    _curveLipSyncMasks.UpdateSize(curveCount, 0ULL, false);
+    _eyeBlinkCurveIndex = -1;
+    _lipSyncCurveIndex = -1;
+
+    for (csmInt32 c = 0; c < curveCount; ++c)
+    {
+        const CubismMotionCurve& curve = _motionData->Curves[c];
+
+        _curveParameterIndices[c] = -1;
+        _curveEyeBlinkMasks[c] = 0ULL;
+        _curveLipSyncMasks[c] = 0ULL;
+
+        if (curve.Type == CubismMotionCurveTarget_Model)
+        {
+            // the last curve wins, same as evaluating them in order
+            if (curve.Id == _modelCurveIdEyeBlink)
+            {
+                _eyeBlinkCurveIndex = c;
+            }
+            else if (curve.Id == _modelCurveIdLipSync)
+            {
+                _lipSyncCurveIndex = c;
+            }
+            continue;
+        }
+
+        _curveParameterIndices[c] = model->GetParameterIndex(curve.Id);
+
+        if (curve.Type != CubismMotionCurveTarget_Parameter)
+        {
+            continue;
+        }
+
+        // only the first matching target is applied
+        for (csmUint32 i = 0; i < eyeBlinkCount; ++i)
+        {
+            if (_eyeBlinkParameterIds[i] == curve.Id)
+            {
+                _curveEyeBlinkMasks[c] = 1ULL << i;
+                break;
+            }
+        }
+
+        for (csmUint32 i = 0; i < lipSyncCount; ++i)
+        {
+            if (_lipSyncParameterIds[i] == curve.Id)
+            {
+                _curveLipSyncMasks[c] = 1ULL << i;
+                break;
+            }
+        }
+    }
+
+    _boundModel = model;
+}
+
+void CubismMotion::DoUpdateParameters(CubismModel* model, csmFloat32 userTimeSeconds, csmFloat32 fadeWeight, CubismMotionQueueEntry* motionQueueEntry)
+{
+    if (_boundModel != model)
+    {
+        BindModel(model);
+    }
+
     csmFloat32 timeOffsetSeconds = userTimeSeconds - motionQueueEntry->GetStartTime();
 
     if (timeOffsetSeconds < 0.0f)
@@ -174,21 +387,9 @@ void CubismMotion::DoUpdateParameters(CubismModel* model, csmFloat32 userTimeSec
     csmFloat32 lipSyncValue = FLT_MAX;
     csmFloat32 eyeBlinkValue = FLT_MAX;
 
-    //まばたき、リップシンクのうちモーションの適用を検出するためのビット（maxFlagCount個まで
-    const csmInt32 MaxTargetSize = 64;
     csmUint64 lipSyncFlags = 0ULL;
     csmUint64 eyeBlinkFlags = 0ULL;
 
-    //瞬き、リップシンクのターゲット数が上限を超えている場合
-    if (_eyeBlinkParameterIds.GetSize() > MaxTargetSize)
-    {
-        CubismLogDebug("too many eye blink targets : %d", _eyeBlinkParameterIds.GetSize());
-    }
-    if (_lipSyncParameterIds.GetSize() > MaxTargetSize)
-    {
-        CubismLogDebug("too many lip sync targets : %d", _lipSyncParameterIds.GetSize());
-    }
-
     const csmFloat32 tmpFadeIn = (_fadeInSeconds <= 0.0f)
                                      ? 1.0f
                                      : CubismMath::GetEasingSine((userTimeSeconds - motionQueueEntry->GetFadeInStartTime()) / _fadeInSeconds);
@@ -213,30 +414,32 @@ void CubismMotion::DoUpdateParameters(CubismModel* model, csmFloat32 userTimeSec
 
     csmVector<CubismMotionCurve>& curves = _motionData->Curves;
 
-    // Evaluate model curves.
-    for (c = 0; c < _motionData->CurveCount && curves[c].Type == CubismMotionCurveTarget_Model; ++c)
+    // segment cursors of this entry, one per curve
+    csmVector<csmInt32>& cursors = motionQueueEntry->_curveCursors;
+    if (cursors.GetSize() != static_cast<csmUint32>(_motionData->CurveCount))
     {
-        // Evaluate curve and call handler.
-        value = EvaluateCurve(_motionData, c, time);
+        cursors.UpdateSize(_motionData->CurveCount, 0, true);
+    }
 
-        if (curves[c].Id == _modelCurveIdEyeBlink)
-        {
-            eyeBlinkValue = value;
-        }
-        else if (curves[c].Id == _modelCurveIdLipSync)
-        {
-            lipSyncValue = value;
-        }
+    // Evaluate model curves, only the eye blink and lip sync ones are used.
+    if (_eyeBlinkCurveIndex != -1)
+    {
+        eyeBlinkValue = EvaluateCurve(_motionData, _eyeBlinkCurveIndex, time, cursors[_eyeBlinkCurveIndex]);
+    }
+    if (_lipSyncCurveIndex != -1)
+    {
+        lipSyncValue = EvaluateCurve(_motionData, _lipSyncCurveIndex, time, cursors[_lipSyncCurveIndex]);
     }
 
-    csmInt32 parameterMotionCurveCount = 0;
+    c = 0;
+    while (c < _motionData->CurveCount && curves[c].Type == CubismMotionCurveTarget_Model)
+    {
+        ++c;
+    }
 
     for (; c < _motionData->CurveCount && curves[c].Type == CubismMotionCurveTarget_Parameter; ++c)
     {
-        parameterMotionCurveCount++;
-
-        // Find parameter index.
-        parameterIndex = model->GetParameterIndex(curves[c].Id);
+        parameterIndex = _curveParameterIndices[c];
 
         // Skip curve evaluation if no value in sink.
         if (parameterIndex == -1)
@@ -247,32 +450,18 @@ void CubismMotion::DoUpdateParameters(CubismModel* model, csmFloat32 userTimeSec
         const csmFloat32 sourceValue = model->GetParameterValue(parameterIndex);
 
         // Evaluate curve and apply value.
-        value = EvaluateCurve(_motionData, c, time);
+        value = EvaluateCurve(_motionData, c, time, cursors[c]);
 
-        if (eyeBlinkValue != FLT_MAX)
+        if (eyeBlinkValue != FLT_MAX && _curveEyeBlinkMasks[c] != 0ULL)
         {
-            for (csmUint32 i = 0; i < _eyeBlinkParameterIds.GetSize() && i < MaxTargetSize; ++i)
-            {
-                if (_eyeBlinkParameterIds[i] == curves[c].Id)
-                {
-                    value *= eyeBlinkValue;
-                    eyeBlinkFlags |= 1ULL << i;
-                    break;
-                }
-            }
+            value *= eyeBlinkValue;
+            eyeBlinkFlags |= _curveEyeBlinkMasks[c];
         }
 
-        if (lipSyncValue != FLT_MAX)
+        if (lipSyncValue != FLT_MAX && _curveLipSyncMasks[c] != 0ULL)
         {
-            for (csmUint32 i = 0; i < _lipSyncParameterIds.GetSize() && i < MaxTargetSize; ++i)
-            {
-                if (_lipSyncParameterIds[i] == curves[c].Id)
-                {
-                    value += lipSyncValue;
-                    lipSyncFlags |= 1ULL << i;
-                    break;
-                }
-            }
+            value += lipSyncValue;
+            lipSyncFlags |= _curveLipSyncMasks[c];
         }
 
         csmFloat32 v;
@@ -322,9 +511,9 @@ void CubismMotion::DoUpdateParameters(CubismModel* model, csmFloat32 userTimeSec
     {
         if (eyeBlinkValue != FLT_MAX)
         {
-            for (csmUint32 i = 0; i < _eyeBlinkParameterIds.GetSize() && i < MaxTargetSize; ++i)
+            for (csmUint32 i = 0; i < _eyeBlinkParameterIndices.GetSize(); ++i)
             {
-                const csmFloat32 sourceValue = model->GetParameterValue(_eyeBlinkParameterIds[i]);
+                const csmFloat32 sourceValue = model->GetParameterValue(_eyeBlinkParameterIndices[i]);
                 //モーションでの上書きがあった時にはまばたきは適用しない
                 if ((eyeBlinkFlags >> i) & 0x01)
                 {
@@ -333,15 +522,15 @@ void CubismMotion::DoUpdateParameters(CubismModel* model, csmFloat32 userTimeSec
 
                 const csmFloat32 v = sourceValue + (eyeBlinkValue - sourceValue) * fadeWeight;
 
-                model->SetParameterValue(_eyeBlinkParameterIds[i], v);
+                model->SetParameterValue(_eyeBlinkParameterIndices[i], v);
             }
         }
 
         if (lipSyncValue != FLT_MAX)
         {
-            for (csmUint32 i = 0; i < _lipSyncParameterIds.GetSize() && i < MaxTargetSize; ++i)
+            for (csmUint32 i = 0; i < _lipSyncParameterIndices.GetSize(); ++i)
             {
-                const csmFloat32 sourceValue = model->GetParameterValue(_lipSyncParameterIds[i]);
+                const csmFloat32 sourceValue = model->GetParameterValue(_lipSyncParameterIndices[i]);
                 //モーションでの上書きがあった時にはリップシンクは適用しない
                 if ((lipSyncFlags >> i) & 0x01)
                 {
@@ -350,15 +539,14 @@ void CubismMotion::DoUpdateParameters(CubismModel* model, csmFloat32 userTimeSec
 
                 const csmFloat32 v = sourceValue + (lipSyncValue - sourceValue) * fadeWeight;
 
-                model->SetParameterValue(_lipSyncParameterIds[i], v);
+                model->SetParameterValue(_lipSyncParameterIndices[i], v);
             }
         }
     }
 
     for (; c < _motionData->CurveCount && curves[c].Type == CubismMotionCurveTarget_PartOpacity; ++c)
     {
-        // Find parameter index.
-        parameterIndex = model->GetParameterIndex(curves[c].Id);
+        parameterIndex = _curveParameterIndices[c];
 
         // Skip curve evaluation if no value in sink.
         if (parameterIndex == -1)
@@ -367,7 +555,7 @@ void CubismMotion::DoUpdateParameters(CubismModel* model, csmFloat32 userTimeSec
         }
 
         // Evaluate curve and apply value.
-        value = EvaluateCurve(_motionData, c, time);
+        value = EvaluateCurve(_motionData, c, time, cursors[c]);
 
         model->SetParameterValue(parameterIndex, value);
     }
@@ -565,6 +753,225 @@ void CubismMotion::Parse(const csmByte* motionJson, const csmSizeInt size)
     CSM_DELETE(json);
 }
 
+csmBool CubismMotion::IsBinary(const csmByte* buffer, csmSizeInt size)
+{
+    if (buffer == NULL || size < sizeof(CubismMotionBinaryHeader))
+    {
+        return false;
+    }
+
+    CubismMotionBinaryHeader header;
+    memcpy(&header, buffer, sizeof(header));
+
+    return header.Magic == CubismMotionBinaryMagic && header.Version == CubismMotionBinaryVersion;
+}
+
+csmBool CubismMotion::ParseBinary(const csmByte* buffer, const csmSizeInt size)
+{
+    _motionData = CSM_NEW CubismMotionData;
+
+    CubismMotionBinaryHeader header;
+    memcpy(&header, buffer, sizeof(header));
+
+    if (header.Size != size
+        || header.CurveCount < 0 || header.CurveCount > 0x7FFF
+        || header.SegmentCount < 0 || header.PointCount < 0 || header.EventCount < 0)
+    {
+        return false;
+    }
+
+    // block offsets, counts are checked first so none of these overflow
+    const csmSizeInt curvesOffset = sizeof(CubismMotionBinaryHeader);
+    const csmSizeInt segmentsOffset = curvesOffset + sizeof(CubismMotionBinaryCurve) * header.CurveCount;
+    const csmSizeInt pointsOffset = segmentsOffset + sizeof(CubismMotionBinarySegment) * header.SegmentCount;
+    const csmSizeInt eventsOffset = pointsOffset + sizeof(CubismMotionPoint) * header.PointCount;
+    const csmSizeInt stringsOffset = eventsOffset + sizeof(CubismMotionBinaryEvent) * header.EventCount;
+
+    if (header.CurveCount > static_cast<csmInt32>(size / sizeof(CubismMotionBinaryCurve))
+        || header.SegmentCount > static_cast<csmInt32>(size / sizeof(CubismMotionBinarySegment))
+        || header.PointCount > static_cast<csmInt32>(size / sizeof(CubismMotionPoint))
+        || header.EventCount > static_cast<csmInt32>(size / sizeof(CubismMotionBinaryEvent))
+        || stringsOffset + header.StringSize != size)
+    {
+        return false;
+    }
+
+    const csmChar* strings = reinterpret_cast<const csmChar*>(buffer + stringsOffset);
+    if (header.StringSize > 0 && strings[header.StringSize - 1] != '\0')
+    {
+        return false;
+    }
+
+    _motionData->Duration = header.Duration;
+    _motionData->Loop = static_cast<csmInt16>(header.Loop);
+    _motionData->CurveCount = static_cast<csmInt16>(header.CurveCount);
+    _motionData->Fps = header.Fps;
+    _motionData->EventCount = header.EventCount;
+    _fadeInSeconds = header.FadeInSeconds;
+    _fadeOutSeconds = header.FadeOutSeconds;
+
+    _motionData->Curves.UpdateSize(header.CurveCount, CubismMotionCurve(), true);
+    _motionData->Segments.UpdateSize(header.SegmentCount, CubismMotionSegment(), true);
+    _motionData->Points.UpdateSize(header.PointCount, CubismMotionPoint(), true);
+    _motionData->Events.UpdateSize(header.EventCount, CubismMotionEvent(), true);
+
+    // Points have the same layout in memory and in the file
+    if (header.PointCount > 0)
+    {
+        memcpy(_motionData->Points.GetPtr(), buffer + pointsOffset, sizeof(CubismMotionPoint) * header.PointCount);
+    }
+
+    for (csmInt32 i = 0; i < header.SegmentCount; ++i)
+    {
+        CubismMotionBinarySegment source;
+        memcpy(&source, buffer + segmentsOffset + sizeof(source) * i, sizeof(source));
+
+        if (source.SegmentType < CubismMotionSegmentType_Linear || source.SegmentType > CubismMotionSegmentType_InverseStepped
+            || source.BasePointIndex < 0
+            || source.BasePointIndex + (source.SegmentType == CubismMotionSegmentType_Bezier ? 3 : 1) >= header.PointCount)
+        {
+            return false;
+        }
+
+        CubismMotionSegment& segment = _motionData->Segments[i];
+        segment.BasePointIndex = source.BasePointIndex;
+        segment.SegmentType = source.SegmentType;
+        segment.Evaluate = SegmentEvaluators[source.SegmentType];
+    }
+
+    for (csmInt32 i = 0; i < header.CurveCount; ++i)
+    {
+        CubismMotionBinaryCurve source;
+        memcpy(&source, buffer + curvesOffset + sizeof(source) * i, sizeof(source));
+
+        if (source.Type < CubismMotionCurveTarget_Model || source.Type > CubismMotionCurveTarget_PartOpacity
+            || source.IdOffset >= header.StringSize
+            || source.BaseSegmentIndex < 0 || source.SegmentCount < 0
+            || source.SegmentCount > header.SegmentCount - source.BaseSegmentIndex)
+        {
+            return false;
+        }
+
+        CubismMotionCurve& curve = _motionData->Curves[i];
+        curve.Type = static_cast<CubismMotionCurveTarget>(source.Type);
+        curve.Id = CubismFramework::GetIdManager()->GetId(strings + source.IdOffset);
+        curve.BaseSegmentIndex = source.BaseSegmentIndex;
+        curve.SegmentCount = source.SegmentCount;
+        curve.FadeInTime = source.FadeInTime;
+        curve.FadeOutTime = source.FadeOutTime;
+    }
+
+    for (csmInt32 i = 0; i < header.EventCount; ++i)
+    {
+        CubismMotionBinaryEvent source;
+        memcpy(&source, buffer + eventsOffset + sizeof(source) * i, sizeof(source));
+
+        if (source.ValueOffset >= header.StringSize)
+        {
+            return false;
+        }
+
+        _motionData->Events[i].FireTime = source.FireTime;
+        _motionData->Events[i].Value = strings + source.ValueOffset;
+    }
+
+    return true;
+}
+
+void CubismMotion::WriteBinary(csmVector<csmByte>& buffer) const
+{
+    CubismMotionBinaryHeader header;
+    header.Magic = CubismMotionBinaryMagic;
+    header.Version = CubismMotionBinaryVersion;
+    header.Duration = _motionData->Duration;
+    header.Fps = _motionData->Fps;
+    header.FadeInSeconds = _fadeInSeconds;
+    header.FadeOutSeconds = _fadeOutSeconds;
+    header.Loop = _motionData->Loop;
+    header.CurveCount = _motionData->CurveCount;
+    header.SegmentCount = _motionData->Segments.GetSize();
+    header.PointCount = _motionData->Points.GetSize();
+    header.EventCount = _motionData->Events.GetSize();
+
+    csmVector<csmByte> strings;
+    csmVector<CubismMotionBinaryCurve> curves;
+    csmVector<CubismMotionBinarySegment> segments;
+    csmVector<CubismMotionBinaryEvent> events;
+
+    curves.PrepareCapacity(header.CurveCount);
+    for (csmInt32 i = 0; i < header.CurveCount; ++i)
+    {
+        const CubismMotionCurve& source = _motionData->Curves[i];
+
+        CubismMotionBinaryCurve curve;
+        curve.Type = source.Type;
+        curve.IdOffset = AppendString(strings, source.Id->GetString());
+        curve.BaseSegmentIndex = source.BaseSegmentIndex;
+        curve.SegmentCount = source.SegmentCount;
+        curve.FadeInTime = source.FadeInTime;
+        curve.FadeOutTime = source.FadeOutTime;
+        curves.PushBack(curve);
+    }
+
+    segments.PrepareCapacity(header.SegmentCount);
+    for (csmInt32 i = 0; i < header.SegmentCount; ++i)
+    {
+        CubismMotionBinarySegment segment;
+        segment.BasePointIndex = _motionData->Segments[i].BasePointIndex;
+        segment.SegmentType = _motionData->Segments[i].SegmentType;
+        segments.PushBack(segment);
+    }
+
+    events.PrepareCapacity(header.EventCount);
+    for (csmInt32 i = 0; i < header.EventCount; ++i)
+    {
+        CubismMotionBinaryEvent event;
+        event.FireTime = _motionData->Events[i].FireTime;
+        event.ValueOffset = AppendString(strings, _motionData->Events[i].Value);
+        events.PushBack(event);
+    }
+
+    header.StringSize = strings.GetSize();
+
+    const csmSizeInt curvesSize = sizeof(CubismMotionBinaryCurve) * header.CurveCount;
+    const csmSizeInt segmentsSize = sizeof(CubismMotionBinarySegment) * header.SegmentCount;
+    const csmSizeInt pointsSize = sizeof(CubismMotionPoint) * header.PointCount;
+    const csmSizeInt eventsSize = sizeof(CubismMotionBinaryEvent) * header.EventCount;
+    header.Size = static_cast<csmUint32>(sizeof(header) + curvesSize + segmentsSize + pointsSize + eventsSize + header.StringSize);
+
+    buffer.Clear();
+    buffer.UpdateSize(header.Size, 0, false);
+
+    csmByte* write = buffer.GetPtr();
+    memcpy(write, &header, sizeof(header));
+    write += sizeof(header);
+
+    if (curvesSize > 0)
+    {
+        memcpy(write, curves.GetPtr(), curvesSize);
+        write += curvesSize;
+    }
+    if (segmentsSize > 0)
+    {
+        memcpy(write, segments.GetPtr(), segmentsSize);
+        write += segmentsSize;
+    }
+    if (pointsSize > 0)
+    {
+        memcpy(write, _motionData->Points.GetPtr(), pointsSize);
+        write += pointsSize;
+    }
+    if (eventsSize > 0)
+    {
+        memcpy(write, events.GetPtr(), eventsSize);
+        write += eventsSize;
+    }
+    if (header.StringSize > 0)
+    {
+        memcpy(write, strings.GetPtr(), header.StringSize);
+    }
+}
+
 void CubismMotion::SetParameterFadeInTime(CubismIdHandle parameterId, csmFloat32 value)
 {
     csmVector<CubismMotionCurve>& curves = _motionData->Curves;
@@ -652,6 +1059,7 @@ void CubismMotion::SetEffectIds(const csmVector<CubismIdHandle>& eyeBlinkParamet
 {
     _eyeBlinkParameterIds = eyeBlinkParameterIds;
     _lipSyncParameterIds = lipSyncParameterIds;
+    _boundModel = NULL;
 }
 
 const csmVector<const csmString*>& CubismMotion::GetFiredEvent(csmFloat32 beforeCheckTimeSeconds, csmFloat32 motionTimeSeconds)
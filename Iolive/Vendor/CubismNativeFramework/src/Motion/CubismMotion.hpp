@@ -30,13 +30,33 @@ public:
      *
      * インスタンスを作成する。
      *
-     * @param[in]   buffer                      motion3.jsonが読み込まれているバッファ
+     * @param[in]   buffer                      motion3.jsonが読み込まれているバッファ (or a precompiled motion, see IsBinary)
      * @param[in]   size                        バッファのサイズ
      * @param[in]   onFinishedMotionHandler     モーション再生終了時に呼び出されるコールバック関数。NULLの場合、呼び出されない。
-     * @return  作成されたインスタンス
+     * @return  作成されたインスタンス, NULL when a precompiled motion is invalid
      */
     static CubismMotion* Create(const csmByte* buffer, csmSizeInt size, FinishedMotionCallback onFinishedMotionHandler = NULL);
 
+    /**
+     * @brief Check for a precompiled motion
+     *
+     * @param[in]   buffer  buffer to check
+     * @param[in]   size    buffer size
+     * @retval  true    buffer starts with a CubismMotionBinaryHeader of the current version
+     * @retval  false   anything else (motion3.json or an outdated binary)
+     */
+    static csmBool IsBinary(const csmByte* buffer, csmSizeInt size);
+
+    /**
+     * @brief Write the motion as a precompiled motion
+     *
+     * The output can be given back to Create instead of the motion3.json.
+     * Fade times are written as currently set, so call it before overriding them.
+     *
+     * @param[out]  buffer  receives the binary motion
+     */
+    void                WriteBinary(csmVector<csmByte>& buffer) const;
+
     /**
     * @brief モデルのパラメータの更新の実行
     *
@@ -195,6 +215,28 @@ private:
      */
     void Parse(const csmByte* motionJson, const csmSizeInt size);
 
+    /**
+     * @brief Read a precompiled motion
+     *
+     * Every count and index is checked against the buffer before use.
+     *
+     * @param[in]   buffer  buffer written by WriteBinary
+     * @param[in]   size    buffer size
+     * @return  false when the buffer is malformed
+     */
+    csmBool ParseBinary(const csmByte* buffer, const csmSizeInt size);
+
+    /**
+     * @brief Bind the curves to a model
+     *
+     * Resolves every curve target to a model parameter index and the eye blink / lip sync
+     * targets to bitmasks, so DoUpdateParameters doesn't look up ids every frame.
+     * Done again when the model or the effect ids change.
+     *
+     * @param[in]   model   target model
+     */
+    void BindModel(CubismModel* model);
+
     csmFloat32      _sourceFrameRate;                   ///< ロードしたファイルのFPS。記述が無ければデフォルト値15fpsとなる
     csmFloat32      _loopDurationSeconds;               ///< mtnファイルで定義される一連のモーションの長さ
     csmBool         _isLoop;                            ///< ループするか?
@@ -208,6 +250,15 @@ private:
 
     CubismIdHandle _modelCurveIdEyeBlink;               ///< モデルが持つ自動まばたき用パラメータIDのハンドル。  モデルとモーションを対応付ける。
     CubismIdHandle _modelCurveIdLipSync;                ///< モデルが持つリップシンク用パラメータIDのハンドル。  モデルとモーションを対応付ける。
+
+    CubismModel*            _boundModel;                ///< model the curves below are bound to, NULL = not bound
+    csmInt32                _eyeBlinkCurveIndex;        ///< index of the eye blink model curve, -1 = none
+    csmInt32                _lipSyncCurveIndex;         ///< index of the lip sync model curve, -1 = none
+    csmVector<csmInt32>     _curveParameterIndices;     ///< parameter index per curve (-1 for model curves)
+    csmVector<csmUint64>    _curveEyeBlinkMasks;        ///< eye blink target bits per curve
+    csmVector<csmUint64>    _curveLipSyncMasks;         ///< lip sync target bits per curve
+    csmVector<csmInt32>     _eyeBlinkParameterIndices;  ///< parameter index per eye blink target
+    csmVector<csmInt32>     _lipSyncParameterIndices;   ///< parameter index per lip sync target
 };
 
 }}}
@@ -0,0 +1,71 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include "CubismFramework.hpp"
+
+namespace Live2D { namespace Cubism { namespace Framework {
+
+/**
+ * @brief Precompiled motion layout
+ *
+ * Binary form of CubismMotionData, written by CubismMotion::WriteBinary.
+ * Every block is a flat array of 4-byte fields, so a mapped file can be read in place:
+ *
+ *   CubismMotionBinaryHeader
+ *   CubismMotionBinaryCurve[CurveCount]
+ *   CubismMotionBinarySegment[SegmentCount]
+ *   CubismMotionPoint[PointCount]
+ *   CubismMotionBinaryEvent[EventCount]
+ *   csmChar[StringSize]     null-terminated curve ids and event values
+ *
+ * Values are stored in the byte order of the writer (little endian on every target we ship).
+ */
+const csmUint32 CubismMotionBinaryMagic = 0x424D4F49;   ///< "IOMB"
+const csmUint32 CubismMotionBinaryVersion = 1;          ///< bumped on any layout change
+
+struct CubismMotionBinaryHeader
+{
+    csmUint32   Magic;
+    csmUint32   Version;
+    csmUint32   Size;               ///< total size in bytes
+    csmFloat32  Duration;
+    csmFloat32  Fps;
+    csmFloat32  FadeInSeconds;
+    csmFloat32  FadeOutSeconds;
+    csmInt32    Loop;
+    csmInt32    CurveCount;
+    csmInt32    SegmentCount;
+    csmInt32    PointCount;
+    csmInt32    EventCount;
+    csmUint32   StringSize;
+};
+
+struct CubismMotionBinaryCurve
+{
+    csmInt32    Type;               ///< CubismMotionCurveTarget
+    csmUint32   IdOffset;           ///< offset into the string block
+    csmInt32    BaseSegmentIndex;
+    csmInt32    SegmentCount;
+    csmFloat32  FadeInTime;
+    csmFloat32  FadeOutTime;
+};
+
+struct CubismMotionBinarySegment
+{
+    csmInt32    BasePointIndex;
+    csmInt32    SegmentType;        ///< CubismMotionSegmentType
+};
+
+struct CubismMotionBinaryEvent
+{
+    csmFloat32  FireTime;
+    csmUint32   ValueOffset;        ///< offset into the string block
+};
+
+}}}
@@ -251,6 +251,8 @@ private:
     csmFloat32      _fadeOutSeconds;
     csmBool         _IsTriggeredFadeOut;
 
+    csmVector<csmInt32> _curveCursors;              ///< last evaluated segment per curve, used by CubismMotion
+
     CubismMotionQueueEntryHandle  _motionQueueEntryHandle;        ///< インスタンスごとに一意の値を持つ識別番号
 };
 
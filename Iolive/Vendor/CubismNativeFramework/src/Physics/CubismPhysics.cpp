@@ -12,6 +12,13 @@
 #include "Utils/CubismString.hpp"
 #include "Math/CubismMath.hpp"
 #include "Math/CubismVector2.hpp"
+#include "Utils/CubismTaskPool.hpp"
+
+// CSM_PHYSICS_NO_SIMD builds the portable lanes of the batched solver on SSE2 targets too
+#if !defined(CSM_PHYSICS_NO_SIMD) && (defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__))
+#define CSM_PHYSICS_USE_SSE2
+#include <emmintrin.h>
+#endif
 
 namespace Live2D { namespace Cubism { namespace Framework {
 
@@ -32,6 +39,9 @@ const csmFloat32 MaximumWeight = 100.0f;
 /// Constant of threshold of movement.
 const csmFloat32 MovementThreshold = 0.001f;
 
+/// Maximum tasks of the batched solver, more tasks than threads keep them busy.
+const csmInt32 MaximumTaskCount = 32;
+
 
 csmFloat32 GetRangeValue(csmFloat32 min, csmFloat32 max)
 {
@@ -390,10 +400,453 @@ void UpdateOutputParameterValue(csmFloat32* parameterValue, csmFloat32 parameter
     }
 }
 
+/// Loads the input parameters of a sub-rig.
+///
+/// @param  rig               Physics rig.
+/// @param  setting           Target sub-rig, its inputs must be bound to the model.
+/// @param  totalTranslation  Translation of the strand root.
+/// @param  totalAngle        Angle of the strand root.
+void LoadInputParameters(CubismPhysicsRig* rig, CubismPhysicsSubRig* setting, const csmFloat32* parameterValue,
+    const csmFloat32* parameterMinimumValue, const csmFloat32* parameterMaximumValue, const csmFloat32* parameterDefaultValue,
+    CubismVector2* totalTranslation, csmFloat32* totalAngle)
+{
+    CubismPhysicsInput* currentInput = &rig->Inputs[setting->BaseInputIndex];
+    csmFloat32 weight;
+    csmFloat32 radAngle;
+
+    *totalAngle = 0.0f;
+    totalTranslation->X = 0.0f;
+    totalTranslation->Y = 0.0f;
+
+    for (csmInt32 i = 0; i < setting->InputCount; ++i)
+    {
+        weight = currentInput[i].Weight / MaximumWeight;
+
+        currentInput[i].GetNormalizedParameterValue(
+            totalTranslation,
+            totalAngle,
+            parameterValue[currentInput[i].SourceParameterIndex],
+            parameterMinimumValue[currentInput[i].SourceParameterIndex],
+            parameterMaximumValue[currentInput[i].SourceParameterIndex],
+            parameterDefaultValue[currentInput[i].SourceParameterIndex],
+            &setting->NormalizationPosition,
+            &setting->NormalizationAngle,
+            currentInput[i].Reflect,
+            weight
+        );
+    }
+
+    radAngle = CubismMath::DegreesToRadian(-*totalAngle);
+
+    totalTranslation->X = (totalTranslation->X * CubismMath::CosF(radAngle) - totalTranslation->Y * CubismMath::SinF(radAngle));
+    totalTranslation->Y = (totalTranslation->X * CubismMath::SinF(radAngle) + totalTranslation->Y * CubismMath::CosF(radAngle));
+}
+
+/// Gets the output value of a strand stored in the batch streams,
+/// same as the PhysicsValueGetter of the output.
+///
+/// @param  output          Target output.
+/// @param  positionX       X position of the first particle, particles are CubismPhysicsBatchWidth apart.
+/// @param  positionY       Y position of the first particle.
+/// @param  particleIndex   Index of the output particle.
+/// @param  parentGravity   Gravity.
+///
+/// @return  Output value.
+csmFloat32 GetOutputValueFromStreams(const CubismPhysicsOutput* output, const csmFloat32* positionX, const csmFloat32* positionY,
+    csmInt32 particleIndex, CubismVector2 parentGravity)
+{
+    const csmInt32 current = particleIndex * CubismPhysicsBatchWidth;
+    const csmInt32 previous = current - CubismPhysicsBatchWidth;
+    csmFloat32 outputValue;
+
+    CubismVector2 translation;
+    translation.X = positionX[current] - positionX[previous];
+    translation.Y = positionY[current] - positionY[previous];
+
+    switch (output->Type)
+    {
+    case CubismPhysicsSource_X:
+        outputValue = translation.X;
+        break;
+    case CubismPhysicsSource_Y:
+        outputValue = translation.Y;
+        break;
+    default:
+        if (particleIndex >= 2)
+        {
+            parentGravity.X = positionX[previous] - positionX[previous - CubismPhysicsBatchWidth];
+            parentGravity.Y = positionY[previous] - positionY[previous - CubismPhysicsBatchWidth];
+        }
+        else
+        {
+            parentGravity *= -1.0f;
+        }
+
+        outputValue = CubismMath::DirectionToRadian(parentGravity, translation);
+        break;
+    }
+
+    if (output->Reflect)
+    {
+        outputValue *= -1.0f;
+    }
+
+    return outputValue;
+}
+
+/// Stores the output values of a sub-rig after a step, the last values become the previous ones.
+///
+/// @param  rig             Physics rig.
+/// @param  setting         Target sub-rig.
+/// @param  particles       Particles of the sub-rig, NULL when positionX & positionY are given.
+/// @param  positionX       X position of the first particle in the batch streams.
+/// @param  positionY       Y position of the first particle in the batch streams.
+/// @param  parentGravity   Gravity.
+void StoreOutputValues(CubismPhysicsRig* rig, CubismPhysicsSubRig* setting, CubismPhysicsParticle* particles,
+    const csmFloat32* positionX, const csmFloat32* positionY, CubismVector2 parentGravity)
+{
+    CubismPhysicsOutput* currentOutput = &rig->Outputs[setting->BaseOutputIndex];
+    csmInt32 particleIndex;
+
+    for (csmInt32 i = 0; i < setting->OutputCount; ++i)
+    {
+        particleIndex = currentOutput[i].VertexIndex;
+
+        if (particleIndex < 1 || particleIndex >= setting->ParticleCount)
+        {
+            break;
+        }
+
+        currentOutput[i].PreviousValue = currentOutput[i].Value;
+
+        if (particles)
+        {
+            CubismVector2 translation;
+            translation.X = particles[particleIndex].Position.X - particles[particleIndex - 1].Position.X;
+            translation.Y = particles[particleIndex].Position.Y - particles[particleIndex - 1].Position.Y;
+
+            currentOutput[i].Value = currentOutput[i].GetValue(
+                translation,
+                particles,
+                particleIndex,
+                currentOutput[i].Reflect,
+                parentGravity
+            );
+        }
+        else
+        {
+            currentOutput[i].Value = GetOutputValueFromStreams(&currentOutput[i], positionX, positionY, particleIndex, parentGravity);
+        }
+    }
+}
+
+/// Writes the output values of a sub-rig to the parameters.
+///
+/// @param  rig             Physics rig.
+/// @param  setting         Target sub-rig.
+/// @param  interpolation   Blend from the previous to the last value, < 0 = last value only.
+void ApplyOutputValues(CubismPhysicsRig* rig, CubismPhysicsSubRig* setting, csmFloat32* parameterValue,
+    const csmFloat32* parameterMinimumValue, const csmFloat32* parameterMaximumValue, csmFloat32 interpolation)
+{
+    CubismPhysicsOutput* currentOutput = &rig->Outputs[setting->BaseOutputIndex];
+    csmInt32 particleIndex;
+    csmFloat32 outputValue;
+
+    for (csmInt32 i = 0; i < setting->OutputCount; ++i)
+    {
+        particleIndex = currentOutput[i].VertexIndex;
+
+        if (particleIndex < 1 || particleIndex >= setting->ParticleCount)
+        {
+            break;
+        }
+
+        outputValue = currentOutput[i].Value;
+
+        if (interpolation >= 0.0f)
+        {
+            csmFloat32 delta = currentOutput[i].Value - currentOutput[i].PreviousValue;
+
+            // angles take the short way around
+            if (currentOutput[i].Type == CubismPhysicsSource_Angle)
+            {
+                if (delta > CubismMath::Pi)
+                {
+                    delta -= CubismMath::Pi * 2.0f;
+                }
+                else if (delta < -CubismMath::Pi)
+                {
+                    delta += CubismMath::Pi * 2.0f;
+                }
+            }
+
+            outputValue = currentOutput[i].PreviousValue + delta * interpolation;
+        }
+
+        UpdateOutputParameterValue(
+            &parameterValue[currentOutput[i].DestinationParameterIndex],
+            parameterMinimumValue[currentOutput[i].DestinationParameterIndex],
+            parameterMaximumValue[currentOutput[i].DestinationParameterIndex],
+            outputValue,
+            &currentOutput[i]);
+    }
+}
+
+/// CubismPhysicsBatchWidth floats, one per strand of a batch.
+/// Every operation rounds like its scalar counterpart, so the batched solver matches the reference one.
+#ifdef CSM_PHYSICS_USE_SSE2
+typedef __m128 Lanes;
+
+inline Lanes LoadLanes(const csmFloat32* source) { return _mm_loadu_ps(source); }
+inline void StoreLanes(csmFloat32* destination, Lanes value) { _mm_storeu_ps(destination, value); }
+inline Lanes SetLanes(csmFloat32 value) { return _mm_set1_ps(value); }
+inline Lanes Add(Lanes a, Lanes b) { return _mm_add_ps(a, b); }
+inline Lanes Sub(Lanes a, Lanes b) { return _mm_sub_ps(a, b); }
+inline Lanes Mul(Lanes a, Lanes b) { return _mm_mul_ps(a, b); }
+inline Lanes Div(Lanes a, Lanes b) { return _mm_div_ps(a, b); }
+/// powf(x, 0.5f) like CubismVector2::Normalize, sqrt differs in the last bit for some values.
+inline Lanes PowHalf(Lanes a)
+{
+    csmFloat32 values[CubismPhysicsBatchWidth];
+    _mm_storeu_ps(values, a);
+    for (csmInt32 l = 0; l < CubismPhysicsBatchWidth; ++l)
+    {
+        values[l] = powf(values[l], 0.5f);
+    }
+    return _mm_loadu_ps(values);
+}
+inline Lanes Abs(Lanes a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+
+/// Lane masks, all bits set where true.
+inline Lanes Less(Lanes a, Lanes b) { return _mm_cmplt_ps(a, b); }
+inline Lanes NotEqual(Lanes a, Lanes b) { return _mm_cmpneq_ps(a, b); }
+inline Lanes And(Lanes a, Lanes b) { return _mm_and_ps(a, b); }
+inline Lanes Select(Lanes mask, Lanes a, Lanes b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+
+/// Lanes whose strand has more than particleIndex particles.
+inline Lanes ActiveLanes(const csmInt32* particleCounts, csmInt32 particleIndex)
+{
+    const __m128i counts = _mm_loadu_si128(reinterpret_cast<const __m128i*>(particleCounts));
+    return _mm_castsi128_ps(_mm_cmpgt_epi32(counts, _mm_set1_epi32(particleIndex)));
+}
+#else
+struct Lanes
+{
+    csmFloat32 V[CubismPhysicsBatchWidth];
+};
+
+#define CSM_PHYSICS_LANES_OP(expression) \
+    Lanes ret; \
+    for (csmInt32 l = 0; l < CubismPhysicsBatchWidth; ++l) { ret.V[l] = (expression); } \
+    return ret;
+
+inline Lanes LoadLanes(const csmFloat32* source) { CSM_PHYSICS_LANES_OP(source[l]) }
+inline void StoreLanes(csmFloat32* destination, Lanes value) { for (csmInt32 l = 0; l < CubismPhysicsBatchWidth; ++l) { destination[l] = value.V[l]; } }
+inline Lanes SetLanes(csmFloat32 value) { CSM_PHYSICS_LANES_OP(value) }
+inline Lanes Add(Lanes a, Lanes b) { CSM_PHYSICS_LANES_OP(a.V[l] + b.V[l]) }
+inline Lanes Sub(Lanes a, Lanes b) { CSM_PHYSICS_LANES_OP(a.V[l] - b.V[l]) }
+inline Lanes Mul(Lanes a, Lanes b) { CSM_PHYSICS_LANES_OP(a.V[l] * b.V[l]) }
+inline Lanes Div(Lanes a, Lanes b) { CSM_PHYSICS_LANES_OP(a.V[l] / b.V[l]) }
+inline Lanes PowHalf(Lanes a) { CSM_PHYSICS_LANES_OP(powf(a.V[l], 0.5f)) }
+inline Lanes Abs(Lanes a) { CSM_PHYSICS_LANES_OP(CubismMath::AbsF(a.V[l])) }
+
+/// Lane masks, 1.0f where true.
+inline Lanes Less(Lanes a, Lanes b) { CSM_PHYSICS_LANES_OP((a.V[l] < b.V[l]) ? 1.0f : 0.0f) }
+inline Lanes NotEqual(Lanes a, Lanes b) { CSM_PHYSICS_LANES_OP((a.V[l] != b.V[l]) ? 1.0f : 0.0f) }
+inline Lanes And(Lanes a, Lanes b) { CSM_PHYSICS_LANES_OP((a.V[l] != 0.0f && b.V[l] != 0.0f) ? 1.0f : 0.0f) }
+inline Lanes Select(Lanes mask, Lanes a, Lanes b) { CSM_PHYSICS_LANES_OP((mask.V[l] != 0.0f) ? a.V[l] : b.V[l]) }
+
+inline Lanes ActiveLanes(const csmInt32* particleCounts, csmInt32 particleIndex)
+{
+    CSM_PHYSICS_LANES_OP((particleCounts[l] > particleIndex) ? 1.0f : 0.0f)
+}
+
+#undef CSM_PHYSICS_LANES_OP
+#endif
+
+/// Updates the particles of a batch, UpdateParticles() for every lane at once.
+///
+/// @param  rig               Physics rig.
+/// @param  batch             Target batch, with the inputs of this step.
+/// @param  windDirection     Direction of wind.
+/// @param  deltaTimeSeconds  Delta time.
+void UpdateParticlesBatch(CubismPhysicsRig* rig, CubismPhysicsBatch* batch, CubismVector2 windDirection, csmFloat32 deltaTimeSeconds)
+{
+    CubismPhysicsParticleStreams& streams = rig->Streams;
+    csmFloat32* positionX = &streams.PositionX[batch->BaseOffset];
+    csmFloat32* positionY = &streams.PositionY[batch->BaseOffset];
+    csmFloat32* velocityX = &streams.VelocityX[batch->BaseOffset];
+    csmFloat32* velocityY = &streams.VelocityY[batch->BaseOffset];
+    const csmFloat32* delays = &streams.Delay[batch->BaseOffset];
+    const csmFloat32* accelerations = &streams.Acceleration[batch->BaseOffset];
+    const csmFloat32* mobilities = &streams.Mobility[batch->BaseOffset];
+    const csmFloat32* radiuses = &streams.Radius[batch->BaseOffset];
+
+    const Lanes zero = SetLanes(0.0f);
+    const Lanes frameScale = SetLanes(30.0f);
+    const Lanes deltaTime = SetLanes(deltaTimeSeconds);
+    const Lanes windX = SetLanes(windDirection.X);
+    const Lanes windY = SetLanes(windDirection.Y);
+    const Lanes gravityX = LoadLanes(batch->GravityX);
+    const Lanes gravityY = LoadLanes(batch->GravityY);
+    const Lanes rotationCos = LoadLanes(batch->Cos);
+    const Lanes rotationSin = LoadLanes(batch->Sin);
+    const Lanes threshold = LoadLanes(batch->Threshold);
+
+    Lanes previousX = LoadLanes(batch->RootX);
+    Lanes previousY = LoadLanes(batch->RootY);
+    StoreLanes(positionX, previousX);
+    StoreLanes(positionY, previousY);
+
+    for (csmInt32 i = 1; i < batch->MaxParticleCount; ++i)
+    {
+        const csmInt32 offset = i * CubismPhysicsBatchWidth;
+        const Lanes active = ActiveLanes(batch->ParticleCounts, i);
+
+        const Lanes lastX = LoadLanes(positionX + offset);
+        const Lanes lastY = LoadLanes(positionY + offset);
+        Lanes velX = LoadLanes(velocityX + offset);
+        Lanes velY = LoadLanes(velocityY + offset);
+        const Lanes acceleration = LoadLanes(accelerations + offset);
+
+        const Lanes forceX = Add(Mul(gravityX, acceleration), windX);
+        const Lanes forceY = Add(Mul(gravityY, acceleration), windY);
+
+        const Lanes delay = Mul(Mul(LoadLanes(delays + offset), deltaTime), frameScale);
+
+        // rotate with the strand root, Y uses the rotated X like the reference solver
+        const Lanes directionX = Sub(lastX, previousX);
+        const Lanes directionY = Sub(lastY, previousY);
+        const Lanes rotatedX = Sub(Mul(rotationCos, directionX), Mul(directionY, rotationSin));
+        const Lanes rotatedY = Add(Mul(rotationSin, rotatedX), Mul(directionY, rotationCos));
+
+        Lanes x = Add(previousX, rotatedX);
+        Lanes y = Add(previousY, rotatedY);
+
+        x = Add(Add(x, Mul(velX, delay)), Mul(Mul(forceX, delay), delay));
+        y = Add(Add(y, Mul(velY, delay)), Mul(Mul(forceY, delay), delay));
+
+        // keep the distance to the previous particle
+        Lanes newDirectionX = Sub(x, previousX);
+        Lanes newDirectionY = Sub(y, previousY);
+        const Lanes length = PowHalf(Add(Mul(newDirectionX, newDirectionX), Mul(newDirectionY, newDirectionY)));
+        newDirectionX = Div(newDirectionX, length);
+        newDirectionY = Div(newDirectionY, length);
+
+        const Lanes radius = LoadLanes(radiuses + offset);
+        x = Add(previousX, Mul(newDirectionX, radius));
+        y = Add(previousY, Mul(newDirectionY, radius));
+
+        x = Select(Less(Abs(x), threshold), zero, x);
+
+        const Lanes moving = And(active, NotEqual(delay, zero));
+        const Lanes mobility = LoadLanes(mobilities + offset);
+        velX = Select(moving, Mul(Div(Sub(x, lastX), delay), mobility), velX);
+        velY = Select(moving, Mul(Div(Sub(y, lastY), delay), mobility), velY);
+
+        // lanes past the end of their strand are left untouched
+        x = Select(active, x, lastX);
+        y = Select(active, y, lastY);
+
+        StoreLanes(positionX + offset, x);
+        StoreLanes(positionY + offset, y);
+        StoreLanes(velocityX + offset, velX);
+        StoreLanes(velocityY + offset, velY);
+
+        previousX = x;
+        previousY = y;
+    }
+
+    for (csmInt32 l = 0; l < CubismPhysicsBatchWidth; ++l)
+    {
+        batch->LastGravityX[l] = batch->GravityX[l];
+        batch->LastGravityY[l] = batch->GravityY[l];
+    }
+}
+
+/// Checks whether a sub-rig writes a parameter.
+///
+/// @param  rig  Physics rig.
+/// @param  setting  Sub-rig.
+/// @param  id  Parameter id.
+/// @return true if one of the outputs has the parameter as destination.
+csmBool WritesParameter(const CubismPhysicsRig* rig, const CubismPhysicsSubRig& setting, CubismIdHandle id)
+{
+    for (csmInt32 i = 0; i < setting.OutputCount; ++i)
+    {
+        if (rig->Outputs[setting.BaseOutputIndex + i].Destination.Id == id)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/// Checks whether the result of a sub-rig depends on the evaluation of another one.
+///
+/// @param  rig  Physics rig.
+/// @param  first  Sub-rig.
+/// @param  second  Other sub-rig.
+/// @return true if they write the same parameter or one reads a parameter written by the other.
+csmBool SubRigsDepend(const CubismPhysicsRig* rig, const CubismPhysicsSubRig& first, const CubismPhysicsSubRig& second)
+{
+    for (csmInt32 i = 0; i < first.OutputCount; ++i)
+    {
+        if (WritesParameter(rig, second, rig->Outputs[first.BaseOutputIndex + i].Destination.Id))
+        {
+            return true;
+        }
+    }
+
+    for (csmInt32 i = 0; i < first.InputCount; ++i)
+    {
+        if (WritesParameter(rig, second, rig->Inputs[first.BaseInputIndex + i].Source.Id))
+        {
+            return true;
+        }
+    }
+
+    for (csmInt32 i = 0; i < second.InputCount; ++i)
+    {
+        if (WritesParameter(rig, first, rig->Inputs[second.BaseInputIndex + i].Source.Id))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/// Finds the group of a sub-rig.
+///
+/// @param  groups  Parent of each sub-rig, a group is named by its first sub-rig.
+/// @param  index  Sub-rig index.
+/// @return Group of the sub-rig.
+csmInt32 FindSubRigGroup(csmVector<csmInt32>& groups, csmInt32 index)
+{
+    while (groups[index] != index)
+    {
+        groups[index] = groups[groups[index]];
+        index = groups[index];
+    }
+
+    return index;
+}
+
 }
 
 CubismPhysics::CubismPhysics()
     : _physicsRig(NULL)
+    , _solver(Solver_Batched)
+    , _boundModel(NULL)
+    , _fixedTimeStep(0.0f)
+    , _maxSubSteps(8)
+    , _timeAccumulator(0.0f)
+    , _hasPreviousStep(false)
+    , _lastStepCount(0)
+    , _threadCount(0)
+    , _taskPool(NULL)
 {
     // set default options.
     _options.Gravity.Y = -1.0f;
@@ -404,6 +857,7 @@ CubismPhysics::CubismPhysics()
 
 CubismPhysics::~CubismPhysics()
 {
+    CSM_DELETE(_taskPool);
     CSM_DELETE(_physicsRig);
 }
 
@@ -444,6 +898,250 @@ void CubismPhysics::Initialize()
             strand[i].Force = CubismVector2(0.0f, 0.0f);
         }
     }
+
+    BuildBatches();
+    SyncParticleStreams(true);
+    UpdateTaskPool();
+}
+
+void CubismPhysics::BuildBatches()
+{
+    csmVector<CubismPhysicsBatch>& batches = _physicsRig->Batches;
+    csmVector<csmInt32>& taskBatches = _physicsRig->TaskBatches;
+    const csmInt32 subRigCount = _physicsRig->SubRigCount;
+    csmVector<csmInt32> groups(subRigCount);
+    csmVector<csmInt32> order(subRigCount);
+    csmVector<csmInt32> groupEnds;
+    CubismPhysicsBatch batch;
+    csmInt32 laneCount = 0;
+    csmInt32 streamSize = 0;
+
+    batches.Clear();
+    taskBatches.Clear();
+
+    // group the sub-rigs whose results depend on each other
+    for (csmInt32 i = 0; i < subRigCount; ++i)
+    {
+        groups.PushBack(i);
+
+        for (csmInt32 j = 0; j < i; ++j)
+        {
+            if (SubRigsDepend(_physicsRig, _physicsRig->Settings[i], _physicsRig->Settings[j]))
+            {
+                const csmInt32 first = FindSubRigGroup(groups, j);
+                const csmInt32 second = FindSubRigGroup(groups, i);
+
+                if (first < second)
+                {
+                    groups[second] = first;
+                }
+                else
+                {
+                    groups[first] = second;
+                }
+            }
+        }
+    }
+
+    for (csmInt32 i = 0; i < subRigCount; ++i)
+    {
+        FindSubRigGroup(groups, i);
+    }
+
+    // lay out the groups one after another, each in sub-rig order
+    for (csmInt32 i = 0; i < subRigCount; ++i)
+    {
+        if (groups[i] != i)
+        {
+            continue;
+        }
+
+        for (csmInt32 j = i; j < subRigCount; ++j)
+        {
+            if (groups[j] == i)
+            {
+                order.PushBack(j);
+            }
+        }
+    }
+
+    for (csmInt32 orderIndex = 0; orderIndex <= subRigCount; ++orderIndex)
+    {
+        csmBool flush = (orderIndex == subRigCount) || (laneCount == CubismPhysicsBatchWidth);
+
+        // inputs are loaded for the whole batch before any output is written
+        if (!flush && laneCount > 0)
+        {
+            const CubismPhysicsSubRig& setting = _physicsRig->Settings[order[orderIndex]];
+
+            for (csmInt32 i = 0; i < setting.InputCount && !flush; ++i)
+            {
+                const CubismIdHandle source = _physicsRig->Inputs[setting.BaseInputIndex + i].Source.Id;
+
+                for (csmInt32 lane = 0; lane < laneCount && !flush; ++lane)
+                {
+                    const CubismPhysicsSubRig& laneSetting = _physicsRig->Settings[batch.SubRigIndices[lane]];
+
+                    for (csmInt32 j = 0; j < laneSetting.OutputCount; ++j)
+                    {
+                        if (_physicsRig->Outputs[laneSetting.BaseOutputIndex + j].Destination.Id == source)
+                        {
+                            flush = true;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        if (flush && laneCount > 0)
+        {
+            batch.MaxParticleCount = 0;
+            for (csmInt32 lane = 0; lane < CubismPhysicsBatchWidth; ++lane)
+            {
+                if (lane >= laneCount)
+                {
+                    // unused lanes step an empty strand
+                    batch.SubRigIndices[lane] = -1;
+                    batch.ParticleCounts[lane] = 0;
+                    batch.RootX[lane] = batch.RootY[lane] = 0.0f;
+                    batch.GravityX[lane] = batch.GravityY[lane] = 0.0f;
+                    batch.Cos[lane] = 1.0f;
+                    batch.Sin[lane] = 0.0f;
+                    batch.Threshold[lane] = 0.0f;
+                }
+
+                batch.LastGravityX[lane] = 0.0f;
+                batch.LastGravityY[lane] = 1.0f;
+                if (batch.ParticleCounts[lane] > batch.MaxParticleCount)
+                {
+                    batch.MaxParticleCount = batch.ParticleCounts[lane];
+                }
+            }
+
+            batch.BaseOffset = streamSize;
+            streamSize += batch.MaxParticleCount * CubismPhysicsBatchWidth;
+
+            batches.PushBack(batch);
+            laneCount = 0;
+
+            // no group spans the batches on either side, tasks may be split here
+            if (orderIndex == subRigCount || groups[order[orderIndex]] != groups[order[orderIndex - 1]])
+            {
+                groupEnds.PushBack(static_cast<csmInt32>(batches.GetSize()));
+            }
+        }
+
+        if (orderIndex < subRigCount)
+        {
+            batch.SubRigIndices[laneCount] = order[orderIndex];
+            batch.ParticleCounts[laneCount] = _physicsRig->Settings[order[orderIndex]].ParticleCount;
+            ++laneCount;
+        }
+    }
+
+    // merge runs of batches into tasks of about the same particle count
+    if (batches.GetSize() > 0)
+    {
+        const csmInt32 taskStreamSize = streamSize / MaximumTaskCount;
+        csmInt32 taskBegin = 0;
+
+        taskBatches.PushBack(0);
+        for (csmUint32 i = 0; i < groupEnds.GetSize(); ++i)
+        {
+            const csmInt32 end = groupEnds[i];
+            const csmInt32 endOffset = (end < static_cast<csmInt32>(batches.GetSize())) ? batches[end].BaseOffset : streamSize;
+
+            if (end == static_cast<csmInt32>(batches.GetSize()) || endOffset - batches[taskBegin].BaseOffset >= taskStreamSize)
+            {
+                taskBatches.PushBack(end);
+                taskBegin = end;
+            }
+        }
+    }
+
+    CubismPhysicsParticleStreams& streams = _physicsRig->Streams;
+    streams.PositionX.UpdateSize(streamSize, 0.0f, true);
+    streams.PositionY.UpdateSize(streamSize, 0.0f, true);
+    streams.VelocityX.UpdateSize(streamSize, 0.0f, true);
+    streams.VelocityY.UpdateSize(streamSize, 0.0f, true);
+    streams.Delay.UpdateSize(streamSize, 0.0f, true);
+    streams.Acceleration.UpdateSize(streamSize, 0.0f, true);
+    streams.Mobility.UpdateSize(streamSize, 0.0f, true);
+    streams.Radius.UpdateSize(streamSize, 0.0f, true);
+}
+
+void CubismPhysics::SyncParticleStreams(csmBool toStreams)
+{
+    CubismPhysicsParticleStreams& streams = _physicsRig->Streams;
+
+    for (csmUint32 batchIndex = 0; batchIndex < _physicsRig->Batches.GetSize(); ++batchIndex)
+    {
+        CubismPhysicsBatch& batch = _physicsRig->Batches[batchIndex];
+
+        for (csmInt32 lane = 0; lane < CubismPhysicsBatchWidth; ++lane)
+        {
+            if (batch.SubRigIndices[lane] < 0)
+            {
+                continue;
+            }
+
+            const CubismPhysicsSubRig& setting = _physicsRig->Settings[batch.SubRigIndices[lane]];
+            CubismPhysicsParticle* strand = &_physicsRig->Particles[setting.BaseParticleIndex];
+
+            // every particle but the root shares the last gravity
+            if (toStreams && setting.ParticleCount > 1)
+            {
+                batch.LastGravityX[lane] = strand[1].LastGravity.X;
+                batch.LastGravityY[lane] = strand[1].LastGravity.Y;
+            }
+
+            for (csmInt32 i = 0; i < setting.ParticleCount; ++i)
+            {
+                const csmInt32 index = batch.BaseOffset + i * CubismPhysicsBatchWidth + lane;
+
+                if (toStreams)
+                {
+                    streams.PositionX[index] = strand[i].Position.X;
+                    streams.PositionY[index] = strand[i].Position.Y;
+                    streams.VelocityX[index] = strand[i].Velocity.X;
+                    streams.VelocityY[index] = strand[i].Velocity.Y;
+                    streams.Delay[index] = strand[i].Delay;
+                    streams.Acceleration[index] = strand[i].Acceleration;
+                    streams.Mobility[index] = strand[i].Mobility;
+                    streams.Radius[index] = strand[i].Radius;
+                }
+                else
+                {
+                    strand[i].Position.X = streams.PositionX[index];
+                    strand[i].Position.Y = streams.PositionY[index];
+                    strand[i].Velocity.X = streams.VelocityX[index];
+                    strand[i].Velocity.Y = streams.VelocityY[index];
+
+                    if (i > 0)
+                    {
+                        strand[i].LastGravity.X = batch.LastGravityX[lane];
+                        strand[i].LastGravity.Y = batch.LastGravityY[lane];
+                    }
+                }
+            }
+        }
+    }
+}
+
+void CubismPhysics::BindModel(CubismModel* model)
+{
+    for (csmUint32 i = 0; i < _physicsRig->Inputs.GetSize(); ++i)
+    {
+        _physicsRig->Inputs[i].SourceParameterIndex = model->GetParameterIndex(_physicsRig->Inputs[i].Source.Id);
+    }
+
+    for (csmUint32 i = 0; i < _physicsRig->Outputs.GetSize(); ++i)
+    {
+        _physicsRig->Outputs[i].DestinationParameterIndex = model->GetParameterIndex(_physicsRig->Outputs[i].Destination.Id);
+    }
+
+    _boundModel = model;
 }
 
 CubismPhysics* CubismPhysics::Create(const csmByte* buffer, csmSizeInt size)
@@ -549,6 +1247,8 @@ void CubismPhysics::Parse(const csmByte* physicsJson, csmSizeInt size)
             }
 
             _physicsRig->Outputs[outputIndex + j].Reflect = json->GetOutputReflect(i, j);
+            _physicsRig->Outputs[outputIndex + j].Value = 0.0f;
+            _physicsRig->Outputs[outputIndex + j].PreviousValue = 0.0f;
         }
         outputIndex += _physicsRig->Settings[i].OutputCount;
 
@@ -574,111 +1274,254 @@ void CubismPhysics::Parse(const csmByte* physicsJson, csmSizeInt size)
 
 void CubismPhysics::Evaluate(CubismModel* model, csmFloat32 deltaTimeSeconds)
 {
-    csmFloat32 totalAngle;
-    csmFloat32 weight;
-    csmFloat32 radAngle;
-    csmFloat32 outputValue;
-    CubismVector2 totalTranslation;
-    csmInt32 i, settingIndex, particleIndex;
-    CubismPhysicsSubRig* currentSetting;
-    CubismPhysicsInput* currentInput;
-    CubismPhysicsOutput* currentOutput;
-    CubismPhysicsParticle* currentParticles;
-
     csmFloat32* parameterValue;
     const csmFloat32* parameterMaximumValue;
     const csmFloat32* parameterMinimumValue;
     const csmFloat32* parameterDefaultValue;
+    csmFloat32 stepSeconds = deltaTimeSeconds;
+    csmInt32 stepCount = 1;
+    csmFloat32 interpolation = -1.0f;
+    csmBool firstStep = false;
+
+    if (_boundModel != model)
+    {
+        BindModel(model);
+    }
+
+    if (_fixedTimeStep > 0.0f)
+    {
+        const csmFloat32 maxAccumulatedTime = _fixedTimeStep * static_cast<csmFloat32>(_maxSubSteps);
+
+        _timeAccumulator += deltaTimeSeconds;
+        if (_timeAccumulator > maxAccumulatedTime)
+        {
+            _timeAccumulator = maxAccumulatedTime;
+        }
+
+        stepSeconds = _fixedTimeStep;
+        stepCount = static_cast<csmInt32>(_timeAccumulator / _fixedTimeStep);
+        _timeAccumulator -= static_cast<csmFloat32>(stepCount) * _fixedTimeStep;
+        interpolation = _timeAccumulator / _fixedTimeStep;
+
+        // nothing to interpolate from yet, show the first step as it is
+        if (!_hasPreviousStep)
+        {
+            _lastStepCount = stepCount;
+
+            if (stepCount == 0)
+            {
+                return;
+            }
+
+            interpolation = 1.0f;
+            firstStep = true;
+        }
+    }
+
+    _lastStepCount = stepCount;
 
     parameterValue = Core::csmGetParameterValues(model->GetModel());
     parameterMaximumValue = Core::csmGetParameterMaximumValues(model->GetModel());
     parameterMinimumValue = Core::csmGetParameterMinimumValues(model->GetModel());
     parameterDefaultValue = Core::csmGetParameterDefaultValues(model->GetModel());
 
+    if (_solver == Solver_Batched)
+    {
+        EvaluateBatched(parameterValue, parameterMinimumValue, parameterMaximumValue, parameterDefaultValue,
+            stepSeconds, stepCount, interpolation);
+    }
+    else
+    {
+        EvaluateReference(parameterValue, parameterMinimumValue, parameterMaximumValue, parameterDefaultValue,
+            stepSeconds, stepCount, interpolation);
+    }
+
+    if (firstStep)
+    {
+        for (csmUint32 i = 0; i < _physicsRig->Outputs.GetSize(); ++i)
+        {
+            _physicsRig->Outputs[i].PreviousValue = _physicsRig->Outputs[i].Value;
+        }
+
+        _hasPreviousStep = true;
+    }
+}
+
+void CubismPhysics::EvaluateReference(csmFloat32* parameterValue, const csmFloat32* parameterMinimumValue,
+    const csmFloat32* parameterMaximumValue, const csmFloat32* parameterDefaultValue,
+    csmFloat32 stepSeconds, csmInt32 stepCount, csmFloat32 interpolation)
+{
+    csmFloat32 totalAngle;
+    CubismVector2 totalTranslation;
+    csmInt32 settingIndex, step;
+    CubismPhysicsSubRig* currentSetting;
+    CubismPhysicsParticle* currentParticles;
+
     for (settingIndex = 0; settingIndex < _physicsRig->SubRigCount; ++settingIndex)
     {
-        totalAngle = 0.0f;
-        totalTranslation.X = 0.0f;
-        totalTranslation.Y = 0.0f;
         currentSetting = &_physicsRig->Settings[settingIndex];
-        currentInput = &_physicsRig->Inputs[currentSetting->BaseInputIndex];
-        currentOutput = &_physicsRig->Outputs[currentSetting->BaseOutputIndex];
         currentParticles = &_physicsRig->Particles[currentSetting->BaseParticleIndex];
 
         // Load input parameters.
-        for (i = 0; i < currentSetting->InputCount; ++i)
+        LoadInputParameters(_physicsRig, currentSetting, parameterValue, parameterMinimumValue, parameterMaximumValue,
+            parameterDefaultValue, &totalTranslation, &totalAngle);
+
+        for (step = 0; step < stepCount; ++step)
         {
-            weight = currentInput[i].Weight / MaximumWeight;
+            // Calculate particles position.
+            UpdateParticles(
+                currentParticles,
+                currentSetting->ParticleCount,
+                totalTranslation,
+                totalAngle,
+                _options.Wind,
+                MovementThreshold * currentSetting->NormalizationPosition.Maximum,
+                stepSeconds,
+                AirResistance
+            );
 
-            if (currentInput[i].SourceParameterIndex == -1)
+            // only the last two steps are shown
+            if (step >= stepCount - 2)
             {
-                currentInput[i].SourceParameterIndex = model->GetParameterIndex(currentInput[i].Source.Id);
+                StoreOutputValues(_physicsRig, currentSetting, currentParticles, NULL, NULL, _options.Gravity);
             }
-
-            currentInput[i].GetNormalizedParameterValue(
-                &totalTranslation,
-                &totalAngle,
-                parameterValue[currentInput[i].SourceParameterIndex],
-                parameterMinimumValue[currentInput[i].SourceParameterIndex],
-                parameterMaximumValue[currentInput[i].SourceParameterIndex],
-                parameterDefaultValue[currentInput[i].SourceParameterIndex],
-                &currentSetting->NormalizationPosition,
-                &currentSetting->NormalizationAngle,
-                currentInput[i].Reflect,
-                weight
-            );
         }
 
-        radAngle = CubismMath::DegreesToRadian(-totalAngle);
+        // Update output parameters.
+        ApplyOutputValues(_physicsRig, currentSetting, parameterValue, parameterMinimumValue, parameterMaximumValue, interpolation);
+    }
+}
+
+void CubismPhysics::EvaluateBatched(csmFloat32* parameterValue, const csmFloat32* parameterMinimumValue,
+    const csmFloat32* parameterMaximumValue, const csmFloat32* parameterDefaultValue,
+    csmFloat32 stepSeconds, csmInt32 stepCount, csmFloat32 interpolation)
+{
+    BatchedEvaluation evaluation;
+    evaluation.Physics = this;
+    evaluation.ParameterValue = parameterValue;
+    evaluation.ParameterMinimumValue = parameterMinimumValue;
+    evaluation.ParameterMaximumValue = parameterMaximumValue;
+    evaluation.ParameterDefaultValue = parameterDefaultValue;
+    evaluation.StepSeconds = stepSeconds;
+    evaluation.StepCount = stepCount;
+    evaluation.Interpolation = interpolation;
+
+    // the tasks write disjoint parameters, outputs & particles
+    if (_taskPool != NULL)
+    {
+        _taskPool->Run(&EvaluateBatchesTask, &evaluation, static_cast<csmInt32>(_physicsRig->TaskBatches.GetSize()) - 1);
+    }
+    else
+    {
+        EvaluateBatches(evaluation, 0, _physicsRig->Batches.GetSize());
+    }
+}
 
-        totalTranslation.X = (totalTranslation.X * CubismMath::CosF(radAngle) - totalTranslation.Y * CubismMath::SinF(radAngle));
-        totalTranslation.Y = (totalTranslation.X * CubismMath::SinF(radAngle) + totalTranslation.Y * CubismMath::CosF(radAngle));
+void CubismPhysics::EvaluateBatchesTask(void* evaluation, csmInt32 taskIndex)
+{
+    const BatchedEvaluation* context = static_cast<const BatchedEvaluation*>(evaluation);
+    const csmVector<csmInt32>& taskBatches = context->Physics->_physicsRig->TaskBatches;
 
-        // Calculate particles position.
-        UpdateParticles(
-            currentParticles,
-            currentSetting->ParticleCount,
-            totalTranslation,
-            totalAngle,
-            _options.Wind,
-            MovementThreshold * currentSetting->NormalizationPosition.Maximum,
-            deltaTimeSeconds,
-            AirResistance
-        );
+    context->Physics->EvaluateBatches(*context, taskBatches[taskIndex], taskBatches[taskIndex + 1]);
+}
 
-        // Update output parameters.
-        for (i = 0; i < currentSetting->OutputCount; ++i)
+void CubismPhysics::EvaluateBatches(const BatchedEvaluation& evaluation, csmUint32 beginBatch, csmUint32 endBatch)
+{
+    csmFloat32* parameterValue = evaluation.ParameterValue;
+    const csmFloat32* parameterMinimumValue = evaluation.ParameterMinimumValue;
+    const csmFloat32* parameterMaximumValue = evaluation.ParameterMaximumValue;
+    const csmFloat32* parameterDefaultValue = evaluation.ParameterDefaultValue;
+    const csmFloat32 stepSeconds = evaluation.StepSeconds;
+    const csmInt32 stepCount = evaluation.StepCount;
+    const csmFloat32 interpolation = evaluation.Interpolation;
+    csmFloat32 totalAngle;
+    csmFloat32 radian;
+    CubismVector2 totalTranslation;
+    CubismVector2 currentGravity;
+    CubismVector2 lastGravity;
+    csmInt32 lane, step;
+    CubismPhysicsSubRig* currentSetting;
+
+    for (csmUint32 batchIndex = beginBatch; batchIndex < endBatch; ++batchIndex)
+    {
+        CubismPhysicsBatch* batch = &_physicsRig->Batches[batchIndex];
+
+        // Load input parameters.
+        for (lane = 0; lane < CubismPhysicsBatchWidth; ++lane)
         {
-            particleIndex = currentOutput[i].VertexIndex;
+            if (batch->SubRigIndices[lane] < 0)
+            {
+                continue;
+            }
+
+            currentSetting = &_physicsRig->Settings[batch->SubRigIndices[lane]];
 
-            if (particleIndex < 1 || particleIndex >= currentSetting->ParticleCount)
+            LoadInputParameters(_physicsRig, currentSetting, parameterValue, parameterMinimumValue, parameterMaximumValue,
+                parameterDefaultValue, &totalTranslation, &totalAngle);
+
+            currentGravity = CubismMath::RadianToDirection(CubismMath::DegreesToRadian(totalAngle));
+            currentGravity.Normalize();
+
+            batch->RootX[lane] = totalTranslation.X;
+            batch->RootY[lane] = totalTranslation.Y;
+            batch->GravityX[lane] = currentGravity.X;
+            batch->GravityY[lane] = currentGravity.Y;
+            batch->Threshold[lane] = MovementThreshold * currentSetting->NormalizationPosition.Maximum;
+        }
+
+        for (step = 0; step < stepCount; ++step)
+        {
+            // the strand rotation is the same for every particle of a strand
+            for (lane = 0; lane < CubismPhysicsBatchWidth; ++lane)
             {
-                break;
+                if (batch->SubRigIndices[lane] < 0)
+                {
+                    continue;
+                }
+
+                currentGravity.X = batch->GravityX[lane];
+                currentGravity.Y = batch->GravityY[lane];
+                lastGravity.X = batch->LastGravityX[lane];
+                lastGravity.Y = batch->LastGravityY[lane];
+                radian = CubismMath::DirectionToRadian(lastGravity, currentGravity) / AirResistance;
+
+                batch->Cos[lane] = CubismMath::CosF(radian);
+                batch->Sin[lane] = CubismMath::SinF(radian);
             }
 
-            if (currentOutput[i].DestinationParameterIndex == -1)
+            // Calculate particles position.
+            UpdateParticlesBatch(_physicsRig, batch, _options.Wind, stepSeconds);
+
+            // only the last two steps are shown
+            if (step < stepCount - 2)
             {
-                currentOutput[i].DestinationParameterIndex = model->GetParameterIndex(currentOutput[i].Destination.Id);
+                continue;
             }
 
-            CubismVector2 translation;
-            translation.X = currentParticles[particleIndex].Position.X - currentParticles[particleIndex - 1].Position.X;
-            translation.Y = currentParticles[particleIndex].Position.Y - currentParticles[particleIndex - 1].Position.Y;
+            for (lane = 0; lane < CubismPhysicsBatchWidth; ++lane)
+            {
+                if (batch->SubRigIndices[lane] < 0)
+                {
+                    continue;
+                }
+
+                StoreOutputValues(_physicsRig, &_physicsRig->Settings[batch->SubRigIndices[lane]], NULL,
+                    &_physicsRig->Streams.PositionX[batch->BaseOffset + lane],
+                    &_physicsRig->Streams.PositionY[batch->BaseOffset + lane],
+                    _options.Gravity);
+            }
+        }
 
-            outputValue = currentOutput[i].GetValue(
-                translation,
-                currentParticles,
-                particleIndex,
-                currentOutput[i].Reflect,
-                _options.Gravity
-            );
+        // Update output parameters, in sub-rig order.
+        for (lane = 0; lane < CubismPhysicsBatchWidth; ++lane)
+        {
+            if (batch->SubRigIndices[lane] < 0)
+            {
+                continue;
+            }
 
-            UpdateOutputParameterValue(
-                &parameterValue[currentOutput[i].DestinationParameterIndex],
-                parameterMinimumValue[currentOutput[i].DestinationParameterIndex],
-                parameterMaximumValue[currentOutput[i].DestinationParameterIndex],
-                outputValue,
-                &currentOutput[i]);
+            ApplyOutputValues(_physicsRig, &_physicsRig->Settings[batch->SubRigIndices[lane]],
+                parameterValue, parameterMinimumValue, parameterMaximumValue, interpolation);
         }
     }
 }
@@ -693,4 +1536,80 @@ const CubismPhysics::Options& CubismPhysics::GetOptions() const
     return _options;
 }
 
+void CubismPhysics::SetSolver(Solver solver)
+{
+    if (solver != _solver)
+    {
+        SyncParticleStreams(solver == Solver_Batched);
+    }
+
+    _solver = solver;
+}
+
+CubismPhysics::Solver CubismPhysics::GetSolver() const
+{
+    return _solver;
+}
+
+void CubismPhysics::SetFixedTimeStep(csmFloat32 stepSeconds, csmInt32 maxSubSteps)
+{
+    _fixedTimeStep = CubismMath::Max(stepSeconds, 0.0f);
+    _maxSubSteps = static_cast<csmInt32>(CubismMath::Max(static_cast<csmFloat32>(maxSubSteps), 1.0f));
+    _timeAccumulator = 0.0f;
+    _hasPreviousStep = false;
+}
+
+csmFloat32 CubismPhysics::GetFixedTimeStep() const
+{
+    return _fixedTimeStep;
+}
+
+csmInt32 CubismPhysics::GetLastStepCount() const
+{
+    return _lastStepCount;
+}
+
+void CubismPhysics::SetThreadCount(csmInt32 threadCount)
+{
+    _threadCount = (threadCount > 0) ? threadCount : 0;
+
+    if (_physicsRig != NULL)
+    {
+        UpdateTaskPool();
+    }
+}
+
+csmInt32 CubismPhysics::GetThreadCount() const
+{
+    return (_taskPool != NULL) ? _taskPool->GetWorkerCount() + 1 : 1;
+}
+
+void CubismPhysics::UpdateTaskPool()
+{
+    const csmInt32 taskCount = static_cast<csmInt32>(_physicsRig->TaskBatches.GetSize()) - 1;
+    csmInt32 threadCount = _threadCount;
+
+    // automatic: serial, the task pool overhead outweighed the gain on the rigs measured
+    if (threadCount == 0)
+    {
+        threadCount = 1;
+    }
+
+    // a thread per task at most
+    threadCount = (threadCount < taskCount) ? threadCount : taskCount;
+
+    if (_taskPool != NULL && _taskPool->GetWorkerCount() == threadCount - 1)
+    {
+        return;
+    }
+
+    CSM_DELETE(_taskPool);
+    _taskPool = NULL;
+
+    if (threadCount > 1)
+    {
+        _taskPool = CSM_NEW Utils::CubismTaskPool(threadCount - 1);
+    }
+}
+
 }}}
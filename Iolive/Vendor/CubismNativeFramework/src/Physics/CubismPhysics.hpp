@@ -14,6 +14,8 @@ namespace Live2D { namespace Cubism { namespace Framework {
 class CubismModel;
 struct CubismPhysicsRig;
 
+namespace Utils { class CubismTaskPool; }
+
 /**
  * @brief 物理演算クラス
  *
@@ -33,6 +35,18 @@ public:
         CubismVector2 Wind;             ///< 風の方向
     };
 
+    /**
+     * @brief Particle solver
+     *
+     * Both solvers give the same results. The reference solver steps one particle at a time,
+     * the batched solver steps CubismPhysicsBatchWidth strands at once in SIMD lanes.
+     */
+    enum Solver
+    {
+        Solver_Reference,   ///< one sub-rig at a time
+        Solver_Batched,     ///< sub-rigs packed in structure of arrays (default)
+    };
+
     /**
      * @brief インスタンスの作成
      *
@@ -57,6 +71,8 @@ public:
      * @brief 物理演算の評価
      *
      * 物理演算を評価する。
+     * With a fixed time step, the particles are stepped by the accumulated time
+     * and the outputs are interpolated between the last two steps.
      *
      * @param[in]   model               物理演算の結果を適用するモデル
      * @param[in]   deltaTimeSeconds    デルタ時間[秒]
@@ -81,6 +97,66 @@ public:
      */
     const Options& GetOptions() const;
 
+    /**
+     * @brief Select the particle solver
+     *
+     * The particle state is carried over, so the solver can be switched at any time.
+     *
+     * @param[in]   solver      solver used by Evaluate
+     */
+    void SetSolver(Solver solver);
+
+    /**
+     * @brief Get the particle solver
+     *
+     * @return solver used by Evaluate
+     */
+    Solver GetSolver() const;
+
+    /**
+     * @brief Step the particles at a fixed rate
+     *
+     * Evaluate accumulates the delta time and runs one step per stepSeconds, at most
+     * maxSubSteps per call (the rest of a long hitch is dropped). The outputs are
+     * interpolated between the last two steps, so they run one step behind.
+     *
+     * @param[in]   stepSeconds     time step in seconds, 0 = one step per Evaluate with its delta time
+     * @param[in]   maxSubSteps     maximum steps per Evaluate
+     */
+    void SetFixedTimeStep(csmFloat32 stepSeconds, csmInt32 maxSubSteps = 8);
+
+    /**
+     * @brief Get the fixed time step
+     *
+     * @return time step in seconds, 0 = disabled
+     */
+    csmFloat32 GetFixedTimeStep() const;
+
+    /**
+     * @brief Get the number of steps run by the last Evaluate
+     *
+     * @return step count
+     */
+    csmInt32 GetLastStepCount() const;
+
+    /**
+     * @brief Set the number of threads of the batched solver
+     *
+     * Sub-rigs sharing an output parameter, or reading the output of another one, are
+     * evaluated by one thread in sub-rig order, so the result doesn't depend on the thread count.
+     *
+     * @param[in]   threadCount     threads including the caller of Evaluate, 1 = serial,
+     *                              0 = automatic (serial for now)
+     */
+    void SetThreadCount(csmInt32 threadCount);
+
+    /**
+     * @brief Get the number of threads used by the batched solver
+     *
+     * @return threads including the caller of Evaluate
+     */
+    csmInt32 GetThreadCount() const;
+
 
 private:
     /**
@@ -118,8 +194,99 @@ private:
      */
     void Initialize();
 
+    /**
+     * @brief Group the sub-rigs into batches & tasks
+     *
+     * Sub-rigs sharing an output parameter, or reading the output of another one, are kept
+     * together in sub-rig order and form independent groups. The groups are laid out one
+     * after another, then consecutive sub-rigs share a batch unless one reads a parameter
+     * written by an earlier one of the same batch, so the batched solver gives the results
+     * of the reference solver. Runs of batches holding whole groups become the tasks.
+     */
+    void BuildBatches();
+
+    /**
+     * @brief Create or release the task pool for the thread count
+     */
+    void UpdateTaskPool();
+
+    /**
+     * @brief Bind the inputs & outputs to a model
+     *
+     * Resolves every source & destination id to a parameter index once,
+     * done again when Evaluate is called with another model.
+     *
+     * @param[in]   model   target model
+     */
+    void BindModel(CubismModel* model);
+
+    /**
+     * @brief Copy the particle state between the particles and the batch streams
+     *
+     * @param[in]   toStreams   true: particles -> streams, false: streams -> particles
+     */
+    void SyncParticleStreams(csmBool toStreams);
+
+    /**
+     * @brief Evaluate with the reference solver
+     *
+     * @param[in]   stepSeconds     time step of each step
+     * @param[in]   stepCount       steps to run, 0 with a fixed time step when no step is due
+     * @param[in]   interpolation   blend from the previous to the last step, < 0 = no interpolation
+     */
+    void EvaluateReference(csmFloat32* parameterValue, const csmFloat32* parameterMinimumValue,
+        const csmFloat32* parameterMaximumValue, const csmFloat32* parameterDefaultValue,
+        csmFloat32 stepSeconds, csmInt32 stepCount, csmFloat32 interpolation);
+
+    /**
+     * @brief Evaluate with the batched solver
+     *
+     * Same parameters as EvaluateReference.
+     */
+    void EvaluateBatched(csmFloat32* parameterValue, const csmFloat32* parameterMinimumValue,
+        const csmFloat32* parameterMaximumValue, const csmFloat32* parameterDefaultValue,
+        csmFloat32 stepSeconds, csmInt32 stepCount, csmFloat32 interpolation);
+
+    /**
+     * @brief Arguments of EvaluateBatched, shared by the tasks
+     */
+    struct BatchedEvaluation
+    {
+        CubismPhysics* Physics;
+        csmFloat32* ParameterValue;
+        const csmFloat32* ParameterMinimumValue;
+        const csmFloat32* ParameterMaximumValue;
+        const csmFloat32* ParameterDefaultValue;
+        csmFloat32 StepSeconds;
+        csmInt32 StepCount;
+        csmFloat32 Interpolation;
+    };
+
+    /**
+     * @brief Evaluate a range of batches with the batched solver
+     *
+     * @param[in]   evaluation  arguments
+     * @param[in]   beginBatch  first batch
+     * @param[in]   endBatch    batch after the last one
+     */
+    void EvaluateBatches(const BatchedEvaluation& evaluation, csmUint32 beginBatch, csmUint32 endBatch);
+
+    /**
+     * @brief Task function of the task pool, evaluates one task of batches
+     */
+    static void EvaluateBatchesTask(void* evaluation, csmInt32 taskIndex);
+
     CubismPhysicsRig*   _physicsRig;          ///< 物理演算のデータ
     Options             _options;             ///< オプション
+    Solver              _solver;              ///< particle solver
+    CubismModel*        _boundModel;          ///< model the parameter indices are resolved for, NULL = not bound
+    csmFloat32          _fixedTimeStep;       ///< time step in seconds, 0 = variable
+    csmInt32            _maxSubSteps;         ///< maximum steps per Evaluate with a fixed time step
+    csmFloat32          _timeAccumulator;     ///< time not stepped yet
+    csmBool             _hasPreviousStep;     ///< the outputs hold a previous step to interpolate from
+    csmInt32            _lastStepCount;       ///< steps run by the last Evaluate
+    csmInt32            _threadCount;         ///< requested threads, 0 = automatic
+    Utils::CubismTaskPool* _taskPool;         ///< workers of the batched solver, NULL = serial
 };
 
 }}}
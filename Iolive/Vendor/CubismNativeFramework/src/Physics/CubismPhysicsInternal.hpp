@@ -199,6 +199,52 @@ struct CubismPhysicsOutput
     csmFloat32 ValueExceededMaximum;            ///< 最大値をこえた時の値
     PhysicsValueGetter GetValue;                ///< 物理演算の値の取得関数
     PhysicsScaleGetter GetScale;                ///< 物理演算のスケール値の取得関数
+    csmFloat32 Value;                           ///< output of the last step, before scale & weight
+    csmFloat32 PreviousValue;                   ///< output of the step before, for the fixed time step interpolation
+};
+
+/**
+ * @brief Number of sub-rigs stepped together by the batched solver
+ */
+const csmInt32 CubismPhysicsBatchWidth = 4;
+
+/**
+ * @brief Sub-rigs stepped together in SIMD lanes
+ *
+ * Lane l holds sub-rig SubRigIndices[l]. Particle p of that lane is stored at
+ * BaseOffset + p * CubismPhysicsBatchWidth + l in CubismPhysicsParticleStreams.
+ * The per-frame inputs (Root ... Threshold) are written before each step.
+ */
+struct CubismPhysicsBatch
+{
+    csmInt32 SubRigIndices[CubismPhysicsBatchWidth];        ///< sub-rig per lane, -1 = unused lane
+    csmInt32 ParticleCounts[CubismPhysicsBatchWidth];       ///< particle count per lane, 0 for unused lanes
+    csmInt32 MaxParticleCount;                              ///< longest strand of the batch
+    csmInt32 BaseOffset;                                    ///< first element in the streams
+    csmFloat32 LastGravityX[CubismPhysicsBatchWidth];       ///< gravity of the last step, shared by a whole strand
+    csmFloat32 LastGravityY[CubismPhysicsBatchWidth];
+    csmFloat32 RootX[CubismPhysicsBatchWidth];              ///< position of the strand root for this step
+    csmFloat32 RootY[CubismPhysicsBatchWidth];
+    csmFloat32 GravityX[CubismPhysicsBatchWidth];           ///< gravity direction for this step
+    csmFloat32 GravityY[CubismPhysicsBatchWidth];
+    csmFloat32 Cos[CubismPhysicsBatchWidth];                ///< rotation of the strand since the last step
+    csmFloat32 Sin[CubismPhysicsBatchWidth];
+    csmFloat32 Threshold[CubismPhysicsBatchWidth];          ///< movement threshold
+};
+
+/**
+ * @brief Particle state of every batch as structure of arrays
+ */
+struct CubismPhysicsParticleStreams
+{
+    csmVector<csmFloat32> PositionX;
+    csmVector<csmFloat32> PositionY;
+    csmVector<csmFloat32> VelocityX;
+    csmVector<csmFloat32> VelocityY;
+    csmVector<csmFloat32> Delay;
+    csmVector<csmFloat32> Acceleration;
+    csmVector<csmFloat32> Mobility;
+    csmVector<csmFloat32> Radius;
 };
 
 /**
@@ -215,6 +261,9 @@ struct CubismPhysicsRig
     csmVector<CubismPhysicsParticle> Particles;     ///< 物理演算の物理点のリスト
     CubismVector2 Gravity;                          ///< 重力
     CubismVector2 Wind;                             ///< 風
+    csmVector<CubismPhysicsBatch> Batches;          ///< sub-rigs grouped for the batched solver
+    CubismPhysicsParticleStreams Streams;           ///< particle state of the batched solver
+    csmVector<csmInt32> TaskBatches;                ///< first batch of each independent task, then the batch count
 };
 
 }}}
@@ -15,6 +15,11 @@
 #include <Windows.h>
 #endif
 
+// Vertex buffers need vertex array objects and glDrawElementsBaseVertex (OpenGL 3.2), which only desktop GL has
+#if defined(CSM_TARGET_WIN_GL) || defined(CSM_TARGET_LINUX_GL) || (defined(CSM_TARGET_MAC_GL) && !defined(CSM_TARGET_COCOS))
+#define CSM_VERTEX_BUFFERS_SUPPORTED
+#endif
+
 //------------ LIVE2D NAMESPACE ------------
 namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
 
@@ -24,11 +29,25 @@ namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering
 ///< ファイルスコープの変数宣言
 namespace {
 const csmInt32 ColorChannelCount = 4;   ///< 実験時に1チャンネルの場合は1、RGBだけの場合は3、アルファも含める場合は4
+
+/**
+ * @brief   Checks the dynamic flags a clipping mask depends on
+ */
+csmBool IsDrawableChanged(CubismModel& model, csmInt32 drawableIndex)
+{
+    return model.GetDrawableDynamicFlagVertexPositionsDidChange(drawableIndex)
+        || model.GetDrawableDynamicFlagOpacityDidChange(drawableIndex)
+        || model.GetDrawableDynamicFlagVisibilityDidChange(drawableIndex);
+}
 }
 
 CubismClippingManager_OpenGLES2::CubismClippingManager_OpenGLES2() :
                                                                    _currentFrameNo(0)
                                                                    , _clippingMaskBufferSize(256)
+                                                                   , _maskCacheValid(false)
+                                                                   , _cachedUsingClipCount(0)
+                                                                   , _maskRedrawCount(0)
+                                                                   , _scannedVertexCount(0)
 {
     CubismRenderer::CubismTextureColor* tmp;
     tmp = CSM_NEW CubismRenderer::CubismTextureColor();
@@ -141,22 +160,57 @@ CubismClippingContext* CubismClippingManager_OpenGLES2::FindSameClip(const csmIn
 void CubismClippingManager_OpenGLES2::SetupClippingContext(CubismModel& model, CubismRenderer_OpenGLES2* renderer, GLint lastFBO, GLint lastViewport[4])
 {
     _currentFrameNo++;
+    _maskRedrawCount = 0;
+    _scannedVertexCount = 0;
+
+    // The high precision masks overwrite the buffer for every clipped drawable
+    if (!renderer->IsUsingMaskCaching() || renderer->IsUsingHighPrecisionMask())
+    {
+        _maskCacheValid = false;
+    }
 
     // 全てのクリッピングを用意する
     // 同じクリップ（複数の場合はまとめて１つのクリップ）を使う場合は１度だけ設定する
     csmInt32 usingClipCount = 0;
+    csmInt32 dirtyClipCount = 0;
     for (csmUint32 clipIndex = 0; clipIndex < _clippingContextListForMask.GetSize(); clipIndex++)
     {
         // １つのクリッピングマスクに関して
         CubismClippingContext* cc = _clippingContextListForMask[clipIndex];
 
-        // このクリップを利用する描画オブジェクト群全体を囲む矩形を計算
-        CalcClippedDrawTotalBounds(model, cc);
+        if (!_maskCacheValid)
+        {
+            // このクリップを利用する描画オブジェクト群全体を囲む矩形を計算
+            CalcClippedDrawTotalBounds(model, cc);
+            cc->_isDirty = true;
+        }
+        else
+        {
+            cc->_isDirty = UpdateClippingContextBounds(model, cc);
+        }
 
         if (cc->_isUsing)
         {
             usingClipCount++; //使用中としてカウント
         }
+
+        if (cc->_isDirty)
+        {
+            dirtyClipCount++;
+        }
+    }
+
+    // The layout depends on the number of used masks, every region moves when it changes
+    if (usingClipCount != _cachedUsingClipCount)
+    {
+        _maskCacheValid = false;
+        _cachedUsingClipCount = usingClipCount;
+    }
+
+    // The buffer already holds every mask
+    if (_maskCacheValid && dirtyClipCount == 0)
+    {
+        return;
     }
 
     // マスク作成処理
@@ -175,9 +229,12 @@ void CubismClippingManager_OpenGLES2::SetupClippingContext(CubismModel& model, C
             // _offscreenFrameBufferへ切り替え
             renderer->_offscreenFrameBuffer.BeginDraw(lastFBO);
 
-            // マスクをクリアする
-            // 1が無効（描かれない）領域、0が有効（描かれる）領域。（シェーダで Cd*Csで0に近い値をかけてマスクを作る。1をかけると何も起こらない）
-            renderer->_offscreenFrameBuffer.Clear(1.0f, 1.0f, 1.0f, 1.0f);
+            if (!_maskCacheValid)
+            {
+                // マスクをクリアする
+                // 1が無効（描かれない）領域、0が有効（描かれる）領域。（シェーダで Cd*Csで0に近い値をかけてマスクを作る。1をかけると何も起こらない）
+                renderer->_offscreenFrameBuffer.Clear(1.0f, 1.0f, 1.0f, 1.0f);
+            }
         }
 
         // 各マスクのレイアウトを決定していく
@@ -189,6 +246,13 @@ void CubismClippingManager_OpenGLES2::SetupClippingContext(CubismModel& model, C
         {
             // --- 実際に１つのマスクを描く ---
             CubismClippingContext* clipContext = _clippingContextListForMask[clipIndex];
+
+            // The mask, its layout and its matrices are the same as in the last frame
+            if (_maskCacheValid && !clipContext->_isDirty)
+            {
+                continue;
+            }
+
             csmRectF* allClippedDrawRect = clipContext->_allClippedDrawRect; //このマスクを使う、全ての描画オブジェクトの論理座標上の囲み矩形
             csmRectF* layoutBoundsOnTex01 = clipContext->_layoutBounds; //この中にマスクを収める
 
@@ -243,30 +307,38 @@ void CubismClippingManager_OpenGLES2::SetupClippingContext(CubismModel& model, C
 
             if (!renderer->IsUsingHighPrecisionMask())
             {
+                if (_maskCacheValid)
+                {
+                    // Clear only the region and channel of this mask, the other masks are kept
+                    const csmFloat32 bufferSize = static_cast<csmFloat32>(_clippingMaskBufferSize);
+                    const GLint left = static_cast<GLint>(layoutBoundsOnTex01->X * bufferSize + 0.5f);
+                    const GLint bottom = static_cast<GLint>(layoutBoundsOnTex01->Y * bufferSize + 0.5f);
+                    const GLint right = static_cast<GLint>(layoutBoundsOnTex01->GetRight() * bufferSize + 0.5f);
+                    const GLint top = static_cast<GLint>(layoutBoundsOnTex01->GetBottom() * bufferSize + 0.5f);
+                    const csmInt32 channelNo = clipContext->_layoutChannelNo;
+
+                    glEnable(GL_SCISSOR_TEST);
+                    glScissor(left, bottom, right - left, top - bottom);
+                    glColorMask(channelNo == 0, channelNo == 1, channelNo == 2, channelNo == 3);
+                    renderer->_offscreenFrameBuffer.Clear(1.0f, 1.0f, 1.0f, 1.0f);
+                    glColorMask(1, 1, 1, 1);
+                    glDisable(GL_SCISSOR_TEST);
+                }
+                _maskRedrawCount++;
+
+                // The region was cleared, every masking drawable is drawn again, moved or not
                 const csmInt32 clipDrawCount = clipContext->_clippingIdCount;
                 for (csmInt32 i = 0; i < clipDrawCount; i++)
                 {
                     const csmInt32 clipDrawIndex = clipContext->_clippingIdList[i];
 
-                    // 頂点情報が更新されておらず、信頼性がない場合は描画をパスする
-                    if (!model.GetDrawableDynamicFlagVertexPositionsDidChange(clipDrawIndex))
-                    {
-                        continue;
-                    }
-
                     renderer->IsCulling(model.GetDrawableCulling(clipDrawIndex) != 0);
 
                     // 今回専用の変換を適用して描く
                     // チャンネルも切り替える必要がある(A,R,G,B)
                     renderer->SetClippingContextBufferForMask(clipContext);
-                    renderer->DrawMesh(
-                        model.GetDrawableTextureIndices(clipDrawIndex),
-                        model.GetDrawableVertexIndexCount(clipDrawIndex),
-                        model.GetDrawableVertexCount(clipDrawIndex),
-                        const_cast<csmUint16*>(model.GetDrawableVertexIndices(clipDrawIndex)),
-                        const_cast<csmFloat32*>(model.GetDrawableVertices(clipDrawIndex)),
-                        reinterpret_cast<csmFloat32*>(const_cast<Core::csmVector2*>(model.GetDrawableVertexUvs(clipDrawIndex))),
-                        model.GetDrawableOpacity(clipDrawIndex),
+                    renderer->DrawDrawableMesh(
+                        clipDrawIndex,
                         CubismRenderer::CubismBlendMode_Normal,   //クリッピングは通常描画を強制
                         false   // マスク生成時はクリッピングの反転使用は全く関係がない
                     );
@@ -282,6 +354,41 @@ void CubismClippingManager_OpenGLES2::SetupClippingContext(CubismModel& model, C
             glViewport(lastViewport[0], lastViewport[1], lastViewport[2], lastViewport[3]);
         }
     }
+
+    _maskCacheValid = renderer->IsUsingMaskCaching() && !renderer->IsUsingHighPrecisionMask();
+}
+
+csmBool CubismClippingManager_OpenGLES2::UpdateClippingContextBounds(CubismModel& model, CubismClippingContext* clippingContext)
+{
+    csmBool maskChanged = false;
+    for (csmInt32 i = 0; i < clippingContext->_clippingIdCount && !maskChanged; i++)
+    {
+        maskChanged = IsDrawableChanged(model, clippingContext->_clippingIdList[i]);
+    }
+
+    csmBool clippedChanged = false;
+    const csmInt32 clippedDrawCount = clippingContext->_clippedDrawableIndexList->GetSize();
+    for (csmInt32 i = 0; i < clippedDrawCount && !clippedChanged; i++)
+    {
+        clippedChanged = IsDrawableChanged(model, (*clippingContext->_clippedDrawableIndexList)[i]);
+    }
+
+    if (!clippedChanged)
+    {
+        return maskChanged;
+    }
+
+    // The mask matrices only change when the bounds do
+    const csmRectF lastRect = *clippingContext->_allClippedDrawRect;
+    const csmBool lastUsing = clippingContext->_isUsing;
+
+    CalcClippedDrawTotalBounds(model, clippingContext);
+
+    const csmRectF* rect = clippingContext->_allClippedDrawRect;
+    return maskChanged
+        || lastUsing != clippingContext->_isUsing
+        || lastRect.X != rect->X || lastRect.Y != rect->Y
+        || lastRect.Width != rect->Width || lastRect.Height != rect->Height;
 }
 
 void CubismClippingManager_OpenGLES2::CalcClippedDrawTotalBounds(CubismModel& model, CubismClippingContext* clippingContext)
@@ -301,6 +408,7 @@ void CubismClippingManager_OpenGLES2::CalcClippedDrawTotalBounds(CubismModel& mo
 
         const csmInt32 drawableVertexCount = model.GetDrawableVertexCount(drawableIndex);
         csmFloat32* drawableVertexes = const_cast<csmFloat32*>(model.GetDrawableVertices(drawableIndex));
+        _scannedVertexCount += drawableVertexCount;
 
         csmFloat32 minX = FLT_MAX, minY = FLT_MAX;
         csmFloat32 maxX = FLT_MIN, maxY = FLT_MIN;
@@ -483,6 +591,11 @@ csmInt32 CubismClippingManager_OpenGLES2::GetClippingMaskBufferSize() const
     return _clippingMaskBufferSize;
 }
 
+void CubismClippingManager_OpenGLES2::InvalidateMaskCache()
+{
+    _maskCacheValid = false;
+}
+
 /*********************************************************************************************************************
 *                                      CubismClippingContext
 ********************************************************************************************************************/
@@ -498,6 +611,8 @@ CubismClippingContext::CubismClippingContext(CubismClippingManager_OpenGLES2* ma
 
     _layoutChannelNo = 0;
 
+    _isDirty = true;
+
     _allClippedDrawRect = CSM_NEW csmRectF();
     _layoutBounds = CSM_NEW csmRectF();
 
@@ -588,9 +703,13 @@ void CubismRendererProfile_OpenGLES2::Save()
     glGetIntegerv(GL_BLEND_DST_ALPHA, &_lastBlending[3]);
 
     // モデル描画直前のFBOとビューポートを保存
+    SaveFrameBuffer();
+}
+
+void CubismRendererProfile_OpenGLES2::SaveFrameBuffer()
+{
     glGetIntegerv(GL_FRAMEBUFFER_BINDING, &_lastFBO);
     glGetIntegerv(GL_VIEWPORT, _lastViewport);
-
 }
 
 void CubismRendererProfile_OpenGLES2::Restore()
@@ -628,6 +747,696 @@ void CubismRendererProfile_OpenGLES2::Restore()
 }
 
 
+/*********************************************************************************************************************
+*                                      CubismStateCache_OpenGLES2
+********************************************************************************************************************/
+CubismStateCache_OpenGLES2::CubismStateCache_OpenGLES2() : _changeCount(0)
+                                                         , _skipCount(0)
+{
+    Invalidate();
+}
+
+void CubismStateCache_OpenGLES2::Invalidate()
+{
+    _programKnown = false;
+    _activeTextureKnown = false;
+    _blendingKnown = false;
+    _cullFaceKnown = false;
+    _frontFaceKnown = false;
+
+    for (csmInt32 i = 0; i < TextureUnitCount; i++)
+    {
+        _texturesKnown[i] = false;
+    }
+
+    for (csmInt32 i = 0; i < VertexAttribCount; i++)
+    {
+        _vertexAttribArraysKnown[i] = false;
+    }
+}
+
+void CubismStateCache_OpenGLES2::ResetCounters()
+{
+    _changeCount = 0;
+    _skipCount = 0;
+}
+
+void CubismStateCache_OpenGLES2::UseProgram(GLuint program)
+{
+    if (_programKnown && _program == program)
+    {
+        _skipCount++;
+        return;
+    }
+
+    glUseProgram(program);
+    _program = program;
+    _programKnown = true;
+    _changeCount++;
+}
+
+void CubismStateCache_OpenGLES2::ActiveTexture(csmInt32 unit)
+{
+    if (_activeTextureKnown && _activeTexture == unit)
+    {
+        _skipCount++;
+        return;
+    }
+
+    glActiveTexture(GL_TEXTURE0 + unit);
+    _activeTexture = unit;
+    _activeTextureKnown = true;
+    _changeCount++;
+}
+
+void CubismStateCache_OpenGLES2::BindTexture(csmInt32 unit, GLuint texture)
+{
+    if (_texturesKnown[unit] && _textures[unit] == texture)
+    {
+        _skipCount++;
+        return;
+    }
+
+    ActiveTexture(unit);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    _textures[unit] = texture;
+    _texturesKnown[unit] = true;
+    _changeCount++;
+}
+
+void CubismStateCache_OpenGLES2::BlendFuncSeparate(GLenum srcColor, GLenum dstColor, GLenum srcAlpha, GLenum dstAlpha)
+{
+    if (_blendingKnown
+        && _blending[0] == srcColor && _blending[1] == dstColor
+        && _blending[2] == srcAlpha && _blending[3] == dstAlpha)
+    {
+        _skipCount++;
+        return;
+    }
+
+    glBlendFuncSeparate(srcColor, dstColor, srcAlpha, dstAlpha);
+    _blending[0] = srcColor;
+    _blending[1] = dstColor;
+    _blending[2] = srcAlpha;
+    _blending[3] = dstAlpha;
+    _blendingKnown = true;
+    _changeCount++;
+}
+
+void CubismStateCache_OpenGLES2::EnableCullFace(csmBool enabled)
+{
+    if (_cullFaceKnown && _cullFace == enabled)
+    {
+        _skipCount++;
+        return;
+    }
+
+    if (enabled)
+    {
+        glEnable(GL_CULL_FACE);
+    }
+    else
+    {
+        glDisable(GL_CULL_FACE);
+    }
+    _cullFace = enabled;
+    _cullFaceKnown = true;
+    _changeCount++;
+}
+
+void CubismStateCache_OpenGLES2::FrontFace(GLenum mode)
+{
+    if (_frontFaceKnown && _frontFace == mode)
+    {
+        _skipCount++;
+        return;
+    }
+
+    glFrontFace(mode);
+    _frontFace = mode;
+    _frontFaceKnown = true;
+    _changeCount++;
+}
+
+void CubismStateCache_OpenGLES2::EnableVertexAttribArray(GLuint index, csmBool enabled)
+{
+    if (index < static_cast<GLuint>(VertexAttribCount))
+    {
+        if (_vertexAttribArraysKnown[index] && _vertexAttribArrays[index] == enabled)
+        {
+            _skipCount++;
+            return;
+        }
+
+        _vertexAttribArrays[index] = enabled;
+        _vertexAttribArraysKnown[index] = true;
+    }
+
+    if (enabled)
+    {
+        glEnableVertexAttribArray(index);
+    }
+    else
+    {
+        glDisableVertexAttribArray(index);
+    }
+    _changeCount++;
+}
+
+
+/*********************************************************************************************************************
+*                                      CubismMeshBuffer_OpenGLES2
+********************************************************************************************************************/
+namespace {
+const GLuint PositionAttributeLocation = 0;     ///< a_position is bound to this location before the shaders are linked
+const GLuint TexCoordAttributeLocation = 1;     ///< a_texCoord is bound to this location before the shaders are linked
+const GLuint OpacityAttributeLocation = 2;      ///< a_opacity is bound to this location before the shaders are linked
+const GLuint DrawableAttributeLocation = 3;     ///< a_drawable is bound to this location before the shaders are linked
+}
+
+CubismMeshBuffer_OpenGLES2::CubismMeshBuffer_OpenGLES2() : _uvBuffer(0)
+                                                         , _indexBuffer(0)
+                                                         , _drawableBuffer(0)
+                                                         , _currentBuffer(0)
+                                                         , _lastVertexArray(0)
+                                                         , _clientArraysBound(false)
+{
+    for (csmInt32 i = 0; i < StreamBufferCount; i++)
+    {
+        _positionBuffers[i] = 0;
+        _opacityBuffers[i] = 0;
+        _vertexArrays[i] = 0;
+    }
+}
+
+CubismMeshBuffer_OpenGLES2::~CubismMeshBuffer_OpenGLES2()
+{
+    Release();
+}
+
+csmBool CubismMeshBuffer_OpenGLES2::IsSupported()
+{
+#ifdef CSM_VERTEX_BUFFERS_SUPPORTED
+    return GLEW_VERSION_3_2 ? true : false;
+#else
+    return false;
+#endif
+}
+
+csmUint32 CubismMeshBuffer_OpenGLES2::Create(CubismModel& model)
+{
+    Release();
+
+#ifdef CSM_VERTEX_BUFFERS_SUPPORTED
+    const csmInt32 drawableCount = model.GetDrawableCount();
+
+    _vertexOffsets.Resize(drawableCount, 0);
+    _indexOffsets.Resize(drawableCount, 0);
+    _stalePositions.Resize(drawableCount, 0);
+    _staleOpacities.Resize(drawableCount, 0);
+
+    csmInt32 vertexCount = 0;
+    csmInt32 indexCount = 0;
+    csmInt32 maxVertexCount = 0;
+    for (csmInt32 i = 0; i < drawableCount; i++)
+    {
+        _vertexOffsets[i] = vertexCount;
+        _indexOffsets[i] = indexCount;
+        vertexCount += model.GetDrawableVertexCount(i);
+        indexCount += model.GetDrawableVertexIndexCount(i);
+
+        if (model.GetDrawableVertexCount(i) > maxVertexCount)
+        {
+            maxVertexCount = model.GetDrawableVertexCount(i);
+        }
+    }
+    _opacities.UpdateSize(maxVertexCount, 0.0f, false);
+    Invalidate();
+
+    const csmUint32 vertexBytes = vertexCount * sizeof(csmFloat32) * 2;
+    const csmUint32 indexBytes = indexCount * sizeof(csmUint16);
+
+    // Everything is uploaded through GL_ARRAY_BUFFER, binding GL_ELEMENT_ARRAY_BUFFER would change the vertex array object bound by the application
+    glGenBuffers(1, &_uvBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, _uvBuffer);
+    glBufferData(GL_ARRAY_BUFFER, vertexBytes, NULL, GL_STATIC_DRAW);
+    for (csmInt32 i = 0; i < drawableCount; i++)
+    {
+        glBufferSubData(GL_ARRAY_BUFFER, _vertexOffsets[i] * sizeof(csmFloat32) * 2
+                        , model.GetDrawableVertexCount(i) * sizeof(csmFloat32) * 2, model.GetDrawableVertexUvs(i));
+    }
+
+    glGenBuffers(1, &_indexBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, _indexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, indexBytes, NULL, GL_STATIC_DRAW);
+    for (csmInt32 i = 0; i < drawableCount; i++)
+    {
+        glBufferSubData(GL_ARRAY_BUFFER, _indexOffsets[i] * sizeof(csmUint16)
+                        , model.GetDrawableVertexIndexCount(i) * sizeof(csmUint16), model.GetDrawableVertexIndices(i));
+    }
+
+    // Lets the GLSL 330 shaders find the data of the drawable in the uniform buffers, also inside a batch
+    csmVector<csmFloat32> drawableIndices;
+    drawableIndices.UpdateSize(vertexCount, 0.0f, false);
+    for (csmInt32 i = 0; i < drawableCount; i++)
+    {
+        for (csmInt32 j = 0; j < model.GetDrawableVertexCount(i); j++)
+        {
+            drawableIndices[_vertexOffsets[i] + j] = static_cast<csmFloat32>(i);
+        }
+    }
+
+    glGenBuffers(1, &_drawableBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, _drawableBuffer);
+    glBufferData(GL_ARRAY_BUFFER, vertexCount * sizeof(csmFloat32), drawableIndices.GetPtr(), GL_STATIC_DRAW);
+
+    glGenBuffers(StreamBufferCount, _positionBuffers);
+    glGenBuffers(StreamBufferCount, _opacityBuffers);
+    glGenVertexArrays(StreamBufferCount, _vertexArrays);
+
+    GLint lastVertexArray;
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &lastVertexArray);
+
+    for (csmInt32 i = 0; i < StreamBufferCount; i++)
+    {
+        glBindVertexArray(_vertexArrays[i]);
+
+        glBindBuffer(GL_ARRAY_BUFFER, _positionBuffers[i]);
+        glBufferData(GL_ARRAY_BUFFER, vertexBytes, NULL, GL_DYNAMIC_DRAW);
+        glEnableVertexAttribArray(PositionAttributeLocation);
+        glVertexAttribPointer(PositionAttributeLocation, 2, GL_FLOAT, GL_FALSE, sizeof(csmFloat32) * 2, NULL);
+
+        glBindBuffer(GL_ARRAY_BUFFER, _uvBuffer);
+        glEnableVertexAttribArray(TexCoordAttributeLocation);
+        glVertexAttribPointer(TexCoordAttributeLocation, 2, GL_FLOAT, GL_FALSE, sizeof(csmFloat32) * 2, NULL);
+
+        glBindBuffer(GL_ARRAY_BUFFER, _opacityBuffers[i]);
+        glBufferData(GL_ARRAY_BUFFER, vertexCount * sizeof(csmFloat32), NULL, GL_DYNAMIC_DRAW);
+        glEnableVertexAttribArray(OpacityAttributeLocation);
+        glVertexAttribPointer(OpacityAttributeLocation, 1, GL_FLOAT, GL_FALSE, sizeof(csmFloat32), NULL);
+
+        glBindBuffer(GL_ARRAY_BUFFER, _drawableBuffer);
+        glEnableVertexAttribArray(DrawableAttributeLocation);
+        glVertexAttribPointer(DrawableAttributeLocation, 1, GL_FLOAT, GL_FALSE, sizeof(csmFloat32), NULL);
+
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indexBuffer);
+    }
+
+    glBindVertexArray(lastVertexArray);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    _currentBuffer = 0;
+
+    return vertexBytes + indexBytes + vertexCount * sizeof(csmFloat32);
+#else
+    return 0;
+#endif
+}
+
+void CubismMeshBuffer_OpenGLES2::Release()
+{
+#ifdef CSM_VERTEX_BUFFERS_SUPPORTED
+    if (_uvBuffer == 0)
+    {
+        return;
+    }
+
+    glDeleteVertexArrays(StreamBufferCount, _vertexArrays);
+    glDeleteBuffers(StreamBufferCount, _opacityBuffers);
+    glDeleteBuffers(StreamBufferCount, _positionBuffers);
+    glDeleteBuffers(1, &_drawableBuffer);
+    glDeleteBuffers(1, &_indexBuffer);
+    glDeleteBuffers(1, &_uvBuffer);
+
+    for (csmInt32 i = 0; i < StreamBufferCount; i++)
+    {
+        _positionBuffers[i] = 0;
+        _opacityBuffers[i] = 0;
+        _vertexArrays[i] = 0;
+    }
+    _drawableBuffer = 0;
+    _indexBuffer = 0;
+    _uvBuffer = 0;
+#endif
+}
+
+csmBool CubismMeshBuffer_OpenGLES2::IsCreated() const
+{
+    return _uvBuffer != 0;
+}
+
+csmUint32 CubismMeshBuffer_OpenGLES2::Update(CubismModel& model, csmBool opacities)
+{
+    csmUint32 uploadedBytes = 0;
+
+#ifdef CSM_VERTEX_BUFFERS_SUPPORTED
+    const csmUint8 allBuffers = (1 << StreamBufferCount) - 1;
+
+    _currentBuffer = (_currentBuffer + 1) % StreamBufferCount;
+    const csmUint8 currentBit = static_cast<csmUint8>(1 << _currentBuffer);
+
+    const csmInt32 drawableCount = model.GetDrawableCount();
+
+    glBindBuffer(GL_ARRAY_BUFFER, _positionBuffers[_currentBuffer]);
+    for (csmInt32 i = 0; i < drawableCount; i++)
+    {
+        if (model.GetDrawableDynamicFlagVertexPositionsDidChange(i))
+        {
+            _stalePositions[i] = allBuffers;
+        }
+
+        if ((_stalePositions[i] & currentBit) == 0)
+        {
+            continue;
+        }
+
+        const csmUint32 bytes = model.GetDrawableVertexCount(i) * sizeof(csmFloat32) * 2;
+        glBufferSubData(GL_ARRAY_BUFFER, _vertexOffsets[i] * sizeof(csmFloat32) * 2, bytes, model.GetDrawableVertices(i));
+        _stalePositions[i] &= ~currentBit;
+        uploadedBytes += bytes;
+    }
+
+    // The opacity is repeated on every vertex so that drawables batched into one draw call keep their own opacity
+    glBindBuffer(GL_ARRAY_BUFFER, _opacityBuffers[_currentBuffer]);
+    for (csmInt32 i = 0; opacities && i < drawableCount; i++)
+    {
+        if (model.GetDrawableDynamicFlagOpacityDidChange(i))
+        {
+            _staleOpacities[i] = allBuffers;
+        }
+
+        if ((_staleOpacities[i] & currentBit) == 0)
+        {
+            continue;
+        }
+
+        const csmInt32 vertexCount = model.GetDrawableVertexCount(i);
+        const csmFloat32 opacity = model.GetDrawableOpacity(i);
+        for (csmInt32 j = 0; j < vertexCount; j++)
+        {
+            _opacities[j] = opacity;
+        }
+
+        const csmUint32 bytes = vertexCount * sizeof(csmFloat32);
+        glBufferSubData(GL_ARRAY_BUFFER, _vertexOffsets[i] * sizeof(csmFloat32), bytes, _opacities.GetPtr());
+        _staleOpacities[i] &= ~currentBit;
+        uploadedBytes += bytes;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &_lastVertexArray);
+#endif
+
+    return uploadedBytes;
+}
+
+void CubismMeshBuffer_OpenGLES2::Invalidate()
+{
+    const csmUint8 allBuffers = (1 << StreamBufferCount) - 1;
+
+    for (csmUint32 i = 0; i < _stalePositions.GetSize(); i++)
+    {
+        _stalePositions[i] = allBuffers;
+        _staleOpacities[i] = allBuffers;
+    }
+}
+
+void CubismMeshBuffer_OpenGLES2::Bind() const
+{
+#ifdef CSM_VERTEX_BUFFERS_SUPPORTED
+    glBindVertexArray(_vertexArrays[_currentBuffer]);
+#endif
+}
+
+void CubismMeshBuffer_OpenGLES2::BindClientArrays()
+{
+#ifdef CSM_VERTEX_BUFFERS_SUPPORTED
+    // vertex array objects came with OpenGL 3.0, before that there's only the default one
+    _clientArraysBound = GLEW_VERSION_3_0 ? true : false;
+    if (_clientArraysBound)
+    {
+        glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &_lastVertexArray);
+        glBindVertexArray(0);
+    }
+#endif
+}
+
+void CubismMeshBuffer_OpenGLES2::Unbind() const
+{
+#ifdef CSM_VERTEX_BUFFERS_SUPPORTED
+    if (IsCreated() || _clientArraysBound)
+    {
+        glBindVertexArray(_lastVertexArray);
+    }
+#endif
+}
+
+csmInt32 CubismMeshBuffer_OpenGLES2::GetBaseVertex(csmInt32 drawableIndex) const
+{
+    return _vertexOffsets[drawableIndex];
+}
+
+const void* CubismMeshBuffer_OpenGLES2::GetIndexOffset(csmInt32 drawableIndex) const
+{
+    return reinterpret_cast<const void*>(static_cast<csmSizeType>(_indexOffsets[drawableIndex]) * sizeof(csmUint16));
+}
+
+
+/*********************************************************************************************************************
+*                                      CubismUniformBuffer_OpenGLES2
+********************************************************************************************************************/
+namespace {
+const GLuint FrameBlockBinding = 0;         ///< Binding point of the CubismFrame block
+const GLuint ClipBlockBinding = 1;          ///< Binding point of the CubismClips block
+const GLuint DrawableBlockBinding = 2;      ///< Binding point of the CubismDrawables block
+const csmInt32 FrameBlockFloatCount = 16 + 4;   ///< mat4 u_matrix and vec4 u_baseColor
+const csmInt32 ClipFloatCount = 16 + 4;         ///< mat4 of u_clipMatrices and vec4 of u_channelFlags, per clipping context
+const csmInt32 DrawableFloatCount = 4;          ///< vec4 of u_drawables, per drawable
+}
+
+CubismUniformBuffer_OpenGLES2::CubismUniformBuffer_OpenGLES2() : _frameBuffer(0)
+                                                               , _clipBuffer(0)
+                                                               , _drawableBuffer(0)
+                                                               , _drawablesStale(false)
+{ }
+
+CubismUniformBuffer_OpenGLES2::~CubismUniformBuffer_OpenGLES2()
+{
+    Release();
+}
+
+csmBool CubismUniformBuffer_OpenGLES2::IsSupported(CubismModel& model, CubismClippingManager_OpenGLES2* clippingManager)
+{
+#ifdef CSM_VERTEX_BUFFERS_SUPPORTED
+    if (!GLEW_VERSION_3_3)
+    {
+        return false;
+    }
+
+    if (model.GetDrawableCount() > MaxDrawableCount)
+    {
+        return false;
+    }
+
+    if (clippingManager != NULL && clippingManager->_clippingContextListForMask.GetSize() > static_cast<csmUint32>(MaxClipContextCount))
+    {
+        return false;
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+csmUint32 CubismUniformBuffer_OpenGLES2::Create(CubismModel& model, CubismClippingManager_OpenGLES2* clippingManager)
+{
+    Release();
+
+#ifdef CSM_VERTEX_BUFFERS_SUPPORTED
+    const csmInt32 drawableCount = model.GetDrawableCount();
+
+    // x: opacity, y: index of the clipping context in CubismClips
+    _drawables.UpdateSize(drawableCount * DrawableFloatCount, 0.0f, false);
+    for (csmInt32 i = 0; i < drawableCount; i++)
+    {
+        csmFloat32 clipIndex = -1.0f;
+        if (clippingManager != NULL)
+        {
+            CubismClippingContext* clipContext = (*clippingManager->GetClippingContextListForDraw())[i];
+            for (csmUint32 j = 0; j < clippingManager->_clippingContextListForMask.GetSize(); j++)
+            {
+                if (clippingManager->_clippingContextListForMask[j] == clipContext)
+                {
+                    clipIndex = static_cast<csmFloat32>(j);
+                    break;
+                }
+            }
+        }
+
+        _drawables[i * DrawableFloatCount + 0] = model.GetDrawableOpacity(i);
+        _drawables[i * DrawableFloatCount + 1] = clipIndex;
+        _drawables[i * DrawableFloatCount + 2] = 0.0f;
+        _drawables[i * DrawableFloatCount + 3] = 0.0f;
+    }
+    _drawablesStale = false;
+
+    _clips.UpdateSize(MaxClipContextCount * ClipFloatCount, 0.0f, false);
+
+    const csmUint32 drawableBytes = drawableCount * DrawableFloatCount * sizeof(csmFloat32);
+
+    // The buffers are as large as the blocks declared in the shaders, whatever the model uses
+    glGenBuffers(1, &_frameBuffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, _frameBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, FrameBlockFloatCount * sizeof(csmFloat32), NULL, GL_DYNAMIC_DRAW);
+
+    glGenBuffers(1, &_clipBuffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, _clipBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, MaxClipContextCount * ClipFloatCount * sizeof(csmFloat32), NULL, GL_DYNAMIC_DRAW);
+
+    glGenBuffers(1, &_drawableBuffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, _drawableBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, MaxDrawableCount * DrawableFloatCount * sizeof(csmFloat32), NULL, GL_DYNAMIC_DRAW);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, drawableBytes, _drawables.GetPtr());
+
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    return drawableBytes;
+#else
+    return 0;
+#endif
+}
+
+void CubismUniformBuffer_OpenGLES2::Release()
+{
+#ifdef CSM_VERTEX_BUFFERS_SUPPORTED
+    if (_frameBuffer == 0)
+    {
+        return;
+    }
+
+    glDeleteBuffers(1, &_drawableBuffer);
+    glDeleteBuffers(1, &_clipBuffer);
+    glDeleteBuffers(1, &_frameBuffer);
+
+    _drawableBuffer = 0;
+    _clipBuffer = 0;
+    _frameBuffer = 0;
+#endif
+}
+
+csmBool CubismUniformBuffer_OpenGLES2::IsCreated() const
+{
+    return _frameBuffer != 0;
+}
+
+csmUint32 CubismUniformBuffer_OpenGLES2::UpdateDrawables(CubismModel& model)
+{
+    csmUint32 uploadedBytes = 0;
+
+#ifdef CSM_VERTEX_BUFFERS_SUPPORTED
+    const csmBool readAll = _drawablesStale;
+    const csmInt32 drawableCount = model.GetDrawableCount();
+    csmInt32 firstChanged = drawableCount;
+    csmInt32 lastChanged = -1;
+    for (csmInt32 i = 0; i < drawableCount; i++)
+    {
+        if (readAll || model.GetDrawableDynamicFlagOpacityDidChange(i))
+        {
+            _drawables[i * DrawableFloatCount] = model.GetDrawableOpacity(i);
+            if (firstChanged > i)
+            {
+                firstChanged = i;
+            }
+            lastChanged = i;
+        }
+    }
+
+    if (lastChanged < 0)
+    {
+        return 0;
+    }
+
+    // One upload of the changed range is cheaper than one per drawable
+    const csmUint32 rangeOffset = firstChanged * DrawableFloatCount * sizeof(csmFloat32);
+    uploadedBytes = (lastChanged - firstChanged + 1) * DrawableFloatCount * sizeof(csmFloat32);
+    glBindBuffer(GL_UNIFORM_BUFFER, _drawableBuffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, rangeOffset, uploadedBytes, _drawables.GetPtr() + firstChanged * DrawableFloatCount);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    _drawablesStale = false;
+#endif
+
+    return uploadedBytes;
+}
+
+csmUint32 CubismUniformBuffer_OpenGLES2::UpdateFrame(CubismMatrix44& matrix, const CubismRenderer::CubismTextureColor& baseColor
+                                                     , CubismClippingManager_OpenGLES2* clippingManager)
+{
+    csmUint32 uploadedBytes = 0;
+
+#ifdef CSM_VERTEX_BUFFERS_SUPPORTED
+    csmFloat32 frame[FrameBlockFloatCount];
+    const csmFloat32* matrixArray = matrix.GetArray();
+    for (csmInt32 i = 0; i < 16; i++)
+    {
+        frame[i] = matrixArray[i];
+    }
+    frame[16] = baseColor.R;
+    frame[17] = baseColor.G;
+    frame[18] = baseColor.B;
+    frame[19] = baseColor.A;
+
+    glBindBuffer(GL_UNIFORM_BUFFER, _frameBuffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(frame), frame);
+    uploadedBytes += sizeof(frame);
+
+    if (clippingManager != NULL)
+    {
+        // std140 puts the vec4 array after the whole mat4 array
+        const csmInt32 clipCount = clippingManager->_clippingContextListForMask.GetSize();
+        csmFloat32* matrices = _clips.GetPtr();
+        csmFloat32* channelFlags = matrices + MaxClipContextCount * 16;
+
+        for (csmInt32 i = 0; i < clipCount; i++)
+        {
+            CubismClippingContext* clipContext = clippingManager->_clippingContextListForMask[i];
+
+            const csmFloat32* clipMatrix = clipContext->_matrixForDraw.GetArray();
+            for (csmInt32 j = 0; j < 16; j++)
+            {
+                matrices[i * 16 + j] = clipMatrix[j];
+            }
+
+            CubismRenderer::CubismTextureColor* colorChannel = clippingManager->GetChannelFlagAsColor(clipContext->_layoutChannelNo);
+            channelFlags[i * 4 + 0] = colorChannel->R;
+            channelFlags[i * 4 + 1] = colorChannel->G;
+            channelFlags[i * 4 + 2] = colorChannel->B;
+            channelFlags[i * 4 + 3] = colorChannel->A;
+        }
+
+        glBindBuffer(GL_UNIFORM_BUFFER, _clipBuffer);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, clipCount * 16 * sizeof(csmFloat32), matrices);
+        glBufferSubData(GL_UNIFORM_BUFFER, MaxClipContextCount * 16 * sizeof(csmFloat32), clipCount * 4 * sizeof(csmFloat32), channelFlags);
+        uploadedBytes += clipCount * ClipFloatCount * sizeof(csmFloat32);
+    }
+
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    glBindBufferBase(GL_UNIFORM_BUFFER, FrameBlockBinding, _frameBuffer);
+    glBindBufferBase(GL_UNIFORM_BUFFER, ClipBlockBinding, _clipBuffer);
+    glBindBufferBase(GL_UNIFORM_BUFFER, DrawableBlockBinding, _drawableBuffer);
+#endif
+
+    return uploadedBytes;
+}
+
+void CubismUniformBuffer_OpenGLES2::Invalidate()
+{
+    _drawablesStale = true;
+}
+
+
 /*********************************************************************************************************************
 *                                       CubismShader_OpenGLES2
 ********************************************************************************************************************/
@@ -677,6 +1486,22 @@ void CubismShader_OpenGLES2::ReleaseShaderProgram()
             CSM_DELETE(_shaderSets[i]);
         }
     }
+
+    ReleaseUniformBufferShaders();
+}
+
+void CubismShader_OpenGLES2::ReleaseUniformBufferShaders()
+{
+    // Sets 7 to 18 share the programs of sets 1 to 6
+    for (csmUint32 i = 0; i < _uniformBufferShaderSets.GetSize(); i++)
+    {
+        if (i <= ShaderNames_NormalMaskedInvertedPremultipliedAlpha && _uniformBufferShaderSets[i]->ShaderProgram)
+        {
+            glDeleteProgram(_uniformBufferShaderSets[i]->ShaderProgram);
+        }
+        CSM_DELETE(_uniformBufferShaderSets[i]);
+    }
+    _uniformBufferShaderSets.Clear();
 }
 
 // SetupMask
@@ -743,6 +1568,7 @@ static const csmChar* FragShaderSrcSetupMaskTegra =
 #endif
 
 //----- バーテックスシェーダプログラム -----
+// a_opacity is the drawable opacity repeated on each vertex, so batched drawables can share one draw call
 // Normal & Add & Mult 共通
 static const csmChar* VertShaderSrc =
 #if defined(CSM_TARGET_IPHONE_ES2) || defined(CSM_TARGET_ANDROID_ES2)
@@ -752,11 +1578,14 @@ static const csmChar* VertShaderSrc =
 #endif
         "attribute vec4 a_position;" //v.vertex
         "attribute vec2 a_texCoord;" //v.texcoord
+        "attribute float a_opacity;"
         "varying vec2 v_texCoord;" //v2f.texcoord
+        "varying float v_opacity;"
         "uniform mat4 u_matrix;"
         "void main()"
         "{"
         "gl_Position = u_matrix * a_position;"
+        "v_opacity = a_opacity;"
         "v_texCoord = a_texCoord;"
         "v_texCoord.y = 1.0 - v_texCoord.y;"
         "}";
@@ -770,7 +1599,9 @@ static const csmChar* VertShaderSrcMasked =
 #endif
         "attribute vec4 a_position;"
         "attribute vec2 a_texCoord;"
+        "attribute float a_opacity;"
         "varying vec2 v_texCoord;"
+        "varying float v_opacity;"
         "varying vec4 v_clipPos;"
         "uniform mat4 u_matrix;"
         "uniform mat4 u_clipMatrix;"
@@ -778,6 +1609,7 @@ static const csmChar* VertShaderSrcMasked =
         "{"
         "gl_Position = u_matrix * a_position;"
         "v_clipPos = u_clipMatrix * a_position;"
+        "v_opacity = a_opacity;"
         "v_texCoord = a_texCoord;"
         "v_texCoord.y = 1.0 - v_texCoord.y;"
         "}";
@@ -792,11 +1624,12 @@ static const csmChar* FragShaderSrc =
         "#version 120\n"
 #endif
         "varying vec2 v_texCoord;" //v2f.texcoord
+        "varying float v_opacity;"
         "uniform sampler2D s_texture0;" //_MainTex
         "uniform vec4 u_baseColor;" //v2f.color
         "void main()"
         "{"
-        "vec4 color = texture2D(s_texture0 , v_texCoord) * u_baseColor;"
+        "vec4 color = texture2D(s_texture0 , v_texCoord) * vec4(u_baseColor.rgb, u_baseColor.a * v_opacity);"
         "gl_FragColor = vec4(color.rgb * color.a,  color.a);"
         "}";
 #if defined(CSM_TARGET_ANDROID_ES2)
@@ -805,11 +1638,12 @@ static const csmChar* FragShaderSrcTegra =
         "#extension GL_NV_shader_framebuffer_fetch : enable\n"
         "precision mediump float;"
         "varying vec2 v_texCoord;" //v2f.texcoord
+        "varying float v_opacity;"
         "uniform sampler2D s_texture0;" //_MainTex
         "uniform vec4 u_baseColor;" //v2f.color
         "void main()"
         "{"
-        "vec4 color = texture2D(s_texture0 , v_texCoord) * u_baseColor;"
+        "vec4 color = texture2D(s_texture0 , v_texCoord) * vec4(u_baseColor.rgb, u_baseColor.a * v_opacity);"
         "gl_FragColor = vec4(color.rgb * color.a,  color.a);"
         "}";
 #endif
@@ -823,11 +1657,12 @@ static const csmChar* FragShaderSrcPremultipliedAlpha =
         "#version 120\n"
 #endif
         "varying vec2 v_texCoord;" //v2f.texcoord
+        "varying float v_opacity;"
         "uniform sampler2D s_texture0;" //_MainTex
         "uniform vec4 u_baseColor;" //v2f.color
         "void main()"
         "{"
-        "gl_FragColor = texture2D(s_texture0 , v_texCoord) * u_baseColor;"
+        "gl_FragColor = texture2D(s_texture0 , v_texCoord) * (u_baseColor * v_opacity);"
         "}";
 #if defined(CSM_TARGET_ANDROID_ES2)
 static const csmChar* FragShaderSrcPremultipliedAlphaTegra =
@@ -835,11 +1670,12 @@ static const csmChar* FragShaderSrcPremultipliedAlphaTegra =
         "#extension GL_NV_shader_framebuffer_fetch : enable\n"
         "precision mediump float;"
         "varying vec2 v_texCoord;" //v2f.texcoord
+        "varying float v_opacity;"
         "uniform sampler2D s_texture0;" //_MainTex
         "uniform vec4 u_baseColor;" //v2f.color
         "void main()"
         "{"
-        "gl_FragColor = texture2D(s_texture0 , v_texCoord) * u_baseColor;"
+        "gl_FragColor = texture2D(s_texture0 , v_texCoord) * (u_baseColor * v_opacity);"
         "}";
 #endif
 
@@ -852,6 +1688,7 @@ static const csmChar* FragShaderSrcMask =
         "#version 120\n"
 #endif
         "varying vec2 v_texCoord;"
+        "varying float v_opacity;"
         "varying vec4 v_clipPos;"
         "uniform sampler2D s_texture0;"
         "uniform sampler2D s_texture1;"
@@ -859,7 +1696,7 @@ static const csmChar* FragShaderSrcMask =
         "uniform vec4 u_baseColor;"
         "void main()"
         "{"
-        "vec4 col_formask = texture2D(s_texture0 , v_texCoord) * u_baseColor;"
+        "vec4 col_formask = texture2D(s_texture0 , v_texCoord) * vec4(u_baseColor.rgb, u_baseColor.a * v_opacity);"
         "col_formask.rgb = col_formask.rgb  * col_formask.a ;"
         "vec4 clipMask = (1.0 - texture2D(s_texture1, v_clipPos.xy / v_clipPos.w)) * u_channelFlag;"
         "float maskVal = clipMask.r + clipMask.g + clipMask.b + clipMask.a;"
@@ -872,6 +1709,7 @@ static const csmChar* FragShaderSrcMaskTegra =
         "#extension GL_NV_shader_framebuffer_fetch : enable\n"
         "precision mediump float;"
         "varying vec2 v_texCoord;"
+        "varying float v_opacity;"
         "varying vec4 v_clipPos;"
         "uniform sampler2D s_texture0;"
         "uniform sampler2D s_texture1;"
@@ -879,7 +1717,7 @@ static const csmChar* FragShaderSrcMaskTegra =
         "uniform vec4 u_baseColor;"
         "void main()"
         "{"
-        "vec4 col_formask = texture2D(s_texture0 , v_texCoord) * u_baseColor;"
+        "vec4 col_formask = texture2D(s_texture0 , v_texCoord) * vec4(u_baseColor.rgb, u_baseColor.a * v_opacity);"
         "col_formask.rgb = col_formask.rgb  * col_formask.a ;"
         "vec4 clipMask = (1.0 - texture2D(s_texture1, v_clipPos.xy / v_clipPos.w)) * u_channelFlag;"
         "float maskVal = clipMask.r + clipMask.g + clipMask.b + clipMask.a;"
@@ -897,6 +1735,7 @@ static const csmChar* FragShaderSrcMaskInverted =
         "#version 120\n"
 #endif
         "varying vec2 v_texCoord;"
+        "varying float v_opacity;"
         "varying vec4 v_clipPos;"
         "uniform sampler2D s_texture0;"
         "uniform sampler2D s_texture1;"
@@ -904,7 +1743,7 @@ static const csmChar* FragShaderSrcMaskInverted =
         "uniform vec4 u_baseColor;"
         "void main()"
         "{"
-        "vec4 col_formask = texture2D(s_texture0 , v_texCoord) * u_baseColor;"
+        "vec4 col_formask = texture2D(s_texture0 , v_texCoord) * vec4(u_baseColor.rgb, u_baseColor.a * v_opacity);"
         "col_formask.rgb = col_formask.rgb  * col_formask.a ;"
         "vec4 clipMask = (1.0 - texture2D(s_texture1, v_clipPos.xy / v_clipPos.w)) * u_channelFlag;"
         "float maskVal = clipMask.r + clipMask.g + clipMask.b + clipMask.a;"
@@ -917,6 +1756,7 @@ static const csmChar* FragShaderSrcMaskInvertedTegra =
         "#extension GL_NV_shader_framebuffer_fetch : enable\n"
         "precision mediump float;"
         "varying vec2 v_texCoord;"
+        "varying float v_opacity;"
         "varying vec4 v_clipPos;"
         "uniform sampler2D s_texture0;"
         "uniform sampler2D s_texture1;"
@@ -924,7 +1764,7 @@ static const csmChar* FragShaderSrcMaskInvertedTegra =
         "uniform vec4 u_baseColor;"
         "void main()"
         "{"
-        "vec4 col_formask = texture2D(s_texture0 , v_texCoord) * u_baseColor;"
+        "vec4 col_formask = texture2D(s_texture0 , v_texCoord) * vec4(u_baseColor.rgb, u_baseColor.a * v_opacity);"
         "col_formask.rgb = col_formask.rgb  * col_formask.a ;"
         "vec4 clipMask = (1.0 - texture2D(s_texture1, v_clipPos.xy / v_clipPos.w)) * u_channelFlag;"
         "float maskVal = clipMask.r + clipMask.g + clipMask.b + clipMask.a;"
@@ -942,6 +1782,7 @@ static const csmChar* FragShaderSrcMaskPremultipliedAlpha =
         "#version 120\n"
 #endif
         "varying vec2 v_texCoord;"
+        "varying float v_opacity;"
         "varying vec4 v_clipPos;"
         "uniform sampler2D s_texture0;"
         "uniform sampler2D s_texture1;"
@@ -949,7 +1790,7 @@ static const csmChar* FragShaderSrcMaskPremultipliedAlpha =
         "uniform vec4 u_baseColor;"
         "void main()"
         "{"
-        "vec4 col_formask = texture2D(s_texture0 , v_texCoord) * u_baseColor;"
+        "vec4 col_formask = texture2D(s_texture0 , v_texCoord) * (u_baseColor * v_opacity);"
         "vec4 clipMask = (1.0 - texture2D(s_texture1, v_clipPos.xy / v_clipPos.w)) * u_channelFlag;"
         "float maskVal = clipMask.r + clipMask.g + clipMask.b + clipMask.a;"
         "col_formask = col_formask * maskVal;"
@@ -961,6 +1802,7 @@ static const csmChar* FragShaderSrcMaskPremultipliedAlphaTegra =
         "#extension GL_NV_shader_framebuffer_fetch : enable\n"
         "precision mediump float;"
         "varying vec2 v_texCoord;"
+        "varying float v_opacity;"
         "varying vec4 v_clipPos;"
         "uniform sampler2D s_texture0;"
         "uniform sampler2D s_texture1;"
@@ -968,7 +1810,7 @@ static const csmChar* FragShaderSrcMaskPremultipliedAlphaTegra =
         "uniform vec4 u_baseColor;"
         "void main()"
         "{"
-        "vec4 col_formask = texture2D(s_texture0 , v_texCoord) * u_baseColor;"
+        "vec4 col_formask = texture2D(s_texture0 , v_texCoord) * (u_baseColor * v_opacity);"
         "vec4 clipMask = (1.0 - texture2D(s_texture1, v_clipPos.xy / v_clipPos.w)) * u_channelFlag;"
         "float maskVal = clipMask.r + clipMask.g + clipMask.b + clipMask.a;"
         "col_formask = col_formask * maskVal;"
@@ -985,37 +1827,230 @@ static const csmChar* FragShaderSrcMaskInvertedPremultipliedAlpha =
         "#version 120\n"
 #endif
         "varying vec2 v_texCoord;"
+        "varying float v_opacity;"
+        "varying vec4 v_clipPos;"
+        "uniform sampler2D s_texture0;"
+        "uniform sampler2D s_texture1;"
+        "uniform vec4 u_channelFlag;"
+        "uniform vec4 u_baseColor;"
+        "void main()"
+        "{"
+        "vec4 col_formask = texture2D(s_texture0 , v_texCoord) * (u_baseColor * v_opacity);"
+        "vec4 clipMask = (1.0 - texture2D(s_texture1, v_clipPos.xy / v_clipPos.w)) * u_channelFlag;"
+        "float maskVal = clipMask.r + clipMask.g + clipMask.b + clipMask.a;"
+        "col_formask = col_formask * (1.0 - maskVal);"
+        "gl_FragColor = col_formask;"
+        "}";
+#if defined(CSM_TARGET_ANDROID_ES2)
+static const csmChar* FragShaderSrcMaskInvertedPremultipliedAlphaTegra =
+        "#version 100\n"
+        "#extension GL_NV_shader_framebuffer_fetch : enable\n"
+        "precision mediump float;"
+        "varying vec2 v_texCoord;"
+        "varying float v_opacity;"
         "varying vec4 v_clipPos;"
         "uniform sampler2D s_texture0;"
         "uniform sampler2D s_texture1;"
-        "uniform vec4 u_channelFlag;"
-        "uniform vec4 u_baseColor;"
+        "uniform vec4 u_channelFlag;"
+        "uniform vec4 u_baseColor;"
+        "void main()"
+        "{"
+        "vec4 col_formask = texture2D(s_texture0 , v_texCoord) * (u_baseColor * v_opacity);"
+        "vec4 clipMask = (1.0 - texture2D(s_texture1, v_clipPos.xy / v_clipPos.w)) * u_channelFlag;"
+        "float maskVal = clipMask.r + clipMask.g + clipMask.b + clipMask.a;"
+        "col_formask = col_formask * (1.0 - maskVal);"
+        "gl_FragColor = col_formask;"
+        "}";
+#endif
+
+#ifdef CSM_VERTEX_BUFFERS_SUPPORTED
+//----- GLSL 3.30 shader programs for CubismUniformBuffer_OpenGLES2 -----
+// The matrices, colors and opacities are read from uniform blocks, a_drawable selects the entry of the drawable
+
+// SetupMask
+static const csmChar* VertShaderSrcSetupMaskGl33 =
+        "#version 330\n"
+        "in vec4 a_position;"
+        "in vec2 a_texCoord;"
+        "out vec2 v_texCoord;"
+        "out vec4 v_myPos;"
+        "uniform mat4 u_clipMatrix;"
+        "void main()"
+        "{"
+        "gl_Position = u_clipMatrix * a_position;"
+        "v_myPos = u_clipMatrix * a_position;"
+        "v_texCoord = a_texCoord;"
+        "v_texCoord.y = 1.0 - v_texCoord.y;"
+        "}";
+static const csmChar* FragShaderSrcSetupMaskGl33 =
+        "#version 330\n"
+        "in vec2 v_texCoord;"
+        "in vec4 v_myPos;"
+        "out vec4 fragColor;"
+        "uniform sampler2D s_texture0;"
+        "uniform vec4 u_channelFlag;"
+        "uniform vec4 u_baseColor;"
+        "void main()"
+        "{"
+        "float isInside = "
+        "  step(u_baseColor.x, v_myPos.x/v_myPos.w)"
+        "* step(u_baseColor.y, v_myPos.y/v_myPos.w)"
+        "* step(v_myPos.x/v_myPos.w, u_baseColor.z)"
+        "* step(v_myPos.y/v_myPos.w, u_baseColor.w);"
+
+        "fragColor = u_channelFlag * texture(s_texture0 , v_texCoord).a * isInside;"
+        "}";
+
+// Normal & Add & Mult 共通
+static const csmChar* VertShaderSrcGl33 =
+        "#version 330\n"
+        "layout(std140) uniform CubismFrame { mat4 u_matrix; vec4 u_baseColor; };"
+        "layout(std140) uniform CubismDrawables { vec4 u_drawables[1024]; };"
+        "in vec4 a_position;"
+        "in vec2 a_texCoord;"
+        "in float a_drawable;"
+        "out vec2 v_texCoord;"
+        "flat out float v_opacity;"
+        "void main()"
+        "{"
+        "gl_Position = u_matrix * a_position;"
+        "v_opacity = u_drawables[int(a_drawable)].x;"
+        "v_texCoord = a_texCoord;"
+        "v_texCoord.y = 1.0 - v_texCoord.y;"
+        "}";
+
+// Normal & Add & Mult 共通（クリッピングされたものの描画用）
+static const csmChar* VertShaderSrcMaskedGl33 =
+        "#version 330\n"
+        "layout(std140) uniform CubismFrame { mat4 u_matrix; vec4 u_baseColor; };"
+        "layout(std140) uniform CubismClips { mat4 u_clipMatrices[64]; vec4 u_channelFlags[64]; };"
+        "layout(std140) uniform CubismDrawables { vec4 u_drawables[1024]; };"
+        "in vec4 a_position;"
+        "in vec2 a_texCoord;"
+        "in float a_drawable;"
+        "out vec2 v_texCoord;"
+        "flat out float v_opacity;"
+        "out vec4 v_clipPos;"
+        "flat out vec4 v_channelFlag;"
+        "void main()"
+        "{"
+        "vec4 drawable = u_drawables[int(a_drawable)];"
+        "int clip = int(drawable.y);"
+        "gl_Position = u_matrix * a_position;"
+        "v_clipPos = u_clipMatrices[clip] * a_position;"
+        "v_channelFlag = u_channelFlags[clip];"
+        "v_opacity = drawable.x;"
+        "v_texCoord = a_texCoord;"
+        "v_texCoord.y = 1.0 - v_texCoord.y;"
+        "}";
+
+// Normal & Add & Mult 共通
+static const csmChar* FragShaderSrcGl33 =
+        "#version 330\n"
+        "layout(std140) uniform CubismFrame { mat4 u_matrix; vec4 u_baseColor; };"
+        "in vec2 v_texCoord;"
+        "flat in float v_opacity;"
+        "out vec4 fragColor;"
+        "uniform sampler2D s_texture0;"
+        "void main()"
+        "{"
+        "vec4 color = texture(s_texture0 , v_texCoord) * vec4(u_baseColor.rgb, u_baseColor.a * v_opacity);"
+        "fragColor = vec4(color.rgb * color.a,  color.a);"
+        "}";
+
+// Normal & Add & Mult 共通 （PremultipliedAlpha）
+static const csmChar* FragShaderSrcPremultipliedAlphaGl33 =
+        "#version 330\n"
+        "layout(std140) uniform CubismFrame { mat4 u_matrix; vec4 u_baseColor; };"
+        "in vec2 v_texCoord;"
+        "flat in float v_opacity;"
+        "out vec4 fragColor;"
+        "uniform sampler2D s_texture0;"
+        "void main()"
+        "{"
+        "fragColor = texture(s_texture0 , v_texCoord) * (u_baseColor * v_opacity);"
+        "}";
+
+// Normal & Add & Mult 共通（クリッピングされたものの描画用）
+static const csmChar* FragShaderSrcMaskGl33 =
+        "#version 330\n"
+        "layout(std140) uniform CubismFrame { mat4 u_matrix; vec4 u_baseColor; };"
+        "in vec2 v_texCoord;"
+        "flat in float v_opacity;"
+        "in vec4 v_clipPos;"
+        "flat in vec4 v_channelFlag;"
+        "out vec4 fragColor;"
+        "uniform sampler2D s_texture0;"
+        "uniform sampler2D s_texture1;"
+        "void main()"
+        "{"
+        "vec4 col_formask = texture(s_texture0 , v_texCoord) * vec4(u_baseColor.rgb, u_baseColor.a * v_opacity);"
+        "col_formask.rgb = col_formask.rgb  * col_formask.a ;"
+        "vec4 clipMask = (1.0 - texture(s_texture1, v_clipPos.xy / v_clipPos.w)) * v_channelFlag;"
+        "float maskVal = clipMask.r + clipMask.g + clipMask.b + clipMask.a;"
+        "col_formask = col_formask * maskVal;"
+        "fragColor = col_formask;"
+        "}";
+
+// Normal & Add & Mult 共通（クリッピングされて反転使用の描画用）
+static const csmChar* FragShaderSrcMaskInvertedGl33 =
+        "#version 330\n"
+        "layout(std140) uniform CubismFrame { mat4 u_matrix; vec4 u_baseColor; };"
+        "in vec2 v_texCoord;"
+        "flat in float v_opacity;"
+        "in vec4 v_clipPos;"
+        "flat in vec4 v_channelFlag;"
+        "out vec4 fragColor;"
+        "uniform sampler2D s_texture0;"
+        "uniform sampler2D s_texture1;"
+        "void main()"
+        "{"
+        "vec4 col_formask = texture(s_texture0 , v_texCoord) * vec4(u_baseColor.rgb, u_baseColor.a * v_opacity);"
+        "col_formask.rgb = col_formask.rgb  * col_formask.a ;"
+        "vec4 clipMask = (1.0 - texture(s_texture1, v_clipPos.xy / v_clipPos.w)) * v_channelFlag;"
+        "float maskVal = clipMask.r + clipMask.g + clipMask.b + clipMask.a;"
+        "col_formask = col_formask * (1.0 - maskVal);"
+        "fragColor = col_formask;"
+        "}";
+
+// Normal & Add & Mult 共通（クリッピングされたものの描画用、PremultipliedAlphaの場合）
+static const csmChar* FragShaderSrcMaskPremultipliedAlphaGl33 =
+        "#version 330\n"
+        "layout(std140) uniform CubismFrame { mat4 u_matrix; vec4 u_baseColor; };"
+        "in vec2 v_texCoord;"
+        "flat in float v_opacity;"
+        "in vec4 v_clipPos;"
+        "flat in vec4 v_channelFlag;"
+        "out vec4 fragColor;"
+        "uniform sampler2D s_texture0;"
+        "uniform sampler2D s_texture1;"
         "void main()"
         "{"
-        "vec4 col_formask = texture2D(s_texture0 , v_texCoord) * u_baseColor;"
-        "vec4 clipMask = (1.0 - texture2D(s_texture1, v_clipPos.xy / v_clipPos.w)) * u_channelFlag;"
+        "vec4 col_formask = texture(s_texture0 , v_texCoord) * (u_baseColor * v_opacity);"
+        "vec4 clipMask = (1.0 - texture(s_texture1, v_clipPos.xy / v_clipPos.w)) * v_channelFlag;"
         "float maskVal = clipMask.r + clipMask.g + clipMask.b + clipMask.a;"
-        "col_formask = col_formask * (1.0 - maskVal);"
-        "gl_FragColor = col_formask;"
+        "col_formask = col_formask * maskVal;"
+        "fragColor = col_formask;"
         "}";
-#if defined(CSM_TARGET_ANDROID_ES2)
-static const csmChar* FragShaderSrcMaskInvertedPremultipliedAlphaTegra =
-        "#version 100\n"
-        "#extension GL_NV_shader_framebuffer_fetch : enable\n"
-        "precision mediump float;"
-        "varying vec2 v_texCoord;"
-        "varying vec4 v_clipPos;"
+
+// Normal & Add & Mult 共通（クリッピングされて反転使用の描画用、PremultipliedAlphaの場合）
+static const csmChar* FragShaderSrcMaskInvertedPremultipliedAlphaGl33 =
+        "#version 330\n"
+        "layout(std140) uniform CubismFrame { mat4 u_matrix; vec4 u_baseColor; };"
+        "in vec2 v_texCoord;"
+        "flat in float v_opacity;"
+        "in vec4 v_clipPos;"
+        "flat in vec4 v_channelFlag;"
+        "out vec4 fragColor;"
         "uniform sampler2D s_texture0;"
         "uniform sampler2D s_texture1;"
-        "uniform vec4 u_channelFlag;"
-        "uniform vec4 u_baseColor;"
         "void main()"
         "{"
-        "vec4 col_formask = texture2D(s_texture0 , v_texCoord) * u_baseColor;"
-        "vec4 clipMask = (1.0 - texture2D(s_texture1, v_clipPos.xy / v_clipPos.w)) * u_channelFlag;"
+        "vec4 col_formask = texture(s_texture0 , v_texCoord) * (u_baseColor * v_opacity);"
+        "vec4 clipMask = (1.0 - texture(s_texture1, v_clipPos.xy / v_clipPos.w)) * v_channelFlag;"
         "float maskVal = clipMask.r + clipMask.g + clipMask.b + clipMask.a;"
         "col_formask = col_formask * (1.0 - maskVal);"
-        "gl_FragColor = col_formask;"
+        "fragColor = col_formask;"
         "}";
 #endif
 
@@ -1298,6 +2333,78 @@ void CubismShader_OpenGLES2::GenerateShaders()
     _shaderSets[18]->UniformClipMatrixLocation = glGetUniformLocation(_shaderSets[18]->ShaderProgram, "u_clipMatrix");
     _shaderSets[18]->UnifromChannelFlagLocation = glGetUniformLocation(_shaderSets[18]->ShaderProgram, "u_channelFlag");
     _shaderSets[18]->UniformBaseColorLocation = glGetUniformLocation(_shaderSets[18]->ShaderProgram, "u_baseColor");
+
+    // The samplers always read the same texture units, so they are set once instead of on every draw
+    GLint lastProgram;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &lastProgram);
+    for (csmInt32 i = 0; i < ShaderCount; i++)
+    {
+        glUseProgram(_shaderSets[i]->ShaderProgram);
+        glUniform1i(glGetUniformLocation(_shaderSets[i]->ShaderProgram, "s_texture0"), 0);
+        glUniform1i(glGetUniformLocation(_shaderSets[i]->ShaderProgram, "s_texture1"), 1);
+    }
+    glUseProgram(lastProgram);
+}
+
+void CubismShader_OpenGLES2::GenerateUniformBufferShaders()
+{
+#ifdef CSM_VERTEX_BUFFERS_SUPPORTED
+    for (csmInt32 i = 0; i < ShaderCount; i++)
+    {
+        _uniformBufferShaderSets.PushBack(CSM_NEW CubismShaderSet());
+    }
+
+    _uniformBufferShaderSets[0]->ShaderProgram = LoadShaderProgram(VertShaderSrcSetupMaskGl33, FragShaderSrcSetupMaskGl33);
+
+    _uniformBufferShaderSets[1]->ShaderProgram = LoadShaderProgram(VertShaderSrcGl33, FragShaderSrcGl33);
+    _uniformBufferShaderSets[2]->ShaderProgram = LoadShaderProgram(VertShaderSrcMaskedGl33, FragShaderSrcMaskGl33);
+    _uniformBufferShaderSets[3]->ShaderProgram = LoadShaderProgram(VertShaderSrcMaskedGl33, FragShaderSrcMaskInvertedGl33);
+    _uniformBufferShaderSets[4]->ShaderProgram = LoadShaderProgram(VertShaderSrcGl33, FragShaderSrcPremultipliedAlphaGl33);
+    _uniformBufferShaderSets[5]->ShaderProgram = LoadShaderProgram(VertShaderSrcMaskedGl33, FragShaderSrcMaskPremultipliedAlphaGl33);
+    _uniformBufferShaderSets[6]->ShaderProgram = LoadShaderProgram(VertShaderSrcMaskedGl33, FragShaderSrcMaskInvertedPremultipliedAlphaGl33);
+
+    // 加算・乗算も通常と同じシェーダーを利用する
+    for (csmInt32 i = ShaderNames_Add; i < ShaderCount; i++)
+    {
+        _uniformBufferShaderSets[i]->ShaderProgram = _uniformBufferShaderSets[(i - 1) % 6 + 1]->ShaderProgram;
+    }
+
+    // SetupMask still takes its matrix and colors per draw
+    _uniformBufferShaderSets[0]->UniformClipMatrixLocation = glGetUniformLocation(_uniformBufferShaderSets[0]->ShaderProgram, "u_clipMatrix");
+    _uniformBufferShaderSets[0]->UnifromChannelFlagLocation = glGetUniformLocation(_uniformBufferShaderSets[0]->ShaderProgram, "u_channelFlag");
+    _uniformBufferShaderSets[0]->UniformBaseColorLocation = glGetUniformLocation(_uniformBufferShaderSets[0]->ShaderProgram, "u_baseColor");
+
+    GLint lastProgram;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &lastProgram);
+    for (csmInt32 i = 0; i < ShaderCount; i++)
+    {
+        CubismShaderSet* shaderSet = _uniformBufferShaderSets[i];
+        shaderSet->AttributePositionLocation = PositionAttributeLocation;
+        shaderSet->AttributeTexCoordLocation = TexCoordAttributeLocation;
+
+        // The blocks are bound to fixed binding points once, CubismUniformBuffer_OpenGLES2 binds the buffers to them
+        const GLuint frameBlock = glGetUniformBlockIndex(shaderSet->ShaderProgram, "CubismFrame");
+        if (frameBlock != GL_INVALID_INDEX)
+        {
+            glUniformBlockBinding(shaderSet->ShaderProgram, frameBlock, FrameBlockBinding);
+        }
+        const GLuint clipBlock = glGetUniformBlockIndex(shaderSet->ShaderProgram, "CubismClips");
+        if (clipBlock != GL_INVALID_INDEX)
+        {
+            glUniformBlockBinding(shaderSet->ShaderProgram, clipBlock, ClipBlockBinding);
+        }
+        const GLuint drawableBlock = glGetUniformBlockIndex(shaderSet->ShaderProgram, "CubismDrawables");
+        if (drawableBlock != GL_INVALID_INDEX)
+        {
+            glUniformBlockBinding(shaderSet->ShaderProgram, drawableBlock, DrawableBlockBinding);
+        }
+
+        glUseProgram(shaderSet->ShaderProgram);
+        glUniform1i(glGetUniformLocation(shaderSet->ShaderProgram, "s_texture0"), 0);
+        glUniform1i(glGetUniformLocation(shaderSet->ShaderProgram, "s_texture1"), 1);
+    }
+    glUseProgram(lastProgram);
+#endif
 }
 
 void CubismShader_OpenGLES2::SetupShaderProgram(CubismRenderer_OpenGLES2* renderer, GLuint textureId
@@ -1308,11 +2415,21 @@ void CubismShader_OpenGLES2::SetupShaderProgram(CubismRenderer_OpenGLES2* render
                                                 , csmBool isPremultipliedAlpha, CubismMatrix44 matrix4x4
                                                 , csmBool invertedMask)
 {
-    if (_shaderSets.GetSize() == 0)
+    // Drawing from the uniform buffer needs the drawable index of the vertex buffers
+    const csmBool useUniformBuffer = renderer->_uniformBuffer.IsCreated() && vertexArray == NULL;
+
+    // Only the shaders in use are built, the GLSL 1.20 ones do not compile on a core profile
+    if (useUniformBuffer && _uniformBufferShaderSets.GetSize() == 0)
+    {
+        GenerateUniformBufferShaders();
+    }
+    else if (!useUniformBuffer && _shaderSets.GetSize() == 0)
     {
         GenerateShaders();
     }
 
+    csmVector<CubismShaderSet*>& shaderSets = useUniformBuffer ? _uniformBufferShaderSets : _shaderSets;
+
     // Blending
     csmInt32 SRC_COLOR;
     csmInt32 DST_COLOR;
@@ -1321,20 +2438,22 @@ void CubismShader_OpenGLES2::SetupShaderProgram(CubismRenderer_OpenGLES2* render
 
     if (renderer->GetClippingContextBufferForMask() != NULL) // マスク生成時
     {
-        CubismShaderSet* shaderSet = _shaderSets[ShaderNames_SetupMask];
-        glUseProgram(shaderSet->ShaderProgram);
+        CubismShaderSet* shaderSet = shaderSets[ShaderNames_SetupMask];
+        renderer->_stateCache.UseProgram(shaderSet->ShaderProgram);
 
         //テクスチャ設定
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, textureId);
-        glUniform1i(shaderSet->SamplerTexture0Location, 0);
+        renderer->_stateCache.BindTexture(0, textureId);
 
-        // 頂点配列の設定
-        glEnableVertexAttribArray(shaderSet->AttributePositionLocation);
-        glVertexAttribPointer(shaderSet->AttributePositionLocation, 2, GL_FLOAT, GL_FALSE, sizeof(csmFloat32) * 2, vertexArray);
-        // テクスチャ頂点の設定
-        glEnableVertexAttribArray(shaderSet->AttributeTexCoordLocation);
-        glVertexAttribPointer(shaderSet->AttributeTexCoordLocation, 2, GL_FLOAT, GL_FALSE, sizeof(csmFloat32) * 2, uvArray);
+        // The bound vertex array object already holds the arrays when vertexArray is NULL
+        if (vertexArray != NULL)
+        {
+            // 頂点配列の設定
+            renderer->_stateCache.EnableVertexAttribArray(shaderSet->AttributePositionLocation, true);
+            glVertexAttribPointer(shaderSet->AttributePositionLocation, 2, GL_FLOAT, GL_FALSE, sizeof(csmFloat32) * 2, vertexArray);
+            // テクスチャ頂点の設定
+            renderer->_stateCache.EnableVertexAttribArray(shaderSet->AttributeTexCoordLocation, true);
+            glVertexAttribPointer(shaderSet->AttributeTexCoordLocation, 2, GL_FLOAT, GL_FALSE, sizeof(csmFloat32) * 2, uvArray);
+        }
 
         // チャンネル
         const csmInt32 channelNo = renderer->GetClippingContextBufferForMask()->_layoutChannelNo;
@@ -1366,7 +2485,7 @@ void CubismShader_OpenGLES2::SetupShaderProgram(CubismRenderer_OpenGLES2* render
         {
         case CubismRenderer::CubismBlendMode_Normal:
         default:
-            shaderSet = _shaderSets[ShaderNames_Normal + offset];
+            shaderSet = shaderSets[ShaderNames_Normal + offset];
             SRC_COLOR = GL_ONE;
             DST_COLOR = GL_ONE_MINUS_SRC_ALPHA;
             SRC_ALPHA = GL_ONE;
@@ -1374,7 +2493,7 @@ void CubismShader_OpenGLES2::SetupShaderProgram(CubismRenderer_OpenGLES2* render
             break;
 
         case CubismRenderer::CubismBlendMode_Additive:
-            shaderSet = _shaderSets[ShaderNames_Add + offset];
+            shaderSet = shaderSets[ShaderNames_Add + offset];
             SRC_COLOR = GL_ONE;
             DST_COLOR = GL_ONE;
             SRC_ALPHA = GL_ZERO;
@@ -1382,7 +2501,7 @@ void CubismShader_OpenGLES2::SetupShaderProgram(CubismRenderer_OpenGLES2* render
             break;
 
         case CubismRenderer::CubismBlendMode_Multiplicative:
-            shaderSet = _shaderSets[ShaderNames_Mult + offset];
+            shaderSet = shaderSets[ShaderNames_Mult + offset];
             SRC_COLOR = GL_DST_COLOR;
             DST_COLOR = GL_ONE_MINUS_SRC_ALPHA;
             SRC_ALPHA = GL_ZERO;
@@ -1390,25 +2509,42 @@ void CubismShader_OpenGLES2::SetupShaderProgram(CubismRenderer_OpenGLES2* render
             break;
         }
 
-        glUseProgram(shaderSet->ShaderProgram);
+        renderer->_stateCache.UseProgram(shaderSet->ShaderProgram);
 
-        // 頂点配列の設定
-        glEnableVertexAttribArray(shaderSet->AttributePositionLocation);
-        glVertexAttribPointer(shaderSet->AttributePositionLocation, 2, GL_FLOAT, GL_FALSE, sizeof(csmFloat32) * 2, vertexArray);
-        // テクスチャ頂点の設定
-        glEnableVertexAttribArray(shaderSet->AttributeTexCoordLocation);
-        glVertexAttribPointer(shaderSet->AttributeTexCoordLocation, 2, GL_FLOAT, GL_FALSE, sizeof(csmFloat32) * 2, uvArray);
+        // The bound vertex array object already holds the arrays when vertexArray is NULL
+        if (vertexArray != NULL)
+        {
+            // 頂点配列の設定
+            renderer->_stateCache.EnableVertexAttribArray(shaderSet->AttributePositionLocation, true);
+            glVertexAttribPointer(shaderSet->AttributePositionLocation, 2, GL_FLOAT, GL_FALSE, sizeof(csmFloat32) * 2, vertexArray);
+            // テクスチャ頂点の設定
+            renderer->_stateCache.EnableVertexAttribArray(shaderSet->AttributeTexCoordLocation, true);
+            glVertexAttribPointer(shaderSet->AttributeTexCoordLocation, 2, GL_FLOAT, GL_FALSE, sizeof(csmFloat32) * 2, uvArray);
+            // The opacity is already in baseColor
+            renderer->_stateCache.EnableVertexAttribArray(OpacityAttributeLocation, false);
+            glVertexAttrib1f(OpacityAttributeLocation, 1.0f);
+        }
 
         if (masked)
         {
-            glActiveTexture(GL_TEXTURE1);
-
             // frameBufferに書かれたテクスチャ
             GLuint tex = renderer->_offscreenFrameBuffer.GetColorBuffer();
 
-            glBindTexture(GL_TEXTURE_2D, tex);
-            glUniform1i(shaderSet->SamplerTexture1Location, 1);
+            renderer->_stateCache.BindTexture(1, tex);
+        }
+
+        //テクスチャ設定
+        renderer->_stateCache.BindTexture(0, textureId);
+
+        // The uniform buffer already holds the matrices and colors of the frame
+        if (useUniformBuffer)
+        {
+            renderer->_stateCache.BlendFuncSeparate(SRC_COLOR, DST_COLOR, SRC_ALPHA, DST_ALPHA);
+            return;
+        }
 
+        if (masked)
+        {
             // View座標をClippingContextの座標に変換するための行列を設定
             glUniformMatrix4fv(shaderSet->UniformClipMatrixLocation, 1, 0, renderer->GetClippingContextBufferForDraw()->_matrixForDraw.GetArray());
 
@@ -1418,18 +2554,13 @@ void CubismShader_OpenGLES2::SetupShaderProgram(CubismRenderer_OpenGLES2* render
             glUniform4f(shaderSet->UnifromChannelFlagLocation, colorChannel->R, colorChannel->G, colorChannel->B, colorChannel->A);
         }
 
-        //テクスチャ設定
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, textureId);
-        glUniform1i(shaderSet->SamplerTexture0Location, 0);
-
         //座標変換
         glUniformMatrix4fv(shaderSet->UniformMatrixLocation, 1, 0, matrix4x4.GetArray()); //
 
         glUniform4f(shaderSet->UniformBaseColorLocation, baseColor.R, baseColor.G, baseColor.B, baseColor.A);
     }
 
-    glBlendFuncSeparate(SRC_COLOR, DST_COLOR, SRC_ALPHA, DST_ALPHA);
+    renderer->_stateCache.BlendFuncSeparate(SRC_COLOR, DST_COLOR, SRC_ALPHA, DST_ALPHA);
 }
 
 csmBool CubismShader_OpenGLES2::CompileShaderSource(GLuint* outShader, GLenum shaderType, const csmChar* shaderSource)
@@ -1534,6 +2665,12 @@ GLuint CubismShader_OpenGLES2::LoadShaderProgram(const csmChar* vertShaderSrc, c
     // Attach fragment shader to program.
     glAttachShader(shaderProgram, fragShader);
 
+    // Pin the attribute locations so every program matches the vertex array objects of CubismMeshBuffer_OpenGLES2
+    glBindAttribLocation(shaderProgram, PositionAttributeLocation, "a_position");
+    glBindAttribLocation(shaderProgram, TexCoordAttributeLocation, "a_texCoord");
+    glBindAttribLocation(shaderProgram, OpacityAttributeLocation, "a_opacity");
+    glBindAttribLocation(shaderProgram, DrawableAttributeLocation, "a_drawable");
+
     // Link program.
     if (!LinkProgram(shaderProgram))
     {
@@ -1737,9 +2874,24 @@ void CubismRenderer::StaticRelease()
 CubismRenderer_OpenGLES2::CubismRenderer_OpenGLES2() : _clippingManager(NULL)
                                                      , _clippingContextBufferForMask(NULL)
                                                      , _clippingContextBufferForDraw(NULL)
+                                                     , _useVertexBuffers(false)
+                                                     , _useUniformBuffers(false)
+                                                     , _useStateRestore(true)
+                                                     , _useMaskCaching(false)
+                                                     , _useDrawBatching(false)
+                                                     , _batchSize(0)
+                                                     , _batchDrawable(0)
+                                                     , _batchClipContext(NULL)
 {
     // テクスチャ対応マップの容量を確保しておく.
     _textures.PrepareCapacity(32, true);
+
+    _drawStatistics.DrawCalls = 0;
+    _drawStatistics.UploadedBytes = 0;
+    _drawStatistics.StateChanges = 0;
+    _drawStatistics.SkippedStateChanges = 0;
+    _drawStatistics.MaskRedraws = 0;
+    _drawStatistics.MaskVerticesScanned = 0;
 }
 
 CubismRenderer_OpenGLES2::~CubismRenderer_OpenGLES2()
@@ -1778,6 +2930,11 @@ void CubismRenderer_OpenGLES2::Initialize(CubismModel* model)
 
     _sortedDrawableIndexList.Resize(model->GetDrawableCount(), 0);
 
+    // A batch holds at most every drawable of the model
+    _batchIndexCounts.UpdateSize(model->GetDrawableCount(), 0, false);
+    _batchIndexOffsets.UpdateSize(model->GetDrawableCount(), NULL, false);
+    _batchBaseVertices.UpdateSize(model->GetDrawableCount(), 0, false);
+
     CubismRenderer::Initialize(model);  //親クラスの処理を呼ぶ
 }
 
@@ -1795,27 +2952,49 @@ void CubismRenderer_OpenGLES2::PreDraw()
     glEnable(GL_BLEND);
     glColorMask(1, 1, 1, 1);
 
+    // The state may have been changed since the last draw, and binding a vertex array object changes the attribute arrays
+    _stateCache.Invalidate();
+
+    if (_meshBuffer.IsCreated())
+    {
+        // The vertex array object holds the buffer bindings
+        _meshBuffer.Bind();
+    }
+    else
+    {
 #ifdef CSM_TARGET_IPHONE_ES2
-    glBindVertexArrayOES(0);
+        glBindVertexArrayOES(0);
 #endif
+        _meshBuffer.BindClientArrays();
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0); //前にバッファがバインドされていたら破棄する必要がある
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0); //前にバッファがバインドされていたら破棄する必要がある
+    }
 
     //異方性フィルタリング。プラットフォームのOpenGLによっては未対応の場合があるので、未設定のときは設定しない
     if (GetAnisotropy() > 0.0f)
     {
+        _stateCache.ActiveTexture(0);
         for (csmInt32 i = 0; i < _textures.GetSize(); i++)
         {
             glBindTexture(GL_TEXTURE_2D, _textures[i]);
             glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, GetAnisotropy());
         }
+        _stateCache.Invalidate();
     }
 }
 
 
 void CubismRenderer_OpenGLES2::DoDrawModel()
 {
+    _drawStatistics.DrawCalls = 0;
+    _drawStatistics.UploadedBytes = 0;
+    _drawStatistics.MaskRedraws = 0;
+    _drawStatistics.MaskVerticesScanned = 0;
+    _stateCache.ResetCounters();
+
+    UpdateMeshBuffer();
+
     //------------ クリッピングマスク・バッファ前処理方式の場合 ------------
     if (_clippingManager != NULL)
     {
@@ -1828,14 +3007,33 @@ void CubismRenderer_OpenGLES2::DoDrawModel()
             _offscreenFrameBuffer.DestroyOffscreenFrame();
             _offscreenFrameBuffer.CreateOffscreenFrame(
                 static_cast<csmUint32>(_clippingManager->GetClippingMaskBufferSize()), static_cast<csmUint32>(_clippingManager->GetClippingMaskBufferSize()));
+            _clippingManager->InvalidateMaskCache();
         }
 
         _clippingManager->SetupClippingContext(*GetModel(), this, _rendererProfile._lastFBO, _rendererProfile._lastViewport);
+
+        _drawStatistics.MaskRedraws += _clippingManager->_maskRedrawCount;
+        _drawStatistics.MaskVerticesScanned += _clippingManager->_scannedVertexCount;
     }
 
     // 上記クリッピング処理内でも一度PreDrawを呼ぶので注意!!
     PreDraw();
 
+    if (_uniformBuffer.IsCreated())
+    {
+        // Same color as SetupMeshDraw gives the vertex buffer draws, the opacity is applied per drawable
+        CubismTextureColor modelColorRGBA = GetModelColor();
+        if (IsPremultipliedAlpha())
+        {
+            modelColorRGBA.R *= modelColorRGBA.A;
+            modelColorRGBA.G *= modelColorRGBA.A;
+            modelColorRGBA.B *= modelColorRGBA.A;
+        }
+
+        CubismMatrix44 mvpMatrix = GetMvpMatrix();
+        _drawStatistics.UploadedBytes += _uniformBuffer.UpdateFrame(mvpMatrix, modelColorRGBA, _clippingManager);
+    }
+
     const csmInt32 drawableCount = GetModel()->GetDrawableCount();
     const csmInt32* renderOrder = GetModel()->GetDrawableRenderOrders();
 
@@ -1864,6 +3062,9 @@ void CubismRenderer_OpenGLES2::DoDrawModel()
 
         if (clipContext != NULL && IsUsingHighPrecisionMask()) // マスクを書く必要がある
         {
+            // The batched drawables have to be drawn before the mask buffer is rewritten
+            FlushDrawBatch();
+
             if(clipContext->_isUsing) // 書くことになっていた
             {
                 // 生成したFrameBufferと同じサイズでビューポートを設定
@@ -1876,6 +3077,8 @@ void CubismRenderer_OpenGLES2::DoDrawModel()
                 // マスクをクリアする
                 // 1が無効（描かれない）領域、0が有効（描かれる）領域。（シェーダで Cd*Csで0に近い値をかけてマスクを作る。1をかけると何も起こらない）
                 _offscreenFrameBuffer.Clear(1.0f, 1.0f, 1.0f, 1.0f);
+
+                _drawStatistics.MaskRedraws++;
             }
 
             {
@@ -1884,25 +3087,14 @@ void CubismRenderer_OpenGLES2::DoDrawModel()
                 {
                     const csmInt32 clipDrawIndex = clipContext->_clippingIdList[index];
 
-                    // 頂点情報が更新されておらず、信頼性がない場合は描画をパスする
-                    if (!GetModel()->GetDrawableDynamicFlagVertexPositionsDidChange(clipDrawIndex))
-                    {
-                        continue;
-                    }
-
+                    // The buffer was cleared, a mask that didn't move has to be drawn again too
                     IsCulling(GetModel()->GetDrawableCulling(clipDrawIndex) != 0);
 
                     // 今回専用の変換を適用して描く
                     // チャンネルも切り替える必要がある(A,R,G,B)
                     SetClippingContextBufferForMask(clipContext);
-                    DrawMesh(
-                        GetModel()->GetDrawableTextureIndices(clipDrawIndex),
-                        GetModel()->GetDrawableVertexIndexCount(clipDrawIndex),
-                        GetModel()->GetDrawableVertexCount(clipDrawIndex),
-                        const_cast<csmUint16*>(GetModel()->GetDrawableVertexIndices(clipDrawIndex)),
-                        const_cast<csmFloat32*>(GetModel()->GetDrawableVertices(clipDrawIndex)),
-                        reinterpret_cast<csmFloat32*>(const_cast<Core::csmVector2*>(GetModel()->GetDrawableVertexUvs(clipDrawIndex))),
-                        GetModel()->GetDrawableOpacity(clipDrawIndex),
+                    DrawDrawableMesh(
+                        clipDrawIndex,
                         CubismRenderer::CubismBlendMode_Normal,   //クリッピングは通常描画を強制
                         false // マスク生成時はクリッピングの反転使用は全く関係がない
                     );
@@ -1919,53 +3111,242 @@ void CubismRenderer_OpenGLES2::DoDrawModel()
             }
         }
 
+        if (_useDrawBatching && _meshBuffer.IsCreated())
+        {
+            BatchDrawableMesh(drawableIndex, clipContext);
+            continue;
+        }
+
         // クリッピングマスクをセットする
         SetClippingContextBufferForDraw(clipContext);
 
         IsCulling(GetModel()->GetDrawableCulling(drawableIndex) != 0);
 
-        DrawMesh(
-            GetModel()->GetDrawableTextureIndices(drawableIndex),
-            GetModel()->GetDrawableVertexIndexCount(drawableIndex),
-            GetModel()->GetDrawableVertexCount(drawableIndex),
-            const_cast<csmUint16*>(GetModel()->GetDrawableVertexIndices(drawableIndex)),
-            const_cast<csmFloat32*>(GetModel()->GetDrawableVertices(drawableIndex)),
-            reinterpret_cast<csmFloat32*>(const_cast<Core::csmVector2*>(GetModel()->GetDrawableVertexUvs(drawableIndex))),
-            GetModel()->GetDrawableOpacity(drawableIndex),
+        DrawDrawableMesh(
+            drawableIndex,
             GetModel()->GetDrawableBlendMode(drawableIndex),
             GetModel()->GetDrawableInvertedMask(drawableIndex) // マスクを反転使用するか
         );
     }
 
+    FlushDrawBatch();
+
+    _meshBuffer.Unbind();
+
+    // Programs are no longer reset after each draw, leave the same state as before
+    _stateCache.UseProgram(0);
+    _stateCache.ActiveTexture(0);
+
+    _drawStatistics.StateChanges = _stateCache._changeCount;
+    _drawStatistics.SkippedStateChanges = _stateCache._skipCount;
+
     //
     PostDraw();
 
 }
 
+void CubismRenderer_OpenGLES2::UpdateMeshBuffer()
+{
+    if (!_useVertexBuffers)
+    {
+        _uniformBuffer.Release();
+        _meshBuffer.Release();
+        return;
+    }
+
+    if (!_meshBuffer.IsCreated())
+    {
+        if (!CubismMeshBuffer_OpenGLES2::IsSupported())
+        {
+            CubismLogWarning("Vertex buffers need OpenGL 3.2, drawing from client-side arrays");
+            _useVertexBuffers = false;
+            return;
+        }
+
+        _drawStatistics.UploadedBytes += _meshBuffer.Create(*GetModel());
+    }
+
+    if (_useUniformBuffers && !_uniformBuffer.IsCreated())
+    {
+        if (!CubismUniformBuffer_OpenGLES2::IsSupported(*GetModel(), _clippingManager))
+        {
+            CubismLogWarning("Uniform buffers need OpenGL 3.3 and a model within the block sizes, drawing with the GLES2 shaders");
+            _useUniformBuffers = false;
+        }
+        else
+        {
+            _drawStatistics.UploadedBytes += _uniformBuffer.Create(*GetModel(), _clippingManager);
+        }
+    }
+    else if (!_useUniformBuffers && _uniformBuffer.IsCreated())
+    {
+        // The opacity buffers were not updated while the uniform buffer held the opacities
+        _uniformBuffer.Release();
+        _meshBuffer.Invalidate();
+    }
+
+    // The uniform buffer holds the opacities instead of the opacity buffers
+    _drawStatistics.UploadedBytes += _meshBuffer.Update(*GetModel(), !_uniformBuffer.IsCreated());
+
+    if (_uniformBuffer.IsCreated())
+    {
+        _drawStatistics.UploadedBytes += _uniformBuffer.UpdateDrawables(*GetModel());
+    }
+}
+
+void CubismRenderer_OpenGLES2::DrawDrawableMesh(csmInt32 drawableIndex, CubismBlendMode colorBlendMode, csmBool invertedMask)
+{
+    CubismModel* model = GetModel();
+
+    if (_meshBuffer.IsCreated())
+    {
+        DrawMeshElements(
+            model->GetDrawableTextureIndices(drawableIndex),
+            model->GetDrawableVertexIndexCount(drawableIndex),
+            model->GetDrawableVertexCount(drawableIndex),
+            _meshBuffer.GetIndexOffset(drawableIndex),
+            _meshBuffer.GetBaseVertex(drawableIndex),
+            NULL,
+            NULL,
+            1.0f,   // The opacity buffer holds the opacity
+            colorBlendMode,
+            invertedMask
+        );
+        return;
+    }
+
+    DrawMeshElements(
+        model->GetDrawableTextureIndices(drawableIndex),
+        model->GetDrawableVertexIndexCount(drawableIndex),
+        model->GetDrawableVertexCount(drawableIndex),
+        model->GetDrawableVertexIndices(drawableIndex),
+        0,
+        const_cast<csmFloat32*>(model->GetDrawableVertices(drawableIndex)),
+        reinterpret_cast<csmFloat32*>(const_cast<Core::csmVector2*>(model->GetDrawableVertexUvs(drawableIndex))),
+        model->GetDrawableOpacity(drawableIndex),
+        colorBlendMode,
+        invertedMask
+    );
+}
+
 void CubismRenderer_OpenGLES2::DrawMesh(csmInt32 textureNo, csmInt32 indexCount, csmInt32 vertexCount
                                         , csmUint16* indexArray, csmFloat32* vertexArray, csmFloat32* uvArray
                                         , csmFloat32 opacity, CubismBlendMode colorBlendMode, csmBool invertedMask)
 {
+    DrawMeshElements(textureNo, indexCount, vertexCount, indexArray, 0, vertexArray, uvArray, opacity, colorBlendMode, invertedMask);
+}
 
-#ifdef CSM_TARGET_WIN_GL
-    if (s_isFirstInitializeGlFunctions) return;  // WindowsプラットフォームではGL命令のバインドを済ませておく必要がある
-#endif
+void CubismRenderer_OpenGLES2::DrawMeshElements(csmInt32 textureNo, csmInt32 indexCount, csmInt32 vertexCount
+                                                , const void* indices, csmInt32 baseVertex, csmFloat32* vertexArray, csmFloat32* uvArray
+                                                , csmFloat32 opacity, CubismBlendMode colorBlendMode, csmBool invertedMask)
+{
+    if (!SetupMeshDraw(textureNo, vertexCount, vertexArray, uvArray, opacity, colorBlendMode, invertedMask))
+    {
+        return;
+    }
 
-#ifndef CSM_DEBUG
-    if (_textures[textureNo] == 0) return;    // モデルが参照するテクスチャがバインドされていない場合は描画をスキップする
+    // ポリゴンメッシュを描画する
+    if (vertexArray != NULL)
+    {
+        glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_SHORT, indices);
+
+        // Client-side arrays are copied by the driver on every draw
+        _drawStatistics.UploadedBytes += vertexCount * sizeof(csmFloat32) * 4 + indexCount * sizeof(csmUint16);
+    }
+    else
+    {
+#ifdef CSM_VERTEX_BUFFERS_SUPPORTED
+        glDrawElementsBaseVertex(GL_TRIANGLES, indexCount, GL_UNSIGNED_SHORT, const_cast<void*>(indices), baseVertex);
 #endif
+    }
+    _drawStatistics.DrawCalls++;
 
-    // 裏面描画の有効・無効
-    if (IsCulling())
+    // 後処理
+    SetClippingContextBufferForDraw(NULL);
+    SetClippingContextBufferForMask(NULL);
+}
+
+void CubismRenderer_OpenGLES2::BatchDrawableMesh(csmInt32 drawableIndex, CubismClippingContext* clipContext)
+{
+    CubismModel* model = GetModel();
+
+    // Only drawables with the same shader, texture and GL state can share a draw call
+    if (_batchSize > 0
+        && (model->GetDrawableTextureIndices(drawableIndex) != model->GetDrawableTextureIndices(_batchDrawable)
+            || model->GetDrawableBlendMode(drawableIndex) != model->GetDrawableBlendMode(_batchDrawable)
+            || (model->GetDrawableCulling(drawableIndex) != 0) != (model->GetDrawableCulling(_batchDrawable) != 0)
+            || (_uniformBuffer.IsCreated() ? (clipContext != NULL) != (_batchClipContext != NULL) : clipContext != _batchClipContext)
+            || (clipContext != NULL && model->GetDrawableInvertedMask(drawableIndex) != model->GetDrawableInvertedMask(_batchDrawable))))
     {
-        glEnable(GL_CULL_FACE);
+        FlushDrawBatch();
     }
-    else
+
+    if (_batchSize == 0)
     {
-        glDisable(GL_CULL_FACE);
+        _batchDrawable = drawableIndex;
+        _batchClipContext = clipContext;
+    }
+
+    _batchIndexCounts[_batchSize] = model->GetDrawableVertexIndexCount(drawableIndex);
+    _batchIndexOffsets[_batchSize] = const_cast<void*>(_meshBuffer.GetIndexOffset(drawableIndex));
+    _batchBaseVertices[_batchSize] = _meshBuffer.GetBaseVertex(drawableIndex);
+    _batchSize++;
+}
+
+void CubismRenderer_OpenGLES2::FlushDrawBatch()
+{
+    if (_batchSize == 0)
+    {
+        return;
+    }
+
+    CubismModel* model = GetModel();
+    const GLsizei batchSize = _batchSize;
+    _batchSize = 0;
+
+    SetClippingContextBufferForDraw(_batchClipContext);
+
+    IsCulling(model->GetDrawableCulling(_batchDrawable) != 0);
+
+    if (!SetupMeshDraw(
+            model->GetDrawableTextureIndices(_batchDrawable),
+            0,
+            NULL,
+            NULL,
+            1.0f,   // The opacity buffer holds the opacity of each drawable
+            model->GetDrawableBlendMode(_batchDrawable),
+            model->GetDrawableInvertedMask(_batchDrawable)))
+    {
+        return;
     }
 
-    glFrontFace(GL_CCW);    // Cubism SDK OpenGLはマスク・アートメッシュ共にCCWが表面
+    // Sub-draws are rasterized in order, so the render order is kept
+#ifdef CSM_VERTEX_BUFFERS_SUPPORTED
+    glMultiDrawElementsBaseVertex(GL_TRIANGLES, _batchIndexCounts.GetPtr(), GL_UNSIGNED_SHORT
+                                  , _batchIndexOffsets.GetPtr(), batchSize, _batchBaseVertices.GetPtr());
+#endif
+    _drawStatistics.DrawCalls++;
+
+    // 後処理
+    SetClippingContextBufferForDraw(NULL);
+    SetClippingContextBufferForMask(NULL);
+}
+
+csmBool CubismRenderer_OpenGLES2::SetupMeshDraw(csmInt32 textureNo, csmInt32 vertexCount, csmFloat32* vertexArray, csmFloat32* uvArray
+                                                , csmFloat32 opacity, CubismBlendMode colorBlendMode, csmBool invertedMask)
+{
+#ifdef CSM_TARGET_WIN_GL
+    if (s_isFirstInitializeGlFunctions) return false;  // WindowsプラットフォームではGL命令のバインドを済ませておく必要がある
+#endif
+
+#ifndef CSM_DEBUG
+    if (_textures[textureNo] == 0) return false;    // モデルが参照するテクスチャがバインドされていない場合は描画をスキップする
+#endif
+
+    // 裏面描画の有効・無効
+    _stateCache.EnableCullFace(IsCulling());
+
+    _stateCache.FrontFace(GL_CCW);    // Cubism SDK OpenGLはマスク・アートメッシュ共にCCWが表面
 
     CubismTextureColor modelColorRGBA = GetModelColor();
 
@@ -1999,22 +3380,27 @@ void CubismRenderer_OpenGLES2::DrawMesh(csmInt32 textureNo, csmInt32 indexCount,
         , GetMvpMatrix(), invertedMask
     );
 
-    // ポリゴンメッシュを描画する
-    glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_SHORT, indexArray);
-
-    // 後処理
-    glUseProgram(0);
-    SetClippingContextBufferForDraw(NULL);
-    SetClippingContextBufferForMask(NULL);
+    return true;
 }
 
 void CubismRenderer_OpenGLES2::SaveProfile()
 {
+    if (!_useStateRestore)
+    {
+        _rendererProfile.SaveFrameBuffer();
+        return;
+    }
+
     _rendererProfile.Save();
 }
 
 void CubismRenderer_OpenGLES2::RestoreProfile()
 {
+    if (!_useStateRestore)
+    {
+        return;
+    }
+
     _rendererProfile.Restore();
 }
 
@@ -2050,6 +3436,72 @@ csmInt32 CubismRenderer_OpenGLES2::GetClippingMaskBufferSize() const
     return _clippingManager->GetClippingMaskBufferSize();
 }
 
+void CubismRenderer_OpenGLES2::UseVertexBuffers(csmBool enabled)
+{
+    _useVertexBuffers = enabled;
+}
+
+csmBool CubismRenderer_OpenGLES2::IsUsingVertexBuffers() const
+{
+    return _useVertexBuffers;
+}
+
+void CubismRenderer_OpenGLES2::UseDrawBatching(csmBool enabled)
+{
+    _useDrawBatching = enabled;
+}
+
+csmBool CubismRenderer_OpenGLES2::IsUsingDrawBatching() const
+{
+    return _useDrawBatching;
+}
+
+void CubismRenderer_OpenGLES2::UseUniformBuffers(csmBool enabled)
+{
+    _useUniformBuffers = enabled;
+}
+
+csmBool CubismRenderer_OpenGLES2::IsUsingUniformBuffers() const
+{
+    return _useUniformBuffers;
+}
+
+void CubismRenderer_OpenGLES2::InvalidateDrawableCaches()
+{
+    _meshBuffer.Invalidate();
+    _uniformBuffer.Invalidate();
+
+    if (_clippingManager != NULL)
+    {
+        _clippingManager->InvalidateMaskCache();
+    }
+}
+
+const CubismRenderer_OpenGLES2::CubismDrawStatistics& CubismRenderer_OpenGLES2::GetDrawStatistics() const
+{
+    return _drawStatistics;
+}
+
+void CubismRenderer_OpenGLES2::UseStateRestore(csmBool enabled)
+{
+    _useStateRestore = enabled;
+}
+
+csmBool CubismRenderer_OpenGLES2::IsUsingStateRestore() const
+{
+    return _useStateRestore;
+}
+
+void CubismRenderer_OpenGLES2::UseMaskCaching(csmBool enabled)
+{
+    _useMaskCaching = enabled;
+}
+
+csmBool CubismRenderer_OpenGLES2::IsUsingMaskCaching() const
+{
+    return _useMaskCaching;
+}
+
 void CubismRenderer_OpenGLES2::SetClippingContextBufferForMask(CubismClippingContext* clip)
 {
     _clippingContextBufferForMask = clip;
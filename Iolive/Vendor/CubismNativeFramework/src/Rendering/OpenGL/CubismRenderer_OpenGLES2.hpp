@@ -53,6 +53,7 @@ class CubismClippingManager_OpenGLES2
 {
     friend class CubismShader_OpenGLES2;
     friend class CubismRenderer_OpenGLES2;
+    friend class CubismUniformBuffer_OpenGLES2;
 
 private:
 
@@ -145,6 +146,23 @@ private:
      */
     csmInt32 GetClippingMaskBufferSize() const;
 
+    /**
+     * @brief   Makes SetupClippingContext draw every mask again on the next frame
+     */
+    void InvalidateMaskCache();
+
+    /**
+     * @brief   Decides whether the mask of a clipping context has to be drawn again<br>
+     *          The bounds of the clipped drawables are computed again when one of them changed.
+     *
+     * @param[in]   model           ->  Model
+     * @param[in]   clippingContext ->  Clipping context
+     *
+     * @retval  true    ->  the mask or its bounds changed
+     * @retval  false   ->  the mask in the buffer is still valid
+     */
+    csmBool UpdateClippingContextBounds(CubismModel& model, CubismClippingContext* clippingContext);
+
     csmInt32    _currentFrameNo;         ///< マスクテクスチャに与えるフレーム番号
 
     csmVector<CubismRenderer::CubismTextureColor*>  _channelColors;
@@ -157,6 +175,10 @@ private:
     CubismMatrix44  _tmpMatrixForDraw;       ///< マスク計算用の行列
     csmRectF        _tmpBoundsOnModel;       ///< マスク配置計算用の矩形
 
+    csmBool         _maskCacheValid;         ///< The mask buffer holds the masks of every clipping context with the current layout
+    csmInt32        _cachedUsingClipCount;   ///< Number of used clipping contexts the layout was made for
+    csmUint32       _maskRedrawCount;        ///< Masks drawn by the last SetupClippingContext
+    csmUint32       _scannedVertexCount;     ///< Vertices read by CalcClippedDrawTotalBounds in the last SetupClippingContext
 };
 
 /**
@@ -167,6 +189,7 @@ class CubismClippingContext
     friend class CubismClippingManager_OpenGLES2;
     friend class CubismShader_OpenGLES2;
     friend class CubismRenderer_OpenGLES2;
+    friend class CubismUniformBuffer_OpenGLES2;
 
 private:
     /**
@@ -202,6 +225,7 @@ private:
     csmRectF* _allClippedDrawRect;                   ///< このクリッピングで、クリッピングされる全ての描画オブジェクトの囲み矩形（毎回更新）
     CubismMatrix44 _matrixForMask;                   ///< マスクの位置計算結果を保持する行列
     CubismMatrix44 _matrixForDraw;                   ///< 描画オブジェクトの位置計算結果を保持する行列
+    csmBool _isDirty;                                ///< The mask has to be drawn again this frame
     csmVector<csmInt32>* _clippedDrawableIndexList;  ///< このマスクにクリップされる描画オブジェクトのリスト
 
     CubismClippingManager_OpenGLES2* _owner;        ///< このマスクを管理しているマネージャのインスタンス
@@ -262,8 +286,8 @@ private:
      * @param[in]   renderer              ->  レンダラのインスタンス
      * @param[in]   textureId             ->  GPUのテクスチャID
      * @param[in]   vertexCount           ->  ポリゴンメッシュの頂点数
-     * @param[in]   vertexArray           ->  ポリゴンメッシュの頂点配列
-     * @param[in]   uvArray               ->  uv配列
+     * @param[in]   vertexArray           ->  ポリゴンメッシュの頂点配列 (NULL to use the bound vertex array object)
+     * @param[in]   uvArray               ->  uv配列 (NULL to use the bound vertex array object)
      * @param[in]   opacity               ->  不透明度
      * @param[in]   colorBlendMode        ->  カラーブレンディングのタイプ
      * @param[in]   baseColor             ->  ベースカラー
@@ -289,6 +313,16 @@ private:
      */
     void GenerateShaders();
 
+    /**
+     * @brief   Creates the GLSL 330 programs that read their per-frame and per-drawable data from uniform buffers
+     */
+    void GenerateUniformBufferShaders();
+
+    /**
+     * @brief   Deletes the programs created by GenerateUniformBufferShaders
+     */
+    void ReleaseUniformBufferShaders();
+
     /**
      * @brief   シェーダプログラムをロードしてアドレス返す。
      *
@@ -347,6 +381,7 @@ private:
 #endif
 
     csmVector<CubismShaderSet*> _shaderSets;   ///< ロードしたシェーダプログラムを保持する変数
+    csmVector<CubismShaderSet*> _uniformBufferShaderSets;  ///< Programs used with CubismUniformBuffer_OpenGLES2, in the order of _shaderSets
 
 };
 
@@ -374,6 +409,12 @@ private:
      */
     void Save();
 
+    /**
+     * @brief   Only saves the frame buffer and viewport the model is drawn to<br>
+     *          The mask pass needs them to switch back from the mask buffer.
+     */
+    void SaveFrameBuffer();
+
     /**
      * @brief   保持したOpenGLES2のステートを復帰させる
      *
@@ -415,6 +456,328 @@ private:
     GLint _lastViewport[4];                 ///< モデル描画直前のビューポート
 };
 
+/**
+ * @brief   Shadow copy of the OpenGL state set by the renderer<br>
+ *          Calls that would set a state to the value it already has are skipped.
+ *
+ * The copy is only trusted between two Invalidate calls. The renderer invalidates it whenever
+ * code outside the cache may have changed the state, at the latest at the start of every frame.
+ */
+class CubismStateCache_OpenGLES2
+{
+    friend class CubismRenderer_OpenGLES2;
+    friend class CubismShader_OpenGLES2;
+
+private:
+    static const csmInt32 TextureUnitCount = 2;     ///< Texture units used by the shaders
+    static const csmInt32 VertexAttribCount = 3;    ///< Vertex attributes used by the shaders
+
+    /**
+     * @brief   Constructor
+     */
+    CubismStateCache_OpenGLES2();
+
+    /**
+     * @brief   Forgets the cached state, the next call of each setter reaches OpenGL
+     */
+    void Invalidate();
+
+    /**
+     * @brief   Clears the change counters
+     */
+    void ResetCounters();
+
+    /**
+     * @brief   glUseProgram
+     *
+     * @param[in]   program ->  Shader program
+     */
+    void UseProgram(GLuint program);
+
+    /**
+     * @brief   glActiveTexture
+     *
+     * @param[in]   unit    ->  Texture unit, starting at 0 for GL_TEXTURE0
+     */
+    void ActiveTexture(csmInt32 unit);
+
+    /**
+     * @brief   glBindTexture of a 2D texture to a texture unit
+     *
+     * @param[in]   unit    ->  Texture unit, starting at 0 for GL_TEXTURE0
+     * @param[in]   texture ->  Texture
+     */
+    void BindTexture(csmInt32 unit, GLuint texture);
+
+    /**
+     * @brief   glBlendFuncSeparate
+     *
+     * @param[in]   srcColor    ->  Source color factor
+     * @param[in]   dstColor    ->  Destination color factor
+     * @param[in]   srcAlpha    ->  Source alpha factor
+     * @param[in]   dstAlpha    ->  Destination alpha factor
+     */
+    void BlendFuncSeparate(GLenum srcColor, GLenum dstColor, GLenum srcAlpha, GLenum dstAlpha);
+
+    /**
+     * @brief   glEnable or glDisable of GL_CULL_FACE
+     *
+     * @param[in]   enabled ->  true to cull back faces
+     */
+    void EnableCullFace(csmBool enabled);
+
+    /**
+     * @brief   glFrontFace
+     *
+     * @param[in]   mode    ->  GL_CW or GL_CCW
+     */
+    void FrontFace(GLenum mode);
+
+    /**
+     * @brief   glEnableVertexAttribArray or glDisableVertexAttribArray
+     *
+     * @param[in]   index   ->  Vertex attribute, below VertexAttribCount
+     * @param[in]   enabled ->  true to read the attribute from an array
+     */
+    void EnableVertexAttribArray(GLuint index, csmBool enabled);
+
+    GLuint _program;                                    ///< Current shader program
+    csmInt32 _activeTexture;                            ///< Current texture unit
+    GLuint _textures[TextureUnitCount];                 ///< Texture bound to each unit
+    GLenum _blending[4];                                ///< Blend factors
+    csmBool _cullFace;                                  ///< GL_CULL_FACE enabled
+    GLenum _frontFace;                                  ///< Front face winding
+    csmBool _vertexAttribArrays[VertexAttribCount];     ///< Vertex attribute arrays enabled
+
+    csmBool _programKnown;                              ///< _program matches OpenGL
+    csmBool _activeTextureKnown;                        ///< _activeTexture matches OpenGL
+    csmBool _texturesKnown[TextureUnitCount];           ///< _textures matches OpenGL
+    csmBool _blendingKnown;                             ///< _blending matches OpenGL
+    csmBool _cullFaceKnown;                             ///< _cullFace matches OpenGL
+    csmBool _frontFaceKnown;                            ///< _frontFace matches OpenGL
+    csmBool _vertexAttribArraysKnown[VertexAttribCount];///< _vertexAttribArrays matches OpenGL
+
+    csmUint32 _changeCount;                             ///< Calls passed to OpenGL since ResetCounters
+    csmUint32 _skipCount;                               ///< Calls skipped since ResetCounters
+};
+
+/**
+ * @brief   Vertex buffers holding the meshes of every drawable on the GPU
+ *
+ * UVs, indices and the drawable index of each vertex never change and are uploaded once.
+ * Vertex positions and opacities go to a ring of buffers,
+ * and each buffer only receives the drawables whose positions or opacities changed since it was last written.
+ */
+class CubismMeshBuffer_OpenGLES2
+{
+    friend class CubismRenderer_OpenGLES2;
+
+private:
+    static const csmInt32 StreamBufferCount = 3;    ///< Buffers in the position and opacity rings, enough for the frames the GPU may still be reading
+
+    /**
+     * @brief   Constructor
+     */
+    CubismMeshBuffer_OpenGLES2();
+
+    /**
+     * @brief   Destructor
+     */
+    virtual ~CubismMeshBuffer_OpenGLES2();
+
+    /**
+     * @brief   Checks that the current context has vertex array objects and glDrawElementsBaseVertex (OpenGL 3.2)
+     *
+     * @retval  true    ->  vertex buffers can be used
+     * @retval  false   ->  the renderer has to keep client-side arrays
+     */
+    static csmBool IsSupported();
+
+    /**
+     * @brief   Creates the buffers and uploads the UVs and indices of every drawable
+     *
+     * @param[in]   model   ->  Model
+     *
+     * @return  Bytes uploaded
+     */
+    csmUint32 Create(CubismModel& model);
+
+    /**
+     * @brief   Deletes the buffers and vertex array objects
+     */
+    void Release();
+
+    /**
+     * @brief   Checks whether the buffers exist
+     *
+     * @retval  true    ->  Create has been called
+     * @retval  false   ->  no buffers
+     */
+    csmBool IsCreated() const;
+
+    /**
+     * @brief   Moves to the next buffers of the rings and uploads the positions and opacities they are missing<br>
+     *          Changes are detected from the VertexPositionsDidChange and OpacityDidChange flags of the last model update.
+     *
+     * @param[in]   model       ->  Model
+     * @param[in]   opacities   ->  false when the shaders read the opacity from CubismUniformBuffer_OpenGLES2,
+     *                              Invalidate has to be called before passing true again
+     *
+     * @return  Bytes uploaded
+     */
+    csmUint32 Update(CubismModel& model, csmBool opacities);
+
+    /**
+     * @brief   Marks every position and opacity as missing from every buffer of the rings
+     */
+    void Invalidate();
+
+    /**
+     * @brief   Binds the vertex array object of the current buffer
+     */
+    void Bind() const;
+
+    /**
+     * @brief   Binds the default vertex array object to draw from client-side arrays, while there are no buffers<br>
+     *          The application may have left one of its own bound (ImGui does), client-side arrays can't be used with it.
+     */
+    void BindClientArrays();
+
+    /**
+     * @brief   Binds the vertex array object that was bound before Update or BindClientArrays
+     */
+    void Unbind() const;
+
+    /**
+     * @brief   Gets the first vertex of a drawable in the buffers
+     *
+     * @param[in]   drawableIndex   ->  Drawable index
+     *
+     * @return  Value for the basevertex argument of glDrawElementsBaseVertex
+     */
+    csmInt32 GetBaseVertex(csmInt32 drawableIndex) const;
+
+    /**
+     * @brief   Gets the byte offset of the indices of a drawable in the index buffer
+     *
+     * @param[in]   drawableIndex   ->  Drawable index
+     *
+     * @return  Value for the indices argument of glDrawElements
+     */
+    const void* GetIndexOffset(csmInt32 drawableIndex) const;
+
+    GLuint _uvBuffer;                                   ///< UVs of every drawable
+    GLuint _indexBuffer;                                ///< Indices of every drawable
+    GLuint _drawableBuffer;                             ///< Drawable index of every vertex
+    GLuint _positionBuffers[StreamBufferCount];         ///< Ring of vertex position buffers
+    GLuint _opacityBuffers[StreamBufferCount];          ///< Ring of vertex opacity buffers
+    GLuint _vertexArrays[StreamBufferCount];            ///< Vertex array object of each buffer of the rings
+    csmInt32 _currentBuffer;                            ///< Position buffer used by the current frame
+    csmVector<csmInt32> _vertexOffsets;                 ///< First vertex of each drawable
+    csmVector<csmInt32> _indexOffsets;                  ///< First index of each drawable
+    csmVector<csmUint8> _stalePositions;                ///< Per drawable, bit i is set when position buffer i holds outdated positions
+    csmVector<csmUint8> _staleOpacities;                ///< Per drawable, bit i is set when opacity buffer i holds an outdated opacity
+    csmVector<csmFloat32> _opacities;                   ///< Scratch array repeating the opacity of a drawable on each of its vertices
+    GLint _lastVertexArray;                             ///< Vertex array object bound before the model was drawn
+    csmBool _clientArraysBound;                         ///< BindClientArrays replaced _lastVertexArray
+};
+
+/**
+ * @brief   Uniform buffers holding the shader data of the OpenGL 3.3 programs
+ *
+ * CubismFrame holds the MVP matrix and the model color, CubismClips the draw matrix and color channel
+ * of each clipping context, and CubismDrawables the opacity and clipping context of each drawable.
+ * The vertex shader finds the drawable from a vertex attribute, so a draw call needs no uniform upload
+ * and drawables with different opacities or clipping contexts can share one.
+ */
+class CubismUniformBuffer_OpenGLES2
+{
+    friend class CubismRenderer_OpenGLES2;
+    friend class CubismShader_OpenGLES2;
+
+private:
+    static const csmInt32 MaxDrawableCount = 1024;      ///< Array size in the CubismDrawables block, 16 KB is the largest block OpenGL 3.3 guarantees
+    static const csmInt32 MaxClipContextCount = 64;     ///< Array size in the CubismClips block
+
+    /**
+     * @brief   Constructor
+     */
+    CubismUniformBuffer_OpenGLES2();
+
+    /**
+     * @brief   Destructor
+     */
+    virtual ~CubismUniformBuffer_OpenGLES2();
+
+    /**
+     * @brief   Checks that the current context has OpenGL 3.3 and that the model fits in the blocks
+     *
+     * @param[in]   model           ->  Model
+     * @param[in]   clippingManager ->  Clipping manager of the model, NULL without clipping masks
+     *
+     * @retval  true    ->  uniform buffers can be used
+     * @retval  false   ->  the renderer has to keep the GLES2 shaders
+     */
+    static csmBool IsSupported(CubismModel& model, CubismClippingManager_OpenGLES2* clippingManager);
+
+    /**
+     * @brief   Creates the buffers and uploads the drawable data
+     *
+     * @param[in]   model           ->  Model
+     * @param[in]   clippingManager ->  Clipping manager of the model, NULL without clipping masks
+     *
+     * @return  Bytes uploaded
+     */
+    csmUint32 Create(CubismModel& model, CubismClippingManager_OpenGLES2* clippingManager);
+
+    /**
+     * @brief   Deletes the buffers
+     */
+    void Release();
+
+    /**
+     * @brief   Checks whether the buffers exist
+     *
+     * @retval  true    ->  Create has been called
+     * @retval  false   ->  no buffers
+     */
+    csmBool IsCreated() const;
+
+    /**
+     * @brief   Uploads the opacities that changed in the last model update
+     *
+     * @param[in]   model   ->  Model
+     *
+     * @return  Bytes uploaded
+     */
+    csmUint32 UpdateDrawables(CubismModel& model);
+
+    /**
+     * @brief   Uploads the per-frame data and binds the buffers to their binding points<br>
+     *          Call it once the clipping contexts are set up for the frame.
+     *
+     * @param[in]   matrix          ->  Model-View-Projection matrix
+     * @param[in]   baseColor       ->  Model color, premultiplied when the model uses premultiplied alpha
+     * @param[in]   clippingManager ->  Clipping manager of the model, NULL without clipping masks
+     *
+     * @return  Bytes uploaded
+     */
+    csmUint32 UpdateFrame(CubismMatrix44& matrix, const CubismRenderer::CubismTextureColor& baseColor
+                          , CubismClippingManager_OpenGLES2* clippingManager);
+
+    /**
+     * @brief   Uploads every opacity on the next UpdateDrawables
+     */
+    void Invalidate();
+
+    GLuint _frameBuffer;                    ///< CubismFrame block
+    GLuint _clipBuffer;                     ///< CubismClips block
+    GLuint _drawableBuffer;                 ///< CubismDrawables block
+    csmVector<csmFloat32> _drawables;       ///< Copy of the CubismDrawables block, opacity and clipping context index of each drawable
+    csmVector<csmFloat32> _clips;           ///< Staging copy of the CubismClips block
+    csmBool _drawablesStale;                ///< Every opacity has to be read and uploaded again
+};
+
 /**
  * @brief   OpenGLES2用の描画命令を実装したクラス
  *
@@ -468,6 +831,115 @@ public:
      */
     csmInt32 GetClippingMaskBufferSize() const;
 
+    /**
+     * @brief  Draws from vertex buffers kept on the GPU instead of client-side arrays<br>
+     *         UVs and indices are uploaded once and only changed vertex positions are streamed each frame.
+     *         The buffers are created on the next draw; without OpenGL 3.2 the renderer keeps client-side arrays.
+     *
+     * @param[in]  enabled -> true to draw from vertex buffers
+     */
+    void UseVertexBuffers(csmBool enabled);
+
+    /**
+     * @brief  Checks whether the renderer draws from vertex buffers
+     *
+     * @return true when drawing from vertex buffers
+     */
+    csmBool IsUsingVertexBuffers() const;
+
+    /**
+     * @brief  Merges consecutive drawables that share texture, blend mode, culling and clipping mask into one draw call<br>
+     *         Only applies while drawing from vertex buffers, see UseVertexBuffers.
+     *
+     * @param[in]  enabled -> true to batch draw calls
+     */
+    void UseDrawBatching(csmBool enabled);
+
+    /**
+     * @brief  Checks whether draw calls are batched
+     *
+     * @return true when draw calls are batched
+     */
+    csmBool IsUsingDrawBatching() const;
+
+    /**
+     * @brief  Draws with GLSL 330 shaders that read the matrices, clipping data and opacities from uniform buffers<br>
+     *         Only applies while drawing from vertex buffers, see UseVertexBuffers. Without OpenGL 3.3,
+     *         or when the model has more drawables or clipping masks than the blocks hold, the GLES2 shaders are kept.
+     *         The shaders are legal in a core profile context.
+     *
+     * @param[in]  enabled -> true to use uniform buffers
+     */
+    void UseUniformBuffers(csmBool enabled);
+
+    /**
+     * @brief  Checks whether the renderer draws with uniform buffers
+     *
+     * @return true when drawing with uniform buffers
+     */
+    csmBool IsUsingUniformBuffers() const;
+
+    /**
+     * @brief  Discards the per-drawable data and clipping masks cached on the GPU<br>
+     *         Changes are detected from the dynamic flags of the last model update,
+     *         so call this when the model was updated without being drawn.
+     */
+    void InvalidateDrawableCaches();
+
+    /**
+     * @brief  Counters of the last DrawModel call
+     */
+    struct CubismDrawStatistics
+    {
+        csmUint32 DrawCalls;        ///< Draw calls issued
+        csmUint32 UploadedBytes;    ///< Vertex, index and uniform buffer bytes handed to the driver, client-side arrays included
+        csmUint32 StateChanges;     ///< Program, texture, blend, culling and vertex attribute calls passed to OpenGL
+        csmUint32 SkippedStateChanges;  ///< Calls of the same kinds skipped because the state already had the value
+        csmUint32 MaskRedraws;      ///< Clipping masks drawn into the mask buffer
+        csmUint32 MaskVerticesScanned;  ///< Vertices of clipped drawables read to compute the mask bounds
+    };
+
+    /**
+     * @brief  Gets the counters of the last DrawModel call
+     *
+     * @return Counters of the last frame
+     */
+    const CubismDrawStatistics& GetDrawStatistics() const;
+
+    /**
+     * @brief  Saves the OpenGL state before drawing the model and restores it afterwards (default)<br>
+     *         Disable it when the application owns the context and sets the state it needs every frame,
+     *         this saves the glGet queries of the profile. Only the frame buffer and viewport are queried then,
+     *         and the renderer leaves program 0 and texture unit 0 active when it is done.
+     *
+     * @param[in]  enabled -> true to save and restore the state
+     */
+    void UseStateRestore(csmBool enabled);
+
+    /**
+     * @brief  Checks whether the OpenGL state is saved and restored around DrawModel
+     *
+     * @return true when the state is restored
+     */
+    csmBool IsUsingStateRestore() const;
+
+    /**
+     * @brief  Keeps the clipping masks in the mask buffer between frames<br>
+     *         A mask is drawn again, in its own region and channel only, when its masking drawables changed
+     *         or when the bounds of its clipped drawables moved. The mask pass is skipped when no mask changed.
+     *         Has no effect with UseHighPrecisionMask, which draws a mask for every clipped drawable.
+     *
+     * @param[in]  enabled -> true to keep the masks
+     */
+    void UseMaskCaching(csmBool enabled);
+
+    /**
+     * @brief  Checks whether the clipping masks are kept between frames
+     *
+     * @return true when the masks are kept
+     */
+    csmBool IsUsingMaskCaching() const;
+
 protected:
     /**
      * @brief   コンストラクタ
@@ -579,6 +1051,70 @@ private:
      */
     CubismClippingContext* GetClippingContextBufferForDraw() const;
 
+    /**
+     * @brief   Creates, updates or releases the vertex buffers as requested by UseVertexBuffers,
+     *          and the uniform buffers as requested by UseUniformBuffers
+     */
+    void UpdateMeshBuffer();
+
+    /**
+     * @brief   Draws a drawable of the model from the vertex buffers, or from client-side arrays without them
+     *
+     * @param[in]   drawableIndex   ->  Drawable index
+     * @param[in]   colorBlendMode  ->  Color blend mode
+     * @param[in]   invertedMask    ->  Use the clipping mask inverted
+     */
+    void DrawDrawableMesh(csmInt32 drawableIndex, CubismBlendMode colorBlendMode, csmBool invertedMask);
+
+    /**
+     * @brief   Adds a drawable to the current batch, drawing the batch first when its state differs<br>
+     *          The culling, blend mode and inverted mask flag are taken from the model.
+     *
+     * @param[in]   drawableIndex   ->  Drawable index
+     * @param[in]   clipContext     ->  Clipping context of the drawable, NULL when it is not clipped
+     */
+    void BatchDrawableMesh(csmInt32 drawableIndex, CubismClippingContext* clipContext);
+
+    /**
+     * @brief   Draws the batched drawables with one glMultiDrawElementsBaseVertex call and empties the batch
+     */
+    void FlushDrawBatch();
+
+    /**
+     * @brief   Sets the culling, shader, texture and blending of a draw call
+     *
+     * @param[in]   textureNo       ->  Model texture number
+     * @param[in]   vertexCount     ->  Number of vertices
+     * @param[in]   vertexArray     ->  Vertex array, NULL when drawing from vertex buffers
+     * @param[in]   uvArray         ->  UV array, NULL when drawing from vertex buffers
+     * @param[in]   opacity         ->  Opacity
+     * @param[in]   colorBlendMode  ->  Color blend mode
+     * @param[in]   invertedMask    ->  Use the clipping mask inverted
+     *
+     * @retval  true    ->  ready to draw
+     * @retval  false   ->  the draw call has to be skipped
+     */
+    csmBool SetupMeshDraw(csmInt32 textureNo, csmInt32 vertexCount, csmFloat32* vertexArray, csmFloat32* uvArray
+                          , csmFloat32 opacity, CubismBlendMode colorBlendMode, csmBool invertedMask);
+
+    /**
+     * @brief   Common part of DrawMesh and DrawDrawableMesh
+     *
+     * @param[in]   textureNo       ->  Model texture number
+     * @param[in]   indexCount      ->  Number of indices
+     * @param[in]   vertexCount     ->  Number of vertices
+     * @param[in]   indices         ->  Index array, or the offset in the index buffer when drawing from vertex buffers
+     * @param[in]   baseVertex      ->  First vertex in the vertex buffers
+     * @param[in]   vertexArray     ->  Vertex array, NULL when drawing from vertex buffers
+     * @param[in]   uvArray         ->  UV array, NULL when drawing from vertex buffers
+     * @param[in]   opacity         ->  Opacity
+     * @param[in]   colorBlendMode  ->  Color blend mode
+     * @param[in]   invertedMask    ->  Use the clipping mask inverted
+     */
+    void DrawMeshElements(csmInt32 textureNo, csmInt32 indexCount, csmInt32 vertexCount
+                          , const void* indices, csmInt32 baseVertex, csmFloat32* vertexArray, csmFloat32* uvArray
+                          , csmFloat32 opacity, CubismBlendMode colorBlendMode, csmBool invertedMask);
+
 #ifdef CSM_TARGET_WIN_GL
     /**
      * @brief   Windows対応。OpenGL命令のバインドを行う。
@@ -604,6 +1140,23 @@ private:
     CubismClippingContext*              _clippingContextBufferForDraw;  ///< 画面上描画するためのクリッピングコンテキスト
 
     CubismOffscreenFrame_OpenGLES2      _offscreenFrameBuffer;          ///< マスク描画用のフレームバッファ
+
+    csmBool                             _useVertexBuffers;              ///< Draw from vertex buffers when supported
+    CubismMeshBuffer_OpenGLES2          _meshBuffer;                    ///< Vertex buffers of the model
+    CubismDrawStatistics                _drawStatistics;                ///< Counters of the last frame
+    CubismStateCache_OpenGLES2          _stateCache;                    ///< OpenGL state set while drawing
+    csmBool                             _useUniformBuffers;             ///< Draw with the GLSL 330 shaders when supported
+    CubismUniformBuffer_OpenGLES2       _uniformBuffer;                 ///< Uniform buffers of the GLSL 330 shaders
+    csmBool                             _useStateRestore;               ///< Save and restore the OpenGL state around DrawModel
+    csmBool                             _useMaskCaching;                ///< Keep the clipping masks between frames
+
+    csmBool                             _useDrawBatching;               ///< Merge draw calls with the same state
+    csmVector<GLsizei>                  _batchIndexCounts;              ///< Index count of each batched drawable
+    csmVector<void*>                    _batchIndexOffsets;             ///< Offset in the index buffer of each batched drawable
+    csmVector<GLint>                    _batchBaseVertices;             ///< First vertex of each batched drawable
+    csmInt32                            _batchSize;                     ///< Number of batched drawables
+    csmInt32                            _batchDrawable;                 ///< First batched drawable, its state is used for the whole batch
+    CubismClippingContext*              _batchClipContext;              ///< Clipping context of the batched drawables
 };
 
 }}}}
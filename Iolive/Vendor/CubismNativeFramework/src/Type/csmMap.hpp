@@ -61,9 +61,73 @@ public:
     _ValT Second;   ///< Valueとして用いる変数
 };
 
+/**
+ * @brief   Hash function of csmMap keys
+ *
+ * Key types without a specialization are looked up by a linear scan.
+ */
+template<class _KeyT>
+struct csmMapHash
+{
+    static const csmBool Enabled = false;
+
+    static csmUint32 Hash(const _KeyT&) { return 0; }
+};
+
+/**
+ * @brief   Mix the bits of a hash so the low bits can index a table
+ */
+inline csmUint32 csmMapMixHash(csmUint32 hash)
+{
+    hash ^= hash >> 16;
+    hash *= 0x45d9f3bu;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+template<>
+struct csmMapHash<csmInt32>
+{
+    static const csmBool Enabled = true;
+
+    static csmUint32 Hash(const csmInt32& key) { return csmMapMixHash(static_cast<csmUint32>(key)); }
+};
+
+template<>
+struct csmMapHash<csmUint32>
+{
+    static const csmBool Enabled = true;
+
+    static csmUint32 Hash(const csmUint32& key) { return csmMapMixHash(key); }
+};
+
+template<class _T>
+struct csmMapHash<_T*>
+{
+    static const csmBool Enabled = true;
+
+    static csmUint32 Hash(_T* const& key)
+    {
+        // allocations are aligned, drop the low bits
+        const csmSizeType address = reinterpret_cast<csmSizeType>(key) >> 3;
+        return csmMapMixHash(static_cast<csmUint32>(address) ^ static_cast<csmUint32>(static_cast<csmUint64>(address) >> 32));
+    }
+};
+
+template<>
+struct csmMapHash<csmString>
+{
+    static const csmBool Enabled = true;
+
+    static csmUint32 Hash(const csmString& key) { return csmMapMixHash(static_cast<csmUint32>(key.GetHashcode())); }
+};
+
 /**
  *@brief    マップ型<br>
  *           コンシューマゲーム機等でSTLの組み込みを避けるための実装。std::map の簡易版
+ *
+ * The pairs are kept in insertion order in one array. Small maps are scanned, larger maps
+ * with a csmMapHash key also get an open addressing index of the array, built on first use.
  */
 template<class _KeyT, class _ValT>
 class csmMap
@@ -103,6 +167,11 @@ public:
         CSM_PLACEMENT_NEW(addr) csmPair<_KeyT, _ValT>(key); //placement new
 
         _size += 1;
+
+        if (_slots != NULL)
+        {
+            IndexKey(_size - 1);
+        }
     }
 
     /**
@@ -110,24 +179,17 @@ public:
      *
      * @return  添字から特定されるValue値
      */
-    _ValT& operator[](_KeyT key)
+    _ValT& operator[](const _KeyT& key)
     {
-        csmInt32 found = -1;
-        for (csmInt32 i = 0; i < _size; i++)
-        {
-            if (_keyValues[i].First == key)
-            {
-                found = i;
-                break;
-            }
-        }
+        const csmInt32 found = Find(key);
         if (found >= 0)
         {
             return _keyValues[found].Second;
         }
         else
         {
-            AppendKey(key); // 新規キーを追加
+            _KeyT newKey(key);
+            AppendKey(newKey); // 新規キーを追加
             return _keyValues[_size - 1].Second;
         }
     }
@@ -137,17 +199,9 @@ public:
      *
      * @return  添字から特定されるValue値
      */
-    const _ValT& operator[](_KeyT key) const
+    const _ValT& operator[](const _KeyT& key) const
     {
-        csmInt32 found = -1;
-        for (csmInt32 i = 0; i < _size; i++)
-        {
-            if (_keyValues[i].First == key)
-            {
-                found = i;
-                break;
-            }
-        }
+        const csmInt32 found = Find(key);
         if (found >= 0)
         {
             return _keyValues[found].Second;
@@ -165,16 +219,9 @@ public:
      * @retval  true    ->  引数で渡したKeyを持つ要素が存在する
      * @retval  false   ->  引数で渡したKeyを持つ要素が存在しない
      */
-    csmBool IsExist(_KeyT key)
+    csmBool IsExist(const _KeyT& key) const
     {
-        for (csmInt32 i = 0; i < _size; i++)
-        {
-            if (_keyValues[i].First == key)
-            {
-                return true;
-            }
-        }
-        return false;
+        return (Find(key) >= 0);
     }
 
     /**
@@ -466,6 +513,9 @@ public:
             memmove(&(_keyValues[index]), &(_keyValues[index + 1]), sizeof(csmPair<_KeyT, _ValT>) * (_size - index - 1));
         --_size;
 
+        // the following pairs moved, the index is rebuilt on the next lookup
+        ReleaseIndex();
+
         iterator ite2(this, index); // 終了
         return ite2;
     }
@@ -486,6 +536,9 @@ public:
             memmove(&(_keyValues[index]), &(_keyValues[index + 1]), sizeof(csmPair<_KeyT, _ValT>) * (_size - index - 1));
         --_size;
 
+        // the following pairs moved, the index is rebuilt on the next lookup
+        ReleaseIndex();
+
         const_iterator ite2(this, index); // 終了
         return ite2;
     }
@@ -502,11 +555,121 @@ public:
 
 private:
     static const csmInt32 DefaultSize = 10;  ///< コンテナ初期化のデフォルトサイズ
+    static const csmInt32 SmallSize = 4;     ///< maps up to this size are scanned without an index
+
+    /**
+     * @brief   Find the first pair with a key
+     *
+     * @param[in]   key ->  key to find
+     * @return  index of the pair, -1 if none
+     */
+    csmInt32 Find(const _KeyT& key) const
+    {
+        if (csmMapHash<_KeyT>::Enabled && _size > SmallSize)
+        {
+            return FindIndexed(key);
+        }
+
+        for (csmInt32 i = 0; i < _size; i++)
+        {
+            if (_keyValues[i].First == key)
+            {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * @brief   Find the first pair with a key through the index
+     *
+     * @param[in]   key ->  key to find
+     * @return  index of the pair, -1 if none
+     */
+    csmInt32 FindIndexed(const _KeyT& key) const
+    {
+        if (_slots == NULL)
+        {
+            BuildIndex();
+        }
+
+        const csmUint32 mask = static_cast<csmUint32>(_slotCount - 1);
+        for (csmUint32 slot = csmMapHash<_KeyT>::Hash(key) & mask; _slots[slot] >= 0; slot = (slot + 1) & mask)
+        {
+            if (_keyValues[_slots[slot]].First == key)
+            {
+                return _slots[slot];
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * @brief   Build the index of all the pairs, at most half full
+     */
+    void BuildIndex() const
+    {
+        csmInt32 slotCount = SmallSize * 4;
+        while (slotCount < _size * 2) slotCount *= 2;
+
+        ReleaseIndex();
+        _slots = static_cast<csmInt32*>(CSM_MALLOC(sizeof(csmInt32) * slotCount));
+        CSM_ASSERT(_slots != NULL);
+        memset(_slots, 0xff, sizeof(csmInt32) * slotCount);
+        _slotCount = slotCount;
+
+        for (csmInt32 i = 0; i < _size; i++)
+        {
+            IndexKey(i);
+        }
+    }
+
+    /**
+     * @brief   Add a pair to the index, the first pair of a key wins like in the scan
+     *
+     * @param[in]   index   ->  index of the pair
+     */
+    void IndexKey(csmInt32 index) const
+    {
+        if ((index + 1) * 2 > _slotCount)
+        {
+            BuildIndex();
+            return;
+        }
+
+        const csmUint32 mask = static_cast<csmUint32>(_slotCount - 1);
+        csmUint32 slot = csmMapHash<_KeyT>::Hash(_keyValues[index].First) & mask;
+
+        for (; _slots[slot] >= 0; slot = (slot + 1) & mask)
+        {
+            if (_keyValues[_slots[slot]].First == _keyValues[index].First)
+            {
+                return;
+            }
+        }
+
+        _slots[slot] = index;
+    }
+
+    /**
+     * @brief   Drop the index
+     */
+    void ReleaseIndex() const
+    {
+        if (_slots != NULL)
+        {
+            CSM_FREE(_slots);
+            _slots = NULL;
+            _slotCount = 0;
+        }
+    }
 
     csmPair<_KeyT, _ValT>* _keyValues;      ///< Key-Valueペアの配列
-    _ValT* _dummyValuePtr;                  ///< 空の値を返すためのダミー(staticのtemplteを回避するためメンバとする）
+    mutable _ValT* _dummyValuePtr;          ///< 空の値を返すためのダミー(staticのtemplteを回避するためメンバとする）
     csmInt32 _size;                         ///< コンテナの要素数（サイズ）
     csmInt32 _capacity;                     ///< コンテナのキャパシティ
+    mutable csmInt32* _slots;               ///< index of _keyValues for each slot, -1 if empty, NULL without index
+    mutable csmInt32 _slotCount;            ///< number of slots, a power of two
 };
 
 
@@ -518,11 +681,15 @@ csmMap<_KeyT, _ValT>::csmMap()
     , _dummyValuePtr(NULL)
     , _size(0)
     , _capacity(0)
+    , _slots(NULL)
+    , _slotCount(0)
 { }
 
 template<class _KeyT, class _ValT>
 csmMap<_KeyT, _ValT>::csmMap(csmInt32 size)
     : _dummyValuePtr(NULL)
+    , _slots(NULL)
+    , _slotCount(0)
 {
     if (size < 1)
     {
@@ -600,6 +767,8 @@ void csmMap<_KeyT, _ValT>::Clear()
 
     _size = 0;
     _capacity = 0;
+
+    ReleaseIndex();
 }
 }}}
 
@@ -12,7 +12,7 @@
 
 //--------- LIVE2D NAMESPACE ------------
 namespace Live2D { namespace Cubism { namespace Framework {
-csmInt32 csmString::s_totalInstanceNo = 0;
+std::atomic<csmInt32> csmString::s_totalInstanceNo(0);
 
 namespace {
 const csmChar* s_emptyString = "";
@@ -30,7 +30,7 @@ csmString::csmString()
 {
     this->_small[0] = '\0';
     _hashcode = CalcHashcode(WritePointer(), this->_length);
-    _instanceNo = s_totalInstanceNo++;
+    _instanceNo = s_totalInstanceNo.fetch_add(1, std::memory_order_relaxed);
 }
 
 csmString::csmString(const csmChar* c)
@@ -47,7 +47,7 @@ csmString::csmString(const csmChar* c)
         SetEmpty();
     }
 
-    _instanceNo = s_totalInstanceNo++;
+    _instanceNo = s_totalInstanceNo.fetch_add(1, std::memory_order_relaxed);
 }
 
 csmString::csmString(const csmString& s)
@@ -62,7 +62,7 @@ csmString::csmString(const csmString& s)
         SetEmpty();
     }
 
-    _instanceNo = s_totalInstanceNo++;
+    _instanceNo = s_totalInstanceNo.fetch_add(1, std::memory_order_relaxed);
 }
 
 csmString::csmString(const csmChar* s, csmInt32 length)
@@ -77,13 +77,13 @@ csmString::csmString(const csmChar* s, csmInt32 length)
         SetEmpty();
     }
 
-    _instanceNo = s_totalInstanceNo++;
+    _instanceNo = s_totalInstanceNo.fetch_add(1, std::memory_order_relaxed);
 }
 
 csmString::csmString(const csmChar* c, csmInt32 length, csmBool useptr)
 {
     Initialize(c, length, useptr);
-    _instanceNo = s_totalInstanceNo++;
+    _instanceNo = s_totalInstanceNo.fetch_add(1, std::memory_order_relaxed);
 }
 
 void csmString::Initialize(const csmChar* c, csmInt32 length, csmBool usePtr)
@@ -457,9 +457,8 @@ const csmChar* csmString::GetRawString() const
     }
 }
 
-csmInt32 csmString::GetHashcode()
+csmInt32 csmString::GetHashcode() const
 {
-    if (_hashcode == -1) _hashcode = CalcHashcode(WritePointer(), this->_length);
     return _hashcode;
 }
 
@@ -9,6 +9,7 @@
 
 #include "CubismFramework.hpp"
 #include <string.h>
+#include <atomic>
 
 //--------- LIVE2D NAMESPACE ------------
 namespace Live2D { namespace Cubism { namespace Framework {
@@ -164,9 +165,22 @@ public:
     /**
      * @brief   ハッシュコードを取得する
      *
+     * The hash code is computed whenever the string changes, so this is free.
+     *
      * @return  ハッシュコード
      */
-    csmInt32 GetHashcode();
+    csmInt32 GetHashcode() const;
+
+    /**
+     * @brief   文字列からハッシュ値を生成して返す
+     *
+     * Same value as GetHashcode() of a csmString holding the characters.
+     *
+     * @param[in]   c       ->  文字列
+     * @param[in]   length  ->  ハッシュ値の長さ
+     * @return      文字列から生成したハッシュ値
+     */
+    static csmInt32 CalcHashcode(const csmChar* c, csmInt32 length);
 
 
 protected:
@@ -188,19 +202,10 @@ protected:
      */
     void Initialize(const csmChar* c, csmInt32 length, csmBool usePtr);
 
-    /**
-     * @brief   文字列からハッシュ値を生成して返す
-     *
-     * @param[in]   c       ->  文字列
-     * @param[in]   length  ->  ハッシュ値の長さ
-     * @return      文字列から生成したハッシュ値
-     */
-    csmInt32 CalcHashcode(const csmChar* c, csmInt32 length);
-
 private:
     static const csmInt32 SmallLength = 64; ///< この長さ-1未満の文字列は内部バッファを使用
     static const csmInt32 DefaultSize = 10; ///< デフォルトの文字数
-    static csmInt32 s_totalInstanceNo;      ///< 通算のインスタンス番号
+    static std::atomic<csmInt32> s_totalInstanceNo; ///< 通算のインスタンス番号 (atomic, strings are created from the loader threads)
     csmChar* _ptr;                          ///< 文字型配列のポインタ
     csmInt32 _length;                       ///< 半角文字数（メモリ確保は最後に0が入るため_length+1）
     csmInt32 _hashcode;                     ///< インスタンスに当てられたハッシュ値
@@ -0,0 +1,129 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "CubismTaskPool.hpp"
+
+//--------- LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Utils{
+
+CubismTaskPool::CubismTaskPool(csmInt32 workerCount)
+    : _generation(0)
+    , _busyWorkers(0)
+    , _stopping(false)
+    , _function(NULL)
+    , _context(NULL)
+    , _taskCount(0)
+    , _nextTask(0)
+    , _remainingTasks(0)
+{
+    for (csmInt32 i = 0; i < workerCount; ++i)
+    {
+        _workers.PushBack(CSM_NEW std::thread(&CubismTaskPool::WorkerLoop, this));
+    }
+}
+
+CubismTaskPool::~CubismTaskPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _wake.notify_all();
+
+    for (csmUint32 i = 0; i < _workers.GetSize(); ++i)
+    {
+        _workers[i]->join();
+        CSM_DELETE(_workers[i]);
+    }
+}
+
+void CubismTaskPool::Run(TaskFunction function, void* context, csmInt32 taskCount)
+{
+    if (taskCount <= 0)
+    {
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        // a worker may still be leaving the last Run()
+        _idle.wait(lock, [this]() { return _busyWorkers == 0; });
+
+        _function = function;
+        _context = context;
+        _taskCount = taskCount;
+        _nextTask.store(0, std::memory_order_relaxed);
+        _remainingTasks.store(taskCount, std::memory_order_relaxed);
+        ++_generation;
+    }
+    _wake.notify_all();
+
+    RunTasks();
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _idle.wait(lock, [this]() { return _remainingTasks.load(std::memory_order_acquire) == 0 && _busyWorkers == 0; });
+}
+
+csmInt32 CubismTaskPool::GetWorkerCount() const
+{
+    return static_cast<csmInt32>(_workers.GetSize());
+}
+
+void CubismTaskPool::WorkerLoop()
+{
+    csmUint32 generation = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _wake.wait(lock, [this, generation]() { return _stopping || _generation != generation; });
+
+            if (_stopping)
+            {
+                return;
+            }
+
+            generation = _generation;
+            ++_busyWorkers;
+        }
+
+        RunTasks();
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            --_busyWorkers;
+        }
+        _idle.notify_all();
+    }
+}
+
+void CubismTaskPool::RunTasks()
+{
+    while (true)
+    {
+        const csmInt32 taskIndex = _nextTask.fetch_add(1, std::memory_order_relaxed);
+
+        if (taskIndex >= _taskCount)
+        {
+            return;
+        }
+
+        _function(_context, taskIndex);
+
+        if (_remainingTasks.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            // lock so the notify can't slip in before Run() waits
+            std::lock_guard<std::mutex> lock(_mutex);
+            _idle.notify_all();
+        }
+    }
+}
+
+}}}}
+//--------- LIVE2D NAMESPACE ------------
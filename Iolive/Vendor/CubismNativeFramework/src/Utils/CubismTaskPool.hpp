@@ -0,0 +1,96 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include "CubismFramework.hpp"
+#include "Type/csmVector.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+//--------- LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Utils{
+
+/**
+ * @brief Persistent worker threads running indexed tasks
+ *
+ * Run() hands out the task indices one at a time from a shared counter, so an idle
+ * thread takes the next task instead of waiting for a slow one. The calling thread
+ * runs tasks too and Run() returns once every task is done.
+ */
+class CubismTaskPool
+{
+public:
+    /**
+     * @brief Task function
+     *
+     * @param[in]   context     pointer given to Run()
+     * @param[in]   taskIndex   task to run, 0 to taskCount - 1
+     */
+    typedef void (*TaskFunction)(void* context, csmInt32 taskIndex);
+
+    /**
+     * @brief Start the worker threads
+     *
+     * @param[in]   workerCount     threads besides the caller of Run()
+     */
+    CubismTaskPool(csmInt32 workerCount);
+
+    /**
+     * @brief Stop & join the worker threads
+     */
+    ~CubismTaskPool();
+
+    /**
+     * @brief Run every task and wait for them
+     *
+     * Not reentrant, a pool runs one set of tasks at a time.
+     *
+     * @param[in]   function    task function
+     * @param[in]   context     passed to the task function
+     * @param[in]   taskCount   number of tasks
+     */
+    void Run(TaskFunction function, void* context, csmInt32 taskCount);
+
+    /**
+     * @brief Get the number of worker threads
+     *
+     * @return threads besides the caller of Run()
+     */
+    csmInt32 GetWorkerCount() const;
+
+private:
+    // Prevention of copy Constructor
+    CubismTaskPool(const CubismTaskPool&);
+    CubismTaskPool& operator=(const CubismTaskPool&);
+
+    void WorkerLoop();
+
+    /**
+     * @brief Take & run tasks until none is left
+     */
+    void RunTasks();
+
+    csmVector<std::thread*>     _workers;
+    std::mutex                  _mutex;
+    std::condition_variable     _wake;              ///< a new set of tasks or stopping
+    std::condition_variable     _idle;              ///< the tasks are done and no worker is in RunTasks
+    csmUint32                   _generation;        ///< incremented by every Run()
+    csmInt32                    _busyWorkers;       ///< workers inside RunTasks
+    csmBool                     _stopping;
+
+    TaskFunction                _function;          ///< only written while no worker is busy
+    void*                       _context;
+    csmInt32                    _taskCount;
+    std::atomic<csmInt32>       _nextTask;
+    std::atomic<csmInt32>       _remainingTasks;
+};
+
+}}}}
+//--------- LIVE2D NAMESPACE ------------
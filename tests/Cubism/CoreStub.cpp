@@ -0,0 +1,281 @@
+#include "CoreStub.hpp"
+#include "Live2D/CubismSamples/LAppAllocator.hpp"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+using namespace Live2D::Cubism::Core;
+
+namespace {
+
+	// what a csmModel points to: the arrays of the real Core, built from a ModelDesc
+	struct StubModel
+	{
+		std::vector<std::string> ParameterIdStrings;
+		std::vector<const char*> ParameterIds;
+		std::vector<float> ParameterMinimums;
+		std::vector<float> ParameterMaximums;
+		std::vector<float> ParameterDefaults;
+		std::vector<float> ParameterValues;
+
+		std::vector<std::string> PartIdStrings;
+		std::vector<const char*> PartIds;
+		std::vector<float> PartOpacities;
+		std::vector<int> PartParents;
+
+		std::vector<std::string> DrawableIdStrings;
+		std::vector<const char*> DrawableIds;
+		std::vector<csmFlags> ConstantFlags;
+		std::vector<csmFlags> DynamicFlags;
+		std::vector<int> TextureIndices;
+		std::vector<int> DrawOrders;
+		std::vector<int> RenderOrders;
+		std::vector<float> Opacities;
+		std::vector<int> MaskCounts;
+		std::vector<int> MaskIndices; // the one mask of a clipped drawable
+		std::vector<const int*> Masks;
+		std::vector<int> VertexCounts;
+		std::vector<csmVector2> Positions; // 4 per drawable
+		std::vector<csmVector2> BasePositions;
+		std::vector<bool> Moving;
+		std::vector<csmVector2> Uvs;
+		std::vector<const csmVector2*> PositionPointers;
+		std::vector<const csmVector2*> UvPointers;
+		std::vector<int> IndexCounts;
+		std::vector<unsigned short> Indices; // 6 per drawable
+		std::vector<const unsigned short*> IndexPointers;
+
+		int UpdateCount = 0;
+
+		explicit StubModel(const CoreStub::ModelDesc& desc)
+		{
+			const size_t parameterCount = desc.ParameterIds.size();
+			ParameterIdStrings = desc.ParameterIds;
+			for (const std::string& id : ParameterIdStrings)
+				ParameterIds.push_back(id.c_str());
+			ParameterMinimums.assign(parameterCount, desc.ParameterMinimum);
+			ParameterMaximums.assign(parameterCount, desc.ParameterMaximum);
+			ParameterDefaults.assign(parameterCount, desc.ParameterDefault);
+			ParameterValues = ParameterDefaults;
+
+			PartIdStrings = desc.PartIds;
+			for (const std::string& id : PartIdStrings)
+				PartIds.push_back(id.c_str());
+			PartOpacities.assign(PartIds.size(), 1.0f);
+			PartParents.assign(PartIds.size(), -1);
+
+			const int drawableCount = desc.DrawableCount;
+			for (int i = 0; i < drawableCount; i++)
+				DrawableIdStrings.push_back("Drawable" + std::to_string(i));
+			for (const std::string& id : DrawableIdStrings)
+				DrawableIds.push_back(id.c_str());
+			ConstantFlags.assign(drawableCount, csmIsDoubleSided);
+			DynamicFlags.assign(drawableCount, csmIsVisible);
+			Opacities.assign(drawableCount, 1.0f);
+			MaskCounts.assign(drawableCount, 0);
+			MaskIndices.assign(drawableCount, 0);
+			Masks.assign(drawableCount, nullptr);
+			Moving.assign(drawableCount, false);
+			VertexCounts.assign(drawableCount, 4);
+			IndexCounts.assign(drawableCount, 6);
+
+			const unsigned short quad[] = { 0, 1, 2, 2, 1, 3 };
+			for (int i = 0; i < drawableCount; i++)
+			{
+				DrawOrders.push_back(i);
+				RenderOrders.push_back(i);
+				TextureIndices.push_back((i / 40) % desc.TextureCount);
+				Moving[i] = desc.MovingStride > 0 && i % desc.MovingStride == 0;
+
+				if (desc.ClippedStride > 0 && i % desc.ClippedStride == desc.ClippedStride - 1 && i > 0)
+				{
+					MaskCounts[i] = 1;
+					MaskIndices[i] = i - 1;
+				}
+
+				const float x = -1.0f + 2.0f * (i % 16) / 16.0f;
+				const float y = -1.0f + 2.0f * ((i / 16) % 16) / 16.0f;
+				Positions.insert(Positions.end(), { { x, y }, { x + 0.125f, y }, { x, y + 0.125f }, { x + 0.125f, y + 0.125f } });
+				Uvs.insert(Uvs.end(), { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 0.0f, 1.0f }, { 1.0f, 1.0f } });
+				Indices.insert(Indices.end(), quad, quad + 6);
+			}
+			BasePositions = Positions;
+			for (int i = 0; i < drawableCount; i++)
+			{
+				Masks[i] = MaskCounts[i] > 0 ? &MaskIndices[i] : nullptr;
+				PositionPointers.push_back(Positions.data() + i * 4);
+				UvPointers.push_back(Uvs.data() + i * 4);
+				IndexPointers.push_back(Indices.data() + i * 6);
+			}
+		}
+
+		// the first update reports everything changed, later ones the moved vertices
+		void Update()
+		{
+			const csmFlags changed = UpdateCount == 0
+				? csmVisibilityDidChange | csmOpacityDidChange | csmDrawOrderDidChange | csmRenderOrderDidChange | csmVertexPositionsDidChange
+				: 0;
+			UpdateCount++;
+
+			for (size_t i = 0; i < DynamicFlags.size(); i++)
+			{
+				DynamicFlags[i] = csmIsVisible | changed;
+				if (!Moving[i])
+					continue;
+
+				const float offset = 0.01f * std::sin(UpdateCount * 0.05f + i);
+				for (size_t v = i * 4; v < i * 4 + 4; v++)
+				{
+					Positions[v].X = BasePositions[v].X + offset;
+					Positions[v].Y = BasePositions[v].Y - offset;
+				}
+				DynamicFlags[i] |= csmVertexPositionsDidChange;
+			}
+		}
+	};
+
+	// the stub csmModel memory only holds the StubModel pointer
+	StubModel* GetStub(const csmModel* model)
+	{
+		StubModel* stub = nullptr;
+		std::memcpy(&stub, model, sizeof(stub));
+		return stub;
+	}
+
+	csmLogFunction s_LogFunction = nullptr;
+	LAppAllocator s_Allocator;
+	Csm::CubismFramework::Option s_Option;
+
+} // namespace
+
+namespace CoreStub {
+
+	ModelDesc MakeDesc(int parameterCount, int partCount, int drawableCount)
+	{
+		ModelDesc desc;
+		for (int i = 0; i < parameterCount; i++)
+			desc.ParameterIds.push_back("Param" + std::to_string(i));
+		for (int i = 0; i < partCount; i++)
+			desc.PartIds.push_back("Part" + std::to_string(i));
+		desc.DrawableCount = drawableCount;
+		return desc;
+	}
+
+	// the "moc3 file" is the address of desc, read back by csmInitializeModelInPlace
+	std::vector<unsigned char> MocBytes(const ModelDesc& desc)
+	{
+		const ModelDesc* address = &desc;
+		std::vector<unsigned char> bytes(sizeof(address));
+		std::memcpy(bytes.data(), &address, sizeof(address));
+		return bytes;
+	}
+
+	void StartFramework()
+	{
+		if (Csm::CubismFramework::IsInitialized())
+			return;
+
+		s_Option.LoggingLevel = Csm::CubismFramework::Option::LogLevel_Warning;
+		s_Option.LogFunction = [](const char* message) { std::fputs(message, stderr); };
+		Csm::CubismFramework::StartUp(&s_Allocator, &s_Option);
+		Csm::CubismFramework::Initialize();
+	}
+
+	Model::Model(const ModelDesc& desc)
+		: m_Moc(nullptr), m_Model(nullptr)
+	{
+		StartFramework();
+
+		const std::vector<unsigned char> moc = MocBytes(desc);
+		m_Moc = Csm::CubismMoc::Create(moc.data(), static_cast<Csm::csmSizeInt>(moc.size()));
+		m_Model = m_Moc->CreateModel();
+	}
+
+	Model::~Model()
+	{
+		StubModel* stub = GetStub(m_Model->GetModel());
+		m_Moc->DeleteModel(m_Model);
+		Csm::CubismMoc::Delete(m_Moc);
+		delete stub;
+	}
+
+	int Model::GetUpdateCount() const
+	{
+		return GetStub(m_Model->GetModel())->UpdateCount;
+	}
+
+} // namespace CoreStub
+
+// the Core API, declared by the framework in Live2D::Cubism::Core
+namespace Live2D { namespace Cubism { namespace Core {
+extern "C" {
+
+	csmVersion csmGetVersion() { return 0x04000000; }
+	csmMocVersion csmGetLatestMocVersion() { return csmMocVersion_40; }
+	csmMocVersion csmGetMocVersion(const void*, const unsigned int) { return csmMocVersion_40; }
+	csmLogFunction csmGetLogFunction() { return s_LogFunction; }
+	void csmSetLogFunction(csmLogFunction handler) { s_LogFunction = handler; }
+
+	csmMoc* csmReviveMocInPlace(void* address, const unsigned int size)
+	{
+		return size == sizeof(CoreStub::ModelDesc*) ? static_cast<csmMoc*>(address) : nullptr;
+	}
+
+	unsigned int csmGetSizeofModel(const csmMoc*) { return sizeof(StubModel*); }
+
+	csmModel* csmInitializeModelInPlace(const csmMoc* moc, void* address, const unsigned int size)
+	{
+		if (size < sizeof(StubModel*))
+			return nullptr;
+
+		const CoreStub::ModelDesc* desc = nullptr;
+		std::memcpy(&desc, moc, sizeof(desc));
+
+		StubModel* stub = new StubModel(*desc);
+		std::memcpy(address, &stub, sizeof(stub));
+		return static_cast<csmModel*>(address);
+	}
+
+	void csmUpdateModel(csmModel* model) { GetStub(model)->Update(); }
+
+	void csmReadCanvasInfo(const csmModel*, csmVector2* outSizeInPixels, csmVector2* outOriginInPixels, float* outPixelsPerUnit)
+	{
+		*outSizeInPixels = { 2.0f, 2.0f };
+		*outOriginInPixels = { 1.0f, 1.0f };
+		*outPixelsPerUnit = 1.0f;
+	}
+
+	int csmGetParameterCount(const csmModel* model) { return static_cast<int>(GetStub(model)->ParameterIds.size()); }
+	const char** csmGetParameterIds(const csmModel* model) { return GetStub(model)->ParameterIds.data(); }
+	const float* csmGetParameterMinimumValues(const csmModel* model) { return GetStub(model)->ParameterMinimums.data(); }
+	const float* csmGetParameterMaximumValues(const csmModel* model) { return GetStub(model)->ParameterMaximums.data(); }
+	const float* csmGetParameterDefaultValues(const csmModel* model) { return GetStub(model)->ParameterDefaults.data(); }
+	float* csmGetParameterValues(csmModel* model) { return GetStub(model)->ParameterValues.data(); }
+
+	int csmGetPartCount(const csmModel* model) { return static_cast<int>(GetStub(model)->PartIds.size()); }
+	const char** csmGetPartIds(const csmModel* model) { return GetStub(model)->PartIds.data(); }
+	float* csmGetPartOpacities(csmModel* model) { return GetStub(model)->PartOpacities.data(); }
+	const int* csmGetPartParentPartIndices(const csmModel* model) { return GetStub(model)->PartParents.data(); }
+
+	int csmGetDrawableCount(const csmModel* model) { return static_cast<int>(GetStub(model)->DrawableIds.size()); }
+	const char** csmGetDrawableIds(const csmModel* model) { return GetStub(model)->DrawableIds.data(); }
+	const csmFlags* csmGetDrawableConstantFlags(const csmModel* model) { return GetStub(model)->ConstantFlags.data(); }
+	const csmFlags* csmGetDrawableDynamicFlags(const csmModel* model) { return GetStub(model)->DynamicFlags.data(); }
+	const int* csmGetDrawableTextureIndices(const csmModel* model) { return GetStub(model)->TextureIndices.data(); }
+	const int* csmGetDrawableDrawOrders(const csmModel* model) { return GetStub(model)->DrawOrders.data(); }
+	const int* csmGetDrawableRenderOrders(const csmModel* model) { return GetStub(model)->RenderOrders.data(); }
+	const float* csmGetDrawableOpacities(const csmModel* model) { return GetStub(model)->Opacities.data(); }
+	const int* csmGetDrawableMaskCounts(const csmModel* model) { return GetStub(model)->MaskCounts.data(); }
+	const int** csmGetDrawableMasks(const csmModel* model) { return GetStub(model)->Masks.data(); }
+	const int* csmGetDrawableVertexCounts(const csmModel* model) { return GetStub(model)->VertexCounts.data(); }
+	const csmVector2** csmGetDrawableVertexPositions(const csmModel* model) { return GetStub(model)->PositionPointers.data(); }
+	const csmVector2** csmGetDrawableVertexUvs(const csmModel* model) { return GetStub(model)->UvPointers.data(); }
+	const int* csmGetDrawableIndexCounts(const csmModel* model) { return GetStub(model)->IndexCounts.data(); }
+	const unsigned short** csmGetDrawableIndices(const csmModel* model) { return GetStub(model)->IndexPointers.data(); }
+
+	// CubismModel::Update resets right after csmUpdateModel, before the renderer reads the flags.
+	// csmUpdateModel rewrites them all, so there is nothing to reset here
+	void csmResetDrawableDynamicFlags(csmModel*) {}
+
+} // extern "C"
+}}}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <CubismFramework.hpp>
+#include <Model/CubismMoc.hpp>
+#include <Model/CubismModel.hpp>
+#include <string>
+#include <vector>
+
+/*
+* Stand-in for the Live2D Cubism Core, so the framework (model, motions,
+* physics, ids) runs in tests without the proprietary library nor a .moc3.
+* The "moc" is a ModelDesc, csmInitializeModelInPlace lays it out in the arrays
+* the framework reads from the real Core. csmUpdateModel sways the moving
+* drawables and flags them like the Core does.
+*/
+namespace CoreStub {
+
+	struct ModelDesc
+	{
+		std::vector<std::string> ParameterIds;
+		float ParameterMinimum = -30.0f;
+		float ParameterMaximum = 30.0f;
+		float ParameterDefault = 0.0f;
+
+		std::vector<std::string> PartIds;
+
+		int DrawableCount = 0; // one quad each
+		int TextureCount = 1; // runs of 40 drawables per texture
+		int MovingStride = 0; // every n-th drawable moves on csmUpdateModel, 0 for none
+		int ClippedStride = 0; // every n-th drawable is clipped by the one before, 0 for none
+	};
+
+	// parameters "Param0".."Param<n-1>", parts "Part0".., drawables
+	ModelDesc MakeDesc(int parameterCount, int partCount = 0, int drawableCount = 0);
+
+	// content of a .moc3 file for desc, valid in this process as long as desc lives
+	std::vector<unsigned char> MocBytes(const ModelDesc& desc);
+
+	// CubismFramework::StartUp + Initialize, once per process
+	void StartFramework();
+
+	// a CubismModel of desc, created through CubismMoc like a loaded .moc3
+	class Model
+	{
+	public:
+		explicit Model(const ModelDesc& desc);
+		~Model();
+
+		Model(const Model&) = delete;
+		Model& operator=(const Model&) = delete;
+
+		Csm::CubismModel* Get() const { return m_Model; }
+		Csm::CubismModel* operator->() const { return m_Model; }
+
+		// csmUpdateModel calls so far
+		int GetUpdateCount() const;
+
+	private:
+		Csm::CubismMoc* m_Moc;
+		Csm::CubismModel* m_Model;
+	};
+
+} // namespace CoreStub
@@ -0,0 +1,150 @@
+#include "CoreStub.hpp"
+#include <benchmark/benchmark.h>
+#include <Id/CubismIdManager.hpp>
+#include <Type/csmMap.hpp>
+#include <Type/csmString.hpp>
+#include <string>
+#include <vector>
+
+using namespace Csm;
+
+namespace {
+
+	std::vector<csmString> MakeKeys(int count)
+	{
+		std::vector<csmString> keys;
+		for (int i = 0; i < count; i++)
+			keys.push_back(csmString(("Key" + std::to_string(i)).c_str()));
+		return keys;
+	}
+
+} // namespace
+
+// CubismJson objects: a map filled member by member while parsing
+static void BM_CsmMapJsonObjectBuild(benchmark::State& state)
+{
+	CoreStub::StartFramework();
+	const int count = static_cast<int>(state.range(0));
+	const std::vector<csmString> keys = MakeKeys(count);
+
+	for (auto _ : state)
+	{
+		csmMap<csmString, csmFloat32> map;
+		for (int i = 0; i < count; i++)
+			map[keys[i]] = static_cast<csmFloat32>(i);
+		benchmark::DoNotOptimize(map.GetSize());
+	}
+	state.SetItemsProcessed(state.iterations() * count);
+}
+
+// Value::operator[](csmString) of a parsed json object, by member name
+static void BM_CsmMapJsonObjectLookup(benchmark::State& state)
+{
+	CoreStub::StartFramework();
+	const int count = static_cast<int>(state.range(0));
+	const std::vector<csmString> keys = MakeKeys(count);
+
+	csmMap<csmString, csmFloat32> map;
+	for (int i = 0; i < count; i++)
+		map[keys[i]] = static_cast<csmFloat32>(i);
+	const csmMap<csmString, csmFloat32>& constMap = map;
+
+	int k = 0;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(constMap[keys[k]]);
+		k = (k + 7) % count;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+// CubismModel::_notExistParameterValues: IsExist then operator[] by parameter index
+static void BM_CsmMapIntIsExistGet(benchmark::State& state)
+{
+	CoreStub::StartFramework();
+	const int count = static_cast<int>(state.range(0));
+
+	csmMap<csmInt32, csmFloat32> map;
+	for (int i = 0; i < count; i++)
+		map[1000 + i] = static_cast<csmFloat32>(i);
+
+	int k = 0;
+	for (auto _ : state)
+	{
+		const csmInt32 key = 1000 + k;
+		if (map.IsExist(key))
+			benchmark::DoNotOptimize(map[key]);
+		k = (k + 7) % count;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+// CubismModel::_notExistParameterId: CubismIdHandle keys, GetParameterIndex of unknown ids
+static void BM_CsmMapIdIsExistGet(benchmark::State& state)
+{
+	CoreStub::StartFramework();
+	const int count = static_cast<int>(state.range(0));
+
+	std::vector<CubismIdHandle> ids;
+	csmMap<CubismIdHandle, csmInt32> map;
+	for (int i = 0; i < count; i++)
+	{
+		ids.push_back(CubismFramework::GetIdManager()->GetId(("CsmMapBenchmark" + std::to_string(i)).c_str()));
+		map[ids.back()] = i;
+	}
+
+	int k = 0;
+	for (auto _ : state)
+	{
+		const CubismIdHandle key = ids[k];
+		if (map.IsExist(key))
+			benchmark::DoNotOptimize(map[key]);
+		k = (k + 7) % count;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+// CubismModelMatrix::SetupFromLayout and the json dumps walk the map in insertion order
+static void BM_CsmMapIterate(benchmark::State& state)
+{
+	CoreStub::StartFramework();
+	const int count = static_cast<int>(state.range(0));
+	const std::vector<csmString> keys = MakeKeys(count);
+
+	csmMap<csmString, csmFloat32> map;
+	for (int i = 0; i < count; i++)
+		map[keys[i]] = static_cast<csmFloat32>(i);
+
+	for (auto _ : state)
+	{
+		csmFloat32 sum = 0.0f;
+		for (csmMap<csmString, csmFloat32>::const_iterator ite = map.Begin(); ite != map.End(); ++ite)
+			sum += ite->Second;
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * count);
+}
+
+// fill then erase from the front, the map emptied element by element
+static void BM_CsmMapEraseAll(benchmark::State& state)
+{
+	CoreStub::StartFramework();
+	const int count = static_cast<int>(state.range(0));
+
+	for (auto _ : state)
+	{
+		csmMap<csmInt32, csmFloat32> map;
+		for (int i = 0; i < count; i++)
+			map[i] = static_cast<csmFloat32>(i);
+		while (map.GetSize() > 0)
+			map.Erase(map.Begin());
+	}
+	state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK(BM_CsmMapJsonObjectBuild)->Arg(4)->Arg(16)->Arg(64)->Arg(256);
+BENCHMARK(BM_CsmMapJsonObjectLookup)->Arg(4)->Arg(16)->Arg(64)->Arg(256);
+BENCHMARK(BM_CsmMapIntIsExistGet)->Arg(2)->Arg(8)->Arg(32)->Arg(128);
+BENCHMARK(BM_CsmMapIdIsExistGet)->Arg(2)->Arg(8)->Arg(32)->Arg(128);
+BENCHMARK(BM_CsmMapIterate)->Arg(16)->Arg(256);
+BENCHMARK(BM_CsmMapEraseAll)->Arg(16)->Arg(256);
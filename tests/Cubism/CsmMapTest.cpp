@@ -0,0 +1,122 @@
+#include "CoreStub.hpp"
+#include <gtest/gtest.h>
+#include <Type/csmMap.hpp>
+#include <Type/csmString.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace Csm;
+
+namespace {
+
+	/*
+	* the vector csmMap was before its index: insertion order, linear search.
+	* Returns the position of key or -1.
+	*/
+	int Find(const std::vector<std::pair<int, int>>& reference, int key)
+	{
+		for (size_t i = 0; i < reference.size(); i++)
+		{
+			if (reference[i].first == key)
+				return static_cast<int>(i);
+		}
+		return -1;
+	}
+
+	void ExpectSameContents(const csmMap<csmInt32, csmInt32>& map, const std::vector<std::pair<int, int>>& reference)
+	{
+		ASSERT_EQ(map.GetSize(), static_cast<csmInt32>(reference.size()));
+		size_t i = 0;
+		for (csmMap<csmInt32, csmInt32>::const_iterator ite = map.Begin(); ite != map.End(); ++ite, ++i)
+		{
+			EXPECT_EQ(ite->First, reference[i].first) << "at " << i;
+			EXPECT_EQ(ite->Second, reference[i].second) << "at " << i;
+		}
+	}
+
+} // namespace
+
+class CsmMap : public ::testing::Test
+{
+protected:
+	void SetUp() override { CoreStub::StartFramework(); }
+};
+
+// random inserts, lookups, erases & AppendKey against the linear reference,
+// across the small (scanned) and indexed sizes
+TEST_F(CsmMap, MatchesLinearReference)
+{
+	uint32_t seed = 3;
+	auto random = [&seed](int range) { seed = seed * 1664525u + 1013904223u; return static_cast<int>((seed >> 8) % range); };
+
+	for (int round = 0; round < 100; round++)
+	{
+		csmMap<csmInt32, csmInt32> map;
+		std::vector<std::pair<int, int>> reference;
+		const int keyRange = 1 + random(200);
+
+		for (int op = 0; op < 1000; op++)
+		{
+			const int key = random(keyRange);
+			const int kind = random(10);
+			const int found = Find(reference, key);
+
+			if (kind < 5)
+			{
+				const int value = random(1 << 20);
+				map[key] = value;
+				if (found < 0)
+					reference.push_back({ key, value });
+				else
+					reference[found].second = value;
+			}
+			else if (kind < 8)
+			{
+				const csmMap<csmInt32, csmInt32>& constMap = map;
+				ASSERT_EQ(map.IsExist(key), found >= 0) << "key " << key;
+				if (found >= 0)
+					ASSERT_EQ(constMap[key], reference[found].second) << "key " << key;
+			}
+			else if (kind < 9 && !reference.empty())
+			{
+				const int position = random(static_cast<int>(reference.size()));
+				csmMap<csmInt32, csmInt32>::const_iterator ite = map.Begin();
+				for (int i = 0; i < position; i++)
+					++ite;
+				ite = map.Erase(ite);
+				reference.erase(reference.begin() + position);
+				if (position < static_cast<int>(reference.size()))
+					ASSERT_EQ(ite->First, reference[position].first);
+			}
+			else if (found < 0)
+			{
+				csmInt32 appended = key;
+				map.AppendKey(appended);
+				reference.push_back({ key, 0 });
+			}
+		}
+
+		ExpectSameContents(map, reference);
+		if (HasFatalFailure())
+			return;
+	}
+}
+
+TEST_F(CsmMap, StringKeys)
+{
+	csmMap<csmString, csmInt32> map;
+	for (int i = 0; i < 100; i++)
+		map[csmString(("Key" + std::to_string(i)).c_str())] = i;
+
+	EXPECT_EQ(map.GetSize(), 100);
+	for (int i = 0; i < 100; i++)
+		EXPECT_EQ(map[csmString(("Key" + std::to_string(i)).c_str())], i);
+	EXPECT_FALSE(map.IsExist(csmString("Key100")));
+
+	map.Clear();
+	EXPECT_EQ(map.GetSize(), 0);
+	EXPECT_FALSE(map.IsExist(csmString("Key0")));
+	map[csmString("Key0")] = 7;
+	EXPECT_EQ(map[csmString("Key0")], 7);
+}
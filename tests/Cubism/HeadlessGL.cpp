@@ -0,0 +1,74 @@
+#include "HeadlessGL.hpp"
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <cstddef>
+
+namespace HeadlessGL {
+
+	bool MakeCurrent()
+	{
+		static const bool s_Created = []
+		{
+			auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+			if (!getPlatformDisplay)
+				return false;
+
+			EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+			if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr) || !eglBindAPI(EGL_OPENGL_API))
+				return false;
+
+			const EGLint contextAttributes[] = {
+				EGL_CONTEXT_MAJOR_VERSION, 3,
+				EGL_CONTEXT_MINOR_VERSION, 3,
+				EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT,
+				EGL_NONE
+			};
+			EGLContext context = eglCreateContext(display, EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, contextAttributes);
+			if (context == EGL_NO_CONTEXT || !eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context))
+				return false;
+
+			GLuint frameBuffer = 0;
+			GLuint renderBuffer = 0;
+			glGenFramebuffers(1, &frameBuffer);
+			glGenRenderbuffers(1, &renderBuffer);
+			glBindRenderbuffer(GL_RENDERBUFFER, renderBuffer);
+			glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, kFrameSize, kFrameSize);
+			glBindFramebuffer(GL_FRAMEBUFFER, frameBuffer);
+			glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, renderBuffer);
+			return glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+		}();
+		return s_Created;
+	}
+
+	void ClearFrame()
+	{
+		glViewport(0, 0, kFrameSize, kFrameSize);
+		glClearColor(0.2f, 0.2f, 0.25f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT);
+	}
+
+	std::vector<unsigned char> ReadFrame()
+	{
+		std::vector<unsigned char> pixels(kFrameSize * kFrameSize * 4);
+		glFinish();
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glReadPixels(0, 0, kFrameSize, kFrameSize, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+		return pixels;
+	}
+
+	GLuint MakeTexture(int seed)
+	{
+		std::vector<unsigned char> pixels(64 * 64 * 4);
+		for (size_t i = 0; i < pixels.size(); i++)
+			pixels[i] = static_cast<unsigned char>(i * (seed + 3));
+
+		GLuint texture = 0;
+		glGenTextures(1, &texture);
+		glBindTexture(GL_TEXTURE_2D, texture);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 64, 64, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		return texture;
+	}
+
+} // namespace HeadlessGL
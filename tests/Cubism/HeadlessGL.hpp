@@ -0,0 +1,26 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <vector>
+
+/*
+* OpenGL 3.3 without a window, on Mesa's surfaceless EGL platform
+* (llvmpipe when there is no GPU), drawing into a kFrameSize² frame buffer.
+*/
+namespace HeadlessGL {
+
+	constexpr GLsizei kFrameSize = 512;
+
+	// creates the context & frame buffer on first call, false when there's no such context
+	bool MakeCurrent();
+
+	// clear the frame buffer to an opaque grey
+	void ClearFrame();
+
+	// RGBA8 pixels of the frame buffer, after glFinish
+	std::vector<unsigned char> ReadFrame();
+
+	// 64x64 RGBA texture with a pattern depending on seed
+	GLuint MakeTexture(int seed);
+
+} // namespace HeadlessGL
@@ -0,0 +1,107 @@
+#include "CoreStub.hpp"
+#include <benchmark/benchmark.h>
+#include <Id/CubismId.hpp>
+#include <Id/CubismIdManager.hpp>
+#include <string>
+#include <vector>
+
+using namespace Csm;
+
+namespace {
+
+	// ids like a few hundred loaded models: shared prefixes, distinct suffixes
+	std::vector<std::string> MakeNames(int count)
+	{
+		std::vector<std::string> names;
+		for (int i = 0; i < count; i++)
+			names.push_back("ParamModel" + std::to_string(i / 200) + "_" + std::to_string(i % 200));
+		return names;
+	}
+
+	// lookups hop across the whole id table, not along insertion order
+	int Scatter(int64_t k, int count)
+	{
+		return static_cast<int>((k * 7919) % count);
+	}
+
+} // namespace
+
+// every id registered into an empty manager, like loading the models' json files
+static void BM_IdManagerRegister(benchmark::State& state)
+{
+	CoreStub::StartFramework();
+	const int count = static_cast<int>(state.range(0));
+	const std::vector<std::string> names = MakeNames(count);
+
+	for (auto _ : state)
+	{
+		CubismIdManager* manager = CSM_NEW CubismIdManager();
+		for (const std::string& name : names)
+			benchmark::DoNotOptimize(manager->RegisterId(name.c_str()));
+		CSM_DELETE(manager);
+	}
+	state.SetItemsProcessed(state.iterations() * count);
+}
+
+// CubismFramework::GetIdManager()->GetId(csmString) of an existing id, as the json loaders do
+static void BM_IdManagerGetIdString(benchmark::State& state)
+{
+	CoreStub::StartFramework();
+	const int count = static_cast<int>(state.range(0));
+	const std::vector<std::string> names = MakeNames(count);
+
+	CubismIdManager* manager = CSM_NEW CubismIdManager();
+	std::vector<csmString> ids;
+	for (const std::string& name : names)
+	{
+		manager->RegisterId(name.c_str());
+		ids.push_back(csmString(name.c_str()));
+	}
+
+	int64_t k = 0;
+	for (auto _ : state)
+		benchmark::DoNotOptimize(manager->GetId(ids[Scatter(k++, count)]));
+	state.SetItemsProcessed(state.iterations());
+	CSM_DELETE(manager);
+}
+
+// GetId(const csmChar*) of an existing id, as the app does with its literal parameter names
+static void BM_IdManagerGetIdChars(benchmark::State& state)
+{
+	CoreStub::StartFramework();
+	const int count = static_cast<int>(state.range(0));
+	const std::vector<std::string> names = MakeNames(count);
+
+	CubismIdManager* manager = CSM_NEW CubismIdManager();
+	for (const std::string& name : names)
+		manager->RegisterId(name.c_str());
+
+	int64_t k = 0;
+	for (auto _ : state)
+		benchmark::DoNotOptimize(manager->GetId(names[Scatter(k++, count)].c_str()));
+	state.SetItemsProcessed(state.iterations());
+	CSM_DELETE(manager);
+}
+
+// IsExist of an id that isn't there, the worst case of the old linear scan
+static void BM_IdManagerIsExistMiss(benchmark::State& state)
+{
+	CoreStub::StartFramework();
+	const int count = static_cast<int>(state.range(0));
+	const std::vector<std::string> names = MakeNames(count);
+
+	CubismIdManager* manager = CSM_NEW CubismIdManager();
+	for (const std::string& name : names)
+		manager->RegisterId(name.c_str());
+
+	const csmString missing("ParamModelMissing");
+	for (auto _ : state)
+		benchmark::DoNotOptimize(manager->IsExist(missing));
+	state.SetItemsProcessed(state.iterations());
+	CSM_DELETE(manager);
+}
+
+BENCHMARK(BM_IdManagerRegister)->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_IdManagerGetIdString)->Arg(1000)->Arg(10000)->Arg(50000);
+BENCHMARK(BM_IdManagerGetIdChars)->Arg(1000)->Arg(10000)->Arg(50000);
+BENCHMARK(BM_IdManagerIsExistMiss)->Arg(1000)->Arg(10000)->Arg(50000);
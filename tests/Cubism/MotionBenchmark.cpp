@@ -0,0 +1,219 @@
+#include "CoreStub.hpp"
+#include "MotionJson.hpp"
+#include <benchmark/benchmark.h>
+#include <Id/CubismIdManager.hpp>
+#include <Motion/CubismMotion.hpp>
+#include <Motion/CubismMotionManager.hpp>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Csm;
+
+namespace {
+
+	const int kParameterCount = 300;
+	const int kCurvesPerMotion = 24;
+
+	// motionCount looped motions over overlapping parameter ranges, with eye blink & lip sync
+	std::vector<CubismMotion*> CreateMotions(int motionCount)
+	{
+		CoreStub::StartFramework();
+
+		csmVector<CubismIdHandle> eyeBlinkIds, lipSyncIds;
+		eyeBlinkIds.PushBack(CubismFramework::GetIdManager()->GetId("Param0"));
+		eyeBlinkIds.PushBack(CubismFramework::GetIdManager()->GetId("Param1"));
+		lipSyncIds.PushBack(CubismFramework::GetIdManager()->GetId("Param2"));
+
+		std::vector<CubismMotion*> motions;
+		for (int i = 0; i < motionCount; i++)
+		{
+			MotionJson::Options options;
+			options.CurveCount = kCurvesPerMotion;
+			options.FirstParameter = (i * 7) % (kParameterCount - kCurvesPerMotion);
+			options.Duration = 1.0f + 0.25f * (i % 5);
+			options.EyeBlinkLipSync = (i % 4 == 0);
+			const std::string json = MotionJson::Make(options);
+
+			CubismMotion* motion = CubismMotion::Create(reinterpret_cast<const csmByte*>(json.data()), static_cast<csmSizeInt>(json.size()));
+			motion->IsLoop(true);
+			motion->SetEffectIds(eyeBlinkIds, lipSyncIds);
+			motions.push_back(motion);
+		}
+		return motions;
+	}
+
+	void DeleteMotions(std::vector<CubismMotion*>& motions)
+	{
+		for (CubismMotion* motion : motions)
+			ACubismMotion::Delete(motion);
+		motions.clear();
+	}
+
+	// models[frame % size] is updated each frame, more than one model rebinds every curve each time
+	void RunSimultaneousMotions(benchmark::State& state, int modelCount)
+	{
+		const int motionCount = static_cast<int>(state.range(0));
+		std::vector<std::unique_ptr<CoreStub::Model>> models;
+		for (int i = 0; i < modelCount; i++)
+			models.push_back(std::make_unique<CoreStub::Model>(CoreStub::MakeDesc(kParameterCount)));
+
+		std::vector<CubismMotion*> motions = CreateMotions(motionCount);
+		{
+			// every motion plays at once, like the expressions Model2D layers
+			CubismMotionManager manager;
+			for (CubismMotion* motion : motions)
+				manager.StartMotion(motion, false, 0.0f, false);
+
+			int frame = 0;
+			for (auto _ : state)
+			{
+				CubismModel* model = models[frame++ % modelCount]->Get();
+				manager.UpdateMotion(model, 1.0f / 60.0f);
+				benchmark::ClobberMemory();
+			}
+		}
+		DeleteMotions(motions);
+
+		state.SetItemsProcessed(state.iterations() * motionCount * kCurvesPerMotion);
+	}
+
+} // namespace
+
+// curves bound to the model on the first update, indexed loads & stores after
+static void BM_SimultaneousMotions(benchmark::State& state)
+{
+	RunSimultaneousMotions(state, 1);
+}
+BENCHMARK(BM_SimultaneousMotions)->Arg(1)->Arg(8)->Arg(32)->Arg(128);
+
+// the model changes every update so every curve is looked up by id again,
+// close to the per-frame id lookups of the unbound evaluation
+static void BM_SimultaneousMotionsRebind(benchmark::State& state)
+{
+	RunSimultaneousMotions(state, 2);
+}
+BENCHMARK(BM_SimultaneousMotionsRebind)->Arg(1)->Arg(8)->Arg(32)->Arg(128);
+
+namespace {
+
+	const int kLongMotionCurves = 32;
+
+	// a motion with segmentsPerCurve keys per curve, 10 keys a second,
+	// driven by manager updates of the given time steps
+	template <typename NextStep>
+	void RunLongMotion(benchmark::State& state, NextStep nextStep)
+	{
+		const int segmentsPerCurve = static_cast<int>(state.range(0));
+		CoreStub::Model model(CoreStub::MakeDesc(kLongMotionCurves));
+
+		MotionJson::Options options;
+		options.CurveCount = kLongMotionCurves;
+		options.SegmentsPerCurve = segmentsPerCurve;
+		options.Duration = segmentsPerCurve / 10.0f;
+		const std::string json = MotionJson::Make(options);
+
+		CubismMotion* motion = CubismMotion::Create(reinterpret_cast<const csmByte*>(json.data()), static_cast<csmSizeInt>(json.size()));
+		motion->IsLoop(true);
+		{
+			CubismMotionManager manager;
+			manager.StartMotion(motion, false, 0.0f, false);
+
+			for (auto _ : state)
+			{
+				manager.UpdateMotion(model.Get(), nextStep(options.Duration));
+				benchmark::ClobberMemory();
+			}
+		}
+		ACubismMotion::Delete(motion);
+
+		state.SetItemsProcessed(state.iterations() * kLongMotionCurves);
+	}
+
+} // namespace
+
+// playback at 60 FPS: the cached segment cursor keeps the cost per frame
+// the same however long the motion is
+static void BM_LongMotionPlayback(benchmark::State& state)
+{
+	RunLongMotion(state, [](float) { return 1.0f / 60.0f; });
+}
+BENCHMARK(BM_LongMotionPlayback)->Arg(8)->Arg(64)->Arg(512)->Arg(4096);
+
+// a random jump every frame, the cursor misses and falls back to a binary search
+static void BM_LongMotionSeek(benchmark::State& state)
+{
+	std::mt19937 random(7);
+	RunLongMotion(state, [&random](float duration) { return std::uniform_real_distribution<float>(0.0f, duration)(random); });
+}
+BENCHMARK(BM_LongMotionSeek)->Arg(8)->Arg(64)->Arg(512)->Arg(4096);
+
+namespace {
+
+	const int kLoadMotionCount = 100;
+
+	// the motions of a model, 40 curves of 60 keys each: motion3.json text or IOMB binaries
+	std::vector<std::vector<csmByte>> MakeMotionFiles(bool binary)
+	{
+		CoreStub::StartFramework();
+
+		std::vector<std::vector<csmByte>> files;
+		for (int i = 0; i < kLoadMotionCount; i++)
+		{
+			MotionJson::Options options;
+			options.CurveCount = 40;
+			options.SegmentsPerCurve = 60;
+			options.Duration = 6.0f;
+			options.FirstParameter = i;
+			const std::string json = MotionJson::Make(options);
+
+			std::vector<csmByte> file(json.begin(), json.end());
+			if (binary)
+			{
+				CubismMotion* motion = CubismMotion::Create(file.data(), static_cast<csmSizeInt>(file.size()));
+				csmVector<csmByte> buffer;
+				motion->WriteBinary(buffer);
+				ACubismMotion::Delete(motion);
+				file.assign(buffer.GetPtr(), buffer.GetPtr() + buffer.GetSize());
+			}
+			files.push_back(std::move(file));
+		}
+		return files;
+	}
+
+	void RunLoadMotions(benchmark::State& state, bool binary)
+	{
+		const std::vector<std::vector<csmByte>> files = MakeMotionFiles(binary);
+		size_t bytes = 0;
+		for (const auto& file : files)
+			bytes += file.size();
+
+		std::vector<CubismMotion*> motions;
+		for (auto _ : state)
+		{
+			for (const auto& file : files)
+				motions.push_back(CubismMotion::Create(file.data(), static_cast<csmSizeInt>(file.size())));
+
+			state.PauseTiming();
+			DeleteMotions(motions);
+			state.ResumeTiming();
+		}
+		state.SetItemsProcessed(state.iterations() * kLoadMotionCount);
+		state.SetBytesProcessed(state.iterations() * bytes);
+	}
+
+} // namespace
+
+// loading the 100 motions of a model from memory, file reads left out
+static void BM_LoadMotionsJson(benchmark::State& state)
+{
+	RunLoadMotions(state, false);
+}
+BENCHMARK(BM_LoadMotionsJson)->Unit(benchmark::kMillisecond);
+
+static void BM_LoadMotionsBinary(benchmark::State& state)
+{
+	RunLoadMotions(state, true);
+}
+BENCHMARK(BM_LoadMotionsBinary)->Unit(benchmark::kMillisecond);
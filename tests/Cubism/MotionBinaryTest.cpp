@@ -0,0 +1,119 @@
+#include "CoreStub.hpp"
+#include "MotionJson.hpp"
+#include <gtest/gtest.h>
+#include <Motion/CubismMotion.hpp>
+#include <Motion/CubismMotionBinary.hpp>
+#include <Motion/CubismMotionManager.hpp>
+#include <string>
+#include <vector>
+
+using namespace Csm;
+
+namespace {
+
+	std::vector<csmByte> MakeJson()
+	{
+		MotionJson::Options options;
+		options.CurveCount = 12;
+		options.SegmentsPerCurve = 9;
+		options.Duration = 3.0f;
+		options.EyeBlinkLipSync = true;
+		const std::string json = MotionJson::Make(options);
+		return std::vector<csmByte>(json.begin(), json.end());
+	}
+
+	CubismMotion* Create(const std::vector<csmByte>& file)
+	{
+		return CubismMotion::Create(file.data(), static_cast<csmSizeInt>(file.size()));
+	}
+
+	std::vector<csmByte> WriteBinary(const CubismMotion* motion)
+	{
+		csmVector<csmByte> buffer;
+		motion->WriteBinary(buffer);
+		return std::vector<csmByte>(buffer.GetPtr(), buffer.GetPtr() + buffer.GetSize());
+	}
+
+	// parameter values of the model at every frame of a 60 FPS playback
+	std::vector<float> Play(CubismMotion* motion, int frameCount)
+	{
+		CoreStub::Model model(CoreStub::MakeDesc(12));
+		std::vector<float> values;
+
+		CubismMotionManager manager;
+		manager.StartMotion(motion, false, 0.0f, false);
+		for (int frame = 0; frame < frameCount; frame++)
+		{
+			manager.UpdateMotion(model.Get(), 1.0f / 60.0f);
+			for (int i = 0; i < model->GetParameterCount(); i++)
+				values.push_back(model->GetParameterValue(i));
+		}
+		return values;
+	}
+
+} // namespace
+
+class MotionBinary : public ::testing::Test
+{
+protected:
+	void SetUp() override { CoreStub::StartFramework(); }
+};
+
+TEST_F(MotionBinary, IsRecognized)
+{
+	const std::vector<csmByte> json = MakeJson();
+	CubismMotion* motion = Create(json);
+	ASSERT_NE(motion, nullptr);
+	const std::vector<csmByte> binary = WriteBinary(motion);
+	ACubismMotion::Delete(motion);
+
+	EXPECT_FALSE(CubismMotion::IsBinary(json.data(), static_cast<csmSizeInt>(json.size())));
+	EXPECT_TRUE(CubismMotion::IsBinary(binary.data(), static_cast<csmSizeInt>(binary.size())));
+}
+
+TEST_F(MotionBinary, RewriteIsByteIdentical)
+{
+	CubismMotion* fromJson = Create(MakeJson());
+	const std::vector<csmByte> binary = WriteBinary(fromJson);
+	ACubismMotion::Delete(fromJson);
+
+	CubismMotion* fromBinary = Create(binary);
+	ASSERT_NE(fromBinary, nullptr);
+	EXPECT_EQ(WriteBinary(fromBinary), binary);
+	ACubismMotion::Delete(fromBinary);
+}
+
+TEST_F(MotionBinary, PlaysLikeTheJson)
+{
+	CubismMotion* fromJson = Create(MakeJson());
+	CubismMotion* fromBinary = Create(WriteBinary(fromJson));
+	ASSERT_NE(fromBinary, nullptr);
+
+	EXPECT_EQ(fromBinary->GetDuration(), fromJson->GetDuration());
+	EXPECT_EQ(fromBinary->GetFadeInTime(), fromJson->GetFadeInTime());
+	EXPECT_EQ(fromBinary->GetFadeOutTime(), fromJson->GetFadeOutTime());
+
+	// past the end too, the last key holds
+	const std::vector<float> expected = Play(fromJson, 200);
+	const std::vector<float> actual = Play(fromBinary, 200);
+	ASSERT_EQ(actual.size(), expected.size());
+	for (size_t i = 0; i < expected.size(); i++)
+		EXPECT_EQ(actual[i], expected[i]) << "frame " << i / 12 << " parameter " << i % 12;
+
+	ACubismMotion::Delete(fromJson);
+	ACubismMotion::Delete(fromBinary);
+}
+
+TEST_F(MotionBinary, TruncatedIsRejected)
+{
+	CubismMotion* motion = Create(MakeJson());
+	const std::vector<csmByte> binary = WriteBinary(motion);
+	ACubismMotion::Delete(motion);
+
+	// still recognized as binary, so never handed to the json parser
+	for (size_t size : { binary.size() - 1, binary.size() / 2, sizeof(CubismMotionBinaryHeader) })
+	{
+		std::vector<csmByte> truncated(binary.begin(), binary.begin() + size);
+		EXPECT_EQ(Create(truncated), nullptr) << size << " of " << binary.size() << " bytes";
+	}
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cmath>
+#include <string>
+
+/*
+* motion3.json text for tests and benchmarks, like an editor export:
+* curveCount parameter curves on "Param<firstParameter>".., each cut into
+* segmentsPerCurve segments cycling linear, bezier, stepped & inverse stepped
+*/
+namespace MotionJson {
+
+	struct Options
+	{
+		int CurveCount = 16;
+		int SegmentsPerCurve = 8;
+		float Duration = 2.0f; // seconds
+		int FirstParameter = 0;
+		bool EyeBlinkLipSync = false; // EyeBlink & LipSync model curves first
+	};
+
+	inline std::string Make(const Options& options)
+	{
+		int segmentCount = 0;
+		int pointCount = 0;
+		std::string curves;
+
+		auto number = [](float value) { return std::to_string(value); };
+
+		auto addCurve = [&](const char* target, const std::string& id, int seed)
+		{
+			std::string segments;
+			auto value = [&](int i) { return number(10.0f * std::sin(0.7f * i + seed)); };
+
+			segments += "0," + value(0);
+			pointCount++;
+
+			for (int s = 0; s < options.SegmentsPerCurve; s++)
+			{
+				const float t0 = options.Duration * s / options.SegmentsPerCurve;
+				const float t1 = options.Duration * (s + 1) / options.SegmentsPerCurve;
+				const int type = (s + seed) % 4;
+
+				segments += "," + std::to_string(type);
+				if (type == 1) // bezier: 2 control points + end point
+				{
+					segments += "," + number(t0 + (t1 - t0) / 3.0f) + "," + value(s);
+					segments += "," + number(t0 + 2.0f * (t1 - t0) / 3.0f) + "," + value(s + 1);
+					pointCount += 2;
+				}
+				segments += "," + number(t1) + "," + value(s + 1);
+				pointCount++;
+				segmentCount++;
+			}
+
+			if (!curves.empty())
+				curves += ",";
+			curves += "{\"Target\":\"" + std::string(target) + "\",\"Id\":\"" + id + "\",\"Segments\":[" + segments + "]}";
+		};
+
+		int curveCount = options.CurveCount;
+		if (options.EyeBlinkLipSync)
+		{
+			addCurve("Model", "EyeBlink", 1);
+			addCurve("Model", "LipSync", 2);
+			curveCount += 2;
+		}
+		for (int i = 0; i < options.CurveCount; i++)
+			addCurve("Parameter", "Param" + std::to_string(options.FirstParameter + i), i);
+
+		return "{\"Version\":3,\"Meta\":{"
+			"\"Duration\":" + number(options.Duration) +
+			",\"Fps\":30.0,\"Loop\":true,\"AreBeziersRestricted\":true"
+			",\"CurveCount\":" + std::to_string(curveCount) +
+			",\"TotalSegmentCount\":" + std::to_string(segmentCount) +
+			",\"TotalPointCount\":" + std::to_string(pointCount) +
+			",\"UserDataCount\":0,\"TotalUserDataSize\":0"
+			"},\"Curves\":[" + curves + "]}";
+	}
+
+} // namespace MotionJson
@@ -0,0 +1,24 @@
+#pragma once
+
+/*
+* Stand-in for GLEW in the renderer benchmark on Linux: Mesa's libGL exports
+* every entry point, so only the version checks the renderer makes are needed.
+*/
+#ifndef GL_GLEXT_PROTOTYPES
+#define GL_GLEXT_PROTOTYPES 1
+#endif
+#include <GL/gl.h>
+#include <GL/glext.h>
+
+inline bool GlewStubVersionAtLeast(GLint major, GLint minor)
+{
+	GLint contextMajor = 0;
+	GLint contextMinor = 0;
+	glGetIntegerv(GL_MAJOR_VERSION, &contextMajor);
+	glGetIntegerv(GL_MINOR_VERSION, &contextMinor);
+	return contextMajor > major || (contextMajor == major && contextMinor >= minor);
+}
+
+#define GLEW_VERSION_3_0 GlewStubVersionAtLeast(3, 0)
+#define GLEW_VERSION_3_2 GlewStubVersionAtLeast(3, 2)
+#define GLEW_VERSION_3_3 GlewStubVersionAtLeast(3, 3)
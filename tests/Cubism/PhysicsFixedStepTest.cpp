@@ -0,0 +1,133 @@
+#include "CoreStub.hpp"
+#include "PhysicsJson.hpp"
+#include <gtest/gtest.h>
+#include <Physics/CubismPhysics.hpp>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using namespace Csm;
+
+namespace {
+
+	const float kPhysicsRate = 64.0f;
+	const float kSampleRate = 8.0f; // inputs change & outputs are compared at this rate
+	const float kSeconds = 20.0f;
+
+	// the same head motion rendered at renderRate, output parameters every 1 / kSampleRate seconds.
+	// Inputs hold still within a sample interval, so every frame rate sees the same inputs
+	// during each physics step.
+	std::vector<float> Render(const std::string& json, const PhysicsJson::Options& options, float renderRate, float physicsRate, CubismPhysics::Solver solver)
+	{
+		const int parameterCount = PhysicsJson::ParameterCount(options);
+		CoreStub::Model model(CoreStub::MakeDesc(parameterCount));
+
+		CubismPhysics* physics = CubismPhysics::Create(reinterpret_cast<const csmByte*>(json.data()), static_cast<csmSizeInt>(json.size()));
+		physics->SetSolver(solver);
+		physics->SetThreadCount(1);
+		if (physicsRate > 0.0f)
+			physics->SetFixedTimeStep(1.0f / physicsRate, 8);
+
+		std::vector<float> samples;
+		const int frameCount = static_cast<int>(kSeconds * renderRate);
+		const int framesPerSample = static_cast<int>(renderRate / kSampleRate);
+
+		for (int frame = 1; frame <= frameCount; frame++)
+		{
+			const int interval = (frame + framesPerSample - 1) / framesPerSample;
+			for (int i = 0; i < parameterCount; i++)
+				model->SetParameterValue(i, i < options.InputCount ? 30.0f * std::sin(interval * 0.7f + i) : 0.0f);
+
+			physics->Evaluate(model.Get(), 1.0f / renderRate);
+
+			if (frame % framesPerSample == 0)
+			{
+				for (int i = options.InputCount; i < parameterCount; i++)
+					samples.push_back(model->GetParameterValue(i));
+			}
+		}
+
+		CubismPhysics::Delete(physics);
+		return samples;
+	}
+
+	bool BitIdentical(const std::vector<float>& a, const std::vector<float>& b)
+	{
+		return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+	}
+
+	float MaxDifference(const std::vector<float>& a, const std::vector<float>& b)
+	{
+		float difference = 0.0f;
+		for (size_t i = 0; i < a.size() && i < b.size(); i++)
+			difference = std::max(difference, std::fabs(a[i] - b[i]));
+		return difference;
+	}
+
+} // namespace
+
+class PhysicsFixedStep : public ::testing::TestWithParam<CubismPhysics::Solver>
+{
+protected:
+	void SetUp() override
+	{
+		CoreStub::StartFramework();
+		m_Json = PhysicsJson::Make(m_Options);
+	}
+
+	PhysicsJson::Options m_Options; // no chained sub-rigs, their inputs are sampled per frame
+	std::string m_Json;
+};
+
+// with a fixed step the outputs at common times don't depend on the frame rate
+TEST_P(PhysicsFixedStep, SameOutputsAtEveryFrameRate)
+{
+	const std::vector<float> expected = Render(m_Json, m_Options, 64.0f, kPhysicsRate, GetParam());
+	ASSERT_FALSE(expected.empty());
+
+	for (float renderRate : { 16.0f, 32.0f, 128.0f, 256.0f })
+	{
+		const std::vector<float> actual = Render(m_Json, m_Options, renderRate, kPhysicsRate, GetParam());
+		EXPECT_TRUE(BitIdentical(expected, actual))
+			<< renderRate << " FPS differs from 64 FPS by up to " << MaxDifference(expected, actual);
+	}
+}
+
+// stepping once per frame, the same inputs move the hair differently at another frame rate
+TEST_P(PhysicsFixedStep, PerFrameStepDependsOnFrameRate)
+{
+	const std::vector<float> at64 = Render(m_Json, m_Options, 64.0f, 0.0f, GetParam());
+	const std::vector<float> at16 = Render(m_Json, m_Options, 16.0f, 0.0f, GetParam());
+	EXPECT_GT(MaxDifference(at64, at16), 1.0f);
+}
+
+INSTANTIATE_TEST_SUITE_P(Solvers, PhysicsFixedStep,
+	::testing::Values(CubismPhysics::Solver_Reference, CubismPhysics::Solver_Batched),
+	[](const ::testing::TestParamInfo<CubismPhysics::Solver>& info) {
+		return info.param == CubismPhysics::Solver_Reference ? "Reference" : "Batched";
+	});
+
+// a long hitch runs at most maxSubSteps steps, the rest is dropped
+TEST(PhysicsFixedStepHitch, CapsSubSteps)
+{
+	CoreStub::StartFramework();
+
+	PhysicsJson::Options options;
+	options.RigCount = 4;
+	const std::string json = PhysicsJson::Make(options);
+	CoreStub::Model model(CoreStub::MakeDesc(PhysicsJson::ParameterCount(options)));
+
+	CubismPhysics* physics = CubismPhysics::Create(reinterpret_cast<const csmByte*>(json.data()), static_cast<csmSizeInt>(json.size()));
+	physics->SetFixedTimeStep(1.0f / kPhysicsRate, 8);
+
+	physics->Evaluate(model.Get(), 2.0f);
+	EXPECT_EQ(physics->GetLastStepCount(), 8);
+
+	physics->Evaluate(model.Get(), 0.25f / kPhysicsRate);
+	EXPECT_EQ(physics->GetLastStepCount(), 0);
+
+	physics->Evaluate(model.Get(), 1.0f / kPhysicsRate);
+	EXPECT_EQ(physics->GetLastStepCount(), 1);
+
+	CubismPhysics::Delete(physics);
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/*
+* physics3.json text of synthetic rigs for tests and benchmarks.
+* Sub-rig r reads X and Angle inputs from "Param0".."Param<InputCount-1>" and writes
+* up to 3 outputs to "Param<InputCount + r * 3>".., strands of 2 to 7 particles.
+*/
+namespace PhysicsJson {
+
+	struct Options
+	{
+		int RigCount = 40;
+		int InputCount = 6; // input parameters
+		bool Chained = false; // some sub-rigs read outputs of earlier ones
+		uint32_t Seed = 7;
+	};
+
+	// parameters used by the rigs, inputs first
+	inline int ParameterCount(const Options& options)
+	{
+		return options.InputCount + options.RigCount * 3;
+	}
+
+	inline std::string Make(const Options& options)
+	{
+		uint32_t state = options.Seed;
+		auto next = [&state](int n) { state = state * 1103515245u + 12345u; return static_cast<int>((state >> 8) % static_cast<uint32_t>(n)); };
+		auto unit = [&next]() { return next(10000) / 10000.0f; };
+		auto number = [](float value) { return std::to_string(value); };
+		auto parameter = [](int index) { return "{\"Target\":\"Parameter\",\"Id\":\"Param" + std::to_string(index) + "\"}"; };
+
+		int inputTotal = 0, outputTotal = 0, vertexTotal = 0;
+		std::string settings;
+
+		for (int r = 0; r < options.RigCount; r++)
+		{
+			const int inputCount = 2;
+			const int outputCount = 1 + next(3);
+			const int vertexCount = 2 + next(6);
+			inputTotal += inputCount;
+			outputTotal += outputCount;
+			vertexTotal += vertexCount;
+
+			std::string inputs;
+			for (int i = 0; i < inputCount; i++)
+			{
+				const bool chained = options.Chained && r > 0 && i == 1 && next(4) == 0;
+				const int source = chained ? options.InputCount + next(r) * 3 : next(options.InputCount);
+				inputs += std::string(i ? "," : "") + "{\"Source\":" + parameter(source) +
+					",\"Weight\":" + std::to_string(40 + next(61)) +
+					",\"Type\":\"" + (i == 0 ? "X" : "Angle") + "\"" +
+					",\"Reflect\":" + (next(2) ? "true" : "false") + "}";
+			}
+
+			std::string outputs;
+			const char* types[] = { "X", "Y", "Angle" };
+			for (int o = 0; o < outputCount; o++)
+			{
+				outputs += std::string(o ? "," : "") + "{\"Destination\":" + parameter(options.InputCount + r * 3 + o) +
+					",\"VertexIndex\":" + std::to_string(1 + next(vertexCount - 1)) +
+					",\"Scale\":" + std::to_string(1 + next(20)) +
+					",\"Weight\":" + std::to_string(50 + next(51)) +
+					",\"Type\":\"" + types[next(3)] + "\",\"Reflect\":false}";
+			}
+
+			std::string vertices;
+			for (int v = 0; v < vertexCount; v++)
+			{
+				vertices += std::string(v ? "," : "") + "{\"Position\":{\"X\":0,\"Y\":" + std::to_string(v * 3) + "}" +
+					",\"Mobility\":" + number(0.8f + 0.2f * unit()) +
+					",\"Delay\":" + number(v == 0 ? 1.0f : 0.6f + 0.4f * unit()) +
+					",\"Acceleration\":" + number(0.5f + 1.5f * unit()) +
+					",\"Radius\":" + number(v == 0 ? 0.0f : 3.0f + 5.0f * unit()) + "}";
+			}
+
+			settings += std::string(r ? "," : "") + "{\"Id\":\"PhysicsSetting" + std::to_string(r) + "\"" +
+				",\"Input\":[" + inputs + "],\"Output\":[" + outputs + "],\"Vertices\":[" + vertices + "]" +
+				",\"Normalization\":{\"Position\":{\"Minimum\":-10,\"Default\":0,\"Maximum\":10}" +
+				",\"Angle\":{\"Minimum\":-10,\"Default\":0,\"Maximum\":10}}}";
+		}
+
+		return "{\"Version\":3,\"Meta\":{\"PhysicsSettingCount\":" + std::to_string(options.RigCount) +
+			",\"TotalInputCount\":" + std::to_string(inputTotal) +
+			",\"TotalOutputCount\":" + std::to_string(outputTotal) +
+			",\"VertexCount\":" + std::to_string(vertexTotal) +
+			",\"EffectiveForces\":{\"Gravity\":{\"X\":0,\"Y\":-1},\"Wind\":{\"X\":0,\"Y\":0}}}" +
+			",\"PhysicsSettings\":[" + settings + "]}";
+	}
+
+} // namespace PhysicsJson
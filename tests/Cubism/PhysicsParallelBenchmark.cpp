@@ -0,0 +1,48 @@
+#include "CoreStub.hpp"
+#include "PhysicsJson.hpp"
+#include <benchmark/benchmark.h>
+#include <Physics/CubismPhysics.hpp>
+#include <cmath>
+#include <string>
+#include <thread>
+
+using namespace Csm;
+
+/*
+* One CubismPhysics::Evaluate of range(0) sub-rigs with SetThreadCount(range(1)),
+* 0 = the automatic thread count. The inputs sway every frame, at 60 FPS.
+*/
+static void BM_PhysicsThreads(benchmark::State& state)
+{
+	CoreStub::StartFramework();
+
+	PhysicsJson::Options options;
+	options.RigCount = static_cast<int>(state.range(0));
+	options.Chained = true;
+	const std::string json = PhysicsJson::Make(options);
+	const int parameterCount = PhysicsJson::ParameterCount(options);
+
+	CoreStub::Model model(CoreStub::MakeDesc(parameterCount));
+	CubismPhysics* physics = CubismPhysics::Create(reinterpret_cast<const csmByte*>(json.data()), static_cast<csmSizeInt>(json.size()));
+	physics->SetThreadCount(static_cast<csmInt32>(state.range(1)));
+
+	int frame = 0;
+	for (auto _ : state)
+	{
+		for (int i = 0; i < options.InputCount; i++)
+			model->SetParameterValue(i, 30.0f * std::sin(0.05f * frame + i));
+		frame++;
+
+		physics->Evaluate(model.Get(), 1.0f / 60.0f);
+		benchmark::ClobberMemory();
+	}
+
+	state.counters["Threads"] = physics->GetThreadCount();
+	state.counters["Cores"] = std::thread::hardware_concurrency();
+	state.SetItemsProcessed(state.iterations() * options.RigCount);
+	CubismPhysics::Delete(physics);
+}
+BENCHMARK(BM_PhysicsThreads)
+	->ArgNames({ "rigs", "threads" })
+	->ArgsProduct({ { 16, 32, 100 }, benchmark::CreateDenseRange(0, 8, 1) })
+	->UseRealTime();
@@ -0,0 +1,195 @@
+#include "CoreStub.hpp"
+#include "PhysicsJson.hpp"
+#include <gtest/gtest.h>
+#include <Physics/CubismPhysics.hpp>
+#include <cmath>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <vector>
+
+using namespace Csm;
+
+namespace {
+
+	// recorded inputs & frame times: a moving head at 20 to 90 FPS with a few hitches
+	struct Recording
+	{
+		int InputCount = 0;
+		std::vector<std::vector<float>> Inputs;
+		std::vector<float> DeltaTimes;
+	};
+
+	Recording Record(int inputCount, int frameCount)
+	{
+		Recording recording;
+		recording.InputCount = inputCount;
+		uint32_t state = 11;
+		auto next = [&state](int n) { state = state * 1103515245u + 12345u; return static_cast<int>((state >> 8) % static_cast<uint32_t>(n)); };
+
+		for (int f = 0; f < frameCount; f++)
+		{
+			std::vector<float> inputs(inputCount);
+			for (int i = 0; i < inputCount; i++)
+				inputs[i] = 30.0f * std::sin(f * 0.01f * (i + 1) + i) + (next(1000) / 1000.0f - 0.5f) * 4.0f;
+			recording.Inputs.push_back(inputs);
+			recording.DeltaTimes.push_back(f % 500 == 250 ? 0.25f : 1.0f / (20 + next(70)));
+		}
+		return recording;
+	}
+
+	struct Playback
+	{
+		CubismPhysics::Solver Solver = CubismPhysics::Solver_Batched;
+		int ThreadCount = 1;
+		float FixedTimeStep = 0.0f;
+		int SwitchSolverAt = -1; // frame the solver is switched back and forth
+	};
+
+	// output parameters after every frame
+	std::vector<float> Play(const std::string& json, int parameterCount, const Recording& recording, const Playback& setup)
+	{
+		CoreStub::Model model(CoreStub::MakeDesc(parameterCount));
+		CubismPhysics* physics = CubismPhysics::Create(reinterpret_cast<const csmByte*>(json.data()), static_cast<csmSizeInt>(json.size()));
+		physics->SetSolver(setup.Solver);
+		physics->SetThreadCount(setup.ThreadCount);
+		physics->SetFixedTimeStep(setup.FixedTimeStep);
+
+		std::vector<float> outputs;
+		for (size_t f = 0; f < recording.DeltaTimes.size(); f++)
+		{
+			if (static_cast<int>(f) == setup.SwitchSolverAt)
+			{
+				physics->SetSolver(setup.Solver == CubismPhysics::Solver_Batched ? CubismPhysics::Solver_Reference : CubismPhysics::Solver_Batched);
+				physics->SetSolver(setup.Solver);
+			}
+
+			// the model starts every frame from the same parameters, like Model2D after LoadParameters()
+			for (int i = 0; i < parameterCount; i++)
+				model->SetParameterValue(i, i < recording.InputCount ? recording.Inputs[f][i] : 0.0f);
+
+			physics->Evaluate(model.Get(), recording.DeltaTimes[f]);
+
+			for (int i = recording.InputCount; i < parameterCount; i++)
+				outputs.push_back(model->GetParameterValue(i));
+		}
+
+		CubismPhysics::Delete(physics);
+		return outputs;
+	}
+
+	void ExpectBitIdentical(const std::vector<float>& expected, const std::vector<float>& actual, int outputCount)
+	{
+		ASSERT_EQ(actual.size(), expected.size());
+		int mismatches = 0;
+		for (size_t i = 0; i < expected.size() && mismatches < 10; i++)
+		{
+			if (std::memcmp(&actual[i], &expected[i], sizeof(float)) != 0)
+			{
+				ADD_FAILURE() << "frame " << i / outputCount << " output " << i % outputCount << ": " << actual[i] << " != " << expected[i];
+				mismatches++;
+			}
+		}
+	}
+
+	struct SolverCase
+	{
+		bool Chained;
+		int ThreadCount;
+		float FixedTimeStep;
+	};
+
+	void PrintTo(const SolverCase& c, std::ostream* os)
+	{
+		*os << (c.Chained ? "chained" : "independent") << ", " << c.ThreadCount << " threads, step " << c.FixedTimeStep;
+	}
+
+} // namespace
+
+class PhysicsSolver : public ::testing::TestWithParam<SolverCase>
+{
+protected:
+	void SetUp() override { CoreStub::StartFramework(); }
+};
+
+// the batched solver (SSE2 or portable lanes, depending on the build) steps
+// exactly like the reference one, with every thread count
+TEST_P(PhysicsSolver, BatchedMatchesReference)
+{
+	PhysicsJson::Options options;
+	options.RigCount = 40;
+	options.Chained = GetParam().Chained;
+	const std::string json = PhysicsJson::Make(options);
+	const int parameterCount = PhysicsJson::ParameterCount(options);
+	const Recording recording = Record(options.InputCount, 1500);
+
+	Playback reference;
+	reference.Solver = CubismPhysics::Solver_Reference;
+	reference.FixedTimeStep = GetParam().FixedTimeStep;
+
+	Playback batched = reference;
+	batched.Solver = CubismPhysics::Solver_Batched;
+	batched.ThreadCount = GetParam().ThreadCount;
+
+	const std::vector<float> expected = Play(json, parameterCount, recording, reference);
+	ExpectBitIdentical(expected, Play(json, parameterCount, recording, batched), parameterCount - options.InputCount);
+}
+
+INSTANTIATE_TEST_SUITE_P(Rigs, PhysicsSolver, ::testing::Values(
+	SolverCase{ false, 1, 0.0f },
+	SolverCase{ true, 1, 0.0f },
+	SolverCase{ true, 2, 0.0f },
+	SolverCase{ true, 4, 0.0f },
+	SolverCase{ true, 1, 1.0f / 60.0f },
+	SolverCase{ true, 4, 1.0f / 60.0f }
+), [](const ::testing::TestParamInfo<SolverCase>& info) {
+	const SolverCase& c = info.param;
+	return std::string(c.Chained ? "Chained" : "Independent") + "_" + std::to_string(c.ThreadCount) + "Threads" + (c.FixedTimeStep > 0.0f ? "_FixedStep" : "");
+});
+
+// a large rig comes out bit-exact at any thread count, 0 = automatic
+TEST(PhysicsThreads, MatchSerial)
+{
+	CoreStub::StartFramework();
+
+	for (bool chained : { false, true })
+	{
+		PhysicsJson::Options options;
+		options.RigCount = 100;
+		options.Chained = chained;
+		const std::string json = PhysicsJson::Make(options);
+		const int parameterCount = PhysicsJson::ParameterCount(options);
+		const Recording recording = Record(options.InputCount, 600);
+
+		const std::vector<float> expected = Play(json, parameterCount, recording, Playback());
+
+		for (int threadCount = 0; threadCount <= 8; threadCount++)
+		{
+			SCOPED_TRACE((chained ? "chained, " : "independent, ") + std::to_string(threadCount) + " threads");
+			Playback threaded;
+			threaded.ThreadCount = threadCount;
+			ExpectBitIdentical(expected, Play(json, parameterCount, recording, threaded), parameterCount - options.InputCount);
+		}
+	}
+}
+
+// the particle state carries over when the solver changes mid-run
+TEST(PhysicsSolverSwitch, KeepsParticleState)
+{
+	CoreStub::StartFramework();
+
+	PhysicsJson::Options options;
+	options.Chained = true;
+	const std::string json = PhysicsJson::Make(options);
+	const int parameterCount = PhysicsJson::ParameterCount(options);
+	const Recording recording = Record(options.InputCount, 600);
+
+	Playback reference;
+	reference.Solver = CubismPhysics::Solver_Reference;
+
+	Playback switched;
+	switched.SwitchSolverAt = 300;
+
+	const std::vector<float> expected = Play(json, parameterCount, recording, reference);
+	ExpectBitIdentical(expected, Play(json, parameterCount, recording, switched), parameterCount - options.InputCount);
+}
@@ -0,0 +1,77 @@
+#include "CoreStub.hpp"
+#include "HeadlessGL.hpp"
+#include <benchmark/benchmark.h>
+#include <Math/CubismMatrix44.hpp>
+#include <Rendering/OpenGL/CubismRenderer_OpenGLES2.hpp>
+
+using namespace Csm;
+using namespace Csm::Rendering;
+
+/*
+* One frame of DrawModel on a model of range(0) drawables over 2 textures, every
+* 9th clipped by the drawable before it, every 3rd moving when range(2) is set.
+* range(1) enables draw batching, range(3) uniform buffers. Time is the CPU time of DrawModel; the
+* rasterization llvmpipe does on its own threads is left to glFinish, outside of it.
+*/
+static void BM_DrawModel(benchmark::State& state)
+{
+	if (!HeadlessGL::MakeCurrent())
+	{
+		state.SkipWithError("no headless OpenGL 3.3 context");
+		return;
+	}
+
+	CoreStub::ModelDesc desc = CoreStub::MakeDesc(4, 0, static_cast<int>(state.range(0)));
+	desc.TextureCount = 2;
+	desc.ClippedStride = 9;
+	desc.MovingStride = state.range(2) ? 3 : 0;
+	CoreStub::Model model(desc);
+
+	const GLuint textures[] = { HeadlessGL::MakeTexture(0), HeadlessGL::MakeTexture(1) };
+	CubismRenderer_OpenGLES2* renderer = static_cast<CubismRenderer_OpenGLES2*>(CubismRenderer::Create());
+	renderer->Initialize(model.Get());
+	renderer->BindTexture(0, textures[0]);
+	renderer->BindTexture(1, textures[1]);
+	renderer->UseVertexBuffers(true);
+	renderer->UseDrawBatching(state.range(1) != 0);
+	renderer->UseUniformBuffers(state.range(3) != 0);
+
+	CubismMatrix44 projection;
+	projection.Scale(0.9f, 0.9f);
+	renderer->SetMvpMatrix(&projection);
+
+	double drawCalls = 0.0;
+	double uploadedBytes = 0.0;
+	double stateChanges = 0.0;
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		model->Update();
+		HeadlessGL::ClearFrame();
+		state.ResumeTiming();
+
+		renderer->DrawModel();
+
+		state.PauseTiming();
+		glFinish();
+		drawCalls += renderer->GetDrawStatistics().DrawCalls;
+		uploadedBytes += renderer->GetDrawStatistics().UploadedBytes;
+		stateChanges += renderer->GetDrawStatistics().StateChanges;
+		state.ResumeTiming();
+	}
+
+	if (glGetError() != GL_NO_ERROR)
+		state.SkipWithError("OpenGL error");
+
+	state.counters["draw_calls"] = benchmark::Counter(drawCalls, benchmark::Counter::kAvgIterations);
+	state.counters["uploaded_bytes"] = benchmark::Counter(uploadedBytes, benchmark::Counter::kAvgIterations, benchmark::Counter::kIs1024);
+	state.counters["state_changes"] = benchmark::Counter(stateChanges, benchmark::Counter::kAvgIterations);
+
+	CubismRenderer::Delete(renderer);
+	glDeleteTextures(2, textures);
+}
+
+BENCHMARK(BM_DrawModel)
+	->ArgNames({ "drawables", "batching", "moving", "ubo" })
+	->ArgsProduct({ { 100, 300 }, { 0, 1 }, { 0, 1 }, { 0, 1 } })
+	->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,7 @@
+#include <Rendering/CubismRenderer.hpp>
+
+// the framework without its OpenGL renderer: models are created without one
+namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
+	CubismRenderer* CubismRenderer::Create() { return nullptr; }
+	void CubismRenderer::StaticRelease() {}
+}}}}
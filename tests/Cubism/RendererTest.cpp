@@ -0,0 +1,263 @@
+#include "CoreStub.hpp"
+#include "HeadlessGL.hpp"
+#include <gtest/gtest.h>
+#include <Math/CubismMatrix44.hpp>
+#include <Rendering/OpenGL/CubismRenderer_OpenGLES2.hpp>
+#include <utility>
+#include <vector>
+
+using namespace Csm;
+using namespace Csm::Rendering;
+
+namespace {
+
+	/*
+	* The GL state ImGui's OpenGL 3 backend leaves when it's drawn between two frames
+	* of the model: its program, vertex array & buffers, font texture and blending
+	*/
+	class ImGuiState
+	{
+	public:
+		ImGuiState()
+		{
+			const char* vertexSource =
+				"#version 130\n"
+				"in vec2 Position; in vec2 UV; in vec4 Color; out vec2 Frag_UV; out vec4 Frag_Color;\n"
+				"void main() { Frag_UV = UV; Frag_Color = Color; gl_Position = vec4(Position, 0, 1); }\n";
+			const char* fragmentSource =
+				"#version 130\n"
+				"uniform sampler2D Texture; in vec2 Frag_UV; in vec4 Frag_Color; out vec4 Out_Color;\n"
+				"void main() { Out_Color = Frag_Color * texture(Texture, Frag_UV); }\n";
+
+			m_Program = glCreateProgram();
+			for (auto [type, source] : { std::make_pair(GL_VERTEX_SHADER, vertexSource), std::make_pair(GL_FRAGMENT_SHADER, fragmentSource) })
+			{
+				GLuint shader = glCreateShader(type);
+				glShaderSource(shader, 1, &source, nullptr);
+				glCompileShader(shader);
+				glAttachShader(m_Program, shader);
+				glDeleteShader(shader);
+			}
+			glLinkProgram(m_Program);
+
+			m_Texture = HeadlessGL::MakeTexture(7);
+			glGenVertexArrays(1, &m_VertexArray);
+			glGenBuffers(2, m_Buffers);
+		}
+
+		~ImGuiState()
+		{
+			// nothing of it stays bound, a program deleted while in use would outlive the object
+			glUseProgram(0);
+			glBindVertexArray(0);
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+			glDeleteProgram(m_Program);
+			glDeleteTextures(1, &m_Texture);
+			glDeleteVertexArrays(1, &m_VertexArray);
+			glDeleteBuffers(2, m_Buffers);
+		}
+
+		// ImGui_ImplOpenGL3_SetupRenderState & a draw list, without restoring the state afterwards
+		void Apply()
+		{
+			glEnable(GL_BLEND);
+			glBlendEquation(GL_FUNC_ADD);
+			glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+			glDisable(GL_CULL_FACE);
+			glEnable(GL_SCISSOR_TEST);
+			glScissor(0, 0, HeadlessGL::kFrameSize, HeadlessGL::kFrameSize);
+
+			glUseProgram(m_Program);
+			glUniform1i(glGetUniformLocation(m_Program, "Texture"), 0);
+
+			glBindVertexArray(m_VertexArray);
+			glBindBuffer(GL_ARRAY_BUFFER, m_Buffers[0]);
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_Buffers[1]);
+			const float vertices[] = { -1, -1, 0, 0, 1, 1, 1, 1, 1, 1, -1, 1, 1, 0, 0, 1, 1, 1 };
+			const GLushort indices[] = { 0, 1, 2 };
+			glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STREAM_DRAW);
+			glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STREAM_DRAW);
+			for (GLuint attribute = 0; attribute < 3; attribute++)
+			{
+				const GLint offsets[] = { 0, 2, 4 };
+				const GLint sizes[] = { 2, 2, 2 };
+				glEnableVertexAttribArray(attribute);
+				glVertexAttribPointer(attribute, sizes[attribute], GL_FLOAT, GL_FALSE, 6 * sizeof(float),
+					reinterpret_cast<const void*>(offsets[attribute] * sizeof(float)));
+			}
+
+			glActiveTexture(GL_TEXTURE1);
+			glBindTexture(GL_TEXTURE_2D, m_Texture);
+			glActiveTexture(GL_TEXTURE0);
+			glBindTexture(GL_TEXTURE_2D, m_Texture);
+
+			// drawn outside of the frame, only the state matters
+			glDrawElements(GL_TRIANGLES, 0, GL_UNSIGNED_SHORT, nullptr);
+		}
+
+	private:
+		GLuint m_Program = 0;
+		GLuint m_Texture = 0;
+		GLuint m_VertexArray = 0;
+		GLuint m_Buffers[2] = {};
+	};
+
+	struct RenderSetup
+	{
+		bool VertexBuffers = true;
+		bool UniformBuffers = false;
+		bool StateRestore = true;
+		bool MaskCaching = false;
+		bool ImGuiBetweenFrames = false; // ImGuiState::Apply after each frame
+		bool InvalidateEachFrame = false; // InvalidateDrawableCaches before each frame
+	};
+
+	using Frames = std::vector<std::vector<unsigned char>>;
+
+	/*
+	* frameCount frames of desc on 2 textures, with draw batching, the pixels of each frame
+	*/
+	Frames Render(const CoreStub::ModelDesc& desc, const RenderSetup& setup, int frameCount)
+	{
+		CoreStub::Model model(desc);
+
+		const GLuint textures[] = { HeadlessGL::MakeTexture(0), HeadlessGL::MakeTexture(1) };
+		CubismRenderer_OpenGLES2* renderer = static_cast<CubismRenderer_OpenGLES2*>(CubismRenderer::Create());
+		renderer->Initialize(model.Get());
+		renderer->BindTexture(0, textures[0]);
+		renderer->BindTexture(1, textures[1]);
+		renderer->UseVertexBuffers(setup.VertexBuffers);
+		renderer->UseDrawBatching(true);
+		renderer->UseUniformBuffers(setup.UniformBuffers);
+		renderer->UseStateRestore(setup.StateRestore);
+		renderer->UseMaskCaching(setup.MaskCaching);
+
+		CubismMatrix44 projection;
+		projection.Scale(0.9f, 0.9f);
+		renderer->SetMvpMatrix(&projection);
+
+		ImGuiState imGui;
+
+		Frames frames;
+		for (int f = 0; f < frameCount; f++)
+		{
+			model->Update();
+			HeadlessGL::ClearFrame();
+			if (setup.InvalidateEachFrame)
+				renderer->InvalidateDrawableCaches();
+			renderer->DrawModel();
+			frames.push_back(HeadlessGL::ReadFrame());
+
+			if (setup.ImGuiBetweenFrames)
+				imGui.Apply();
+
+			if (f == 0)
+				EXPECT_EQ(renderer->IsUsingUniformBuffers(), setup.UniformBuffers);
+		}
+		EXPECT_EQ(glGetError(), static_cast<GLenum>(GL_NO_ERROR));
+
+		CubismRenderer::Delete(renderer);
+		glDeleteTextures(2, textures);
+		return frames;
+	}
+
+	void ExpectSameFrames(const Frames& expected, const Frames& actual)
+	{
+		ASSERT_EQ(actual.size(), expected.size());
+		for (size_t f = 0; f < expected.size(); f++)
+		{
+			ASSERT_EQ(actual[f].size(), expected[f].size());
+			for (size_t i = 0; i < expected[f].size(); i++)
+			{
+				if (actual[f][i] != expected[f][i])
+				{
+					const size_t pixel = i / 4;
+					FAIL() << "frame " << f << ", pixel (" << pixel % HeadlessGL::kFrameSize << ", " << pixel / HeadlessGL::kFrameSize
+						<< ") channel " << i % 4 << ": " << int(actual[f][i]) << " != " << int(expected[f][i]);
+				}
+			}
+		}
+	}
+
+	// drawables over 2 textures, every 9th clipped by the one before, every 3rd moving
+	CoreStub::ModelDesc MakeDesc(int drawableCount)
+	{
+		CoreStub::ModelDesc desc = CoreStub::MakeDesc(4, 0, drawableCount);
+		desc.TextureCount = 2;
+		desc.ClippedStride = 9;
+		desc.MovingStride = 3;
+		return desc;
+	}
+
+} // namespace
+
+class Renderer : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		if (!HeadlessGL::MakeCurrent())
+			GTEST_SKIP() << "no headless OpenGL 3.3 context";
+		CoreStub::StartFramework();
+	}
+};
+
+// the GLSL 330 shaders reading the uniform blocks draw the same pixels as the GLES2 ones
+TEST_F(Renderer, UniformBuffersMatchGles2)
+{
+	const CoreStub::ModelDesc desc = MakeDesc(300);
+
+	RenderSetup uniformBuffers;
+	uniformBuffers.UniformBuffers = true;
+
+	const Frames expected = Render(desc, RenderSetup(), 20);
+	ASSERT_NE(expected.front(), expected.back()); // the model moved
+	ExpectSameFrames(expected, Render(desc, uniformBuffers, 20));
+}
+
+/*
+* ImGui changes program, textures, blending & vertex array between two frames: the renderer's
+* state cache must not skip a call because of the state it set itself in the previous frame
+*/
+class RendererStateCache : public Renderer, public ::testing::WithParamInterface<std::tuple<bool, bool>>
+{
+};
+
+TEST_P(RendererStateCache, ImGuiBetweenFramesMatchesInvalidated)
+{
+	const CoreStub::ModelDesc desc = MakeDesc(300);
+
+	RenderSetup reference;
+	reference.VertexBuffers = std::get<0>(GetParam());
+	reference.StateRestore = std::get<1>(GetParam());
+	reference.InvalidateEachFrame = true;
+
+	RenderSetup imGui = reference;
+	imGui.ImGuiBetweenFrames = true;
+	imGui.InvalidateEachFrame = false;
+
+	ExpectSameFrames(Render(desc, reference, 10), Render(desc, imGui, 10));
+}
+
+INSTANTIATE_TEST_SUITE_P(Renderer, RendererStateCache, ::testing::Combine(::testing::Bool(), ::testing::Bool()),
+	[](const ::testing::TestParamInfo<std::tuple<bool, bool>>& info) {
+		return std::string(std::get<0>(info.param) ? "VertexBuffers" : "ClientArrays") + (std::get<1>(info.param) ? "_StateRestore" : "_NoStateRestore");
+	});
+
+/*
+* A clipped drawable that moves makes its mask's region be cleared and drawn again,
+* the masking drawable that didn't move included
+*/
+TEST_F(Renderer, MaskCachingMatchesRedraw)
+{
+	// every 4th drawable clipped by the one before, every 3rd moving: clipped 3, 15, 27.. move under a static mask
+	CoreStub::ModelDesc desc = MakeDesc(120);
+	desc.ClippedStride = 4;
+
+	RenderSetup maskCaching;
+	maskCaching.MaskCaching = true;
+
+	const Frames expected = Render(desc, RenderSetup(), 20);
+	ASSERT_NE(expected.front(), expected.back()); // the model moved
+	ExpectSameFrames(expected, Render(desc, maskCaching, 20));
+}
@@ -0,0 +1,107 @@
+#include "Ioface/FaceFeatures.hpp"
+#include "SyntheticFace.hpp"
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+	const std::vector<cv::Mat>& Frames()
+	{
+		static const std::vector<cv::Mat> frames = []
+		{
+			std::vector<cv::Mat> landmarks;
+			for (int i = 0; i < 256; i++)
+				landmarks.push_back(SyntheticFace::Landmarks(SyntheticFace::PoseAt(i)));
+			return landmarks;
+		}();
+		return frames;
+	}
+
+	// the same pairs one at a time, without the SoA gather nor the vector pass
+	void ExtractFaceFeaturesScalar(const cv::Mat& landmarks, FaceFeatures& outFeatures)
+	{
+		const float* xs = landmarks.ptr<float>(0);
+		const float* ys = landmarks.ptr<float>(1);
+		auto distance = [xs, ys](int from, int to) { return std::sqrt((xs[to] - xs[from]) * (xs[to] - xs[from]) + (ys[to] - ys[from]) * (ys[to] - ys[from])); };
+
+		outFeatures.NoseHeight = distance(10, 16);
+		outFeatures.LeftEyeV1 = distance(20, 24);
+		outFeatures.LeftEyeV2 = distance(21, 23);
+		outFeatures.LeftEyeH = distance(19, 22);
+		outFeatures.RightEyeV1 = distance(26, 30);
+		outFeatures.RightEyeV2 = distance(27, 29);
+		outFeatures.RightEyeH = distance(25, 28);
+		outFeatures.MouthHeight = distance(44, 47);
+		outFeatures.MouthWidth = distance(31, 37);
+		outFeatures.LeftBrowHeight = distance(10, 4);
+		outFeatures.RightBrowHeight = distance(10, 5);
+		outFeatures.LeftEAR = (outFeatures.LeftEyeV1 + outFeatures.LeftEyeV2) / (2.0f * outFeatures.LeftEyeH);
+		outFeatures.RightEAR = (outFeatures.RightEyeV1 + outFeatures.RightEyeV2) / (2.0f * outFeatures.RightEyeH);
+	}
+
+	// what Ioface did before: integer cv::Points through an std::pow based norm
+	#define L2Norm(p1, p2) std::sqrt(std::pow(p2.x - p1.x, 2) + std::pow(p2.y - p1.y, 2))
+
+	cv::Point LandmarkPoint(const cv::Mat& landmarks, int i)
+	{
+		return cv::Point(landmarks.at<float>(0, i), landmarks.at<float>(1, i));
+	}
+
+	void ExtractFaceFeaturesPoints(const cv::Mat& landmarks, FaceFeatures& outFeatures)
+	{
+		cv::Point pTopNose = LandmarkPoint(landmarks, 10);
+		outFeatures.NoseHeight = L2Norm(pTopNose, LandmarkPoint(landmarks, 16));
+
+		outFeatures.LeftEyeV1 = L2Norm(LandmarkPoint(landmarks, 20), LandmarkPoint(landmarks, 24));
+		outFeatures.LeftEyeV2 = L2Norm(LandmarkPoint(landmarks, 21), LandmarkPoint(landmarks, 23));
+		outFeatures.LeftEyeH = L2Norm(LandmarkPoint(landmarks, 19), LandmarkPoint(landmarks, 22));
+		outFeatures.LeftEAR = (outFeatures.LeftEyeV1 + outFeatures.LeftEyeV2) / (2.0f * outFeatures.LeftEyeH);
+
+		outFeatures.RightEyeV1 = L2Norm(LandmarkPoint(landmarks, 26), LandmarkPoint(landmarks, 30));
+		outFeatures.RightEyeV2 = L2Norm(LandmarkPoint(landmarks, 27), LandmarkPoint(landmarks, 29));
+		outFeatures.RightEyeH = L2Norm(LandmarkPoint(landmarks, 25), LandmarkPoint(landmarks, 28));
+		outFeatures.RightEAR = (outFeatures.RightEyeV1 + outFeatures.RightEyeV2) / (2.0f * outFeatures.RightEyeH);
+
+		outFeatures.MouthHeight = L2Norm(LandmarkPoint(landmarks, 44), LandmarkPoint(landmarks, 47));
+		outFeatures.MouthWidth = L2Norm(LandmarkPoint(landmarks, 31), LandmarkPoint(landmarks, 37));
+		outFeatures.LeftBrowHeight = L2Norm(pTopNose, LandmarkPoint(landmarks, 4));
+		outFeatures.RightBrowHeight = L2Norm(pTopNose, LandmarkPoint(landmarks, 5));
+	}
+
+	#undef L2Norm
+
+	template<void (*Extract)(const cv::Mat&, FaceFeatures&)>
+	void RunFrames(benchmark::State& state)
+	{
+		const std::vector<cv::Mat>& frames = Frames();
+		size_t i = 0;
+		for (auto _ : state)
+		{
+			FaceFeatures features;
+			Extract(frames[i], features);
+			benchmark::DoNotOptimize(features);
+			i = (i + 1) % frames.size();
+		}
+	}
+
+} // namespace
+
+// one SIMD pass, used by Ioface
+static void BM_ExtractFaceFeatures(benchmark::State& state)
+{
+	RunFrames<ExtractFaceFeatures>(state);
+}
+BENCHMARK(BM_ExtractFaceFeatures);
+
+static void BM_ExtractFaceFeaturesScalar(benchmark::State& state)
+{
+	RunFrames<ExtractFaceFeaturesScalar>(state);
+}
+BENCHMARK(BM_ExtractFaceFeaturesScalar);
+
+static void BM_ExtractFaceFeaturesPoints(benchmark::State& state)
+{
+	RunFrames<ExtractFaceFeaturesPoints>(state);
+}
+BENCHMARK(BM_ExtractFaceFeaturesPoints);
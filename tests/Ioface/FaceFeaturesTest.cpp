@@ -0,0 +1,82 @@
+#include "Ioface/FaceFeatures.hpp"
+#include "Ioface/ReplayTracker.hpp"
+#include <gtest/gtest.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*
+* Golden values of ExtractFaceFeatures on a landmark recording.
+* Data/FaceFeatures.iolm is a synthetic face with sub-pixel landmarks (blinks, mouth, head motion),
+* Data/FaceFeatures.golden holds its distances computed in double precision.
+*/
+namespace {
+
+	constexpr float kDistanceTolerance = 1e-3f; // pixels, integer truncation used to be off by up to one pixel
+	constexpr float kEARTolerance = 1e-5f;
+
+	struct GoldenFeatures
+	{
+		float Values[13];
+	};
+
+	std::vector<GoldenFeatures> LoadGolden(const std::string& filePath)
+	{
+		std::vector<GoldenFeatures> golden;
+		std::ifstream file(filePath);
+
+		std::string line;
+		while (std::getline(file, line))
+		{
+			if (line.empty() || line[0] == '#')
+				continue;
+
+			GoldenFeatures features;
+			std::istringstream values(line);
+			for (float& value : features.Values)
+				values >> value;
+			if (values)
+				golden.push_back(features);
+		}
+		return golden;
+	}
+
+} // namespace
+
+TEST(FaceFeatures, MatchesGoldenValuesOfRecording)
+{
+	std::string dataDir = IOLIVE_TESTS_DATA_DIR;
+	std::vector<GoldenFeatures> golden = LoadGolden(dataDir + "/FaceFeatures.golden");
+
+	ReplayTracker replay(dataDir + "/FaceFeatures.iolm", false, false);
+	ASSERT_TRUE(replay.IsInitialized());
+	ASSERT_EQ(replay.GetRecordCount(), golden.size());
+
+	cv::Mat frame, landmarks;
+	float score = 0.0f;
+	for (size_t record = 0; record < golden.size(); record++)
+	{
+		ASSERT_TRUE(replay.Track(frame, landmarks, landmarks, score));
+
+		FaceFeatures features;
+		ExtractFaceFeatures(landmarks, features);
+
+		const float actual[13] = {
+			features.NoseHeight,
+			features.LeftEyeV1, features.LeftEyeV2, features.LeftEyeH,
+			features.RightEyeV1, features.RightEyeV2, features.RightEyeH,
+			features.MouthHeight, features.MouthWidth,
+			features.LeftBrowHeight, features.RightBrowHeight,
+			features.LeftEAR, features.RightEAR
+		};
+
+		for (int i = 0; i < 13; i++)
+		{
+			float tolerance = i < 11 ? kDistanceTolerance : kEARTolerance;
+			EXPECT_NEAR(actual[i], golden[record].Values[i], tolerance) << "record " << record << ", value " << i;
+		}
+	}
+
+	EXPECT_TRUE(replay.IsFinished());
+}
@@ -0,0 +1,49 @@
+#include "Ioface/Ioface.hpp"
+#include "HeadPoseRotations.hpp"
+#include <benchmark/benchmark.h>
+#include <opencv2/calib3d.hpp>
+
+namespace {
+
+	const std::vector<cv::Mat>& Rotations()
+	{
+		static const std::vector<cv::Mat> rotations = HeadPoseRotations::Generate(1024);
+		return rotations;
+	}
+
+} // namespace
+
+// hand written Givens decomposition used by Ioface
+static void BM_RotationToEuler(benchmark::State& state)
+{
+	const std::vector<cv::Mat>& rotations = Rotations();
+	size_t i = 0;
+	for (auto _ : state)
+	{
+		cv::Vec3d euler = Ioface::RotationToEuler(rotations[i]);
+		benchmark::DoNotOptimize(euler);
+		i = (i + 1) % rotations.size();
+	}
+}
+BENCHMARK(BM_RotationToEuler);
+
+// what Ioface did before, for comparison
+static void BM_DecomposeProjectionMatrix(benchmark::State& state)
+{
+	const std::vector<cv::Mat>& rotations = Rotations();
+	size_t i = 0;
+	for (auto _ : state)
+	{
+		const cv::Mat& rotation = rotations[i];
+		cv::Vec3d eav;
+		cv::Mat tmp, tmp1, tmp2, tmp3, tmp4, tmp5;
+		double pm[12] = {
+			rotation.at<float>(0, 0), rotation.at<float>(0, 1), rotation.at<float>(0, 2), 0,
+			rotation.at<float>(1, 0), rotation.at<float>(1, 1), rotation.at<float>(1, 2), 0,
+			rotation.at<float>(2, 0), rotation.at<float>(2, 1), rotation.at<float>(2, 2), 0 };
+		cv::decomposeProjectionMatrix(cv::Mat(3, 4, CV_64FC1, pm), tmp, tmp1, tmp2, tmp3, tmp4, tmp5, eav);
+		benchmark::DoNotOptimize(eav);
+		i = (i + 1) % rotations.size();
+	}
+}
+BENCHMARK(BM_DecomposeProjectionMatrix);
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <opencv2/core.hpp>
+#include <vector>
+#include <random>
+#include <cmath>
+
+/*
+* Head rotations for the RotationToEuler test & benchmark:
+* uniformly random ones plus the poses where the decomposition is fragile
+*/
+namespace HeadPoseRotations {
+
+	// 3x3 CV_32F rotation of a unit quaternion
+	inline cv::Mat FromQuaternion(double w, double x, double y, double z)
+	{
+		cv::Mat rotation(3, 3, CV_32FC1);
+		rotation.at<float>(0, 0) = static_cast<float>(1 - 2 * (y * y + z * z));
+		rotation.at<float>(0, 1) = static_cast<float>(2 * (x * y - w * z));
+		rotation.at<float>(0, 2) = static_cast<float>(2 * (x * z + w * y));
+		rotation.at<float>(1, 0) = static_cast<float>(2 * (x * y + w * z));
+		rotation.at<float>(1, 1) = static_cast<float>(1 - 2 * (x * x + z * z));
+		rotation.at<float>(1, 2) = static_cast<float>(2 * (y * z - w * x));
+		rotation.at<float>(2, 0) = static_cast<float>(2 * (x * z - w * y));
+		rotation.at<float>(2, 1) = static_cast<float>(2 * (y * z + w * x));
+		rotation.at<float>(2, 2) = static_cast<float>(1 - 2 * (x * x + y * y));
+		return rotation;
+	}
+
+	// rotation about a single axis (0 = x, 1 = y, 2 = z)
+	inline cv::Mat AboutAxis(int axis, double degrees)
+	{
+		double half = degrees * CV_PI / 360.0;
+		double v[3] = { 0.0, 0.0, 0.0 };
+		v[axis] = std::sin(half);
+		return FromQuaternion(std::cos(half), v[0], v[1], v[2]);
+	}
+
+	inline std::vector<cv::Mat> Generate(int randomCount, unsigned seed = 42)
+	{
+		std::vector<cv::Mat> rotations;
+
+		// identity, half turns, and yaw close to +-90 degrees (gimbal lock).
+		// Exactly +-90 degrees yaw is left out, pitch & roll aren't unique there
+		rotations.push_back(cv::Mat::eye(3, 3, CV_32FC1));
+		for (int axis = 0; axis < 3; axis++)
+		{
+			for (double degrees : { -179.9, -90.0, -45.0, 45.0, 90.0, 179.9 })
+			{
+				if (axis != 1 || std::abs(degrees) != 90.0)
+					rotations.push_back(AboutAxis(axis, degrees));
+			}
+		}
+		for (double degrees : { -89.9, -89.0, 89.0, 89.9 })
+			rotations.push_back(cv::Mat(AboutAxis(1, degrees) * AboutAxis(0, 30.0)));
+
+		// uniform random rotations (random unit quaternions)
+		std::mt19937 rng(seed);
+		std::normal_distribution<double> normal;
+		for (int i = 0; i < randomCount; i++)
+		{
+			double q[4] = { normal(rng), normal(rng), normal(rng), normal(rng) };
+			double n = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+			rotations.push_back(FromQuaternion(q[0] / n, q[1] / n, q[2] / n, q[3] / n));
+		}
+
+		return rotations;
+	}
+
+} // namespace HeadPoseRotations
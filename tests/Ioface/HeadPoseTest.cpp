@@ -0,0 +1,87 @@
+#include "Ioface/Ioface.hpp"
+#include "HeadPoseRotations.hpp"
+#include <gtest/gtest.h>
+#include <opencv2/calib3d.hpp>
+#include <cmath>
+
+namespace {
+
+	constexpr double kToleranceDeg = 1e-4;
+
+	// the way Ioface decomposed the head rotation before RotationToEuler
+	cv::Vec3d DecomposeProjectionMatrix(const cv::Mat& rotation)
+	{
+		cv::Vec3d eav;
+		cv::Mat tmp, tmp1, tmp2, tmp3, tmp4, tmp5;
+		double pm[12] = {
+			rotation.at<float>(0, 0), rotation.at<float>(0, 1), rotation.at<float>(0, 2), 0,
+			rotation.at<float>(1, 0), rotation.at<float>(1, 1), rotation.at<float>(1, 2), 0,
+			rotation.at<float>(2, 0), rotation.at<float>(2, 1), rotation.at<float>(2, 2), 0 };
+		cv::decomposeProjectionMatrix(cv::Mat(3, 4, CV_64FC1, pm), tmp, tmp1, tmp2, tmp3, tmp4, tmp5, eav);
+		return eav;
+	}
+
+	// -180 and 180 degrees are the same angle
+	double AngleDifference(double a, double b)
+	{
+		double d = std::fmod(a - b, 360.0);
+		if (d > 180.0)
+			d -= 360.0;
+		else if (d < -180.0)
+			d += 360.0;
+		return std::abs(d);
+	}
+
+} // namespace
+
+TEST(HeadPose, RotationToEulerMatchesDecomposeProjectionMatrix)
+{
+	std::vector<cv::Mat> rotations = HeadPoseRotations::Generate(100000);
+
+	double maxError = 0.0;
+	for (size_t i = 0; i < rotations.size(); i++)
+	{
+		cv::Vec3d expected = DecomposeProjectionMatrix(rotations[i]);
+		cv::Vec3d actual = Ioface::RotationToEuler(rotations[i]);
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			double error = AngleDifference(actual[axis], expected[axis]);
+			maxError = std::max(maxError, error);
+			ASSERT_LE(error, kToleranceDeg) << "rotation " << i << ", axis " << axis << "\n" << rotations[i];
+		}
+	}
+
+	RecordProperty("MaxErrorDeg", std::to_string(maxError));
+}
+
+// pitch & roll can't be told apart, any split must still give back the rotation
+TEST(HeadPose, GimbalLockRebuildsRotation)
+{
+	for (double yaw : { -90.0, 90.0 })
+	{
+		for (double pitch : { 0.0, 30.0, -60.0 })
+		{
+			cv::Mat rotation = HeadPoseRotations::AboutAxis(1, yaw) * HeadPoseRotations::AboutAxis(0, pitch);
+			cv::Vec3d euler = Ioface::RotationToEuler(rotation);
+			EXPECT_NEAR(euler[1], yaw, kToleranceDeg);
+
+			// R = Rz * Ry * Rx
+			cv::Mat rebuilt = HeadPoseRotations::AboutAxis(2, euler[2])
+				* HeadPoseRotations::AboutAxis(1, euler[1])
+				* HeadPoseRotations::AboutAxis(0, euler[0]);
+			EXPECT_LE(cv::norm(rebuilt, rotation, cv::NORM_INF), 1e-5) << "yaw " << yaw << ", pitch " << pitch;
+		}
+	}
+}
+
+TEST(HeadPose, SingleAxisRotations)
+{
+	for (int axis = 0; axis < 3; axis++)
+	{
+		cv::Vec3d euler = Ioface::RotationToEuler(HeadPoseRotations::AboutAxis(axis, 30.0));
+
+		for (int i = 0; i < 3; i++)
+			EXPECT_NEAR(euler[i], i == axis ? 30.0 : 0.0, kToleranceDeg) << "axis " << axis;
+	}
+}
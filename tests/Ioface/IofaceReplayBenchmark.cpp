@@ -0,0 +1,68 @@
+#include "Ioface/Ioface.hpp"
+#include "Ioface/ReplayTracker.hpp"
+#include "SyntheticFace.hpp"
+#include <benchmark/benchmark.h>
+#include <filesystem>
+
+/*
+* Headless tracking pipeline: a landmark recording replayed as fast as possible,
+* through head pose, feature distances and sample publishing.
+*/
+namespace {
+
+	constexpr int kRecordCount = 900; // 30 s at 30 FPS
+
+	const std::string& RecordingPath()
+	{
+		static const std::string filePath = []()
+		{
+			std::string path = (std::filesystem::temp_directory_path() / "IofaceReplayBenchmark.iolm").string();
+			SyntheticFace::WriteRecording(path, kRecordCount);
+			return path;
+		}();
+		return filePath;
+	}
+
+} // namespace
+
+// replay decoding only
+static void BM_ReplayTrackerTrack(benchmark::State& state)
+{
+	ReplayTracker tracker(RecordingPath(), false, true);
+	if (!tracker.IsInitialized())
+	{
+		state.SkipWithError("Can't read the recording");
+		return;
+	}
+
+	cv::Mat frame, landmarks, rotation;
+	float score = 0.0f;
+	for (auto _ : state)
+	{
+		tracker.Track(frame, landmarks, landmarks, score);
+		tracker.EstimateHeadPose(landmarks, rotation);
+		benchmark::DoNotOptimize(rotation.data);
+	}
+}
+BENCHMARK(BM_ReplayTrackerTrack);
+
+// one tracker result through Ioface, as the capture thread & the render thread see it
+static void BM_IofaceReplayPipeline(benchmark::State& state)
+{
+	Ioface ioface;
+	if (!ioface.OpenReplay(RecordingPath(), false, true))
+	{
+		state.SkipWithError("Can't open the recording");
+		return;
+	}
+
+	FaceSample sample;
+	for (auto _ : state)
+	{
+		ioface.UpdateAll();
+		ioface.GetLatestSample(sample);
+		benchmark::DoNotOptimize(sample);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_IofaceReplayPipeline);
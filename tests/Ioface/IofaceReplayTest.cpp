@@ -0,0 +1,68 @@
+#include "Ioface/Ioface.hpp"
+#include "SyntheticFace.hpp"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+
+namespace {
+
+	constexpr int kRecordCount = 60;
+
+	class IofaceReplay : public ::testing::Test
+	{
+	protected:
+		void SetUp() override
+		{
+			m_FilePath = testing::TempDir() + "IofaceReplayTest.iolm";
+			ASSERT_TRUE(SyntheticFace::WriteRecording(m_FilePath, kRecordCount));
+		}
+
+		void TearDown() override
+		{
+			std::remove(m_FilePath.c_str());
+		}
+
+		std::string m_FilePath;
+	};
+
+} // namespace
+
+TEST_F(IofaceReplay, PublishesEveryRecordOnce)
+{
+	Ioface ioface;
+	ASSERT_TRUE(ioface.OpenReplay(m_FilePath, false, false));
+
+	int published = 0;
+	FaceSample sample;
+	for (int i = 0; i < kRecordCount; i++)
+	{
+		ioface.UpdateAll();
+		if (ioface.GetLatestSample(sample))
+			published++;
+		EXPECT_TRUE(sample.IsDetected);
+	}
+
+	EXPECT_EQ(published, kRecordCount);
+	EXPECT_EQ(sample.Sequence, static_cast<uint64_t>(kRecordCount));
+}
+
+TEST_F(IofaceReplay, FinishedReplayDoesNotSpin)
+{
+	Ioface ioface;
+	ASSERT_TRUE(ioface.OpenReplay(m_FilePath, false, false));
+
+	for (int i = 0; i < kRecordCount; i++)
+		ioface.UpdateAll();
+
+	FaceSample sample;
+	ioface.GetLatestSample(sample);
+
+	// the capture loop keeps calling UpdateAll(), it has to block instead of returning at once
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < 3; i++)
+		ioface.UpdateAll();
+	auto elapsed = std::chrono::steady_clock::now() - start;
+
+	EXPECT_GE(elapsed, std::chrono::milliseconds(200));
+	EXPECT_FALSE(ioface.GetLatestSample(sample));
+}
@@ -0,0 +1,197 @@
+#include "Ioface/SamplePredictor.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+#include <random>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+	constexpr double kPi = 3.14159265358979323846;
+
+	constexpr double kDuration = 10.0;         // seconds
+	constexpr double kTrackerInterval = 1.0 / 30.0;
+	constexpr double kTrackerJitter = 0.004;   // capture time noise, seconds
+	constexpr double kTrackerLatency = 0.015;  // capture -> sample published
+	constexpr double kRenderInterval = 1.0 / 144.0;
+
+	// head motion the tracker sees
+	double ReferenceAngle(double t)
+	{
+		return 20.0 * std::sin(2.0 * kPi * 0.5 * t) + 5.0 * std::sin(2.0 * kPi * 1.3 * t);
+	}
+
+	struct TrackedSample
+	{
+		FaceSample Sample;
+		double ArrivalTime;
+	};
+
+	// 30 FPS tracker stream, with capture jitter and processing latency
+	std::vector<TrackedSample> RecordTrackerStream()
+	{
+		std::mt19937 rng(1234);
+		std::uniform_real_distribution<double> jitter(-kTrackerJitter, kTrackerJitter);
+
+		std::vector<TrackedSample> stream;
+		uint64_t sequence = 0;
+		for (double frameTime = 0.0; frameTime < kDuration + 1.0; frameTime += kTrackerInterval)
+		{
+			TrackedSample tracked;
+			tracked.Sample.Sequence = ++sequence;
+			tracked.Sample.Timestamp = frameTime + jitter(rng);
+			tracked.Sample.IsDetected = true;
+			tracked.Sample.Score = 1.0f;
+			tracked.Sample.AngleX = static_cast<float>(ReferenceAngle(tracked.Sample.Timestamp));
+			tracked.ArrivalTime = tracked.Sample.Timestamp + kTrackerLatency;
+			stream.push_back(tracked);
+		}
+		return stream;
+	}
+
+	struct ReplayResult
+	{
+		double Lag;    // seconds, shift that best aligns the rendered angle with the reference
+		double Error;  // degrees, RMS error left once the lag is compensated
+		double Jitter; // degrees, RMS frame to frame change of the rendered velocity, minus the reference one
+	};
+
+	/*
+	* Replay the stream into a predictor evaluated at every render frame,
+	* like Iolive does, then measure the rendered AngleX against the reference
+	*/
+	ReplayResult Replay(const std::vector<TrackedSample>& stream, SamplePredictor::Mode mode, float interpolationDelay = SamplePredictor().InterpolationDelay)
+	{
+		SamplePredictor predictor;
+		predictor.SetMode(SamplePredictor::Group::HeadAngles, mode);
+		predictor.InterpolationDelay = interpolationDelay;
+
+		std::vector<double> renderTimes;
+		std::vector<double> rendered;
+
+		size_t next = 0;
+		for (double renderTime = 0.5; renderTime < kDuration; renderTime += kRenderInterval)
+		{
+			while (next < stream.size() && stream[next].ArrivalTime <= renderTime)
+				predictor.Push(stream[next++].Sample);
+
+			FaceSample sample;
+			if (predictor.Evaluate(renderTime, sample))
+			{
+				renderTimes.push_back(renderTime);
+				rendered.push_back(sample.AngleX);
+			}
+		}
+
+		ReplayResult result = { 0.0, INFINITY, 0.0 };
+		for (double lag = 0.0; lag <= 0.15; lag += 0.0005)
+		{
+			double sumSq = 0.0;
+			for (size_t i = 0; i < rendered.size(); i++)
+			{
+				double error = rendered[i] - ReferenceAngle(renderTimes[i] - lag);
+				sumSq += error * error;
+			}
+
+			double rms = std::sqrt(sumSq / rendered.size());
+			if (rms < result.Error)
+			{
+				result.Lag = lag;
+				result.Error = rms;
+			}
+		}
+
+		// second difference, a 30 FPS step shows up on every tracker frame
+		double sumSq = 0.0;
+		for (size_t i = 2; i < rendered.size(); i++)
+		{
+			double renderedAccel = rendered[i] - 2.0 * rendered[i - 1] + rendered[i - 2];
+			double referenceAccel = ReferenceAngle(renderTimes[i] - result.Lag)
+				- 2.0 * ReferenceAngle(renderTimes[i - 1] - result.Lag)
+				+ ReferenceAngle(renderTimes[i - 2] - result.Lag);
+			double error = renderedAccel - referenceAccel;
+			sumSq += error * error;
+		}
+		result.Jitter = std::sqrt(sumSq / (rendered.size() - 2));
+
+		std::printf("[ %-11s ] lag %5.1f ms, error %.3f deg, jitter %.4f deg\n",
+			SamplePredictor::ModeName(mode), result.Lag * 1000.0, result.Error, result.Jitter);
+		return result;
+	}
+
+} // namespace
+
+TEST(SamplePredictorReplay, InterpolateRemovesStepsAtFixedDelay)
+{
+	std::vector<TrackedSample> stream = RecordTrackerStream();
+
+	ReplayResult latest = Replay(stream, SamplePredictor::Mode::Latest);
+	// enough delay to always have a newer sample: one tracker frame + latency + capture jitter
+	float delay = static_cast<float>(kTrackerInterval + kTrackerLatency + 2.0 * kTrackerJitter);
+	ReplayResult interpolate = Replay(stream, SamplePredictor::Mode::Interpolate, delay);
+
+	// a 30 FPS staircase rendered at 144 FPS vs a smooth curve
+	EXPECT_LT(interpolate.Jitter, latest.Jitter / 10.0);
+	EXPECT_LT(interpolate.Error, latest.Error);
+
+	// the lag is the interpolation delay, not the tracker rate nor the render rate
+	EXPECT_NEAR(interpolate.Lag, delay, 0.005);
+}
+
+TEST(SamplePredictorReplay, InterpolateShorterThanLatencyStalls)
+{
+	std::vector<TrackedSample> stream = RecordTrackerStream();
+
+	float enough = static_cast<float>(kTrackerInterval + kTrackerLatency + 2.0 * kTrackerJitter);
+	ReplayResult smooth = Replay(stream, SamplePredictor::Mode::Interpolate, enough);
+
+	// time - delay often lands past the newest sample, the angle holds until the next one
+	ReplayResult stalled = Replay(stream, SamplePredictor::Mode::Interpolate, static_cast<float>(kTrackerInterval));
+
+	EXPECT_GT(stalled.Jitter, smooth.Jitter * 4.0);
+}
+
+TEST(SamplePredictorReplay, DefaultDelayDoesNotStall)
+{
+	std::vector<TrackedSample> stream = RecordTrackerStream();
+
+	float enough = static_cast<float>(kTrackerInterval + kTrackerLatency + 2.0 * kTrackerJitter);
+	EXPECT_GE(SamplePredictor().InterpolationDelay, enough);
+
+	ReplayResult smooth = Replay(stream, SamplePredictor::Mode::Interpolate, enough);
+	ReplayResult byDefault = Replay(stream, SamplePredictor::Mode::Interpolate);
+	ReplayResult latest = Replay(stream, SamplePredictor::Mode::Latest);
+
+	// as smooth as the delay the stream needs, nowhere near the stalls or the staircase
+	EXPECT_LT(byDefault.Jitter, smooth.Jitter * 2.0);
+	EXPECT_LT(byDefault.Jitter, latest.Jitter / 10.0);
+}
+
+TEST(SamplePredictorReplay, ExtrapolateHidesTrackerLatency)
+{
+	std::vector<TrackedSample> stream = RecordTrackerStream();
+
+	ReplayResult latest = Replay(stream, SamplePredictor::Mode::Latest);
+	ReplayResult extrapolate = Replay(stream, SamplePredictor::Mode::Extrapolate);
+
+	EXPECT_LT(extrapolate.Lag, kTrackerLatency);
+	EXPECT_LT(extrapolate.Jitter, latest.Jitter);
+}
+
+TEST(SamplePredictorReplay, LostFaceIsNotPredicted)
+{
+	SamplePredictor predictor;
+	FaceSample sample;
+
+	sample.Sequence = 1;
+	sample.Timestamp = 1.0;
+	sample.IsDetected = true;
+	predictor.Push(sample);
+	ASSERT_TRUE(predictor.Evaluate(1.05, sample));
+
+	sample.Sequence = 2;
+	sample.Timestamp = 1.1;
+	sample.IsDetected = false;
+	predictor.Push(sample);
+	EXPECT_FALSE(predictor.Evaluate(1.15, sample));
+}
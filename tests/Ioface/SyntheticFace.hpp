@@ -0,0 +1,121 @@
+#pragma once
+
+#include "Ioface/LandmarkRecorder.hpp"
+#include <opencv2/core.hpp>
+#include <string>
+#include <cmath>
+
+/*
+* Landmarks & head rotation of a moving face, for tests and benchmarks
+* that run the Ioface pipeline without a camera nor a tracker.
+* Point layout follows the 49 IntraFace points used by FaceFeatures.
+*/
+namespace SyntheticFace {
+
+	struct Pose
+	{
+		float Yaw = 0.0f;   // degrees
+		float Pitch = 0.0f; // degrees
+		float Roll = 0.0f;  // degrees
+		float EyeOpen = 1.0f;   // 0 = closed
+		float MouthOpen = 0.0f; // 0 = closed, 1 = wide open
+	};
+
+	// pose of frame i, every parameter moves at a different rate
+	inline Pose PoseAt(int frame)
+	{
+		float t = frame / 30.0f;
+
+		Pose pose;
+		pose.Yaw = 20.0f * std::sin(t * 1.1f);
+		pose.Pitch = 10.0f * std::sin(t * 0.7f);
+		pose.Roll = 8.0f * std::sin(t * 0.5f);
+		pose.EyeOpen = (frame % 90) < 6 ? 0.1f : 1.0f;
+		pose.MouthOpen = 0.5f + 0.5f * std::sin(t * 2.3f);
+		return pose;
+	}
+
+	// 2x49 CV_32F, row 0 = x, row 1 = y
+	inline cv::Mat Landmarks(const Pose& pose)
+	{
+		cv::Mat landmarks(2, 49, CV_32FC1);
+		auto set = [&](int i, float x, float y)
+		{
+			landmarks.at<float>(0, i) = 320.0f + x + pose.Yaw;
+			landmarks.at<float>(1, i) = 240.0f + y + pose.Pitch;
+		};
+
+		// brows 0-4 left (outer to inner), 5-9 right (inner to outer)
+		for (int i = 0; i < 5; i++)
+		{
+			set(i, -75.0f + i * 15.0f, -70.0f + (i == 0 || i == 4 ? 4.0f : 0.0f));
+			set(5 + i, 15.0f + i * 15.0f, -70.0f + (i == 0 || i == 4 ? 4.0f : 0.0f));
+		}
+
+		// nose 10-13 bridge, 14-18 bottom
+		for (int i = 0; i < 4; i++)
+			set(10 + i, 0.0f, -60.0f + i * 20.0f);
+		for (int i = 0; i < 5; i++)
+			set(14 + i, -20.0f + i * 10.0f, 20.0f - (i == 2 ? 0.0f : 3.0f));
+
+		// eyes 19-24 left, 25-30 right, EAR ~0.3 when open
+		float lid = 6.0f * pose.EyeOpen;
+		auto eye = [&](int first, float cx)
+		{
+			set(first + 0, cx - 20.0f, -40.0f);
+			set(first + 1, cx - 7.0f, -40.0f - lid);
+			set(first + 2, cx + 7.0f, -40.0f - lid);
+			set(first + 3, cx + 20.0f, -40.0f);
+			set(first + 4, cx + 7.0f, -40.0f + lid);
+			set(first + 5, cx - 7.0f, -40.0f + lid);
+		};
+		eye(19, -45.0f);
+		eye(25, 45.0f);
+
+		// mouth 31-42 outer (31 left corner, 37 right corner), 43-48 inner
+		float open = 25.0f * pose.MouthOpen;
+		for (int i = 0; i < 12; i++)
+		{
+			float a = static_cast<float>(CV_PI) * i / 6.0f;
+			set(31 + i, -40.0f * std::cos(a), 60.0f - (8.0f + open * 0.5f) * std::sin(a));
+		}
+		for (int i = 0; i < 6; i++)
+		{
+			float a = static_cast<float>(CV_PI) * (i + 0.5f) / 3.0f;
+			set(43 + i, -25.0f * std::cos(a), 60.0f - (1.0f + open * 0.5f) * std::sin(a));
+		}
+
+		return landmarks;
+	}
+
+	// 3x3 CV_32F, R = Rz * Ry * Rx
+	inline cv::Mat Rotation(const Pose& pose)
+	{
+		const double kDegToRad = CV_PI / 180.0;
+		double x = pose.Pitch * kDegToRad, y = pose.Yaw * kDegToRad, z = pose.Roll * kDegToRad;
+
+		cv::Matx33d rx(1, 0, 0, 0, std::cos(x), -std::sin(x), 0, std::sin(x), std::cos(x));
+		cv::Matx33d ry(std::cos(y), 0, std::sin(y), 0, 1, 0, -std::sin(y), 0, std::cos(y));
+		cv::Matx33d rz(std::cos(z), -std::sin(z), 0, std::sin(z), std::cos(z), 0, 0, 0, 1);
+
+		cv::Mat rotation;
+		cv::Mat(rz * ry * rx).convertTo(rotation, CV_32FC1);
+		return rotation;
+	}
+
+	// write a 30 FPS recording of frameCount frames
+	inline bool WriteRecording(const std::string& filePath, int frameCount)
+	{
+		LandmarkRecorder recorder;
+		if (!recorder.Open(filePath))
+			return false;
+
+		for (int frame = 0; frame < frameCount; frame++)
+		{
+			Pose pose = PoseAt(frame);
+			recorder.Write(frame / 30.0, 0.9f, Landmarks(pose), Rotation(pose));
+		}
+		return true;
+	}
+
+} // namespace SyntheticFace
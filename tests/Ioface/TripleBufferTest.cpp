@@ -0,0 +1,143 @@
+#include "Ioface/TripleBuffer.hpp"
+#include "Ioface/FaceSample.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+
+namespace {
+
+	constexpr uint64_t kPublishCount = 2000000;
+
+	// every field is derived from the sequence, so a sample mixing two writes is detectable
+	void FillSample(FaceSample& sample, uint64_t sequence)
+	{
+		float v = static_cast<float>(sequence % 100000);
+
+		sample.Sequence = sequence;
+		sample.Timestamp = static_cast<double>(sequence);
+		sample.IsDetected = (sequence & 1) != 0;
+		sample.Score = v;
+		sample.DistScale = v + 1.0f;
+		sample.AngleX = v + 2.0f;
+		sample.AngleY = v + 3.0f;
+		sample.AngleZ = v + 4.0f;
+		sample.LeftEAR = v + 5.0f;
+		sample.RightEAR = v + 6.0f;
+		sample.EAR = v + 7.0f;
+		sample.MouthOpenY = v + 8.0f;
+		sample.MouthForm = v + 9.0f;
+		sample.EyeBrowLY = v + 10.0f;
+		sample.EyeBrowRY = v + 11.0f;
+	}
+
+	bool IsConsistent(const FaceSample& sample)
+	{
+		FaceSample expected;
+		FillSample(expected, sample.Sequence);
+
+		return sample.Timestamp == expected.Timestamp
+			&& sample.IsDetected == expected.IsDetected
+			&& sample.Score == expected.Score
+			&& sample.DistScale == expected.DistScale
+			&& sample.AngleX == expected.AngleX
+			&& sample.AngleY == expected.AngleY
+			&& sample.AngleZ == expected.AngleZ
+			&& sample.LeftEAR == expected.LeftEAR
+			&& sample.RightEAR == expected.RightEAR
+			&& sample.EAR == expected.EAR
+			&& sample.MouthOpenY == expected.MouthOpenY
+			&& sample.MouthForm == expected.MouthForm
+			&& sample.EyeBrowLY == expected.EyeBrowLY
+			&& sample.EyeBrowRY == expected.EyeBrowRY;
+	}
+
+} // namespace
+
+TEST(TripleBuffer, NothingPublished)
+{
+	TripleBuffer<FaceSample> buffer;
+
+	EXPECT_FALSE(buffer.HasNew());
+	EXPECT_FALSE(buffer.Update());
+	EXPECT_EQ(buffer.ReadBuffer().Sequence, 0u);
+}
+
+TEST(TripleBuffer, ReadsNewestPublished)
+{
+	TripleBuffer<FaceSample> buffer;
+
+	for (uint64_t seq = 1; seq <= 5; seq++)
+	{
+		FillSample(buffer.WriteBuffer(), seq);
+		buffer.Publish();
+	}
+
+	ASSERT_TRUE(buffer.Update());
+	EXPECT_EQ(buffer.ReadBuffer().Sequence, 5u);
+	EXPECT_TRUE(IsConsistent(buffer.ReadBuffer()));
+
+	// consumed, the read buffer stays
+	EXPECT_FALSE(buffer.Update());
+	EXPECT_EQ(buffer.ReadBuffer().Sequence, 5u);
+}
+
+TEST(TripleBuffer, ResetDropsPublished)
+{
+	TripleBuffer<FaceSample> buffer;
+
+	FillSample(buffer.WriteBuffer(), 1);
+	buffer.Publish();
+	buffer.Reset();
+
+	EXPECT_FALSE(buffer.Update());
+}
+
+/*
+* One writer thread publishes samples as fast as it can while the reader polls.
+* The reader must never see a torn sample nor go back in time,
+* and must end on the last published sample.
+*/
+TEST(TripleBuffer, ConcurrentWriterReaderNeverMixSamples)
+{
+	TripleBuffer<FaceSample> buffer;
+	std::atomic<bool> writerDone(false);
+
+	std::thread writer([&]()
+	{
+		for (uint64_t seq = 1; seq <= kPublishCount; seq++)
+		{
+			FillSample(buffer.WriteBuffer(), seq);
+			buffer.Publish();
+		}
+		writerDone.store(true, std::memory_order_release);
+	});
+
+	uint64_t lastSequence = 0;
+	uint64_t updates = 0;
+	uint64_t mixed = 0;
+	uint64_t outOfOrder = 0;
+
+	auto consume = [&]()
+	{
+		if (!buffer.Update())
+			return;
+
+		const FaceSample& sample = buffer.ReadBuffer();
+		updates++;
+		if (!IsConsistent(sample))
+			mixed++;
+		if (sample.Sequence <= lastSequence)
+			outOfOrder++;
+		lastSequence = sample.Sequence;
+	};
+
+	while (!writerDone.load(std::memory_order_acquire))
+		consume();
+	writer.join();
+	consume();
+
+	EXPECT_EQ(mixed, 0u);
+	EXPECT_EQ(outOfOrder, 0u);
+	EXPECT_GT(updates, 0u);
+	EXPECT_EQ(lastSequence, kPublishCount);
+}
@@ -0,0 +1,101 @@
+#include "FaceMapping.hpp"
+#include <benchmark/benchmark.h>
+#include <rapidjson/document.h>
+#include <string>
+
+using namespace Iolive;
+
+namespace {
+
+	/*
+	* A mapping table of mappingCount rows, like a user table driving a big model:
+	* face sources and earlier targets as inputs, every curve, a few smoothing speeds
+	*/
+	void BuildTable(int mappingCount, rapidjson::Document& document)
+	{
+		auto& allocator = document.GetAllocator();
+		document.SetArray();
+
+		const int sourceCount = static_cast<int>(FaceMapping::Source::Count);
+		const float speeds[] = { 0.0f, 4.0f, 8.0f, 16.0f };
+
+		for (int i = 0; i < mappingCount; i++)
+		{
+			std::string input = (i < sourceCount || i % 3 != 0)
+				? FaceMapping::SourceName(static_cast<FaceMapping::Source>(i % sourceCount))
+				: "ParamBench" + std::to_string(i / 2);
+			std::string target = "ParamBench" + std::to_string(i);
+
+			rapidjson::Value obj(rapidjson::kObjectType);
+			obj.AddMember("input", rapidjson::Value(input.c_str(), allocator), allocator);
+			obj.AddMember("target", rapidjson::Value(target.c_str(), allocator), allocator);
+			obj.AddMember("inMin", -1.0f, allocator);
+			obj.AddMember("inMax", 1.0f, allocator);
+			obj.AddMember("outMin", 0.0f, allocator);
+			obj.AddMember("outMax", 30.0f, allocator);
+			obj.AddMember("curve", rapidjson::StringRef(FaceMapping::CurveName(static_cast<FaceMapping::Curve>(i % static_cast<int>(FaceMapping::Curve::Count)))), allocator);
+			obj.AddMember("smoothing", speeds[i % 4], allocator);
+			obj.AddMember("scaleByDistance", i % 5 == 0, allocator);
+			if (i % 7 == 0)
+				obj.AddMember("clampMax", 20.0f, allocator);
+
+			document.PushBack(obj, allocator);
+		}
+	}
+
+} // namespace
+
+// one frame of the face -> parameter mapping
+static void BM_FaceMappingEvaluate(benchmark::State& state)
+{
+	const int mappingCount = static_cast<int>(state.range(0));
+
+	rapidjson::Document table;
+	BuildTable(mappingCount, table);
+
+	FaceMapping mapping;
+	mapping.LoadFromJson(table);
+	mapping.Compile(nullptr); // no model, targets stay in the registers
+	if (mapping.GetOpCount() != static_cast<size_t>(mappingCount))
+	{
+		state.SkipWithError("Some mappings weren't compiled");
+		return;
+	}
+
+	FaceSample face;
+	face.IsDetected = true;
+	face.DistScale = 1.1f;
+	face.EAR = face.LeftEAR = face.RightEAR = 0.25f;
+	face.MouthOpenY = 8.0f;
+	face.MouthForm = 78.0f;
+
+	int frame = 0;
+	for (auto _ : state)
+	{
+		// the face moves every frame
+		face.AngleX = static_cast<float>((frame % 60) - 30);
+		face.AngleY = static_cast<float>((frame % 40) - 20);
+		frame++;
+
+		mapping.Evaluate(face, 0.1f, -0.2f, false, 1.0f / 60.0f);
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * mappingCount);
+}
+BENCHMARK(BM_FaceMappingEvaluate)->Arg(22)->Arg(100)->Arg(300)->Arg(1000);
+
+// loading & compiling a table, done when a model or the settings change
+static void BM_FaceMappingCompile(benchmark::State& state)
+{
+	rapidjson::Document table;
+	BuildTable(static_cast<int>(state.range(0)), table);
+
+	for (auto _ : state)
+	{
+		FaceMapping mapping;
+		mapping.LoadFromJson(table);
+		mapping.Compile(nullptr);
+		benchmark::DoNotOptimize(mapping.GetOpCount());
+	}
+}
+BENCHMARK(BM_FaceMappingCompile)->Arg(300);
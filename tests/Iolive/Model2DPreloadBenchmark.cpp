@@ -0,0 +1,83 @@
+#include "ModelDirectory.hpp"
+#include "../Cubism/HeadlessGL.hpp"
+#include "../Cubism/MotionJson.hpp"
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <memory>
+
+namespace {
+
+	// 50 files like a model with many expressions: 35 editor-sized motions, 15 expressions
+	ModelDirectory::Options MakeOptions()
+	{
+		ModelDirectory::Options options;
+		options.Desc = CoreStub::MakeDesc(128);
+
+		for (int i = 0; i < 35; i++)
+		{
+			MotionJson::Options motion;
+			motion.CurveCount = 40 + i % 40;
+			motion.SegmentsPerCurve = 24;
+			motion.Duration = 4.0f + i % 5;
+			options.Motions.push_back(MotionJson::Make(motion));
+		}
+		for (int i = 0; i < 15; i++)
+		{
+			std::vector<std::string> ids;
+			for (int p = 0; p < 12; p++)
+				ids.push_back("Param" + std::to_string((i * 7 + p) % 128));
+			options.Expressions.push_back(ModelDirectory::MakeExpression(ids, 0.5f));
+		}
+		return options;
+	}
+
+	// the precompiled .iomb sidecars, for a load from the json
+	void RemoveMotionCaches(const ModelDirectory& directory)
+	{
+		for (const auto& entry : std::filesystem::directory_iterator(directory.GetPath() / "motions"))
+		{
+			if (entry.path().extension() == ".iomb")
+				std::filesystem::remove(entry.path());
+		}
+	}
+
+} // namespace
+
+/*
+* Model2D setup with range(0) preload threads, range(1) = 1 loads the motions
+* from their json each time, 0 from the sidecars written by the first load
+*/
+static void BM_Model2DPreload(benchmark::State& state)
+{
+	if (!HeadlessGL::MakeCurrent())
+	{
+		state.SkipWithError("no EGL context");
+		return;
+	}
+
+	const bool fromJson = state.range(1) != 0;
+	ModelDirectory directory(MakeOptions());
+
+	MotionLoading loading;
+	loading.PreloadThreads = static_cast<unsigned int>(state.range(0));
+	delete directory.CreateModel(loading); // writes the sidecars
+
+	for (auto _ : state)
+	{
+		if (fromJson)
+		{
+			state.PauseTiming();
+			RemoveMotionCaches(directory);
+			state.ResumeTiming();
+		}
+
+		std::unique_ptr<Model2D> model(directory.CreateModel(loading));
+		benchmark::DoNotOptimize(model.get());
+	}
+	state.SetItemsProcessed(state.iterations() * 50);
+}
+BENCHMARK(BM_Model2DPreload)
+	->ArgNames({ "threads", "json" })
+	->ArgsProduct({ benchmark::CreateDenseRange(1, 8, 1), { 0, 1 } })
+	->Unit(benchmark::kMillisecond)
+	->UseRealTime();
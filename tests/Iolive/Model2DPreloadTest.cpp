@@ -0,0 +1,106 @@
+#include "ModelDirectory.hpp"
+#include "../Cubism/HeadlessGL.hpp"
+#include "../Cubism/MotionJson.hpp"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+	/*
+	* motionCount motions & expressionCount expressions,
+	* each with its own duration / fade time to tell them apart once loaded
+	*/
+	ModelDirectory::Options MakeOptions(int motionCount, int expressionCount)
+	{
+		ModelDirectory::Options options;
+		options.Desc = CoreStub::MakeDesc(64);
+
+		for (int i = 0; i < motionCount; i++)
+		{
+			MotionJson::Options motion;
+			motion.CurveCount = 8 + i % 24;
+			motion.Duration = 1.0f + 0.25f * i;
+			options.Motions.push_back(MotionJson::Make(motion));
+		}
+		for (int i = 0; i < expressionCount; i++)
+			options.Expressions.push_back(ModelDirectory::MakeExpression({ "Param" + std::to_string(i) }, 1.0f, 0.1f + 0.05f * i));
+
+		return options;
+	}
+
+	// what a slot ends up as: its id, name & what was loaded into it
+	struct LoadedSlot
+	{
+		int Id;
+		std::string Name;
+		float Duration;
+
+		bool operator==(const LoadedSlot& other) const
+		{
+			return Id == other.Id && Name == other.Name && Duration == other.Duration;
+		}
+	};
+
+	std::vector<LoadedSlot> ListSlots(std::vector<ModelMotion>& motions, bool expressions)
+	{
+		std::vector<LoadedSlot> slots;
+		for (ModelMotion& motion : motions)
+		{
+			const float duration = motion.motion ? (expressions ? motion.motion->GetFadeInTime() : motion.motion->GetDuration()) : -1.0f;
+			slots.push_back({ motion.id, motion.name, duration });
+		}
+		return slots;
+	}
+
+} // namespace
+
+// the preload threads fill the slots in any order, they're read back in file order
+TEST(Model2DPreload, SlotOrderDoesNotDependOnThreadCount)
+{
+	if (!HeadlessGL::MakeCurrent())
+		GTEST_SKIP() << "no EGL context";
+
+	const int motionCount = 30;
+	const int expressionCount = 20;
+	ModelDirectory directory(MakeOptions(motionCount, expressionCount));
+
+	std::vector<LoadedSlot> referenceMotions;
+	std::vector<LoadedSlot> referenceExpressions;
+
+	for (unsigned int threadCount : { 1u, 2u, 3u, 8u, 0u })
+	{
+		MotionLoading loading;
+		loading.PreloadThreads = threadCount;
+		std::unique_ptr<Model2D> model(directory.CreateModel(loading));
+		ASSERT_TRUE(model);
+
+		std::vector<LoadedSlot> motions = ListSlots(model->GetMotions(), false);
+		std::vector<LoadedSlot> expressions = ListSlots(model->GetExpressions(), true);
+		ASSERT_EQ(static_cast<int>(motions.size()), motionCount);
+		ASSERT_EQ(static_cast<int>(expressions.size()), expressionCount);
+
+		if (threadCount == 1)
+		{
+			for (int i = 0; i < motionCount; i++)
+			{
+				EXPECT_EQ(motions[i].Id, i);
+				EXPECT_EQ(motions[i].Name, "motions/motion" + std::to_string(i) + ".motion3.json");
+				EXPECT_FLOAT_EQ(motions[i].Duration, 1.0f + 0.25f * i);
+			}
+			for (int i = 0; i < expressionCount; i++)
+			{
+				EXPECT_EQ(expressions[i].Name, "Expression" + std::to_string(i));
+				EXPECT_FLOAT_EQ(expressions[i].Duration, 0.1f + 0.05f * i);
+			}
+			referenceMotions = motions;
+			referenceExpressions = expressions;
+		}
+		else
+		{
+			EXPECT_TRUE(motions == referenceMotions) << threadCount << " threads";
+			EXPECT_TRUE(expressions == referenceExpressions) << threadCount << " threads";
+		}
+	}
+}
@@ -0,0 +1,232 @@
+#include "ModelDirectory.hpp"
+#include "../Cubism/HeadlessGL.hpp"
+#include "../Cubism/MotionJson.hpp"
+#include "../Cubism/PhysicsJson.hpp"
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace {
+
+	const int kParameterCount = 500;
+
+	// kParameterCount parameters (+ "ParamUnbound") driven by a motion, an expression & physics
+	ModelDirectory::Options MakeOptions(bool withUnbound)
+	{
+		ModelDirectory::Options options;
+		options.Desc = CoreStub::MakeDesc(kParameterCount, 0, 8);
+		if (withUnbound)
+			options.Desc.ParameterIds.push_back("ParamUnbound");
+
+		MotionJson::Options motion;
+		motion.CurveCount = 32;
+		motion.FirstParameter = 200;
+		motion.Duration = 1000.0f; // doesn't end during the benchmark
+		options.Motions.push_back(MotionJson::Make(motion));
+
+		std::vector<std::string> expressionIds;
+		for (int i = 300; i < 310; i++)
+			expressionIds.push_back("Param" + std::to_string(i));
+		options.Expressions.push_back(ModelDirectory::MakeExpression(expressionIds, 5.0f));
+
+		options.Physics = PhysicsJson::Make(PhysicsJson::Options());
+		return options;
+	}
+
+	/*
+	* Model2D::OnUpdate before the snapshot was skipped: four element by element copies
+	* of the parameter array per frame (save, load, save, load) whether bound or not
+	*/
+	class Model2DBeforeSnapshotSkip : public Model2D
+	{
+	public:
+		using Model2D::Model2D;
+
+		void Bind(int index, float* source)
+		{
+			if (m_Binding.GetParameterCount() == 0)
+			{
+				m_Binding.Setup(_model->GetParameterCount(),
+					Live2D::Cubism::Core::csmGetParameterMinimumValues(_model->GetModel()),
+					Live2D::Cubism::Core::csmGetParameterMaximumValues(_model->GetModel())
+				);
+			}
+			m_Binding.Bind(index, source);
+		}
+
+		void OnUpdateBefore(float deltaTime)
+		{
+			using Clock = std::chrono::steady_clock;
+			Clock::time_point stageStart = Clock::now();
+			auto stageElapsedMs = [&stageStart]() -> float {
+				Clock::time_point now = Clock::now();
+				float elapsedMs = std::chrono::duration<float, std::milli>(now - stageStart).count();
+				stageStart = now;
+				return elapsedMs;
+			};
+
+			m_Stats.SnapshotCopies = 0;
+
+			m_Binding.Apply(Live2D::Cubism::Core::csmGetParameterValues(_model->GetModel()));
+			SaveParameters();
+			LoadParameters();
+			m_Stats.BindingMs = stageElapsedMs();
+
+			_motionManager->UpdateMotion(_model, deltaTime);
+			SaveParameters();
+			LoadParameters();
+			m_Stats.MotionMs = stageElapsedMs();
+
+			_expressionManager->UpdateMotion(_model, deltaTime);
+			m_Stats.ExpressionMs = stageElapsedMs();
+
+			if (_breath)
+				_breath->UpdateParameters(_model, deltaTime);
+			m_Stats.BreathMs = stageElapsedMs();
+
+			if (_physics)
+			{
+				_physics->Evaluate(_model, deltaTime);
+				m_Stats.PhysicsSteps = _physics->GetLastStepCount();
+			}
+			m_Stats.PhysicsMs = stageElapsedMs();
+
+			if (_pose)
+				_pose->UpdateParameters(_model, deltaTime);
+			m_Stats.PoseMs = stageElapsedMs();
+
+			_model->Update();
+			m_Stats.ModelUpdateMs = stageElapsedMs();
+		}
+
+		const UpdateStats& GetBeforeStats() const { return m_Stats; }
+
+	private:
+		// the copy loops CubismModel::Save/LoadParameters had
+		void SaveParameters()
+		{
+			const int count = _model->GetParameterCount();
+			const float* values = Live2D::Cubism::Core::csmGetParameterValues(_model->GetModel());
+			for (int i = 0; i < count; i++)
+			{
+				if (i < static_cast<int>(m_Saved.size()))
+					m_Saved[i] = values[i];
+				else
+					m_Saved.push_back(values[i]);
+			}
+			m_Stats.SnapshotCopies++;
+		}
+
+		void LoadParameters()
+		{
+			const int count = std::min(_model->GetParameterCount(), static_cast<int>(m_Saved.size()));
+			float* values = Live2D::Cubism::Core::csmGetParameterValues(_model->GetModel());
+			for (int i = 0; i < count; i++)
+				values[i] = m_Saved[i];
+			m_Stats.SnapshotCopies++;
+		}
+
+	private:
+		ParameterBinding m_Binding;
+		std::vector<float> m_Saved;
+		UpdateStats m_Stats;
+	};
+
+	struct StageTotals
+	{
+		double Binding = 0.0, Motion = 0.0, Expression = 0.0, Physics = 0.0, ModelUpdate = 0.0;
+		int SnapshotCopies = 0;
+
+		void Add(const Model2D::UpdateStats& stats)
+		{
+			Binding += stats.BindingMs;
+			Motion += stats.MotionMs;
+			Expression += stats.ExpressionMs;
+			Physics += stats.PhysicsMs;
+			ModelUpdate += stats.ModelUpdateMs;
+			SnapshotCopies = stats.SnapshotCopies;
+		}
+
+		// mean milliseconds per OnUpdate of each stage
+		void Report(benchmark::State& state) const
+		{
+			const double frames = static_cast<double>(std::max<benchmark::IterationCount>(state.iterations(), 1));
+			state.counters["BindingMs"] = Binding / frames;
+			state.counters["MotionMs"] = Motion / frames;
+			state.counters["ExpressionMs"] = Expression / frames;
+			state.counters["PhysicsMs"] = Physics / frames;
+			state.counters["ModelUpdateMs"] = ModelUpdate / frames;
+			state.counters["SnapshotCopies"] = SnapshotCopies;
+		}
+	};
+
+	void MoveSources(std::vector<float>& sources, int frame)
+	{
+		for (float& value : sources)
+			value = value > 25.0f ? -25.0f : value + 0.5f;
+		sources[frame % sources.size()] = 0.0f;
+	}
+
+	template<typename ModelT, typename BindFunc, typename UpdateFunc>
+	void RunOnUpdate(benchmark::State& state, BindFunc bind, UpdateFunc update)
+	{
+		if (!HeadlessGL::MakeCurrent())
+		{
+			state.SkipWithError("no EGL context");
+			return;
+		}
+
+		// range(0): 1 when every parameter is bound, otherwise "ParamUnbound" isn't
+		ModelDirectory directory(MakeOptions(state.range(0) == 0));
+		std::unique_ptr<ModelT> model(directory.template CreateModel<ModelT>());
+		if (!model)
+		{
+			state.SkipWithError("model failed to load");
+			return;
+		}
+
+		std::vector<float> sources(kParameterCount);
+		for (int i = 0; i < kParameterCount; i++)
+		{
+			sources[i] = static_cast<float>(i % 50 - 25);
+			bind(*model, i, &sources[i]);
+		}
+		model->StartMotion(&model->GetMotions()[0]);
+		model->StartMotion(&model->GetExpressions()[0]);
+
+		StageTotals totals;
+		int frame = 0;
+		for (auto _ : state)
+		{
+			MoveSources(sources, frame++);
+			totals.Add(update(*model));
+		}
+		totals.Report(state);
+		state.SetItemsProcessed(state.iterations() * kParameterCount);
+	}
+
+} // namespace
+
+static void BM_Model2DOnUpdateBefore(benchmark::State& state)
+{
+	RunOnUpdate<Model2DBeforeSnapshotSkip>(state,
+		[](Model2DBeforeSnapshotSkip& model, int index, float* source) { model.Bind(index, source); },
+		[](Model2DBeforeSnapshotSkip& model) -> const Model2D::UpdateStats& {
+			model.OnUpdateBefore(1.0f / 60.0f);
+			return model.GetBeforeStats();
+		});
+}
+BENCHMARK(BM_Model2DOnUpdateBefore)->ArgName("allBound")->Arg(0)->Arg(1);
+
+static void BM_Model2DOnUpdate(benchmark::State& state)
+{
+	RunOnUpdate<Model2D>(state,
+		[](Model2D& model, int index, float* source) { model.SetParameterBindingAt(index, source); },
+		[](Model2D& model) -> const Model2D::UpdateStats& {
+			model.OnUpdate(1.0f / 60.0f);
+			return model.GetUpdateStats();
+		});
+}
+BENCHMARK(BM_Model2DOnUpdate)->ArgName("allBound")->Arg(0)->Arg(1);
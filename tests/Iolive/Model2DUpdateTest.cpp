@@ -0,0 +1,124 @@
+#include "ModelDirectory.hpp"
+#include "../Cubism/HeadlessGL.hpp"
+#include "../Cubism/MotionJson.hpp"
+#include "../Cubism/PhysicsJson.hpp"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace {
+
+	const int kParameterCount = 500;
+	const float kExpressionValue = 5.0f;
+
+	/*
+	* kParameterCount parameters driven by a motion, an expression & physics,
+	* plus "ParamUnbound" when withUnbound, which the expression adds to
+	*/
+	ModelDirectory::Options MakeOptions(bool withUnbound)
+	{
+		ModelDirectory::Options options;
+		options.Desc = CoreStub::MakeDesc(kParameterCount, 0, 8);
+		if (withUnbound)
+			options.Desc.ParameterIds.push_back("ParamUnbound");
+
+		MotionJson::Options motion;
+		motion.CurveCount = 32;
+		motion.FirstParameter = 200;
+		options.Motions.push_back(MotionJson::Make(motion));
+
+		std::vector<std::string> expressionIds;
+		for (int i = 300; i < 310; i++)
+			expressionIds.push_back("Param" + std::to_string(i));
+		if (withUnbound)
+			expressionIds.push_back("ParamUnbound");
+		options.Expressions.push_back(ModelDirectory::MakeExpression(expressionIds, kExpressionValue));
+
+		options.Physics = PhysicsJson::Make(PhysicsJson::Options());
+		return options;
+	}
+
+	// GUI values moving every frame, bound to the first kParameterCount parameters
+	void MoveSources(std::vector<float>& sources, int frame)
+	{
+		for (int i = 0; i < static_cast<int>(sources.size()); i++)
+			sources[i] = 20.0f * std::sin(0.05f * frame + 0.3f * i);
+	}
+
+	void StartAll(Model2D& model)
+	{
+		model.StartMotion(&model.GetMotions()[0]);
+		model.StartMotion(&model.GetExpressions()[0]);
+	}
+
+} // namespace
+
+/*
+* The snapshot is skipped when every parameter is bound: the bound parameters
+* must come out of OnUpdate the same either way
+*/
+TEST(Model2DUpdate, AllBoundMatchesSnapshot)
+{
+	if (!HeadlessGL::MakeCurrent())
+		GTEST_SKIP() << "no EGL context";
+
+	ModelDirectory allBoundDirectory(MakeOptions(false));
+	ModelDirectory snapshotDirectory(MakeOptions(true));
+	std::unique_ptr<Model2D> allBound(allBoundDirectory.CreateModel());
+	std::unique_ptr<Model2D> snapshot(snapshotDirectory.CreateModel());
+	ASSERT_TRUE(allBound && snapshot);
+
+	std::vector<float> sources(kParameterCount);
+	for (int i = 0; i < kParameterCount; i++)
+	{
+		allBound->SetParameterBindingAt(i, &sources[i]);
+		snapshot->SetParameterBindingAt(i, &sources[i]);
+	}
+	ASSERT_TRUE(allBound->GetBindedParameter().IsAllBound());
+	ASSERT_FALSE(snapshot->GetBindedParameter().IsAllBound());
+
+	StartAll(*allBound);
+	StartAll(*snapshot);
+
+	for (int frame = 0; frame < 120; frame++)
+	{
+		MoveSources(sources, frame);
+		allBound->OnUpdate(1.0f / 60.0f);
+		snapshot->OnUpdate(1.0f / 60.0f);
+
+		EXPECT_EQ(allBound->GetUpdateStats().SnapshotCopies, 0);
+		EXPECT_EQ(snapshot->GetUpdateStats().SnapshotCopies, 2);
+
+		for (int i = 0; i < kParameterCount; i++)
+		{
+			ASSERT_EQ(allBound->GetModel()->GetParameterValue(i), snapshot->GetModel()->GetParameterValue(i))
+				<< "parameter " << i << ", frame " << frame;
+		}
+	}
+}
+
+// an unbound parameter gets the expression on top of its default, not once more every frame
+TEST(Model2DUpdate, UnboundParameterDoesNotAccumulate)
+{
+	if (!HeadlessGL::MakeCurrent())
+		GTEST_SKIP() << "no EGL context";
+
+	ModelDirectory directory(MakeOptions(true));
+	std::unique_ptr<Model2D> model(directory.CreateModel());
+	ASSERT_TRUE(model);
+
+	std::vector<float> sources(kParameterCount);
+	for (int i = 0; i < kParameterCount; i++)
+		model->SetParameterBindingAt(i, &sources[i]);
+	StartAll(*model);
+
+	for (int frame = 0; frame < 120; frame++)
+	{
+		MoveSources(sources, frame);
+		model->OnUpdate(1.0f / 60.0f);
+	}
+
+	// past the 0.5 s fade in
+	EXPECT_NEAR(model->GetModel()->GetParameterValue(kParameterCount), kExpressionValue, 1e-4f);
+}
@@ -0,0 +1,84 @@
+#include "ModelDirectory.hpp"
+#include <CubismModelSettingJson.hpp>
+#include <atomic>
+#include <fstream>
+#include <unistd.h>
+
+namespace {
+
+	void WriteFile(const std::filesystem::path& path, const void* data, size_t size)
+	{
+		std::ofstream file(path, std::ios::binary);
+		file.write(static_cast<const char*>(data), size);
+	}
+
+	void WriteFile(const std::filesystem::path& path, const std::string& text)
+	{
+		WriteFile(path, text.data(), text.size());
+	}
+
+} // namespace
+
+ModelDirectory::ModelDirectory(const Options& options)
+	: m_Options(options)
+{
+	static std::atomic<int> s_DirectoryCount = 0;
+	m_Path = std::filesystem::temp_directory_path() /
+		("IoliveTests-" + std::to_string(getpid()) + "-" + std::to_string(s_DirectoryCount++));
+	std::filesystem::create_directories(m_Path / "motions");
+
+	const std::vector<unsigned char> moc = CoreStub::MocBytes(m_Options.Desc);
+	WriteFile(m_Path / "model.moc3", moc.data(), moc.size());
+
+	std::string motions;
+	for (size_t i = 0; i < m_Options.Motions.size(); i++)
+	{
+		const std::string file = "motions/motion" + std::to_string(i) + ".motion3.json";
+		WriteFile(m_Path / file, m_Options.Motions[i]);
+		motions += (i ? "," : "") + std::string("{\"File\":\"") + file + "\"}";
+	}
+
+	std::string expressions;
+	for (size_t i = 0; i < m_Options.Expressions.size(); i++)
+	{
+		const std::string file = "expression" + std::to_string(i) + ".exp3.json";
+		WriteFile(m_Path / file, m_Options.Expressions[i]);
+		expressions += (i ? "," : "") + std::string("{\"Name\":\"Expression") + std::to_string(i) + "\",\"File\":\"" + file + "\"}";
+	}
+
+	std::string physics;
+	if (!m_Options.Physics.empty())
+	{
+		WriteFile(m_Path / "model.physics3.json", m_Options.Physics);
+		physics = ",\"Physics\":\"model.physics3.json\"";
+	}
+
+	WriteFile(m_Path / "model.model3.json",
+		"{\"Version\":3,\"FileReferences\":{\"Moc\":\"model.moc3\",\"Textures\":[]" + physics +
+		",\"Motions\":{\"Idle\":[" + motions + "]},\"Expressions\":[" + expressions + "]}}");
+}
+
+ModelDirectory::~ModelDirectory()
+{
+	std::error_code error;
+	std::filesystem::remove_all(m_Path, error);
+}
+
+ICubismModelSetting* ModelDirectory::LoadModelSetting() const
+{
+	CoreStub::StartFramework();
+
+	std::ifstream file(m_Path / "model.model3.json", std::ios::binary);
+	const std::string json((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	return new CubismModelSettingJson(reinterpret_cast<const csmByte*>(json.data()), static_cast<csmSizeInt>(json.size()));
+}
+
+std::string ModelDirectory::MakeExpression(const std::vector<std::string>& parameterIds, float value, float fadeTime)
+{
+	std::string parameters;
+	for (const std::string& id : parameterIds)
+		parameters += (parameters.empty() ? "" : ",") + std::string("{\"Id\":\"") + id + "\",\"Value\":" + std::to_string(value) + ",\"Blend\":\"Add\"}";
+
+	return "{\"Type\":\"Live2D Expression\",\"FadeInTime\":" + std::to_string(fadeTime) +
+		",\"FadeOutTime\":" + std::to_string(fadeTime) + ",\"Parameters\":[" + parameters + "]}";
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "../Cubism/CoreStub.hpp"
+#include "Live2D/Model2D.hpp"
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/*
+* A model3.json directory in the temp directory, for Model2D on the stub Core:
+* the .moc3 holds the address of Desc, motions, expressions & physics are the given json.
+* The directory is removed with the object, which must outlive the models created from it.
+*/
+class ModelDirectory
+{
+public:
+	struct Options
+	{
+		CoreStub::ModelDesc Desc;
+		std::vector<std::string> Motions;     // motion3.json texts, group "Idle"
+		std::vector<std::string> Expressions; // exp3.json texts
+		std::string Physics;                  // physics3.json text, empty for none
+	};
+
+	explicit ModelDirectory(const Options& options);
+	~ModelDirectory();
+
+	ModelDirectory(const ModelDirectory&) = delete;
+	ModelDirectory& operator=(const ModelDirectory&) = delete;
+
+	// like Live2DManager::CreateModel, nullptr when the model failed to initialize
+	template<typename ModelT = Model2D>
+	ModelT* CreateModel(const MotionLoading& motionLoading = MotionLoading()) const
+	{
+		ModelT* model = new ModelT(LoadModelSetting(), m_Path.wstring() + L'/', L"model.model3.json", motionLoading);
+		if (!model->IsInitialized())
+		{
+			delete model;
+			return nullptr;
+		}
+		return model;
+	}
+
+	const std::filesystem::path& GetPath() const { return m_Path; }
+
+	// exp3.json adding value to each of parameterIds, fading in & out in fadeTime seconds
+	static std::string MakeExpression(const std::vector<std::string>& parameterIds, float value, float fadeTime = 0.5f);
+
+private:
+	ICubismModelSetting* LoadModelSetting() const;
+
+private:
+	const Options m_Options;
+	std::filesystem::path m_Path;
+};
@@ -0,0 +1,79 @@
+#include "Live2D/Component/ParameterBinding.hpp"
+#include "../Cubism/CoreStub.hpp"
+#include <benchmark/benchmark.h>
+#include <map>
+#include <vector>
+
+namespace {
+
+	// every parameter bound to a GUI value that moves every frame
+	std::vector<float> MakeSources(int count)
+	{
+		std::vector<float> sources(count);
+		for (int i = 0; i < count; i++)
+			sources[i] = static_cast<float>(i % 60 - 30);
+		return sources;
+	}
+
+	void MoveSources(std::vector<float>& sources, int frame)
+	{
+		for (float& value : sources)
+			value = value > 40.0f ? -40.0f : value + 0.5f;
+		sources[frame % sources.size()] = 0.0f;
+	}
+
+} // namespace
+
+// before: std::map<int, float*> walked with a SetParameterValue call each
+static void BM_ParameterBindingMap(benchmark::State& state)
+{
+	const int count = static_cast<int>(state.range(0));
+	CoreStub::Model model(CoreStub::MakeDesc(count));
+	std::vector<float> sources = MakeSources(count);
+
+	std::map<int, float*> binding;
+	for (int i = 0; i < count; i++)
+		binding[i] = &sources[i];
+
+	int frame = 0;
+	for (auto _ : state)
+	{
+		MoveSources(sources, frame++);
+		for (auto [index, ptrValue] : binding)
+		{
+			if (ptrValue)
+				model->SetParameterValue(index, *ptrValue);
+		}
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_ParameterBindingMap)->Arg(64)->Arg(320)->Arg(1000);
+
+// after: ParameterBinding::Apply straight into the Core parameter values
+static void BM_ParameterBindingApply(benchmark::State& state)
+{
+	const int count = static_cast<int>(state.range(0));
+	CoreStub::Model model(CoreStub::MakeDesc(count));
+	std::vector<float> sources = MakeSources(count);
+
+	ParameterBinding binding;
+	binding.Setup(count,
+		Live2D::Cubism::Core::csmGetParameterMinimumValues(model->GetModel()),
+		Live2D::Cubism::Core::csmGetParameterMaximumValues(model->GetModel())
+	);
+	for (int i = 0; i < count; i++)
+		binding.Bind(i, &sources[i]);
+
+	float* values = Live2D::Cubism::Core::csmGetParameterValues(model->GetModel());
+
+	int frame = 0;
+	for (auto _ : state)
+	{
+		MoveSources(sources, frame++);
+		binding.Apply(values);
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_ParameterBindingApply)->Arg(64)->Arg(320)->Arg(1000);
@@ -0,0 +1,113 @@
+#include "Live2D/Component/ParameterBinding.hpp"
+#include "../Cubism/CoreStub.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+
+	// sources spanning past both ends of the [-30, 30] parameter range
+	std::vector<float> MakeSources(int count)
+	{
+		std::vector<float> sources(count);
+		for (int i = 0; i < count; i++)
+			sources[i] = -45.0f + 90.0f * i / count;
+		return sources;
+	}
+
+	ParameterBinding SetupBinding(CoreStub::Model& model)
+	{
+		ParameterBinding binding;
+		binding.Setup(model->GetParameterCount(),
+			Live2D::Cubism::Core::csmGetParameterMinimumValues(model->GetModel()),
+			Live2D::Cubism::Core::csmGetParameterMaximumValues(model->GetModel())
+		);
+		return binding;
+	}
+
+	// the map + SetParameterValue loop ParameterBinding replaced
+	std::vector<float> ApplyThroughModel(CoreStub::Model& model, const std::vector<float*>& sources)
+	{
+		for (int i = 0; i < static_cast<int>(sources.size()); i++)
+		{
+			if (sources[i])
+				model->SetParameterValue(i, *sources[i]);
+		}
+		const float* values = Live2D::Cubism::Core::csmGetParameterValues(model->GetModel());
+		return std::vector<float>(values, values + sources.size());
+	}
+
+} // namespace
+
+TEST(ParameterBinding, AllBoundMatchesSetParameterValue)
+{
+	const int count = 320;
+	CoreStub::Model reference(CoreStub::MakeDesc(count));
+	CoreStub::Model model(CoreStub::MakeDesc(count));
+	std::vector<float> sources = MakeSources(count);
+
+	ParameterBinding binding = SetupBinding(model);
+	std::vector<float*> bound(count);
+	for (int i = 0; i < count; i++)
+	{
+		bound[i] = &sources[i];
+		binding.Bind(i, bound[i]);
+	}
+	ASSERT_TRUE(binding.IsAllBound());
+
+	binding.Apply(Live2D::Cubism::Core::csmGetParameterValues(model->GetModel()));
+	std::vector<float> expected = ApplyThroughModel(reference, bound);
+
+	for (int i = 0; i < count; i++)
+		EXPECT_EQ(model->GetParameterValue(i), expected[i]) << "parameter " << i;
+}
+
+TEST(ParameterBinding, PartlyBoundLeavesOthersUntouched)
+{
+	const int count = 100;
+	CoreStub::Model reference(CoreStub::MakeDesc(count));
+	CoreStub::Model model(CoreStub::MakeDesc(count));
+	std::vector<float> sources = MakeSources(count);
+
+	ParameterBinding binding = SetupBinding(model);
+	std::vector<float*> bound(count, nullptr);
+	for (int i = 0; i < count; i += 3)
+	{
+		bound[i] = &sources[i];
+		binding.Bind(i, bound[i]);
+	}
+	EXPECT_FALSE(binding.IsAllBound());
+
+	for (int i = 0; i < count; i++)
+	{
+		model->SetParameterValue(i, 7.0f);
+		reference->SetParameterValue(i, 7.0f);
+	}
+
+	binding.Apply(Live2D::Cubism::Core::csmGetParameterValues(model->GetModel()));
+	std::vector<float> expected = ApplyThroughModel(reference, bound);
+
+	for (int i = 0; i < count; i++)
+		EXPECT_EQ(model->GetParameterValue(i), expected[i]) << "parameter " << i;
+}
+
+TEST(ParameterBinding, RebindReadsNewSource)
+{
+	const int count = 8;
+	CoreStub::Model model(CoreStub::MakeDesc(count));
+	float first = 5.0f, second = -12.0f;
+
+	ParameterBinding binding = SetupBinding(model);
+	binding.Bind(2, &first);
+	binding.Apply(Live2D::Cubism::Core::csmGetParameterValues(model->GetModel()));
+	EXPECT_EQ(model->GetParameterValue(2), 5.0f);
+
+	binding.Bind(2, &second);
+	binding.Apply(Live2D::Cubism::Core::csmGetParameterValues(model->GetModel()));
+	EXPECT_EQ(model->GetParameterValue(2), -12.0f);
+
+	binding.Bind(2, nullptr);
+	EXPECT_EQ(binding.GetBoundCount(), 0);
+	model->SetParameterValue(2, 1.0f);
+	binding.Apply(Live2D::Cubism::Core::csmGetParameterValues(model->GetModel()));
+	EXPECT_EQ(model->GetParameterValue(2), 1.0f);
+}
@@ -0,0 +1,111 @@
+#include "Live2D/Utility.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+* Live2D/Utility.cpp uses the Win32 file API, this is the same on POSIX
+* so Model2D runs in the tests. Wide paths go through std::filesystem.
+*/
+namespace Utility {
+
+	namespace {
+		std::string NarrowPath(const wchar_t* filePath)
+		{
+			return std::filesystem::path(filePath).string();
+		}
+	}
+
+	std::tuple<unsigned char*, int> CreateBufferFromFile(const wchar_t* filePath)
+	{
+		FILE* file = std::fopen(NarrowPath(filePath).c_str(), "rb");
+		if (!file)
+			return { nullptr, 0 };
+
+		std::fseek(file, 0, SEEK_END);
+		int fileSize = static_cast<int>(std::ftell(file));
+		std::fseek(file, 0, SEEK_SET);
+
+		unsigned char* buf = new unsigned char[fileSize];
+		if (std::fread(buf, 1, fileSize, file) != static_cast<size_t>(fileSize))
+		{
+			delete[] buf;
+			buf = nullptr;
+		}
+		std::fclose(file);
+
+		return { buf, fileSize };
+	}
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	bool MappedFile::Open(const wchar_t* filePath)
+	{
+		Close();
+
+		int file = open(NarrowPath(filePath).c_str(), O_RDONLY);
+		if (file < 0)
+			return false;
+
+		struct stat fileStat;
+		if (fstat(file, &fileStat) != 0 || fileStat.st_size <= 0)
+		{
+			// empty files can't be mapped
+			close(file);
+			return false;
+		}
+
+		void* data = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+		close(file);
+		if (data == MAP_FAILED)
+			return false;
+
+		m_Data = static_cast<const unsigned char*>(data);
+		m_Size = static_cast<size_t>(fileStat.st_size);
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (m_Data)
+			munmap(const_cast<unsigned char*>(m_Data), m_Size);
+
+		m_File = nullptr;
+		m_Mapping = nullptr;
+		m_Data = nullptr;
+		m_Size = 0;
+	}
+
+	bool WriteBufferToFile(const wchar_t* filePath, const unsigned char* buffer, size_t size)
+	{
+		const std::string path = NarrowPath(filePath);
+		FILE* file = std::fopen(path.c_str(), "wb");
+		if (!file)
+			return false;
+
+		bool success = std::fwrite(buffer, 1, size, file) == size;
+		success = std::fclose(file) == 0 && success;
+
+		if (!success)
+			std::remove(path.c_str());
+
+		return success;
+	}
+
+	wchar_t* NewWideChar(const char* value)
+	{
+		const size_t charSize = strlen(value) + 1;
+		wchar_t* wValue = new wchar_t[charSize];
+		std::mbstowcs(wValue, value, charSize);
+
+		return wValue;
+	}
+}